@@ -0,0 +1,103 @@
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include <stdint.h>
+
+// RV32A primitives. Reservations and AMOs are tracked in the RAM path of the interconnect, so
+// these must target RAM (0x20000000); on MMIO an SC always fails.
+// The core completes every access in order, so FENCE is a NOP here; the .aq/.rl bits and the
+// fences below document intent and keep the compiler from reordering around them.
+#define ATOMIC_FENCE() __asm__ volatile ("fence rw, rw" ::: "memory")
+
+static inline uint32_t atomic_swap(volatile uint32_t *p, uint32_t value) {
+    uint32_t old;
+    __asm__ volatile ("amoswap.w.aqrl %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(value) : "memory");
+    return old;
+}
+
+// Returns the value before the add
+static inline uint32_t atomic_add(volatile uint32_t *p, uint32_t value) {
+    uint32_t old;
+    __asm__ volatile ("amoadd.w.aqrl %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(value) : "memory");
+    return old;
+}
+
+static inline uint32_t atomic_or(volatile uint32_t *p, uint32_t mask) {
+    uint32_t old;
+    __asm__ volatile ("amoor.w.aqrl %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(mask) : "memory");
+    return old;
+}
+
+static inline uint32_t atomic_and(volatile uint32_t *p, uint32_t mask) {
+    uint32_t old;
+    __asm__ volatile ("amoand.w.aqrl %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(mask) : "memory");
+    return old;
+}
+
+// LR/SC loop: returns 1 if *p held 'expected' and now holds 'desired'. A trap between the LR
+// and the SC makes the SC fail and the loop retry.
+static inline int atomic_cas(volatile uint32_t *p, uint32_t expected, uint32_t desired) {
+    uint32_t seen, failed;
+    __asm__ volatile (
+        "1: lr.w.aq  %0, (%2)\n"
+        "   bne      %0, %3, 2f\n"
+        "   sc.w.rl  %1, %4, (%2)\n"
+        "   bnez     %1, 1b\n"
+        "2:\n"
+        : "=&r"(seen), "=&r"(failed) : "r"(p), "r"(expected), "r"(desired) : "memory");
+    return seen == expected;
+}
+
+// --- SPINLOCK (0 = free) ---
+typedef volatile uint32_t spinlock_t;
+
+// Single attempt: a trap handler must not spin on a lock the code it interrupted may hold
+static inline int spin_trylock(spinlock_t *lock) {
+    return atomic_swap(lock, 1) == 0;
+}
+
+static inline void spin_lock(spinlock_t *lock) {
+    while (atomic_swap(lock, 1) != 0) {
+        while (*lock); // Spin on plain loads; the AMO only retries once the lock looks free
+    }
+}
+
+static inline void spin_unlock(spinlock_t *lock) {
+    ATOMIC_FENCE();
+    *lock = 0;
+}
+
+// --- LOCK-FREE SPSC QUEUE ---
+// One producer and one consumer (e.g. a task and an ISR, or one task per hart). Each index is
+// written by one side only, so no atomics are needed: only the order of the data and index stores.
+// 'size' must be a power of two; one slot stays empty to tell full from empty.
+typedef struct {
+    volatile uint32_t *head;    // Next slot to write (producer)
+    volatile uint32_t *tail;    // Next slot to read (consumer)
+    volatile uint32_t *buffer;
+    uint32_t           size;
+} spsc_queue_t;
+
+static inline int spsc_push(const spsc_queue_t *q, uint32_t value) {
+    uint32_t head = *q->head, next = (head + 1) & (q->size - 1);
+    if (next == *q->tail) return 0; // Full
+    q->buffer[head] = value;
+    ATOMIC_FENCE();                 // Data before the index that publishes it
+    *q->head = next;
+    return 1;
+}
+
+static inline int spsc_empty(const spsc_queue_t *q) {
+    return *q->tail == *q->head;
+}
+
+static inline int spsc_pop(const spsc_queue_t *q, uint32_t *value) {
+    uint32_t tail = *q->tail;
+    if (tail == *q->head) return 0; // Empty
+    *value = q->buffer[tail];
+    ATOMIC_FENCE();                 // Slot read before it is handed back to the producer
+    *q->tail = (tail + 1) & (q->size - 1);
+    return 1;
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include "../semihost.h"
+
+// Performance counters (soc_top, read-only)
+#define PERF_CYCLES  (*(volatile uint32_t *)0x40000020)
+#define PERF_INSTRET (*(volatile uint32_t *)0x40000024)
+
+// Trap CSRs and causes (shared with the kernel in scheduler.c)
+#define CSR_MEPC     (*(volatile uint32_t *)0x40000010)
+#define CSR_MCAUSE   (*(volatile uint32_t *)0x40000014)
+#define CAUSE_TIMER  0x80000007
+#define CAUSE_ECALL  0x0000000B
+
+// Saved-register slots in the crt0 trap frame (word index)
+#define FRAME_A0     6
+#define FRAME_A7     13
+
+#define SEMI_REPORT  4u  // ARG0 = bench_result_t*: counters for the host's CSV report
+
+// Layout is read by soc_top_tb (BenchReport); keep the field order
+typedef struct {
+    const char *name;
+    uint32_t    iterations;
+    uint32_t    cycles;
+    uint32_t    instret;
+    uint32_t    checksum;
+} bench_result_t;
+
+typedef struct {
+    uint32_t cycles;
+    uint32_t instret;
+} bench_mark_t;
+
+static inline bench_mark_t bench_start(void) {
+    bench_mark_t mark;
+    mark.instret = PERF_INSTRET;
+    mark.cycles  = PERF_CYCLES;
+    return mark;
+}
+
+// Posts one result with explicit counters to the host; returns 1 if the checksum does not match
+// the value computed for this workload, so a broken core cannot post a score.
+static inline uint32_t bench_post(const char *name, uint32_t iterations, uint32_t cycles,
+                                  uint32_t instret, uint32_t checksum, uint32_t expected) {
+    bench_result_t result;
+    result.cycles     = cycles;
+    result.instret    = instret;
+    result.name       = name;
+    result.iterations = iterations;
+    result.checksum   = checksum;
+
+    SEMI_ARG0 = (uint32_t)&result;
+    SEMI_CALL = SEMI_REPORT;
+    if (checksum != expected) {
+        semihost_puts("[FAIL] checksum mismatch: ");
+        semihost_puts(name);
+        semihost_puts("\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Posts the cycles/instructions since 'start'
+static inline uint32_t bench_report(const char *name, bench_mark_t start, uint32_t iterations,
+                                    uint32_t checksum, uint32_t expected) {
+    uint32_t cycles  = PERF_CYCLES - start.cycles;
+    uint32_t instret = PERF_INSTRET - start.instret;
+    return bench_post(name, iterations, cycles, instret, checksum, expected);
+}
+
+// Ends the run; the exit code (number of failed checks) becomes the simulator's status
+static inline void bench_exit(uint32_t failures) {
+    semihost_exit(failures);
+}
+
+// System call from a benchmark: a7 = number, a0 = argument/result (served by bench_rt.c)
+static inline uint32_t bench_syscall(uint32_t number, uint32_t argument) {
+    register uint32_t a0 __asm__("a0") = argument;
+    register uint32_t a7 __asm__("a7") = number;
+    __asm__ volatile ("ecall" : "+r"(a0) : "r"(a7) : "memory");
+    return a0;
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include <stdint.h>
+#include "bench.h"
+
+// Runtime shared by every benchmark image (linked with crt0.S and boot.c)
+
+// System calls: 0 returns its argument (null call), 1 returns the cycle counter
+static uint32_t syscall_dispatch(uint32_t number, uint32_t argument) {
+    switch (number) {
+        case 1:  return PERF_CYCLES;
+        default: return argument;
+    }
+}
+
+// Trap entry (crt0): timer ticks resume the interrupted code (their cost is part of every
+// measurement, as on a running system); ECALL is served in place and resumes after the ecall.
+// Images that schedule tasks (ctxswitch.c) provide their own trap_handler.
+__attribute__((weak)) uint32_t trap_handler(uint32_t current_sp) {
+    if (CSR_MCAUSE == CAUSE_ECALL) {
+        volatile uint32_t *frame = (volatile uint32_t *)current_sp;
+        frame[FRAME_A0] = syscall_dispatch(frame[FRAME_A7], frame[FRAME_A0]);
+        CSR_MEPC = CSR_MEPC + 4;
+    }
+    return current_sp;
+}
+
+// RV32I has no M extension and the images link with -nostdlib: the compiler's multiply and
+// divide helpers are provided here (shift-and-add / restoring division).
+uint32_t __mulsi3(uint32_t a, uint32_t b) {
+    uint32_t product = 0;
+    while (b) {
+        if (b & 1) product += a;
+        a <<= 1;
+        b >>= 1;
+    }
+    return product;
+}
+
+static uint32_t udivmod(uint32_t dividend, uint32_t divisor, uint32_t *remainder) {
+    uint32_t quotient = 0, rest = 0;
+    if (divisor == 0) {
+        *remainder = dividend;
+        return 0xFFFFFFFF;
+    }
+    for (int bit = 31; bit >= 0; bit--) {
+        rest = (rest << 1) | ((dividend >> bit) & 1);
+        if (rest >= divisor) {
+            rest -= divisor;
+            quotient |= 1u << bit;
+        }
+    }
+    *remainder = rest;
+    return quotient;
+}
+
+uint32_t __udivsi3(uint32_t a, uint32_t b) {
+    uint32_t remainder;
+    return udivmod(a, b, &remainder);
+}
+
+uint32_t __umodsi3(uint32_t a, uint32_t b) {
+    uint32_t remainder;
+    udivmod(a, b, &remainder);
+    return remainder;
+}
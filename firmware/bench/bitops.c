@@ -0,0 +1,133 @@
+#include <stdint.h>
+#include "bench.h"
+#include "../bitops.h"
+
+// Cost of the bitops.h helpers (Zba/Zbb) against their RV32I forms. Each row repeats one
+// operation CALLS times, so cycles / iterations is the cost of one. The rows without a suffix
+// use bitops.h as built (one Zbb instruction with config.sh's -march); the _soft rows always
+// run the RV32I sequence, so one image shows both.
+// - ready_ctz / ready_scan: round-robin pick from a 32-slot ready mask, by CTZ or by testing
+//   one slot per step like the scheduler's task table walk
+// - clz / ctz / cpop: over 256 values spread across every bit position (zero included)
+// - checksum_rol: rotate-xor hash of a 512-byte buffer per call
+// - checksum_be: Internet checksum (big-endian 16-bit words) of the buffer per call
+
+#define VALUES       256
+#define BUFFER_WORDS 128
+#define CALLS        VALUES
+#define SUM_CALLS    16
+
+#define EXPECTED_READY  0x00000F93u
+#define EXPECTED_CLZ    0x0000091Cu
+#define EXPECTED_CTZ    0x000008A6u
+#define EXPECTED_CPOP   0x00000875u
+#define EXPECTED_ROL    0x0E048278u
+#define EXPECTED_BE     0x00043D48u
+
+static uint32_t values[VALUES];
+static uint32_t ready[VALUES];       // Ready sets: a few of the 32 slots (about one in eight), never empty
+static uint32_t buffer[BUFFER_WORDS];
+
+#define XORSHIFT(x) do { (x) ^= (x) << 13; (x) ^= (x) >> 17; (x) ^= (x) << 5; } while (0)
+
+// One slot per step from the one after 'after' (the scheduler's loop, sized for 32 tasks)
+static uint32_t next_ready_scan(uint32_t mask, uint32_t after) {
+    uint32_t candidate = after;
+    for (uint32_t i = 0; i < 32; i++) {
+        if (++candidate >= 32) candidate = 0;
+        if (mask & (1u << candidate)) return candidate;
+    }
+    return 32;
+}
+
+// The call number seeds each checksum, so no call can be hoisted out of the row's loop
+static uint32_t checksum_rol(uint32_t sum) {
+    for (uint32_t i = 0; i < BUFFER_WORDS; i++) sum = bit_rol(sum, 5) ^ buffer[i];
+    return sum;
+}
+
+static uint32_t checksum_rol_soft(uint32_t sum) {
+    for (uint32_t i = 0; i < BUFFER_WORDS; i++) sum = bit_rol_soft(sum, 5) ^ buffer[i];
+    return sum;
+}
+
+// Ones' complement sum of the buffer read as big-endian 16-bit words, folded to 16 bits
+static uint32_t checksum_be(uint32_t sum) {
+    for (uint32_t i = 0; i < BUFFER_WORDS; i++) {
+        uint32_t w = bit_bswap(buffer[i]);
+        sum += (w >> 16) + (w & 0xFFFF);
+    }
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (sum & 0xFFFF) + (sum >> 16);
+}
+
+static uint32_t checksum_be_soft(uint32_t sum) {
+    for (uint32_t i = 0; i < BUFFER_WORDS; i++) {
+        uint32_t w = bit_bswap_soft(buffer[i]);
+        sum += (w >> 16) + (w & 0xFFFF);
+    }
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (sum & 0xFFFF) + (sum >> 16);
+}
+
+// Row with the call loop inlined (as in bench/libc.c)
+#define BENCH_CALLS(name, calls, body, checksum, expected) do {                         \
+        bench_mark_t start = bench_start();                                              \
+        for (uint32_t call = 0; call < (calls); call++) { body; }                        \
+        uint32_t cycles  = PERF_CYCLES - start.cycles;                                   \
+        uint32_t instret = PERF_INSTRET - start.instret;                                 \
+        failures += bench_post(name, calls, cycles, instret, checksum, expected);        \
+    } while (0)
+
+int main(void) {
+    uint32_t failures = 0;
+    uint32_t seed = 0x9E3779B9u;
+    for (uint32_t i = 0; i < VALUES; i++) {
+        XORSHIFT(seed);
+        values[i] = (i & 1) ? seed >> (i & 31) : seed << (i & 31);   // Leading and trailing zeros
+    }
+    values[0] = 0;
+    for (uint32_t i = 0; i < VALUES; i++) {
+        uint32_t mask = 0xFFFFFFFFu;
+        for (uint32_t k = 0; k < 3; k++) { XORSHIFT(seed); mask &= seed; }
+        ready[i] = mask | (1u << (seed >> 27));
+    }
+    for (uint32_t i = 0; i < BUFFER_WORDS; i++) buffer[i] = values[(i * 5) & (VALUES - 1)] ^ (i << 8);
+
+    uint32_t sum, current;
+
+    // 1. Ready-task selection
+    sum = 0; current = 31;
+    BENCH_CALLS("ready_ctz", CALLS, current = bit_next_set(ready[call], current); sum += current,
+                sum, EXPECTED_READY);
+    sum = 0; current = 31;
+    BENCH_CALLS("ready_scan", CALLS, current = next_ready_scan(ready[call], current); sum += current,
+                sum, EXPECTED_READY);
+
+    // 2. Counts
+    sum = 0;
+    BENCH_CALLS("clz", CALLS, sum += bit_clz(values[call]), sum, EXPECTED_CLZ);
+    sum = 0;
+    BENCH_CALLS("clz_soft", CALLS, sum += bit_clz_soft(values[call]), sum, EXPECTED_CLZ);
+    sum = 0;
+    BENCH_CALLS("ctz", CALLS, sum += bit_ctz(values[call]), sum, EXPECTED_CTZ);
+    sum = 0;
+    BENCH_CALLS("ctz_soft", CALLS, sum += bit_ctz_soft(values[call]), sum, EXPECTED_CTZ);
+    sum = 0;
+    BENCH_CALLS("cpop", CALLS, sum += bit_popcount(values[call]), sum, EXPECTED_CPOP);
+    sum = 0;
+    BENCH_CALLS("cpop_soft", CALLS, sum += bit_popcount_soft(values[call]), sum, EXPECTED_CPOP);
+
+    // 3. Checksums over the 512-byte buffer
+    sum = 0;
+    BENCH_CALLS("checksum_rol", SUM_CALLS, sum += checksum_rol(call), sum, EXPECTED_ROL);
+    sum = 0;
+    BENCH_CALLS("checksum_rol_soft", SUM_CALLS, sum += checksum_rol_soft(call), sum, EXPECTED_ROL);
+    sum = 0;
+    BENCH_CALLS("checksum_be", SUM_CALLS, sum += checksum_be(call), sum, EXPECTED_BE);
+    sum = 0;
+    BENCH_CALLS("checksum_be_soft", SUM_CALLS, sum += checksum_be_soft(call), sum, EXPECTED_BE);
+
+    bench_exit(failures);
+    return 0;
+}
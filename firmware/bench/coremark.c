@@ -0,0 +1,146 @@
+#include <stdint.h>
+#include "bench.h"
+
+// CoreMark-style workload: the three kernels of the classic benchmark (linked-list find and
+// sort, small matrix multiply-accumulate, input-scanning state machine), each result folded
+// into a CRC-16 as CoreMark validates its runs. Sized for 4KB RAM; scores are not CoreMark.
+
+#define ITERATIONS 4
+#define EXPECTED   0x00009700u
+
+#define LIST_NODES 24
+#define MATRIX_N   6
+#define INPUT_SIZE 64
+
+typedef struct node {
+    struct node *next;
+    int16_t      key;
+    int16_t      value;
+} node_t;
+
+static node_t  nodes[LIST_NODES];
+static int16_t matrix_a[MATRIX_N][MATRIX_N], matrix_b[MATRIX_N][MATRIX_N];
+static int32_t matrix_c[MATRIX_N][MATRIX_N];
+static char    input[INPUT_SIZE];
+
+static uint16_t crc16_update(uint16_t crc, uint32_t data, uint32_t bits) {
+    for (uint32_t i = 0; i < bits; i++) {
+        uint32_t mix = (crc ^ (data >> i)) & 1;
+        crc >>= 1;
+        if (mix) crc ^= 0xA001;
+    }
+    return crc;
+}
+
+// --- 1. LIST: build, find keys, insertion sort by value ---
+static node_t *list_build(uint32_t seed) {
+    node_t *head = 0;
+    for (int32_t i = LIST_NODES - 1; i >= 0; i--) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        nodes[i].key   = (int16_t)i;
+        nodes[i].value = (int16_t)(seed & 0x7FFF);
+        nodes[i].next  = head;
+        head = &nodes[i];
+    }
+    return head;
+}
+
+static node_t *list_find(node_t *head, int16_t key) {
+    while (head && head->key != key) head = head->next;
+    return head;
+}
+
+static node_t *list_sort(node_t *head) {
+    node_t *sorted = 0;
+    while (head) {
+        node_t *node = head;
+        head = head->next;
+        node_t **link = &sorted;
+        while (*link && (*link)->value < node->value) link = &(*link)->next;
+        node->next = *link;
+        *link = node;
+    }
+    return sorted;
+}
+
+static uint16_t bench_list(uint32_t seed, uint16_t crc) {
+    node_t *head = list_build(seed);
+    for (int16_t key = 0; key < LIST_NODES; key += 5) {
+        node_t *found = list_find(head, key);
+        crc = crc16_update(crc, found ? (uint16_t)found->value : 0xFFFF, 16);
+    }
+    head = list_sort(head);
+    for (node_t *node = head; node; node = node->next) crc = crc16_update(crc, (uint16_t)node->value, 16);
+    return crc;
+}
+
+// --- 2. MATRIX: C = A * B, then C += constant (software multiply on RV32I) ---
+static uint16_t bench_matrix(uint32_t seed, uint16_t crc) {
+    for (int32_t i = 0; i < MATRIX_N; i++) {
+        for (int32_t j = 0; j < MATRIX_N; j++) {
+            seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+            matrix_a[i][j] = (int16_t)((seed & 0xFF) - 128);
+            matrix_b[i][j] = (int16_t)((seed >> 8) & 0xFF);
+        }
+    }
+    for (int32_t i = 0; i < MATRIX_N; i++) {
+        for (int32_t j = 0; j < MATRIX_N; j++) {
+            int32_t sum = 0;
+            for (int32_t k = 0; k < MATRIX_N; k++) sum += (int32_t)matrix_a[i][k] * matrix_b[k][j];
+            matrix_c[i][j] = sum + (int32_t)(seed % 7);
+        }
+    }
+    for (int32_t i = 0; i < MATRIX_N; i++)
+        for (int32_t j = 0; j < MATRIX_N; j++) crc = crc16_update(crc, (uint32_t)matrix_c[i][j], 32);
+    return crc;
+}
+
+// --- 3. STATE MACHINE: classify comma-separated tokens (int, float, exponent, invalid) ---
+enum { STATE_START, STATE_INT, STATE_FLOAT, STATE_EXP, STATE_INVALID, STATE_COUNT };
+
+static uint16_t bench_state(uint32_t seed, uint16_t crc) {
+    static const char alphabet[] = "0123456789.e-,x";
+    for (int32_t i = 0; i < INPUT_SIZE - 1; i++) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        input[i] = alphabet[seed % 15];
+    }
+    input[INPUT_SIZE - 1] = 0;
+
+    uint32_t counts[STATE_COUNT] = { 0, 0, 0, 0, 0 };
+    uint32_t state = STATE_START;
+    for (const char *p = input; ; p++) {
+        char c = *p;
+        if (c == ',' || c == 0) {
+            counts[state]++;
+            state = STATE_START;
+            if (c == 0) break;
+            continue;
+        }
+        uint32_t digit = (c >= '0' && c <= '9');
+        switch (state) {
+            case STATE_START: state = digit || c == '-' ? STATE_INT : STATE_INVALID; break;
+            case STATE_INT:   state = digit ? STATE_INT : c == '.' ? STATE_FLOAT : c == 'e' ? STATE_EXP : STATE_INVALID; break;
+            case STATE_FLOAT: state = digit ? STATE_FLOAT : c == 'e' ? STATE_EXP : STATE_INVALID; break;
+            case STATE_EXP:   state = digit || c == '-' ? STATE_EXP : STATE_INVALID; break;
+            default:          break;
+        }
+    }
+    for (uint32_t s = 0; s < STATE_COUNT; s++) crc = crc16_update(crc, counts[s], 16);
+    return crc;
+}
+
+int main(void) {
+    uint16_t crc = 0;
+
+    bench_mark_t start = bench_start();
+    for (uint32_t run = 0; run < ITERATIONS; run++) {
+        uint32_t seed = 0x2545F491u + run;
+        crc = bench_list(seed, crc);
+        crc = bench_matrix(seed, crc);
+        crc = bench_state(seed, crc);
+    }
+
+    uint32_t failures = bench_report("coremark", start, ITERATIONS, crc, EXPECTED);
+    bench_exit(failures);
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <stdint.h>
+#include "bench.h"
+
+// CRC-32 (IEEE, reflected) over a 512-byte buffer, bitwise and with a 16-entry nibble table:
+// shift/xor/branch heavy, one byte load per step.
+
+#define BUFFER_BYTES 512
+#define PASSES       2
+#define EXPECTED_BITWISE 0x11BF6819u
+#define EXPECTED_NIBBLE  0x11BF6819u
+
+static uint8_t buffer[BUFFER_BYTES];
+
+static const uint32_t nibble_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+static uint32_t crc32_bitwise(const uint8_t *data, uint32_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (length--) {
+        crc ^= *data++;
+        for (int32_t bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static uint32_t crc32_nibble(const uint8_t *data, uint32_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (length--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ nibble_table[crc & 0xF];
+        crc = (crc >> 4) ^ nibble_table[crc & 0xF];
+    }
+    return ~crc;
+}
+
+int main(void) {
+    uint32_t failures = 0, crc = 0;
+    for (uint32_t i = 0; i < BUFFER_BYTES; i++) buffer[i] = (uint8_t)(i ^ (i >> 3) ^ 0x5A);
+
+    bench_mark_t start = bench_start();
+    for (uint32_t pass = 0; pass < PASSES; pass++) crc = (crc << 1) ^ crc32_bitwise(buffer, BUFFER_BYTES - pass);
+    failures += bench_report("crc32_bit", start, PASSES, crc, EXPECTED_BITWISE);
+
+    crc   = 0;
+    start = bench_start();
+    for (uint32_t pass = 0; pass < PASSES; pass++) crc = (crc << 1) ^ crc32_nibble(buffer, BUFFER_BYTES - pass);
+    failures += bench_report("crc32_nibble", start, PASSES, crc, EXPECTED_NIBBLE);
+
+    bench_exit(failures);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <stdint.h>
+#include "bench.h"
+
+// Context-switch cost: two tasks hand the CPU back and forth with ECALL (yield). Each switch
+// is a full crt0 trap frame save/restore plus the scheduler below. Score: switches per Mcycle
+// (cycles per switch = 1e6 / score).
+// ctxswitch_fp (RV32F builds): both tasks keep a value of their own in fs0 across every yield,
+// so crt0.S saves and restores f0-f31 on each switch; a value that comes back changed counts
+// against the checksum. ctxswitch itself runs with the FP state clean, as a task that never
+// uses the FPU does.
+
+#define SWITCHES 200
+#define EXPECTED SWITCHES
+
+#define STACK_B_WORDS 256
+#define FRAME_WORDS   32
+
+static uint32_t stack_b[STACK_B_WORDS];
+static uint32_t task_sp[2];
+static uint32_t task_pc[2];
+static uint32_t current_task;
+static volatile uint32_t switches;
+static volatile uint32_t fp_mode, fp_errors;
+
+static inline void yield(void) {
+    __asm__ volatile ("ecall" ::: "memory");
+}
+
+// Timer ticks resume the interrupted task; ECALL switches to the other one
+uint32_t trap_handler(uint32_t current_sp) {
+    if (CSR_MCAUSE != CAUSE_ECALL) return current_sp;
+
+    task_sp[current_task] = current_sp;
+    task_pc[current_task] = CSR_MEPC + 4;
+    current_task ^= 1;
+    switches++;
+    CSR_MEPC = task_pc[current_task];
+    return task_sp[current_task];
+}
+
+#if defined(__riscv_flen)
+// Yield with 'value' in fs0; counts an error if another task's value comes back
+static inline void yield_fp(uint32_t value) {
+    uint32_t back;
+    __asm__ volatile ("fmv.w.x fs0, %1\n\tecall\n\tfmv.x.w %0, fs0" : "=r"(back) : "r"(value) : "fs0", "memory");
+    if (back != value) fp_errors++;
+}
+#endif
+
+static void task_b(void) {
+    while (1) {
+#if defined(__riscv_flen)
+        if (fp_mode) { yield_fp(0x40000000u); continue; }
+#endif
+        yield();
+    }
+}
+
+int main(void) {
+    // Task B starts at task_b on its own stack with an empty trap frame
+    uint32_t *frame_b = stack_b + STACK_B_WORDS - FRAME_WORDS;
+    for (uint32_t i = 0; i < FRAME_WORDS; i++) frame_b[i] = 0;
+    task_sp[1]   = (uint32_t)frame_b;
+    task_pc[1]   = (uint32_t)task_b;
+    current_task = 0;
+    switches     = 0;
+
+    bench_mark_t start = bench_start();
+    while (switches < SWITCHES) yield();
+
+    uint32_t failures = bench_report("ctxswitch", start, switches, switches, EXPECTED);
+
+#if defined(__riscv_flen)
+    fp_mode  = 1;
+    switches = 0;
+    start    = bench_start();
+    while (switches < SWITCHES) yield_fp(0x3F800000u);
+    failures += bench_report("ctxswitch_fp", start, switches, switches - fp_errors, EXPECTED);
+#endif
+    bench_exit(failures);
+    return 0;
+}
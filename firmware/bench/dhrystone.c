@@ -0,0 +1,201 @@
+#include <stdint.h>
+#include "bench.h"
+
+// Dhrystone-style integer workload: record manipulation through pointers, string copy and
+// compare, enumerations and small procedures, in the proportions of the classic benchmark.
+// A compact re-implementation (not the reference source), so scores are not DMIPS.
+
+#define ITERATIONS 100
+#define EXPECTED   0x016E07B8u
+
+typedef enum { IDENT_1, IDENT_2, IDENT_3, IDENT_4, IDENT_5 } enumeration_t;
+
+typedef struct record {
+    struct record *next;
+    enumeration_t  discriminant;
+    enumeration_t  enum_comp;
+    int32_t        int_comp;
+    char           string_comp[32];
+} record_t;
+
+static record_t  records[2];
+static record_t *record_glob;
+static int32_t   array_1[32];
+static int32_t   array_2[16][16];
+static char      string_1[32], string_2[32];
+static int32_t   int_glob;
+static uint32_t  bool_glob;
+static char      char_glob_1, char_glob_2;
+
+static void str_copy(char *dst, const char *src) {
+    while ((*dst++ = *src++));
+}
+
+static int32_t str_compare(const char *a, const char *b) {
+    while (*a && *a == *b) { a++; b++; }
+    return (int32_t)(uint8_t)*a - (int32_t)(uint8_t)*b;
+}
+
+static uint32_t func_3(enumeration_t value) {
+    return value == IDENT_3;
+}
+
+static void proc_6(enumeration_t value, enumeration_t *out) {
+    *out = value;
+    if (!func_3(value)) *out = IDENT_4;
+    switch (value) {
+        case IDENT_1: *out = IDENT_1; break;
+        case IDENT_2: *out = (int_glob > 100) ? IDENT_1 : IDENT_4; break;
+        case IDENT_3: *out = IDENT_2; break;
+        case IDENT_4: break;
+        case IDENT_5: *out = IDENT_3; break;
+    }
+}
+
+static void proc_7(int32_t a, int32_t b, int32_t *out) {
+    *out = b + a + 2;
+}
+
+static void proc_8(int32_t *arr_1, int32_t arr_2[16][16], int32_t a, int32_t b) {
+    int32_t index = a + 5;
+    arr_1[index]      = b;
+    arr_1[index + 1]  = arr_1[index];
+    arr_1[index + 10] = index;
+    for (int32_t i = index; i <= index + 1; i++) arr_2[index][i] = index;
+    arr_2[index][index - 1] += 1;
+    arr_2[index + 5][index] = arr_1[index];
+    int_glob = 5;
+}
+
+static enumeration_t func_1(char a, char b) {
+    if (a != b) return IDENT_1;
+    char_glob_1 = a;
+    return IDENT_2;
+}
+
+static uint32_t func_2(const char *a, const char *b) {
+    int32_t index = 2;
+    char    letter = 'A';
+    while (index <= 2) {
+        if (func_1(a[index], b[index + 1]) == IDENT_1) {
+            letter = 'A';
+            index++;
+        }
+    }
+    if (letter >= 'W' && letter < 'Z') index = 7;
+    if (letter == 'R') return 1;
+    if (str_compare(a, b) > 0) {
+        int_glob = index + 7;
+        return 1;
+    }
+    return 0;
+}
+
+static void proc_3(record_t **out) {
+    if (record_glob) *out = record_glob->next;
+    proc_7(10, int_glob, &record_glob->int_comp);
+}
+
+static void proc_1(record_t *value) {
+    record_t *next = value->next;
+    // Field-wise copy of *record_glob (a struct assignment would call memcpy)
+    next->next          = record_glob->next;
+    next->discriminant  = record_glob->discriminant;
+    next->enum_comp     = record_glob->enum_comp;
+    next->int_comp      = record_glob->int_comp;
+    str_copy(next->string_comp, record_glob->string_comp);
+
+    value->int_comp = 5;
+    next->int_comp  = value->int_comp;
+    next->next      = value->next;
+    proc_3(&next->next);
+    if (next->discriminant == IDENT_1) {
+        next->int_comp = 6;
+        proc_6(value->enum_comp, &next->enum_comp);
+        next->next = record_glob->next;
+        proc_7(next->int_comp, 10, &next->int_comp);
+    } else {
+        value->int_comp = next->int_comp;
+    }
+}
+
+static void proc_2(int32_t *value) {
+    int32_t local = *value + 10;
+    enumeration_t enum_local = IDENT_2;
+    do {
+        if (char_glob_1 == 'A') {
+            local--;
+            *value = local - int_glob;
+            enum_local = IDENT_1;
+        }
+    } while (enum_local != IDENT_1);
+}
+
+static void proc_4(void) {
+    uint32_t local = (char_glob_1 == 'A');
+    bool_glob   = local | bool_glob;
+    char_glob_2 = 'B';
+}
+
+static void proc_5(void) {
+    char_glob_1 = 'A';
+    bool_glob   = 0;
+}
+
+int main(void) {
+    records[0].next         = &records[1];
+    records[0].discriminant = IDENT_1;
+    records[0].enum_comp    = IDENT_3;
+    records[0].int_comp     = 40;
+    str_copy(records[0].string_comp, "DHRYSTONE PROGRAM, SOME STRING");
+    records[1].next         = 0;
+    record_glob             = &records[0];
+    for (int32_t i = 0; i < 32; i++) array_1[i] = 0;
+    for (int32_t i = 0; i < 16; i++)
+        for (int32_t j = 0; j < 16; j++) array_2[i][j] = 0;
+    array_2[8][7] = 10;
+    str_copy(string_1, "DHRYSTONE PROGRAM, 1'ST STRING");
+    int_glob = 0;
+    bool_glob = 0;
+
+    int32_t       int_1 = 0, int_2 = 0, int_3 = 0;
+    enumeration_t enum_local = IDENT_2;
+    uint32_t      checksum = 0;
+
+    bench_mark_t start = bench_start();
+    for (uint32_t run = 1; run <= ITERATIONS; run++) {
+        proc_5();
+        proc_4();
+        int_1 = 2;
+        int_2 = 3;
+        str_copy(string_2, "DHRYSTONE PROGRAM, 2'ND STRING");
+        enum_local = IDENT_2;
+        bool_glob = !func_2(string_1, string_2);
+        while (int_1 < int_2) {
+            int_3 = 5 * int_1 - int_2;
+            proc_7(int_1, int_2, &int_3);
+            int_1 += 1;
+        }
+        proc_8(array_1, array_2, int_1, int_3);
+        proc_1(record_glob);
+        for (char index = 'A'; index <= char_glob_2; index++) {
+            if (enum_local == func_1(index, 'C')) {
+                proc_6(IDENT_1, &enum_local);
+                str_copy(string_2, "DHRYSTONE PROGRAM, 3'RD STRING");
+                int_2 = run;
+                int_glob = run;
+            }
+        }
+        int_2 = int_2 * int_1;
+        int_1 = (int32_t)((uint32_t)int_2 / (uint32_t)int_3);
+        int_2 = 7 * (int_2 - int_3) - int_1;
+        proc_2(&int_1);
+        checksum = (checksum << 1 | checksum >> 31) ^ (uint32_t)(int_1 + int_2 + int_3 + int_glob);
+    }
+    checksum ^= (uint32_t)records[1].int_comp ^ ((uint32_t)array_1[8] << 8) ^ ((uint32_t)array_2[8][7] << 16) ^
+                (uint32_t)str_compare(string_2, "DHRYSTONE PROGRAM, 2'ND STRING") ^ (bool_glob << 24);
+
+    uint32_t failures = bench_report("dhrystone", start, ITERATIONS, checksum, EXPECTED);
+    bench_exit(failures);
+    return 0;
+}
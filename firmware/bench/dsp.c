@@ -0,0 +1,193 @@
+#include <stdint.h>
+#include "bench.h"
+#include "../fpu.h"
+
+// Control-loop arithmetic on the FPU against the fixed-point and soft-float code it replaces.
+// The rows without a suffix use fpu.h as built (FPU instructions: the Makefile adds F for this image); the
+// _soft rows always run the RV32I soft-float, and the _q15 rows are the Q15 fixed-point form
+// (multiplies through bench_rt.c's shift-and-add __mulsi3: the core has no M extension).
+// Built with -ffp-contract=off (Makefile), so float and soft-float round the same operations
+// and share their expected checksums; fir_fma is the one row with fused multiply-adds.
+// - fir_*: 16-tap low-pass FIR over 128 samples of a noisy square wave (iterations: samples)
+// - pid_*: PID loop driving a first-order plant through 256 steps of a changing setpoint, output
+//   clamped to [-1, 1] (iterations: steps)
+
+#define TAPS    16
+#define SAMPLES 128
+#define STEPS   256
+
+#define EXPECTED_FIR_FLOAT 0xAEFAD0BFu
+#define EXPECTED_FIR_FMA   0xAEFAD0ACu
+#define EXPECTED_FIR_Q15   0x0000007Cu
+#define EXPECTED_PID_FLOAT 0x7E53C7B3u
+#define EXPECTED_PID_Q15   0x0010CACEu
+
+#define Q15_SCALE 0x38000000u  // 2^-15: Q15 value to float, exact
+
+// Symmetric low-pass (Q15, gain 1 - 2^-13)
+static const int32_t taps_q15[TAPS] = {
+    -327, -511, -257, 509, 1793, 3329, 5119, 6727, 6727, 5119, 3329, 1793, 509, -257, -511, -327
+};
+
+static int32_t samples_q15[SAMPLES + TAPS - 1];
+static fp32_t  taps[TAPS];
+static fp32_t  samples[SAMPLES + TAPS - 1];
+
+#define XORSHIFT(x) do { (x) ^= (x) << 13; (x) ^= (x) >> 17; (x) ^= (x) << 5; } while (0)
+
+// --- 1. FIR FILTER ---
+// Output n is the dot product of the taps with samples n .. n + TAPS - 1; the checksum adds
+// up the outputs' bits
+
+#if defined(__riscv_flen)
+static uint32_t fir_fma(void) {
+    uint32_t sum = 0;
+    for (uint32_t n = 0; n < SAMPLES; n++) {
+        fp32_t acc = 0;
+        for (uint32_t k = 0; k < TAPS; k++) acc = fp32_fma(taps[k], samples[n + k], acc);
+        sum += acc;
+    }
+    return sum;
+}
+#endif
+
+static uint32_t fir_float(void) {
+    uint32_t sum = 0;
+    for (uint32_t n = 0; n < SAMPLES; n++) {
+        fp32_t acc = 0;
+        for (uint32_t k = 0; k < TAPS; k++) acc = fp32_add(acc, fp32_mul(taps[k], samples[n + k]));
+        sum += acc;
+    }
+    return sum;
+}
+
+static uint32_t fir_soft(void) {
+    uint32_t sum = 0;
+    for (uint32_t n = 0; n < SAMPLES; n++) {
+        fp32_t acc = 0;
+        for (uint32_t k = 0; k < TAPS; k++) acc = fp32_add_soft(acc, fp32_mul_soft(taps[k], samples[n + k]));
+        sum += acc;
+    }
+    return sum;
+}
+
+// Q30 products summed in 32 bits (the samples stay within 2^14), rounded back to Q15
+static uint32_t fir_q15(void) {
+    uint32_t sum = 0;
+    for (uint32_t n = 0; n < SAMPLES; n++) {
+        int32_t acc = 0;
+        for (uint32_t k = 0; k < TAPS; k++) acc += taps_q15[k] * samples_q15[n + k];
+        sum += (uint32_t)((acc + (1 << 14)) >> 15);
+    }
+    return sum;
+}
+
+// --- 2. PID LOOP ---
+// u = kp*e + ki*sum(e) + kd*(e - e_prev), clamped; plant y += (u - y) / 8. The setpoint
+// steps between 0.5 and -0.25 every 64 steps. The checksum adds up the controller outputs.
+
+#define KP     0x3F400000u  // 0.75
+#define KI     0x3D800000u  // 0.0625
+#define KD     0x3E800000u  // 0.25
+#define ALPHA  0x3E000000u  // 0.125
+#define HIGH   0x3F000000u  // 0.5
+#define LOW    0xBE800000u  // -0.25
+
+static uint32_t pid_float(void) {
+    fp32_t y = 0, integral = 0, previous = 0;
+    uint32_t sum = 0;
+    for (uint32_t step = 0; step < STEPS; step++) {
+        fp32_t setpoint = (step & 64) ? LOW : HIGH;
+        fp32_t error    = fp32_sub(setpoint, y);
+        integral        = fp32_add(integral, fp32_mul(KI, error));
+        fp32_t u = fp32_add(fp32_add(fp32_mul(KP, error), integral), fp32_mul(KD, fp32_sub(error, previous)));
+        if (fp32_lt(u, FP32_ONE | FP32_SIGN)) u = FP32_ONE | FP32_SIGN;
+        if (fp32_lt(FP32_ONE, u)) u = FP32_ONE;
+        y        = fp32_add(y, fp32_mul(ALPHA, fp32_sub(u, y)));
+        previous = error;
+        sum     += u;
+    }
+    return sum;
+}
+
+static uint32_t pid_soft(void) {
+    fp32_t y = 0, integral = 0, previous = 0;
+    uint32_t sum = 0;
+    for (uint32_t step = 0; step < STEPS; step++) {
+        fp32_t setpoint = (step & 64) ? LOW : HIGH;
+        fp32_t error    = fp32_sub_soft(setpoint, y);
+        integral        = fp32_add_soft(integral, fp32_mul_soft(KI, error));
+        fp32_t u = fp32_add_soft(fp32_add_soft(fp32_mul_soft(KP, error), integral),
+                                 fp32_mul_soft(KD, fp32_sub_soft(error, previous)));
+        if (fp32_lt_soft(u, FP32_ONE | FP32_SIGN)) u = FP32_ONE | FP32_SIGN;
+        if (fp32_lt_soft(FP32_ONE, u)) u = FP32_ONE;
+        y        = fp32_add_soft(y, fp32_mul_soft(ALPHA, fp32_sub_soft(u, y)));
+        previous = error;
+        sum     += u;
+    }
+    return sum;
+}
+
+// Same loop in Q15 (gains 24576, 2048, 8192; plant step by >> 3), saturating the output
+static uint32_t pid_q15(void) {
+    int32_t y = 0, integral = 0, previous = 0;
+    uint32_t sum = 0;
+    for (uint32_t step = 0; step < STEPS; step++) {
+        int32_t setpoint = (step & 64) ? -8192 : 16384;
+        int32_t error    = setpoint - y;
+        integral        += (2048 * error) >> 15;
+        int32_t u = ((24576 * error) >> 15) + integral + ((8192 * (error - previous)) >> 15);
+        if (u < -32768) u = -32768;
+        if (u > 32767)  u = 32767;
+        y        += (u - y) >> 3;
+        previous = error;
+        sum     += (uint32_t)u;
+    }
+    return sum;
+}
+
+int main(void) {
+    uint32_t failures = 0;
+    uint32_t seed = 0x2545F491u;
+
+    // Square wave of amplitude 0.25 plus noise within +-0.125 (Q15), and its exact float copy
+    for (uint32_t i = 0; i < SAMPLES + TAPS - 1; i++) {
+        XORSHIFT(seed);
+        samples_q15[i] = ((i & 32) ? 8192 : -8192) + (int32_t)(seed >> 20) - 2048;
+        samples[i]     = fp32_mul_soft(fp32_from_int_soft(samples_q15[i]), Q15_SCALE);
+    }
+    for (uint32_t k = 0; k < TAPS; k++) taps[k] = fp32_mul_soft(fp32_from_int_soft(taps_q15[k]), Q15_SCALE);
+
+    bench_mark_t start;
+    uint32_t sum;
+
+    // 1. FIR filter
+#if defined(__riscv_flen)
+    start = bench_start();
+    sum   = fir_fma();
+    failures += bench_report("fir_fma", start, SAMPLES, sum, EXPECTED_FIR_FMA);
+#endif
+    start = bench_start();
+    sum   = fir_float();
+    failures += bench_report("fir_float", start, SAMPLES, sum, EXPECTED_FIR_FLOAT);
+    start = bench_start();
+    sum   = fir_soft();
+    failures += bench_report("fir_soft", start, SAMPLES, sum, EXPECTED_FIR_FLOAT);
+    start = bench_start();
+    sum   = fir_q15();
+    failures += bench_report("fir_q15", start, SAMPLES, sum, EXPECTED_FIR_Q15);
+
+    // 2. PID loop
+    start = bench_start();
+    sum   = pid_float();
+    failures += bench_report("pid_float", start, STEPS, sum, EXPECTED_PID_FLOAT);
+    start = bench_start();
+    sum   = pid_soft();
+    failures += bench_report("pid_soft", start, STEPS, sum, EXPECTED_PID_FLOAT);
+    start = bench_start();
+    sum   = pid_q15();
+    failures += bench_report("pid_q15", start, STEPS, sum, EXPECTED_PID_Q15);
+
+    bench_exit(failures);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <stdint.h>
+#include "bench.h"
+#include "../smp.h"
+#include "../ipc.h"
+#include "../timer.h"
+#include "../kernel.h"
+
+// IPC cost (linked with the kernel: scheduler.c, ipc.c, timer.c, kernel.c, pool.c). Main and a consumer task run on
+// hart 0 and hand a token back and forth through each kind of object. Every handoff finds the receiver
+// parked, so it measures the full blocking path: send/post/set, wake-up, the sender blocking on
+// the reply and the context switch into the receiver.
+// - ipc_fastpath: send + receive on a queue nobody waits on (lock-free path only)
+// - ipc_<object>: messages per Mcycle over a ping-pong run
+// - ipc_<object>_lat: the sum of send-to-receive latencies (cycles / iterations = mean latency)
+
+#define FAST_MESSAGES 1000
+#define FAST_EXPECTED 499500   // Sum of 0..999
+#define ROUNDS        100
+#define MESSAGES      (2 * ROUNDS)
+
+#define CONSUMER_TASK 1
+#define QUEUE_SIZE    4
+
+#define EVENT_PING    0x1u
+#define EVENT_PONG    0x2u
+
+typedef struct {
+    msg_queue_t       ping, pong;
+    uint32_t          ping_seq[QUEUE_SIZE], ping_data[QUEUE_SIZE];
+    uint32_t          pong_seq[QUEUE_SIZE], pong_data[QUEUE_SIZE];
+    semaphore_t       sem_ping, sem_pong;
+    event_flags_t     events;
+    volatile uint32_t stamp;       // Send time for semaphores and events (queues carry it)
+    volatile uint32_t latency;     // Sum of send-to-receive cycles, both directions
+    volatile uint32_t received;
+} ipc_workspace_t;
+
+static ipc_workspace_t workspace;   // Zeroed by crt0; main sets up the objects
+#define WS (&workspace)
+
+static inline void record(uint32_t sent) {
+    atomic_add(&WS->latency, PERF_CYCLES - sent);
+    atomic_add(&WS->received, 1);
+}
+
+static void consumer(void) {
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        record(msgq_recv(&WS->ping));
+        msgq_send(&WS->pong, PERF_CYCLES);
+    }
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        sem_wait(&WS->sem_ping);
+        record(WS->stamp);
+        WS->stamp = PERF_CYCLES;
+        sem_post(&WS->sem_pong);
+    }
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        event_wait(&WS->events, EVENT_PING);
+        record(WS->stamp);
+        WS->stamp = PERF_CYCLES;
+        event_set(&WS->events, EVENT_PONG);
+    }
+    while (1) task_yield();
+}
+
+static uint32_t report(const char *name, const char *latency_name, bench_mark_t start) {
+    uint32_t failures = bench_report(name, start, MESSAGES, WS->received, MESSAGES);
+    failures += bench_post(latency_name, WS->received, WS->latency, 0, WS->received, MESSAGES);
+    WS->latency  = 0;
+    WS->received = 0;
+    return failures;
+}
+
+int main(void) {
+    // Kernel state: main is task 0 on hart 0; task 2 is never spawned and stays parked
+    uint32_t failures = !kernel_init();
+
+    msgq_init(&WS->ping, WS->ping_seq, WS->ping_data, QUEUE_SIZE);
+    msgq_init(&WS->pong, WS->pong_seq, WS->pong_data, QUEUE_SIZE);
+    sem_init(&WS->sem_ping, 0);
+    sem_init(&WS->sem_pong, 0);
+    event_init(&WS->events);
+
+    // 1. Fast path: the consumer does not exist yet, so no call finds a waiter
+    uint32_t sum = 0, message;
+    bench_mark_t start = bench_start();
+    for (uint32_t i = 0; i < FAST_MESSAGES; i++) {
+        msgq_trysend(&WS->ping, i);
+        if (msgq_tryrecv(&WS->ping, &message)) sum += message;
+    }
+    failures += bench_report("ipc_fastpath", start, FAST_MESSAGES, sum, FAST_EXPECTED);
+
+    failures += !task_spawn(CONSUMER_TASK, consumer);
+
+    // 2. Message queue ping-pong (the message is the send time)
+    start = bench_start();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        msgq_send(&WS->ping, PERF_CYCLES);
+        record(msgq_recv(&WS->pong));
+    }
+    failures += report("ipc_queue", "ipc_queue_lat", start);
+
+    // 3. Semaphore ping-pong
+    start = bench_start();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        WS->stamp = PERF_CYCLES;
+        sem_post(&WS->sem_ping);
+        sem_wait(&WS->sem_pong);
+        record(WS->stamp);
+    }
+    failures += report("ipc_sem", "ipc_sem_lat", start);
+
+    // 4. Event flag ping-pong
+    start = bench_start();
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        WS->stamp = PERF_CYCLES;
+        event_set(&WS->events, EVENT_PING);
+        event_wait(&WS->events, EVENT_PONG);
+        record(WS->stamp);
+    }
+    failures += report("ipc_event", "ipc_event_lat", start);
+
+    bench_exit(failures);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <stdint.h>
+#include "bench.h"
+#include "../libc.h"
+
+// Per-call cost of the freestanding library (libc.c). Each row repeats one call CALLS times, so
+// cycles / iterations is the cost of a single call. The _byte rows are the loops the library
+// replaces (byte copy, byte scan, divide by 10 through bench_rt.c's __udivsi3), for comparison.
+// - memcpy_<n>: aligned copy of n bytes; memcpy_unaligned: source one byte off the destination
+// - memmove_overlap: backward copy, destination 4 bytes above the source
+// - memcmp / strlen: equal buffers (worst case: every word is compared)
+// - fmt_u32 / snprintf: one number / one formatted line per call
+
+#define BUFFER_BYTES 512
+#define CALLS        16
+#define SMALL_CALLS  128
+#define SMALL_BYTES  16
+#define STRING_BYTES 63
+#define FMT_CALLS    48          // Up to 10 digits each: fits the destination buffer
+
+#define EXPECTED_MEMCPY       0x92317731u
+#define EXPECTED_MEMCPY_BYTE  0x92317731u
+#define EXPECTED_MEMCPY_SMALL 0xC77BF031u
+#define EXPECTED_UNALIGNED    0x3A9156B8u
+#define EXPECTED_MEMMOVE      0xAEF9958Fu
+#define EXPECTED_MEMSET       0xD4A5A000u
+#define EXPECTED_MEMCMP       0u
+#define EXPECTED_STRLEN       (SMALL_CALLS * STRING_BYTES)
+#define EXPECTED_FMT          0xD322214Fu
+#define EXPECTED_SNPRINTF     0xDF770EFEu
+
+static uint32_t source[BUFFER_BYTES / 4];
+static uint32_t destination[BUFFER_BYTES / 4 + 1];   // One spare word for the shifted copies
+static char     text[STRING_BYTES + 1];
+
+static uint32_t sum_bytes(const void *buffer, uint32_t bytes) {
+    const uint8_t *p = (const uint8_t *)buffer;
+    uint32_t sum = 0;
+    while (bytes--) sum = ((sum << 5) + sum) ^ *p++;   // djb2, order-sensitive
+    return sum;
+}
+
+static void copy_bytes(uint8_t *dst, const uint8_t *src, uint32_t bytes) {
+    while (bytes--) *dst++ = *src++;
+}
+
+static uint32_t length_bytes(const char *s) {
+    uint32_t length = 0;
+    while (s[length]) length++;
+    return length;
+}
+
+static uint32_t fmt_u32_div(char *buffer, uint32_t value) {
+    char digits[FMT_U32_DIGITS];
+    uint32_t count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    for (uint32_t i = 0; i < count; i++) buffer[i] = digits[count - 1 - i];
+    return count;
+}
+
+// Row with the call loop inlined: 'body' runs 'calls' times; the checksum is taken after the
+// counters are read, so it is not part of the per-call cost
+#define BENCH_CALLS(name, calls, body, checksum, expected) do {                         \
+        bench_mark_t start = bench_start();                                              \
+        for (uint32_t call = 0; call < (calls); call++) { body; }                        \
+        uint32_t cycles  = PERF_CYCLES - start.cycles;                                   \
+        uint32_t instret = PERF_INSTRET - start.instret;                                 \
+        failures += bench_post(name, calls, cycles, instret, checksum, expected);        \
+    } while (0)
+
+int main(void) {
+    uint32_t failures = 0;
+    uint32_t seed = 0x9E3779B9u;
+    for (uint32_t i = 0; i < BUFFER_BYTES / 4; i++) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        source[i] = seed;
+    }
+    for (uint32_t i = 0; i < STRING_BYTES; i++) text[i] = (char)('A' + (i & 15));
+
+    uint8_t *src = (uint8_t *)source, *dst = (uint8_t *)destination;
+    uint32_t sum = 0;
+
+    // 1. Copies
+    BENCH_CALLS("memcpy_512", CALLS, memcpy(dst, src, BUFFER_BYTES),
+                sum_bytes(dst, BUFFER_BYTES), EXPECTED_MEMCPY);
+    memset(dst, 0, sizeof(destination));
+    BENCH_CALLS("memcpy_512_byte", CALLS, copy_bytes(dst, src, BUFFER_BYTES),
+                sum_bytes(dst, BUFFER_BYTES), EXPECTED_MEMCPY_BYTE);
+    BENCH_CALLS("memcpy_16", SMALL_CALLS,
+                memcpy(dst + (call & 31) * SMALL_BYTES, src + ((call * 5) & 31) * SMALL_BYTES, SMALL_BYTES),
+                sum_bytes(dst, BUFFER_BYTES), EXPECTED_MEMCPY_SMALL);
+    BENCH_CALLS("memcpy_unaligned", CALLS, memcpy(dst + 1 + (call & 2), src, BUFFER_BYTES - 4),
+                sum_bytes(dst, BUFFER_BYTES), EXPECTED_UNALIGNED);
+    BENCH_CALLS("memmove_overlap", CALLS, memmove(dst + 4, dst, BUFFER_BYTES - 4),
+                sum_bytes(dst, BUFFER_BYTES), EXPECTED_MEMMOVE);
+
+    // 2. Fill and compare
+    BENCH_CALLS("memset_512", CALLS, memset(dst, 0x6D, BUFFER_BYTES),
+                sum_bytes(dst, BUFFER_BYTES), EXPECTED_MEMSET);
+    memcpy(dst, src, BUFFER_BYTES);
+    BENCH_CALLS("memcmp_512", CALLS, sum |= (uint32_t)memcmp(dst, src, BUFFER_BYTES),
+                sum, EXPECTED_MEMCMP);
+
+    // 3. Strings
+    sum = 0;
+    BENCH_CALLS("strlen_63", SMALL_CALLS, sum += strlen(text), sum, EXPECTED_STRLEN);
+    sum = 0;
+    BENCH_CALLS("strlen_63_byte", SMALL_CALLS, sum += length_bytes(text), sum, EXPECTED_STRLEN);
+
+    // 4. Formatting: the output of every call is appended to the destination buffer
+    //    (values spread over every digit count)
+    uint32_t length = 0;
+    BENCH_CALLS("fmt_u32", FMT_CALLS, length += fmt_u32((char *)dst + length, source[call] >> (call & 31)),
+                sum_bytes(dst, length), EXPECTED_FMT);
+    length = 0;
+    BENCH_CALLS("fmt_u32_div", FMT_CALLS, length += fmt_u32_div((char *)dst + length, source[call] >> (call & 31)),
+                sum_bytes(dst, length), EXPECTED_FMT);
+    length = 0;
+    BENCH_CALLS("snprintf", CALLS,
+                length += (uint32_t)snprintf((char *)dst + length, BUFFER_BYTES - length, "%s %08x %5d %u\n",
+                                             "row", source[call], (int32_t)source[call] >> 12, call),
+                sum_bytes(dst, length), EXPECTED_SNPRINTF);
+
+    bench_exit(failures);
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <stdint.h>
+#include "bench.h"
+
+// Linked-list traversal: 128 nodes linked in a pseudo-random order, so consecutive nodes
+// land in different D-cache lines (dependent loads, miss-bound). Score: traversals per Mcycle.
+
+#define NODES    128
+#define PASSES   8
+#define EXPECTED 0x9B9B979Bu
+
+typedef struct node {
+    struct node *next;
+    uint32_t     value;
+} node_t;
+
+static node_t  nodes[NODES];
+static uint8_t order[NODES];
+
+int main(void) {
+    // Fisher-Yates shuffle of the visiting order (xorshift, modulo by masking a power of two)
+    uint32_t seed = 0xC0FFEE11u;
+    for (uint32_t i = 0; i < NODES; i++) order[i] = (uint8_t)i;
+    for (uint32_t i = NODES - 1; i > 0; i--) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        uint32_t j = seed & (NODES - 1);
+        while (j > i) j -= i + 1;
+        uint8_t swap = order[i]; order[i] = order[j]; order[j] = swap;
+    }
+    for (uint32_t i = 0; i < NODES; i++) {
+        nodes[order[i]].next  = (i + 1 < NODES) ? &nodes[order[i + 1]] : 0;
+        nodes[order[i]].value = i ^ 0xA5;
+    }
+
+    uint32_t checksum = 0;
+    bench_mark_t start = bench_start();
+    for (uint32_t pass = 0; pass < PASSES; pass++) {
+        for (node_t *node = &nodes[order[0]]; node; node = node->next) checksum = (checksum << 1 | checksum >> 31) + node->value;
+    }
+
+    uint32_t failures = bench_report("list_walk", start, PASSES, checksum, EXPECTED);
+    bench_exit(failures);
+    return 0;
+}
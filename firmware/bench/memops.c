@@ -0,0 +1,61 @@
+#include <stdint.h>
+#include "bench.h"
+
+// Memory throughput kernels over 1KB buffers: word copy, byte copy (LBU/SB, so every store
+// is a read-modify-write of its word) and word fill. Score: bytes moved per Mcycle = the
+// score column x BUFFER_BYTES.
+
+#define BUFFER_BYTES 1024
+#define PASSES       4
+#define EXPECTED_COPY_WORD 0x747A124Eu
+#define EXPECTED_COPY_BYTE 0x7E5D77A9u
+#define EXPECTED_FILL      0x736F6F6Fu
+
+static uint32_t source[BUFFER_BYTES / 4];
+static uint32_t destination[BUFFER_BYTES / 4];
+
+static void copy_words(uint32_t *dst, const uint32_t *src, uint32_t words) {
+    while (words--) *dst++ = *src++;
+}
+
+static void copy_bytes(uint8_t *dst, const uint8_t *src, uint32_t bytes) {
+    while (bytes--) *dst++ = *src++;
+}
+
+static void fill_words(uint32_t *dst, uint32_t value, uint32_t words) {
+    while (words--) *dst++ = value;
+}
+
+static uint32_t sum_words(const uint32_t *buffer, uint32_t words) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < words; i++) sum = (sum << 3 | sum >> 29) + buffer[i];
+    return sum;
+}
+
+int main(void) {
+    uint32_t failures = 0;
+    uint32_t seed = 0x9E3779B9u;
+    for (uint32_t i = 0; i < BUFFER_BYTES / 4; i++) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        source[i] = seed;
+    }
+
+    bench_mark_t start = bench_start();
+    for (uint32_t pass = 0; pass < PASSES; pass++) copy_words(destination, source, BUFFER_BYTES / 4);
+    failures += bench_report("memcpy_word", start, PASSES, sum_words(destination, BUFFER_BYTES / 4),
+                             EXPECTED_COPY_WORD);
+
+    fill_words(destination, 0, BUFFER_BYTES / 4);
+    start = bench_start();
+    for (uint32_t pass = 0; pass < PASSES; pass++)
+        copy_bytes((uint8_t *)destination + pass, (const uint8_t *)source, BUFFER_BYTES - PASSES);
+    failures += bench_report("memcpy_byte", start, PASSES, sum_words(destination, BUFFER_BYTES / 4),
+                             EXPECTED_COPY_BYTE);
+
+    start = bench_start();
+    for (uint32_t pass = 0; pass < PASSES; pass++) fill_words(destination, 0x01010101u * (pass + 1), BUFFER_BYTES / 4);
+    failures += bench_report("memset", start, PASSES, sum_words(destination, BUFFER_BYTES / 4), EXPECTED_FILL);
+
+    bench_exit(failures);
+    return 0;
+}
@@ -0,0 +1,28 @@
+#include <stdint.h>
+#include "bench.h"
+
+// System-call round trip: ECALL into the crt0 trap path, dispatch in bench_rt.c and MRET
+// back. Null call (argument echoed) and a cycle-counter read. Score: calls per Mcycle.
+
+#define CALLS    200
+#define EXPECTED_NULL ((CALLS * (CALLS - 1)) / 2)
+
+int main(void) {
+    uint32_t failures = 0, checksum = 0;
+
+    bench_mark_t start = bench_start();
+    for (uint32_t i = 0; i < CALLS; i++) checksum += bench_syscall(0, i);
+    failures += bench_report("syscall_null", start, CALLS, checksum, EXPECTED_NULL);
+
+    uint32_t last = 0, monotonic = 1;
+    start = bench_start();
+    for (uint32_t i = 0; i < CALLS; i++) {
+        uint32_t now = bench_syscall(1, 0);
+        if (now <= last) monotonic = 0;
+        last = now;
+    }
+    failures += bench_report("syscall_clock", start, CALLS, monotonic, 1);
+
+    bench_exit(failures);
+    return 0;
+}
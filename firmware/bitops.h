@@ -0,0 +1,117 @@
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#include <stdint.h>
+
+// Bit-manipulation helpers. Built with Zbb (config.sh: -march=..._zba_zbb, the compiler then
+// defines __riscv_zbb) each one is a single instruction; otherwise it is the _soft version,
+// plain RV32I with no library calls. The _soft versions are always available, so a benchmark
+// can compare both in one image (bench/bitops.c).
+// Zba (sh1add/sh2add/sh3add) and the rest of Zbb (andn/orn/xnor, min/max, sext/zext) need no
+// helper: the compiler emits them for array indexing, masks and compares on its own.
+// Counts are defined for zero: bit_clz(0) = bit_ctz(0) = 32, as the instructions give.
+
+// Hides a value from the optimizer, so it cannot turn a _soft sequence back into a Zbb instruction
+#define BIT_OPAQUE(v) __asm__ ("" : "+r"(v))
+
+// --- 1. PORTABLE (RV32I) ---
+
+// Binary search: five steps instead of a loop over 32 bits
+static inline uint32_t bit_clz_soft(uint32_t x) {
+    uint32_t n = 0;
+    if (!x) return 32;
+    if (!(x & 0xFFFF0000u)) { n += 16; x <<= 16; }
+    if (!(x & 0xFF000000u)) { n += 8;  x <<= 8;  }
+    if (!(x & 0xF0000000u)) { n += 4;  x <<= 4;  }
+    if (!(x & 0xC0000000u)) { n += 2;  x <<= 2;  }
+    if (!(x & 0x80000000u)) { n += 1; }
+    return n;
+}
+
+static inline uint32_t bit_ctz_soft(uint32_t x) {
+    uint32_t n = 0;
+    if (!x) return 32;
+    if (!(x & 0x0000FFFFu)) { n += 16; x >>= 16; }
+    if (!(x & 0x000000FFu)) { n += 8;  x >>= 8;  }
+    if (!(x & 0x0000000Fu)) { n += 4;  x >>= 4;  }
+    if (!(x & 0x00000003u)) { n += 2;  x >>= 2;  }
+    if (!(x & 0x00000001u)) { n += 1; }
+    return n;
+}
+
+// Bit counts summed in pairs, nibbles, bytes, then halves (no multiply: RV32I has no M extension)
+static inline uint32_t bit_popcount_soft(uint32_t x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    BIT_OPAQUE(x);
+    x += x >> 8;
+    x += x >> 16;
+    return x & 0x3F;
+}
+
+static inline uint32_t bit_rol_soft(uint32_t x, uint32_t n) {
+    uint32_t high = x << (n & 31);
+    BIT_OPAQUE(high);
+    return high | (x >> (-n & 31));
+}
+
+static inline uint32_t bit_ror_soft(uint32_t x, uint32_t n) {
+    uint32_t low = x >> (n & 31);
+    BIT_OPAQUE(low);
+    return low | (x << (-n & 31));
+}
+
+static inline uint32_t bit_bswap_soft(uint32_t x) {
+    uint32_t swapped = ((x & 0x00FF00FFu) << 8) | ((x >> 8) & 0x00FF00FFu);
+    BIT_OPAQUE(swapped);
+    return (swapped << 16) | (swapped >> 16);
+}
+
+// Non-zero if any byte of x is zero
+static inline uint32_t bit_has_zero_byte_soft(uint32_t x) {
+    return (x - 0x01010101u) & ~x & 0x80808080u;
+}
+
+// --- 2. ZBB ---
+#if defined(__riscv_zbb)
+
+// CLZ/CTZ return 32 for zero, so the compiler drops the test
+static inline uint32_t bit_clz(uint32_t x)      { return x ? (uint32_t)__builtin_clz(x) : 32; }
+static inline uint32_t bit_ctz(uint32_t x)      { return x ? (uint32_t)__builtin_ctz(x) : 32; }
+static inline uint32_t bit_popcount(uint32_t x) { return (uint32_t)__builtin_popcount(x); }
+static inline uint32_t bit_rol(uint32_t x, uint32_t n) { return (x << (n & 31)) | (x >> (-n & 31)); }
+static inline uint32_t bit_ror(uint32_t x, uint32_t n) { return (x >> (n & 31)) | (x << (-n & 31)); }
+static inline uint32_t bit_bswap(uint32_t x)    { return __builtin_bswap32(x); }
+
+// ORC.B: 0xFF in every non-zero byte, 0x00 in every zero byte
+static inline uint32_t bit_orc_b(uint32_t x) {
+    uint32_t result;
+    __asm__ ("orc.b %0, %1" : "=r"(result) : "r"(x));
+    return result;
+}
+
+static inline uint32_t bit_has_zero_byte(uint32_t x) { return ~bit_orc_b(x); }
+
+#else
+
+#define bit_clz            bit_clz_soft
+#define bit_ctz            bit_ctz_soft
+#define bit_popcount       bit_popcount_soft
+#define bit_rol            bit_rol_soft
+#define bit_ror            bit_ror_soft
+#define bit_bswap          bit_bswap_soft
+#define bit_has_zero_byte  bit_has_zero_byte_soft
+
+#endif
+
+// --- 3. DERIVED ---
+
+// Round-robin pick from a ready mask: the first set bit above 'after', wrapping to bit 0.
+// Returns 32 if the mask is empty.
+static inline uint32_t bit_next_set(uint32_t mask, uint32_t after) {
+    uint32_t above = mask & (0xFFFFFFFEu << (after & 31));
+    return bit_ctz(above ? above : mask);
+}
+
+#endif
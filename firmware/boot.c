@@ -0,0 +1,57 @@
+#include <stdint.h>
+
+// UART Registers
+#define UART_TX          (*(volatile uint32_t *)0x40000000)
+#define UART_STATUS      (*(volatile uint32_t *)0x40000004)
+#define UART_RX          (*(volatile uint32_t *)0x4000000C)
+#define UART_STATUS_RXAV (1u << 3)
+
+// Program RAM Loader
+#define LOAD_ADDR        (*(volatile uint32_t *)0x40000200)
+#define LOAD_DATA        (*(volatile uint32_t *)0x40000204)
+#define BOOT_STRAP       (*(volatile uint32_t *)0x40000208)  // Bit 0: boot mode pin, 1 = serial
+#define PROGRAM_RAM      0x00004000u
+#define PROGRAM_RAM_SIZE 0x00004000u
+
+// Frame: "BOOT" | length (LE, bytes) | image | sum of image words (LE)
+#define BOOT_MAGIC       0x544F4F42u  // "BOOT" little-endian
+
+// Blocks for the next received byte (the RX FIFO absorbs bursts while a word is stored)
+static uint32_t boot_getc(void) {
+    while (!(UART_STATUS & UART_STATUS_RXAV));
+    return UART_RX & 0xFF;
+}
+
+static uint32_t boot_get_word(void) {
+    uint32_t word = boot_getc();
+    word |= boot_getc() << 8;
+    word |= boot_getc() << 16;
+    word |= boot_getc() << 24;
+    return word;
+}
+
+// Serial bootloader (ROM): with the boot strap set, waits for a host's frame however late it
+// starts, streams the image into program RAM and starts it; with the strap clear the ROM
+// application continues at once. Replies 'K' on success and 'E' on a bad frame.
+void boot_serial(void) {
+    // An image already running from program RAM links this too; never reload over itself
+    if ((uint32_t)&boot_serial >= PROGRAM_RAM) return;
+    if (!(BOOT_STRAP & 1)) return;
+
+    if (boot_get_word() != BOOT_MAGIC) { UART_TX = 'E'; return; }
+
+    uint32_t length = boot_get_word();
+    if (length == 0 || length > PROGRAM_RAM_SIZE) { UART_TX = 'E'; return; }
+
+    uint32_t checksum = 0;
+    LOAD_ADDR = PROGRAM_RAM;
+    for (uint32_t offset = 0; offset < length; offset += 4) {
+        uint32_t word = boot_get_word();
+        LOAD_DATA = word;
+        checksum += word;
+    }
+    if (boot_get_word() != checksum) { UART_TX = 'E'; return; }
+
+    UART_TX = 'K';
+    ((void (*)(void))PROGRAM_RAM)();
+}
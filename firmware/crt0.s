@@ -1,109 +0,0 @@
-.section .text
-.global _start
-
-# ==============================================================================
-# 0x00000000: RESET VECTOR
-# ==============================================================================
-_start:
-    j crt_init              # Jump to C-Runtime initialization
-
-# ==============================================================================
-# 0x00000010: TRAP VECTOR (Hardware Interrupt Entry)
-# ==============================================================================
-.org 0x10                   # Force physical alignment for hardware vectoring
-trap_vector:
-    # 1. ALLOCATE STACK FRAME
-    # Reserving 128 bytes (32 registers * 4 bytes)
-    addi sp, sp, -128
-    
-    # 2. SAVE CPU CONTEXT
-    # Capturing all general-purpose registers to current task stack
-    sw ra,  0(sp)
-    sw t0,  4(sp)
-    sw t1,  8(sp)
-    sw t2,  12(sp)
-    sw s0,  16(sp)
-    sw s1,  20(sp)
-    sw a0,  24(sp)
-    sw a1,  28(sp)
-    sw a2,  32(sp)
-    sw a3,  36(sp)
-    sw a4,  40(sp)
-    sw a5,  44(sp)
-    sw a6,  48(sp)
-    sw a7,  52(sp)
-    sw s2,  56(sp)
-    sw s3,  60(sp)
-    sw s4,  64(sp)
-    sw s5,  68(sp)
-    sw s6,  72(sp)
-    sw s7,  76(sp)
-    sw s8,  80(sp)
-    sw s9,  84(sp)
-    sw s10, 88(sp)
-    sw s11, 92(sp)
-    sw t3,  96(sp)
-    sw t4,  100(sp)
-    sw t5,  104(sp)
-    sw t6,  108(sp)
-    sw gp,  112(sp)
-    sw tp,  116(sp)
-
-    # 3. EXECUTE SCHEDULER
-    # Pass current Stack Pointer (SP) as first argument to scheduler()
-    mv a0, sp
-    call scheduler
-    
-    # scheduler() returns the new Task's SP in a0
-    mv sp, a0
-
-    # 4. RESTORE CPU CONTEXT
-    # Loading state from the new task's stack frame
-    lw ra,  0(sp)
-    lw t0,  4(sp)
-    lw t1,  8(sp)
-    lw t2,  12(sp)
-    lw s0,  16(sp)
-    lw s1,  20(sp)
-    lw a0,  24(sp)
-    lw a1,  28(sp)
-    lw a2,  32(sp)
-    lw a3,  36(sp)
-    lw a4,  40(sp)
-    lw a5,  44(sp)
-    lw a6,  48(sp)
-    lw a7,  52(sp)
-    lw s2,  56(sp)
-    lw s3,  60(sp)
-    lw s4,  64(sp)
-    lw s5,  68(sp)
-    lw s6,  72(sp)
-    lw s7,  76(sp)
-    lw s8,  80(sp)
-    lw s9,  84(sp)
-    lw s10, 88(sp)
-    lw s11, 92(sp)
-    lw t3,  96(sp)
-    lw t4,  100(sp)
-    lw t5,  104(sp)
-    lw t6,  108(sp)
-    lw gp,  112(sp)
-    lw tp,  116(sp)
-
-    # 5. RELEASE STACK FRAME & EXIT
-    addi sp, sp, 128
-    mret                    # Return to PC saved in MEPC register
-
-# ==============================================================================
-# INITIALIZATION (CRT_INIT)
-# ==============================================================================
-crt_init:
-    # Initialize Stack Pointer to top of 4KB RAM (0x20000000 + 0x1000)
-    li sp, 0x20001000
-    
-    # Transfer control to main C application
-    call main
-    
-    # Hang if main ever returns
-_exit_hang:
-    j _exit_hang
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef DMA_H
+#define DMA_H
+
+#include <stdint.h>
+#include "libc.h"
+
+// DMA Registers
+#define DMA_SRC     (*(volatile uint32_t *)0x40000100)
+#define DMA_DST     (*(volatile uint32_t *)0x40000104)
+#define DMA_CTRL    (*(volatile uint32_t *)0x40000108)
+#define DMA_NEXT    (*(volatile uint32_t *)0x4000010C)
+#define DMA_STATUS  (*(volatile uint32_t *)0x40000110)
+#define DMA_COUNT   (*(volatile uint32_t *)0x40000114)
+
+// CTRL Fields: [15:0] length (words; bytes in DMA_MODE_PERIPH), mode, IRQ enable, start
+#define DMA_MODE_COPY    (0u << 16)
+#define DMA_MODE_FILL    (1u << 16)
+#define DMA_MODE_PERIPH  (2u << 16)
+#define DMA_IRQ_ENABLE   (1u << 18)
+#define DMA_START        (1u << 31)
+
+#define DMA_STATUS_BUSY  (1u << 0)
+#define DMA_STATUS_IRQ   (1u << 1)
+
+// Completed IRQ-enabled transfers (kernel data in kernel.c, incremented by dma_isr)
+extern volatile uint32_t dma_completions;
+
+#define DMA_COMPLETIONS  (&dma_completions)
+
+#define UART_TX_ADDR     0x40000000u
+
+// Chained descriptor: word-aligned, read by the engine as {next, src, dst, ctrl}
+typedef struct {
+    uint32_t next; // Address of the next descriptor, 0 ends the chain
+    uint32_t src;  // Source address (fill value in DMA_MODE_FILL)
+    uint32_t dst;  // Destination address (fixed in DMA_MODE_PERIPH)
+    uint32_t ctrl; // Length | mode | DMA_IRQ_ENABLE
+} dma_descriptor_t;
+
+static inline int dma_busy(void) {
+    return DMA_STATUS & DMA_STATUS_BUSY;
+}
+
+static inline void dma_wait(void) {
+    while (dma_busy());
+}
+
+// Starts a single transfer once the channel is free; returns without waiting for completion
+static inline void dma_start(uint32_t src, uint32_t dst, uint32_t ctrl) {
+    dma_wait();
+    DMA_SRC  = src;
+    DMA_DST  = dst;
+    DMA_NEXT = 0;
+    DMA_CTRL = ctrl | DMA_START;
+}
+
+// Runs a descriptor chain: a zero-length kick makes the engine fetch 'first' itself
+static inline void dma_start_chain(const volatile dma_descriptor_t* first) {
+    dma_wait();
+    DMA_NEXT = (uint32_t)first;
+    DMA_CTRL = DMA_START;
+}
+
+// memcpy offload: word-aligned bulk moves by the engine, any remainder (or a misaligned copy) by
+// the CPU through libc memcpy.
+// The engine reads through the same D-cache as the CPU, so no flush is needed.
+static inline void dma_memcpy_async(void* dst, const void* src, uint32_t bytes) {
+    dma_start((uint32_t)src, (uint32_t)dst, (bytes >> 2) | DMA_MODE_COPY);
+}
+
+static inline void* dma_memcpy(void* dst, const void* src, uint32_t bytes) {
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    if (((((uint32_t)d) | ((uint32_t)s)) & 3) == 0 && bytes >= 4) {
+        dma_memcpy_async(d, s, bytes);
+        d += bytes & ~3u;
+        s += bytes & ~3u;
+        bytes &= 3;
+        dma_wait();
+    }
+    memcpy(d, s, bytes);
+    return dst;
+}
+
+static inline void dma_memset32(uint32_t* dst, uint32_t value, uint32_t words) {
+    dma_start(value, (uint32_t)dst, words | DMA_MODE_FILL);
+}
+
+// Streams a string to the UART, paced by the transmitter; the CPU continues immediately.
+// The string must stay valid until the transfer ends (literals in ROM always do).
+static inline void dma_puts(const char* s) {
+    uint32_t length = strlen(s);
+    if (length) dma_start((uint32_t)s, UART_TX_ADDR, length | DMA_MODE_PERIPH);
+}
+
+// Completion interrupt: acknowledge and count (called from the trap handler)
+static inline void dma_isr(void) {
+    DMA_STATUS = DMA_STATUS_IRQ;
+    (*DMA_COMPLETIONS)++;
+}
+
+#endif
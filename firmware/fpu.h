@@ -0,0 +1,176 @@
+#ifndef FPU_H
+#define FPU_H
+
+#include <stdint.h>
+#include "bitops.h"
+
+// Single-precision helpers on raw IEEE 754 bits (fp32_t). Built with RV32F (-march=rv32iafc...,
+// the FPU images in the Makefile; the compiler then defines __riscv_flen) each one is an FPU instruction;
+// otherwise it is the _soft version, plain RV32I with no library calls (the images link with
+// -nostdlib, so there is no libgcc soft-float). The _soft versions are always available, so a
+// benchmark can compare both in one image (bench/dsp.c).
+// The soft-float rounds to nearest even, handles subnormals, infinities and NaNs (any NaN
+// result is the canonical one) and raises no flags, so its results match the FPU bit for bit.
+// fp32_to_int truncates like a C cast; out-of-range values and NaN saturate like FCVT.W.S.
+
+// FPU registers (hart-local; the core's Zicsr instructions are NOPs, so they are memory-mapped)
+#define FCSR           (*(volatile uint32_t *)0x40000028)  // {frm[7:5], fflags[4:0]}
+#define FP_STATUS      (*(volatile uint32_t *)0x4000002C)  // Bit 0: FP state changed (crt0.S lazy save)
+
+#define FFLAG_NX       0x01u  // Inexact
+#define FFLAG_UF       0x02u  // Underflow
+#define FFLAG_OF       0x04u  // Overflow
+#define FFLAG_DZ       0x08u  // Divide by zero
+#define FFLAG_NV       0x10u  // Invalid operation
+#define FRM_SHIFT      5u     // FCSR rounding mode: 0 RNE, 1 RTZ, 2 RDN, 3 RUP, 4 RMM
+
+typedef uint32_t fp32_t;
+
+#define FP32_SIGN      0x80000000u
+#define FP32_INF       0x7F800000u
+#define FP32_NAN       0x7FC00000u  // Canonical NaN
+#define FP32_ONE       0x3F800000u
+
+// --- 1. PORTABLE (RV32I SOFT-FLOAT) ---
+
+static inline uint32_t fp32_is_nan(fp32_t a) { return (a << 1) > (FP32_INF << 1); }
+
+// Right shift that ORs the bits shifted out into bit 0 (sticky)
+static inline uint32_t fp32_shift_jam(uint32_t sig, uint32_t shift) {
+    if (shift == 0) return sig;
+    return shift < 32 ? (sig >> shift) | ((sig << (32 - shift)) != 0) : (sig != 0);
+}
+
+// Rounds sig * 2^(exp - 153) to nearest even: a normal value has its leading one at bit 26
+// (three bits below the result's LSB: guard, round, sticky); exp < 1 is denormalized first.
+static inline fp32_t fp32_round_pack(uint32_t sign, int32_t exp, uint32_t sig) {
+    if (exp < 1) {
+        sig = fp32_shift_jam(sig, (uint32_t)(1 - exp));
+        exp = 1;
+    }
+    uint32_t low = sig & 7;
+    sig >>= 3;
+    if (low > 4 || (low == 4 && (sig & 1))) sig++;
+    if (sig & 0x01000000u) {              // Rounded up to the next binade
+        sig >>= 1;
+        exp++;
+    }
+    if (!(sig & 0x00800000u)) exp = 0;    // Subnormal or zero
+    if (exp >= 255) return sign | FP32_INF;
+    return sign | ((uint32_t)exp << 23) | (sig & 0x007FFFFFu);
+}
+
+static inline fp32_t fp32_add_soft(fp32_t a, fp32_t b) {
+    uint32_t ea = (a >> 23) & 0xFF, eb = (b >> 23) & 0xFF;
+    if (ea == 0xFF || eb == 0xFF) {
+        if (fp32_is_nan(a) || fp32_is_nan(b)) return FP32_NAN;
+        if (ea == eb && ((a ^ b) & FP32_SIGN)) return FP32_NAN;   // inf - inf
+        return ea == 0xFF ? a : b;
+    }
+    if ((a & ~FP32_SIGN) < (b & ~FP32_SIGN)) {                    // |a| >= |b|
+        fp32_t t = a; a = b; b = t;
+        uint32_t e = ea; ea = eb; eb = e;
+    }
+    uint32_t sa = a & 0x007FFFFFu, sb = b & 0x007FFFFFu;
+    if (ea) sa |= 0x00800000u; else ea = 1;
+    if (eb) sb |= 0x00800000u; else eb = 1;
+    sa <<= 3;
+    sb = fp32_shift_jam(sb << 3, ea - eb);
+    if ((a ^ b) & FP32_SIGN) {
+        sa -= sb;
+        if (sa == 0) return 0;                                    // Exact cancellation: +0
+        while (!(sa & 0x04000000u) && ea > 1) { sa <<= 1; ea--; }
+    } else {
+        sa += sb;
+        if (sa & 0x08000000u) { sa = (sa >> 1) | (sa & 1); ea++; }
+    }
+    return fp32_round_pack(a & FP32_SIGN, (int32_t)ea, sa);
+}
+
+static inline fp32_t fp32_sub_soft(fp32_t a, fp32_t b) { return fp32_add_soft(a, b ^ FP32_SIGN); }
+
+// 24 x 24-bit significand product by shift-and-add (RV32I has no multiplier)
+static inline fp32_t fp32_mul_soft(fp32_t a, fp32_t b) {
+    uint32_t sign = (a ^ b) & FP32_SIGN;
+    int32_t  ea = (a >> 23) & 0xFF, eb = (b >> 23) & 0xFF;
+    if (ea == 0xFF || eb == 0xFF) {
+        if (fp32_is_nan(a) || fp32_is_nan(b)) return FP32_NAN;
+        if (!(a << 1) || !(b << 1)) return FP32_NAN;               // inf * 0
+        return sign | FP32_INF;
+    }
+    if (!(a << 1) || !(b << 1)) return sign;
+    uint32_t sa = a & 0x007FFFFFu, sb = b & 0x007FFFFFu;
+    if (ea) sa |= 0x00800000u; else { ea = 1; while (!(sa & 0x00800000u)) { sa <<= 1; ea--; } }
+    if (eb) sb |= 0x00800000u; else { eb = 1; while (!(sb & 0x00800000u)) { sb <<= 1; eb--; } }
+
+    uint64_t product = 0, addend = sa;
+    for (; sb; sb >>= 1, addend <<= 1) {
+        if (sb & 1) product += addend;
+    }
+    int32_t exp = ea + eb - 127;
+    uint32_t shift = 20;
+    if (product >> 47) { shift = 21; exp++; }
+    uint32_t sig = (uint32_t)(product >> shift) | ((product & ((1u << shift) - 1)) != 0);
+    return fp32_round_pack(sign, exp, sig);
+}
+
+static inline fp32_t fp32_from_int_soft(int32_t x) {
+    if (x == 0) return 0;
+    uint32_t sign = x < 0 ? FP32_SIGN : 0;
+    uint32_t magnitude = x < 0 ? -(uint32_t)x : (uint32_t)x;
+    uint32_t zeros = bit_clz_soft(magnitude);
+    magnitude <<= zeros;
+    return fp32_round_pack(sign, 158 - (int32_t)zeros, (magnitude >> 5) | ((magnitude & 31) != 0));
+}
+
+static inline int32_t fp32_to_int_soft(fp32_t a) {
+    int32_t exp = (int32_t)((a >> 23) & 0xFF) - 127;
+    if (fp32_is_nan(a)) return 0x7FFFFFFF;
+    if (exp < 0) return 0;
+    if (exp >= 31) return (a & FP32_SIGN) ? (int32_t)0x80000000u : 0x7FFFFFFF;
+    uint32_t sig = (a & 0x007FFFFFu) | 0x00800000u;
+    uint32_t magnitude = exp >= 23 ? sig << (exp - 23) : sig >> (23 - exp);
+    return (a & FP32_SIGN) ? -(int32_t)magnitude : (int32_t)magnitude;
+}
+
+// a < b (false if either is NaN; -0 == +0)
+static inline uint32_t fp32_lt_soft(fp32_t a, fp32_t b) {
+    if (fp32_is_nan(a) || fp32_is_nan(b)) return 0;
+    if ((a | b) << 1 == 0) return 0;
+    if ((a ^ b) & FP32_SIGN) return a >> 31;
+    return (a & FP32_SIGN) ? a > b : a < b;
+}
+
+// --- 2. RV32F ---
+#if defined(__riscv_flen)
+
+static inline float  fp32_to_float(fp32_t a)  { float f; __builtin_memcpy(&f, &a, 4); return f; }
+static inline fp32_t fp32_from_float(float f) { fp32_t a; __builtin_memcpy(&a, &f, 4); return a; }
+
+static inline fp32_t   fp32_add(fp32_t a, fp32_t b) { return fp32_from_float(fp32_to_float(a) + fp32_to_float(b)); }
+static inline fp32_t   fp32_sub(fp32_t a, fp32_t b) { return fp32_from_float(fp32_to_float(a) - fp32_to_float(b)); }
+static inline fp32_t   fp32_mul(fp32_t a, fp32_t b) { return fp32_from_float(fp32_to_float(a) * fp32_to_float(b)); }
+static inline fp32_t   fp32_from_int(int32_t x)     { return fp32_from_float((float)x); }
+static inline int32_t  fp32_to_int(fp32_t a)        { return (int32_t)fp32_to_float(a); }
+static inline uint32_t fp32_lt(fp32_t a, fp32_t b)  { return fp32_to_float(a) < fp32_to_float(b); }
+
+// a * b + c with one rounding; the soft-float has no fused form. FMADD.S directly: with
+// -ffreestanding, __builtin_fmaf may become a call to a libm that is not linked.
+static inline fp32_t fp32_fma(fp32_t a, fp32_t b, fp32_t c) {
+    float result;
+    __asm__ ("fmadd.s %0, %1, %2, %3" : "=f"(result) : "f"(fp32_to_float(a)), "f"(fp32_to_float(b)), "f"(fp32_to_float(c)));
+    return fp32_from_float(result);
+}
+
+#else
+
+#define fp32_add       fp32_add_soft
+#define fp32_sub       fp32_sub_soft
+#define fp32_mul       fp32_mul_soft
+#define fp32_from_int  fp32_from_int_soft
+#define fp32_to_int    fp32_to_int_soft
+#define fp32_lt        fp32_lt_soft
+
+#endif
+
+#endif
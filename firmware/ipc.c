@@ -0,0 +1,75 @@
+#include <stdint.h>
+#include "ipc.h"
+
+// Blocking side of ipc.h. The waiter's bit and SMP_TASK_WAIT change under KERNEL_LOCK, the same
+// lock the scheduler saves a task under, so a task is parked only if no wake-up came first.
+
+void ipc_prepare_wait(volatile uint32_t *waiters) {
+    uint32_t task = smp_current_task();
+    hart_lock();
+    *waiters |= 1u << task;
+    SMP_TASK_WAIT[task] = 1;
+    hart_unlock();
+}
+
+// The retry succeeded: withdraw (a wake-up may already have done it)
+void ipc_cancel_wait(volatile uint32_t *waiters) {
+    uint32_t task = smp_current_task();
+    hart_lock();
+    *waiters &= ~(1u << task);
+    SMP_TASK_WAIT[task] = 0;
+    hart_unlock();
+}
+
+// Readies the lowest waiting task (or all of them)
+void ipc_wake(volatile uint32_t *waiters, uint32_t wake_all) {
+    hart_lock();
+    uint32_t woken = *waiters;
+    if (!wake_all) woken &= 0u - woken; // Lowest set bit
+    *waiters &= ~woken;
+    for (uint32_t task = 0; task < SMP_TASKS; task++) {
+        if (woken & (1u << task)) task_wake_locked(task);
+    }
+    hart_unlock();
+    if (woken) smp_kick_idle(HART_ID);
+}
+
+// One waiter-protocol step after a failed try: publish the task, or sleep if it already is.
+// Returns whether the task is still published. A wake-up clears the bit together with
+// SMP_TASK_WAIT; a yield whose scheduler found the lock busy returns without parking.
+static uint32_t ipc_block(volatile uint32_t *waiters, uint32_t published) {
+    if (!published) {
+        ipc_prepare_wait(waiters);
+        return 1;
+    }
+    task_yield();
+    return SMP_TASK_WAIT[smp_current_task()];
+}
+
+// Each call inlines its fast path once: the retry after publishing is the loop's next test
+void sem_wait(semaphore_t *sem) {
+    uint32_t published = 0;
+    while (!sem_trywait(sem)) published = ipc_block(&sem->waiters, published);
+    if (published) ipc_cancel_wait(&sem->waiters);
+}
+
+// Blocks until any bit of 'mask' is set; takes and returns those bits
+uint32_t event_wait(event_flags_t *events, uint32_t mask) {
+    uint32_t taken, published = 0;
+    while (!(taken = event_trytake(events, mask))) published = ipc_block(&events->waiters, published);
+    if (published) ipc_cancel_wait(&events->waiters);
+    return taken;
+}
+
+void msgq_send(msg_queue_t *queue, uint32_t message) {
+    uint32_t published = 0;
+    while (!msgq_trysend(queue, message)) published = ipc_block(&queue->send_waiters, published);
+    if (published) ipc_cancel_wait(&queue->send_waiters);
+}
+
+uint32_t msgq_recv(msg_queue_t *queue) {
+    uint32_t message, published = 0;
+    while (!msgq_tryrecv(queue, &message)) published = ipc_block(&queue->recv_waiters, published);
+    if (published) ipc_cancel_wait(&queue->recv_waiters);
+    return message;
+}
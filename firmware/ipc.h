@@ -0,0 +1,151 @@
+#ifndef IPC_H
+#define IPC_H
+
+#include <stdint.h>
+#include "atomic.h"
+#include "smp.h"
+
+// Inter-task communication: counting semaphores, event flags and bounded message queues.
+// Every operation has a lock-free fast path (AMO and LR/SC on the object itself). Only a task
+// that has to wait, or a call that finds waiters to wake, enters ipc.c and takes KERNEL_LOCK.
+// A waiting task is parked in the task table (SMP_BLOCKED): the scheduler skips it, so it costs
+// no cycles until a post, set or message makes it ready again.
+// Objects live in RAM (the atomics need it). Blocking calls and wake-ups are for tasks only: a
+// trap handler must not take KERNEL_LOCK.
+
+#define IPC_WAKE_ONE 0u
+#define IPC_WAKE_ALL 1u
+
+// --- SLOW PATHS (ipc.c) ---
+// Waiter protocol: publish the task in 'waiters', retry the fast path once (a wake that ran
+// before the publish saw no waiter), then sleep; a waker clears the bit and readies the task.
+void ipc_prepare_wait(volatile uint32_t *waiters);
+void ipc_cancel_wait(volatile uint32_t *waiters);
+void ipc_wake(volatile uint32_t *waiters, uint32_t wake_all);
+
+// --- COUNTING SEMAPHORE ---
+typedef struct {
+    volatile uint32_t count;
+    volatile uint32_t waiters;   // Task bit mask blocked in sem_wait
+} semaphore_t;
+
+static inline void sem_init(semaphore_t *sem, uint32_t count) {
+    sem->count   = count;
+    sem->waiters = 0;
+}
+
+// Returns 1 if it took a unit
+static inline int sem_trywait(semaphore_t *sem) {
+    uint32_t count;
+    do {
+        count = sem->count;
+        if (count == 0) return 0;
+    } while (!atomic_cas(&sem->count, count, count - 1));
+    return 1;
+}
+
+static inline void sem_post(semaphore_t *sem) {
+    atomic_add(&sem->count, 1);
+    if (sem->waiters) ipc_wake(&sem->waiters, IPC_WAKE_ONE);
+}
+
+void sem_wait(semaphore_t *sem);
+
+// --- EVENT FLAGS ---
+// 32 independent bits. A waiter takes (clears) the bits it asked for, so each set is seen once.
+typedef struct {
+    volatile uint32_t flags;
+    volatile uint32_t waiters;   // Every waiter is woken by a set and checks its own mask
+} event_flags_t;
+
+static inline void event_init(event_flags_t *events) {
+    events->flags   = 0;
+    events->waiters = 0;
+}
+
+static inline void event_set(event_flags_t *events, uint32_t mask) {
+    atomic_or(&events->flags, mask);
+    if (events->waiters) ipc_wake(&events->waiters, IPC_WAKE_ALL);
+}
+
+static inline void event_clear(event_flags_t *events, uint32_t mask) {
+    atomic_and(&events->flags, ~mask);
+}
+
+// Takes any of 'mask' that are set; returns the bits taken (0 if none)
+static inline uint32_t event_trytake(event_flags_t *events, uint32_t mask) {
+    uint32_t flags;
+    do {
+        flags = events->flags;
+        if (!(flags & mask)) return 0;
+    } while (!atomic_cas(&events->flags, flags, flags & ~mask));
+    return flags & mask;
+}
+
+uint32_t event_wait(event_flags_t *events, uint32_t mask);
+
+// --- BOUNDED MESSAGE QUEUE ---
+// Multi-producer, multi-consumer ring of words (a value or a pointer to a buffer). Each slot
+// carries a sequence number: a sender claims a ticket on 'head' with LR/SC, writes the slot and
+// then publishes it; a receiver does the same on 'tail'. Tickets wrap modulo 2^32.
+// 'size' must be a power of two.
+typedef struct {
+    volatile uint32_t  head;          // Next ticket to send
+    volatile uint32_t  tail;          // Next ticket to receive
+    volatile uint32_t  send_waiters;  // Tasks blocked on a full queue
+    volatile uint32_t  recv_waiters;  // Tasks blocked on an empty queue
+    volatile uint32_t *seq;           // [size]: the ticket that may use the slot next
+    volatile uint32_t *data;          // [size]
+    uint32_t           mask;          // size - 1
+} msg_queue_t;
+
+static inline void msgq_init(msg_queue_t *queue, volatile uint32_t *seq, volatile uint32_t *data,
+                             uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) seq[i] = i;
+    queue->head         = 0;
+    queue->tail         = 0;
+    queue->send_waiters = 0;
+    queue->recv_waiters = 0;
+    queue->seq          = seq;
+    queue->data         = data;
+    queue->mask         = size - 1;
+}
+
+// Returns 0 if the queue is full
+static inline int msgq_trysend(msg_queue_t *queue, uint32_t message) {
+    uint32_t ticket, slot;
+    for (;;) {
+        ticket = queue->head;
+        slot   = ticket & queue->mask;
+        int32_t lag = (int32_t)(queue->seq[slot] - ticket);
+        if (lag < 0) return 0; // Slot still holds the message from one lap ago
+        if (lag == 0 && atomic_cas(&queue->head, ticket, ticket + 1)) break;
+    }
+    queue->data[slot] = message;
+    ATOMIC_FENCE();              // Data before the sequence number that publishes it
+    queue->seq[slot] = ticket + 1;
+    if (queue->recv_waiters) ipc_wake(&queue->recv_waiters, IPC_WAKE_ONE);
+    return 1;
+}
+
+// Returns 0 if the queue is empty
+static inline int msgq_tryrecv(msg_queue_t *queue, uint32_t *message) {
+    uint32_t ticket, slot;
+    for (;;) {
+        ticket = queue->tail;
+        slot   = ticket & queue->mask;
+        int32_t lag = (int32_t)(queue->seq[slot] - (ticket + 1));
+        if (lag < 0) return 0; // Not published yet
+        if (lag == 0 && atomic_cas(&queue->tail, ticket, ticket + 1)) break;
+    }
+    *message = queue->data[slot];
+    ATOMIC_FENCE();              // Slot read before it is handed to the sender one lap ahead
+    queue->seq[slot] = ticket + queue->mask + 1;
+    if (queue->send_waiters) ipc_wake(&queue->send_waiters, IPC_WAKE_ONE);
+    return 1;
+}
+
+void msgq_send(msg_queue_t *queue, uint32_t message);
+uint32_t msgq_recv(msg_queue_t *queue);
+
+#endif
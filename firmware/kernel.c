@@ -0,0 +1,32 @@
+#include <stdint.h>
+#include "kernel.h"
+#include "print.h"
+#include "dma.h"
+
+// --- KERNEL DATA (.bss: placed by link.ld and zeroed by crt0) ---
+smp_kernel_t      smp_kernel;
+volatile uint32_t txq_head, txq_tail, txq_buffer[TXQ_SIZE];
+volatile uint32_t dma_completions;
+
+pool_t stack_pool, msg_pool, timer_pool;
+
+// Only the non-zero state is set here
+int kernel_init(void) {
+    for (uint32_t task = 1; task < SMP_TASKS; task++) SMP_TASK_OWNER[task] = SMP_BLOCKED; // Until task_spawn
+    HART_CURRENT[1] = SMP_IDLE;
+
+    // The caller is task 0 on hart 0
+    SMP_TASK_OWNER[0] = 1;
+
+    arena_init();
+    return pool_init(&stack_pool, TASK_STACK_BYTES, TASK_STACK_BLOCKS) &&
+           pool_init(&msg_pool, MSG_BUFFER_BYTES, MSG_BUFFER_BLOCKS) &&
+           pool_init(&timer_pool, sizeof(soft_timer_t), TIMER_NODE_BLOCKS);
+}
+
+int task_spawn(uint32_t task, void (*entry)(void)) {
+    uint8_t *stack = pool_alloc(&stack_pool);
+    if (!stack) return 0;
+    task_create(task, entry, (uint32_t)(stack + TASK_STACK_BYTES));
+    return 1;
+}
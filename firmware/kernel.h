@@ -0,0 +1,50 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <stdint.h>
+#include "smp.h"
+#include "pool.h"
+#include "timer.h"
+
+// Kernel bring-up and the RAM pools. Kernel tables and driver queues are ordinary .bss objects
+// placed by link.ld; task stacks, message buffers and timer nodes come from pools carved out of
+// the arena that follows them.
+
+// --- POOLS ---
+#define TASK_STACK_BYTES   512u
+#define TASK_STACK_BLOCKS  (SMP_TASKS - 1)  // Task 0 is main() on the boot stack
+#define MSG_BUFFER_BYTES   32u
+#define MSG_BUFFER_BLOCKS  8u
+#define TIMER_NODE_BLOCKS  8u
+
+extern pool_t stack_pool, msg_pool, timer_pool;
+
+// Hart 0, before hart 1 starts: parks the other tasks, carves the pools and makes the caller
+// task 0. Returns 0 if the pools do not fit in the arena.
+int kernel_init(void);
+
+// Starts 'entry' as 'task' on a stack from stack_pool; returns 0 if none is left
+int task_spawn(uint32_t task, void (*entry)(void));
+
+// Message buffers: send the pointer through a msg_queue_t; the receiver frees it
+static inline void *msg_alloc(void) {
+    return pool_alloc(&msg_pool);
+}
+
+static inline void msg_free(void *buffer) {
+    pool_free(&msg_pool, buffer);
+}
+
+// Timer nodes for timers that do not live inside another object
+static inline soft_timer_t *timer_alloc(void) {
+    soft_timer_t *timer = pool_alloc(&timer_pool);
+    if (timer) timer->pprev = 0;
+    return timer;
+}
+
+// The timer must not be pending
+static inline void timer_free(soft_timer_t *timer) {
+    pool_free(&timer_pool, timer);
+}
+
+#endif
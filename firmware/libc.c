@@ -0,0 +1,300 @@
+#include <stdint.h>
+#include "libc.h"
+#include "bitops.h"
+#include "print.h"
+
+// GCC would turn the byte and word loops below back into calls to memcpy/memset (themselves)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("no-tree-loop-distribute-patterns")
+#endif
+
+// Word accesses to buffers of any declared type
+typedef uint32_t __attribute__((may_alias)) word_t;
+
+#define ALIGNED(p)       (((uintptr_t)(p) & 3) == 0)
+#define CO_ALIGNED(a, b) ((((uintptr_t)(a) ^ (uintptr_t)(b)) & 3) == 0)
+
+// Below this the byte loop is cheaper than aligning
+#define WORD_MIN 8u
+
+// --- 1. MEMORY ---
+
+// Forward copy shared by memcpy and memmove: every block is loaded before it is stored, so a
+// destination below an overlapping source is safe.
+static void copy_forward(uint8_t *d, const uint8_t *s, size_t n) {
+    if (n >= WORD_MIN) {
+        // Align the destination: at most three read-modify-write byte stores
+        while (!ALIGNED(d)) { *d++ = *s++; n--; }
+        word_t *dw = (word_t *)d;
+        uint32_t shift = ((uintptr_t)s & 3) * 8;
+
+        if (shift == 0) {
+            const word_t *sw = (const word_t *)s;
+            for (; n >= 16; n -= 16, dw += 4, sw += 4) {
+                uint32_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+                dw[0] = w0; dw[1] = w1; dw[2] = w2; dw[3] = w3;
+            }
+            for (; n >= 4; n -= 4) *dw++ = *sw++;
+            s = (const uint8_t *)sw;
+        } else {
+            // Source off by 1-3 bytes: merge consecutive aligned words, never a byte load
+            // (the last word read is the one holding the last byte copied)
+            const word_t *sw = (const word_t *)(s - (shift >> 3));
+            uint32_t low = *sw++;
+            for (; n >= 8; n -= 8, dw += 2, sw += 2) {
+                uint32_t mid = sw[0], high = sw[1];
+                dw[0] = low >> shift | mid << (32 - shift);
+                dw[1] = mid >> shift | high << (32 - shift);
+                low = high;
+            }
+            if (n >= 4) {
+                uint32_t high = *sw++;
+                *dw++ = low >> shift | high << (32 - shift);
+                n -= 4;
+            }
+            s = (const uint8_t *)sw - 4 + (shift >> 3);
+        }
+        d = (uint8_t *)dw;
+    }
+    while (n--) *d++ = *s++;
+}
+
+void *memcpy(void *restrict dst, const void *restrict src, size_t n) {
+    copy_forward((uint8_t *)dst, (const uint8_t *)src, n);
+    return dst;
+}
+
+void *memmove(void *dst, const void *src, size_t n) {
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+
+    // Destination below the source, or no overlap: a forward copy is safe
+    if ((uintptr_t)d - (uintptr_t)s >= n) {
+        copy_forward(d, s, n);
+        return dst;
+    }
+
+    // Destination overlaps the end of the source: copy from the top down
+    d += n;
+    s += n;
+    if (n >= WORD_MIN && CO_ALIGNED(d, s)) {
+        while (!ALIGNED(d)) { *--d = *--s; n--; }
+        word_t *dw = (word_t *)d;
+        const word_t *sw = (const word_t *)s;
+        for (; n >= 16; n -= 16) {
+            dw -= 4; sw -= 4;
+            uint32_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+            dw[3] = w3; dw[2] = w2; dw[1] = w1; dw[0] = w0;
+        }
+        for (; n >= 4; n -= 4) *--dw = *--sw;
+        d = (uint8_t *)dw;
+        s = (const uint8_t *)sw;
+    }
+    while (n--) *--d = *--s;
+    return dst;
+}
+
+void *memset(void *dst, int c, size_t n) {
+    uint8_t *d = (uint8_t *)dst;
+
+    if (n >= WORD_MIN) {
+        // Replicate the byte without a multiply (no M extension)
+        uint32_t fill = (uint8_t)c;
+        fill |= fill << 8;
+        fill |= fill << 16;
+
+        while (!ALIGNED(d)) { *d++ = (uint8_t)c; n--; }
+        word_t *dw = (word_t *)d;
+        for (; n >= 32; n -= 32, dw += 8) {
+            dw[0] = fill; dw[1] = fill; dw[2] = fill; dw[3] = fill;
+            dw[4] = fill; dw[5] = fill; dw[6] = fill; dw[7] = fill;
+        }
+        for (; n >= 4; n -= 4) *dw++ = fill;
+        d = (uint8_t *)dw;
+    }
+    while (n--) *d++ = (uint8_t)c;
+    return dst;
+}
+
+int memcmp(const void *a, const void *b, size_t n) {
+    const uint8_t *p = (const uint8_t *)a, *q = (const uint8_t *)b;
+
+    if (n >= WORD_MIN && CO_ALIGNED(p, q)) {
+        for (; !ALIGNED(p); p++, q++, n--)
+            if (*p != *q) return *p - *q;
+        // Skip equal words; the byte loop then orders the first differing word
+        const word_t *pw = (const word_t *)p, *qw = (const word_t *)q;
+        for (; n >= 4 && *pw == *qw; n -= 4) { pw++; qw++; }
+        p = (const uint8_t *)pw;
+        q = (const uint8_t *)qw;
+    }
+    for (; n; p++, q++, n--)
+        if (*p != *q) return *p - *q;
+    return 0;
+}
+
+size_t strlen(const char *s) {
+    const char *p = s;
+    for (; !ALIGNED(p); p++)
+        if (!*p) return p - s;
+
+    // A word holds a zero byte iff (w - 0x01..) & ~w & 0x80.. is non-zero (with Zbb: ORC.B,
+    // and CTZ of the mask gives the terminator's offset). Reading the rest of the word that
+    // holds the terminator stays inside one aligned word.
+    const word_t *w = (const word_t *)p;
+#if defined(__riscv_zbb)
+    uint32_t zeros;
+    while (!(zeros = bit_has_zero_byte(*w))) w++;
+    return (const char *)w - s + (bit_ctz(zeros) >> 3);
+#else
+    while (!bit_has_zero_byte(*w)) w++;
+    for (p = (const char *)w; *p; p++);
+    return p - s;
+#endif
+}
+
+// --- 2. NUMBER FORMATTING ---
+
+// n / 10 by shifts and adds (Hacker's Delight, divu10): the estimate is low by at most one,
+// corrected from the remainder
+static inline uint32_t divu10(uint32_t n, uint32_t *remainder) {
+    uint32_t q = (n >> 1) + (n >> 2);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    q >>= 3;
+    uint32_t r = n - (((q << 2) + q) << 1);
+    if (r > 9) { q++; r -= 10; }
+    *remainder = r;
+    return q;
+}
+
+uint32_t fmt_u32(char *buffer, uint32_t value) {
+    char digits[FMT_U32_DIGITS];
+    uint32_t count = 0, digit;
+    do {
+        value = divu10(value, &digit);
+        digits[count++] = (char)('0' + digit);
+    } while (value);
+
+    for (uint32_t i = 0; i < count; i++) buffer[i] = digits[count - 1 - i];
+    return count;
+}
+
+uint32_t fmt_hex(char *buffer, uint32_t value, uint32_t upper) {
+    const char *hex_chars = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint32_t count = 0;
+    // No leading zeros; "0" for zero
+#if defined(__riscv_zbb)
+    int shift = (31 - (int)bit_clz(value | 1)) & ~3;
+#else
+    int shift = 28;
+    while (shift > 0 && !(value >> shift)) shift -= 4;
+#endif
+    for (; shift >= 0; shift -= 4) buffer[count++] = hex_chars[(value >> shift) & 0xF];
+    return count;
+}
+
+// --- 3. PRINTF ---
+
+/** @brief Output cursor of vsnprintf: counts every character, stores those that fit. */
+typedef struct {
+    char  *buffer;
+    size_t size;
+    size_t length;
+} format_out_t;
+
+static inline void out_char(format_out_t *out, char c) {
+    if (out->length + 1 < out->size) out->buffer[out->length] = c;
+    out->length++;
+}
+
+static void out_padded(format_out_t *out, const char *text, uint32_t length, uint32_t width, char pad) {
+    // A sign stays in front of zero padding ("-0042")
+    if (pad == '0' && length && *text == '-') {
+        out_char(out, *text++);
+        length--;
+        if (width) width--;
+    }
+    for (; width > length; width--) out_char(out, pad);
+    while (length--) out_char(out, *text++);
+}
+
+int vsnprintf(char *buffer, size_t size, const char *format, va_list args) {
+    format_out_t out = { buffer, size, 0 };
+    char number[FMT_U32_DIGITS + 2];
+
+    for (; *format; format++) {
+        if (*format != '%') { out_char(&out, *format); continue; }
+
+        char pad = ' ';
+        uint32_t width = 0;
+        if (*++format == '0') { pad = '0'; format++; }
+        for (; *format >= '0' && *format <= '9'; format++)
+            width = (width << 3) + (width << 1) + (uint32_t)(*format - '0');
+
+        const char *text = number;
+        uint32_t length;
+        switch (*format) {
+        case 'd':
+        case 'i': {
+            int32_t value = va_arg(args, int32_t);
+            uint32_t sign = value < 0;
+            number[0] = '-';
+            length = sign + fmt_u32(number + sign, sign ? 0u - (uint32_t)value : (uint32_t)value);
+            break;
+        }
+        case 'u':
+            length = fmt_u32(number, va_arg(args, uint32_t));
+            break;
+        case 'x':
+        case 'X':
+            length = fmt_hex(number, va_arg(args, uint32_t), *format == 'X');
+            break;
+        case 'p':
+            out_char(&out, '0');
+            out_char(&out, 'x');
+            length = fmt_hex(number, (uint32_t)(uintptr_t)va_arg(args, void *), 0);
+            break;
+        case 'c':
+            number[0] = (char)va_arg(args, int);
+            length = 1;
+            break;
+        case 's':
+            text = va_arg(args, const char *);
+            if (!text) text = "(null)";
+            length = strlen(text);
+            pad = ' ';
+            break;
+        case '%':
+            number[0] = '%';
+            length = 1;
+            break;
+        default:                // Unknown conversion (or a trailing '%'): dropped
+            if (!*format) format--;
+            continue;
+        }
+        out_padded(&out, text, length, width, pad);
+    }
+
+    if (size) buffer[out.length < size ? out.length : size - 1] = '\0';
+    return (int)out.length;
+}
+
+int snprintf(char *buffer, size_t size, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, size, format, args);
+    va_end(args);
+    return length;
+}
+
+int printf(const char *format, ...) {
+    char buffer[PRINTF_BUFFER];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    print_str(buffer);
+    return length;
+}
@@ -0,0 +1,39 @@
+#ifndef LIBC_H
+#define LIBC_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Freestanding C library subset (libc.c). The images link with -nostdlib, and the compiler may
+// call memcpy/memset for struct copies and large initializers, so these are also its helpers.
+// Sub-word stores are read-modify-writes of the word on this SoC (no byte strobes): the memory
+// routines align the destination first and then move whole words, unrolled; a source that is
+// not word-aligned relative to it is merged from aligned loads with shifts.
+
+void  *memcpy(void *restrict dst, const void *restrict src, size_t n);
+void  *memmove(void *dst, const void *src, size_t n);
+void  *memset(void *dst, int c, size_t n);
+int    memcmp(const void *a, const void *b, size_t n);
+size_t strlen(const char *s);
+
+// --- NUMBER FORMATTING (no divide: RV32I has no M extension) ---
+// Writes the digits of 'value' (no terminator) and returns the number written
+#define FMT_U32_DIGITS 10
+uint32_t fmt_u32(char *buffer, uint32_t value);
+uint32_t fmt_hex(char *buffer, uint32_t value, uint32_t upper);
+
+// --- MINIMAL PRINTF ---
+// Conversions: %d %i %u %x %X %p %c %s %%, with an optional '0' flag and width (%08x, %5u).
+// No precision, length modifiers or floating point. The result is always terminated when
+// size > 0; the return value is the length the full output would have had.
+int vsnprintf(char *buffer, size_t size, const char *format, va_list args);
+int snprintf(char *buffer, size_t size, const char *format, ...);
+
+// Formats into a PRINTF_BUFFER-byte stack buffer (longer output is cut) and writes it to the
+// UART TX FIFO like print_str: blocking, for boot code and single-task images. Tasks format with
+// snprintf and queue the text with print_async under the kernel lock.
+#define PRINTF_BUFFER 96
+int printf(const char *format, ...);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include "print.h"
+
+// Deferred (binary) logging: format strings live in the non-loaded .logstr ELF section, so the
+// target sends only a token and raw argument words; sim/log_decoder.h rebuilds the text.
+//
+// Frame: LOG_MARKER | header (LE16: [15:13] argument count, [12:0] token) | args (LE32 each)
+// The token is the string's offset in .logstr (link.ld places it at address 0, 8KB max).
+#define LOG_MARKER     0x1E  // ASCII record separator, never part of plain text output
+#define LOG_MAX_ARGS   4
+
+#define LOG_NARGS(...) LOG_NARGS_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+#define LOG_NARGS_(_0, _1, _2, _3, _4, N, ...) N
+
+static inline void log_emit(uint32_t token, uint32_t nargs, const uint32_t* args) {
+    uint32_t header = (nargs << 13) | (token & 0x1FFF);
+    uart_putc(LOG_MARKER);
+    uart_putc(header & 0xFF);
+    uart_putc(header >> 8);
+    for (uint32_t i = 0; i < nargs; i++) {
+        uart_putc(args[i] & 0xFF);
+        uart_putc((args[i] >> 8) & 0xFF);
+        uart_putc((args[i] >> 16) & 0xFF);
+        uart_putc(args[i] >> 24);
+    }
+}
+
+// Usage: LOG("[DMA] %u transfers, last 0x%08x\n", count, value);
+// Arguments are sent as 32-bit words; %d %u %x %X %o %c %p are supported (no %s).
+#define LOG(fmt, ...) do {                                                              \
+    static const char log_format_[] __attribute__((section(".logstr"), used)) = fmt;   \
+    const uint32_t log_args_[LOG_MAX_ARGS + 1] = { 0, ##__VA_ARGS__ };                  \
+    log_emit((uint32_t)log_format_, LOG_NARGS(__VA_ARGS__), log_args_ + 1);             \
+} while (0)
+
+#endif
@@ -1,41 +1,133 @@
 #include <stdint.h>
 #include "print.h"
+#include "dma.h"
+#include "log.h"
+#include "semihost.h"
+#include "smp.h"
+#include "ipc.h"
+#include "timer.h"
+#include "kernel.h"
 
-// --- KERNEL MEMORY MAP ---
-#define TASK_PCS          ((volatile uint32_t *)0x20000000)
-#define TASK_SPS          ((volatile uint32_t *)0x20000008)
-#define CURRENT_TASK_PTR  ((volatile uint32_t *)0x20000010)
+// --- TASK STACKS ---
+// Task A is main() on the boot stack (link.ld); B and C get blocks from the kernel's stack pool
 
+// --- TASK PERIODS (timer ticks) ---
+#define TASK_A_PERIOD     6
+#define TASK_B_PERIOD     4
+
+// --- SMP BRING-UP ---
+#define HART1_WAIT_POLLS  2000        // Hart 1 is not modelled by the VP: continue on hart 0 alone
+
+// --- IPC DEMO (task B -> task C: pointers to message buffers) ---
+// At most queue size + one buffer per side are in flight, fewer than MSG_BUFFER_BLOCKS
+#define DEMO_QUEUE_SIZE   4
+
+static msg_queue_t       demo_queue;
+static volatile uint32_t demo_queue_seq[DEMO_QUEUE_SIZE], demo_queue_data[DEMO_QUEUE_SIZE];
+
+// --- DMA WORKSPACE ---
+#define DMA_BUFFER_WORDS  32
+
+static volatile dma_descriptor_t dma_chain[2];
+static volatile uint32_t         dma_buffer_src[DMA_BUFFER_WORDS], dma_buffer_dst[DMA_BUFFER_WORDS];
+
+// Both harts produce into the TX queue: the lock serializes producers (a timer tick that finds
+// it taken simply skips the switch)
+static void task_print(const char* s) {
+    hart_lock();
+    print_async(s);
+    hart_unlock();
+}
+
+// Periodic: sleeps to an absolute tick, so the period does not drift with the print time
 void task_A(void) {
+    uint32_t wake = timer_now();
     while (1) {
-        print_str("A");
-        // Delay loop so we don't spam too fast
-        for (volatile int i = 0; i < 10000; i++); 
+        task_print("A");
+        wake += TASK_A_PERIOD;
+        task_sleep_until(wake);
     }
 }
 
+// Producer: one message per loop; blocks only if task C falls a full queue behind
 void task_B(void) {
     while (1) {
-        print_str("B");
-        for (volatile int i = 0; i < 10000; i++);
+        task_print("B");
+        char *message = msg_alloc();
+        message[0] = 'C';
+        message[1] = '\0';
+        msgq_send(&demo_queue, (uint32_t)message);
+        task_sleep(TASK_B_PERIOD);
     }
 }
 
-int main() {
-    print_str("\n[BOOT] Context Switcher Demo\n");
+// Consumer: parked on the empty queue between messages, so it takes no timer slices
+void task_C(void) {
+    while (1) {
+        char *message = (char *)msgq_recv(&demo_queue);
+        task_print(message);
+        msg_free(message);
+    }
+}
+
+// Releases hart 1 and kicks it with an IPI; then checks hart 0's own IPI path
+static void smp_start(void) {
+    HART_START = 2;
 
-    // 1. Initialize Kernel Data
-    TASK_PCS[0] = (uint32_t)task_A;
-    TASK_PCS[1] = (uint32_t)task_B;
-    *CURRENT_TASK_PTR = 0;
+    uint32_t polls = 0;
+    while (!*HART_ONLINE && polls < HART1_WAIT_POLLS) polls++;
+    if (*HART_ONLINE) {
+        send_ipi(1);
+        while (IPI_COUNT[1] == 0);
+        LOG("[SMP] Hart 1 online after %u polls, IPI taken\n", polls);
+    } else {
+        LOG("[SMP] Hart 1 absent, running all tasks on hart 0\n");
+    }
+
+    send_ipi(0);
+    while (IPI_COUNT[0] == 0);
+    LOG("[SMP] Self IPI taken on hart %u\n", HART_ID);
+}
+
+// Fills a buffer and copies it as one chained job; completion is reported by interrupt
+static void dma_self_test(void) {
+    volatile dma_descriptor_t* chain = dma_chain;
+
+    chain[0].next = (uint32_t)&chain[1];
+    chain[0].src  = 0xA5A5A5A5;
+    chain[0].dst  = (uint32_t)dma_buffer_src;
+    chain[0].ctrl = DMA_BUFFER_WORDS | DMA_MODE_FILL;
+
+    chain[1].next = 0;
+    chain[1].src  = (uint32_t)dma_buffer_src;
+    chain[1].dst  = (uint32_t)dma_buffer_dst;
+    chain[1].ctrl = DMA_BUFFER_WORDS | DMA_MODE_COPY | DMA_IRQ_ENABLE;
+
+    dma_start_chain(chain);
+    while (*DMA_COMPLETIONS == 0);
+
+    LOG("[DMA] Chained fill + copy: last word 0x%08x, %u completion(s), %u units moved\n",
+        dma_buffer_dst[DMA_BUFFER_WORDS - 1], *DMA_COMPLETIONS, DMA_COUNT);
+}
+
+int main() {
+    // 1. Initialize Kernel Data (hart 0 is already running task A: this code)
+    int pools_ok = kernel_init();
+    dma_puts("\n[BOOT] Context Switcher Demo\n");
+    semihost_puts("[BOOT] Semihost console attached\n");
+    if (!pools_ok) {
+        semihost_puts("[BOOT] Kernel pools do not fit in the RAM arena\n");
+        while (1);
+    }
 
-    // 2. Initialize Task B Stack
-    uint32_t* stackB = (uint32_t*)(0x20000800);
-    uint32_t* sp_B = stackB - 32; 
-    sp_B[0] = (uint32_t)task_B; // Set Return Address
-    TASK_SPS[1] = (uint32_t)sp_B; 
+    // 2. Start Tasks B and C on pool stacks (C consumes B's messages)
+    msgq_init(&demo_queue, demo_queue_seq, demo_queue_data, DEMO_QUEUE_SIZE);
+    task_spawn(1, task_B);
+    task_spawn(2, task_C);
 
-    print_str("[INFO] Starting Task A...\n");
+    dma_self_test();
+    smp_start();
+    dma_puts("[INFO] Starting Task A...\n");
     task_A(); 
     return 0;
 }
\ No newline at end of file
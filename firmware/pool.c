@@ -0,0 +1,43 @@
+#include <stdint.h>
+#include "pool.h"
+
+// Linker-defined bounds (link.ld, section 5)
+extern uint8_t _arena_start[], _arena_end[];
+
+static uint8_t *arena_next;
+
+void arena_init(void) {
+    arena_next = _arena_start;
+}
+
+void *arena_alloc(uint32_t bytes) {
+    bytes = (bytes + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (bytes > (uint32_t)(_arena_end - arena_next)) return 0;
+    void *block = arena_next;
+    arena_next += bytes;
+    return block;
+}
+
+uint32_t arena_free_bytes(void) {
+    return (uint32_t)(_arena_end - arena_next);
+}
+
+// Blocks are carved one by one (no multiply: RV32I has none) and linked in address order
+int pool_init(pool_t *pool, uint32_t block_size, uint32_t blocks) {
+    block_size = (block_size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    pool->free       = 0;
+    pool->lock       = 0;
+    pool->block_size = block_size;
+    pool->blocks     = blocks;
+    pool->used       = 0;
+
+    void **tail = &pool->free;
+    for (uint32_t i = 0; i < blocks; i++) {
+        void **block = (void **)arena_alloc(block_size);
+        if (!block) return 0;
+        *block = 0;
+        *tail  = block;
+        tail   = block;
+    }
+    return 1;
+}
@@ -0,0 +1,53 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdint.h>
+#include "atomic.h"
+
+// RAM left between .bss and the boot stacks is the arena (link.ld: _arena_start.._arena_end).
+// At boot it is carved, once and in order, into fixed-block pools; nothing is returned to it.
+// A pool keeps its free blocks on a singly linked list threaded through the blocks themselves,
+// so allocation and release are O(1) and blocks of one size cannot fragment.
+// The pool lock is spun on: tasks only, not trap handlers.
+
+// Carve-outs are whole words. Stack pools are carved first with sizes that are multiples of 16,
+// so stacks keep the 16-byte alignment the ABI asks for (link.ld aligns _arena_start).
+#define ARENA_ALIGN 4u
+
+/** @brief Fixed-size block allocator over one arena carve-out. */
+typedef struct {
+    void      *free;          // First free block; its first word links the next
+    spinlock_t lock;
+    uint32_t   block_size;
+    uint32_t   blocks;
+    uint32_t   used;
+} pool_t;
+
+void  arena_init(void);
+void *arena_alloc(uint32_t bytes);        // 0 once the arena is exhausted
+uint32_t arena_free_bytes(void);
+
+// Carves 'blocks' blocks of 'block_size' bytes (rounded up to a word); 0 if they do not fit
+int pool_init(pool_t *pool, uint32_t block_size, uint32_t blocks);
+
+// Returns 0 when the pool is empty
+static inline void *pool_alloc(pool_t *pool) {
+    spin_lock(&pool->lock);
+    void **block = (void **)pool->free;
+    if (block) {
+        pool->free = *block;
+        pool->used++;
+    }
+    spin_unlock(&pool->lock);
+    return block;
+}
+
+static inline void pool_free(pool_t *pool, void *block) {
+    spin_lock(&pool->lock);
+    *(void **)block = pool->free;
+    pool->free = block;
+    pool->used--;
+    spin_unlock(&pool->lock);
+}
+
+#endif
@@ -2,17 +2,57 @@
 #define PRINT_H
 
 #include <stdint.h>
+#include "atomic.h"
 
 // UART Registers
 #define UART_TX     (*(volatile uint32_t *)0x40000000)
+#define UART_STATUS (*(volatile uint32_t *)0x40000004)
+#define UART_CTRL   (*(volatile uint32_t *)0x40000008)
 
-// Helper: Write char to UART (Bypassing Busy Check for Simulation)
+// STATUS: [0] busy, [1] TX FIFO full, [2] TX FIFO empty, [15:8] TX FIFO level
+#define UART_STATUS_FULL  (1u << 1)
+// CTRL: [7:0] TX threshold, [8] interrupt while TX level < threshold, [9] RX interrupt
+#define UART_TX_THRESHOLD 4u
+#define UART_CTRL_IRQ     (1u << 8)
+#define UART_CTRL_RX_IRQ  (1u << 9)
+
+// Software TX queue drained by the threshold interrupt (one char per word; kernel data, kernel.c)
+#define TXQ_SIZE          64u
+
+extern volatile uint32_t txq_head, txq_tail, txq_buffer[TXQ_SIZE];
+
+#define TXQ_HEAD          (&txq_head)
+#define TXQ_TAIL          (&txq_tail)
+#define TXQ_BUFFER        txq_buffer
+
+static const spsc_queue_t txq = { TXQ_HEAD, TXQ_TAIL, TXQ_BUFFER, TXQ_SIZE };
+
+// Helper: Write char to UART
+// The store lands in the TX FIFO; the bus only holds it (wait states) while the FIFO is full.
 static inline void uart_putc(char c) {
     UART_TX = c;
-    
-    // Tiny software delay to let the Verilog $write block catch it
-    // This prevents "overwriting" the bus before the simulator notices.
-    for (volatile int i = 0; i < 5; i++); 
+}
+
+// Threshold interrupt: top up the hardware FIFO from the software queue, stop when it is empty.
+// Runs with traps disabled, so it never races another drain.
+static inline void uart_tx_isr(void) {
+    uint32_t c;
+    if (!(UART_CTRL & UART_CTRL_IRQ)) return;
+    while (!(UART_STATUS & UART_STATUS_FULL) && spsc_pop(&txq, &c)) UART_TX = c;
+    if (spsc_empty(&txq)) UART_CTRL = (UART_CTRL & UART_CTRL_RX_IRQ) | UART_TX_THRESHOLD;
+}
+
+// Interrupt-driven print: queues the string and returns; spins only when the queue is full.
+// TXQ_HEAD/TXQ_TAIL must be zeroed before first use. Single producer (the ISR is the consumer):
+// producers on both harts serialize with a lock; two tasks preempting each other mid-call on one
+// hart may interleave characters.
+static inline void print_async(const char* s) {
+    while (*s) {
+        while (!spsc_push(&txq, (uint8_t)*s));
+        s++;
+    }
+    // Enabling while already below threshold raises the interrupt immediately
+    UART_CTRL = (UART_CTRL & UART_CTRL_RX_IRQ) | UART_TX_THRESHOLD | UART_CTRL_IRQ;
 }
 
 // Helper: Print a 32-bit integer as Hex (e.g., "1A2B3C4D")
@@ -27,9 +67,7 @@ static inline void print_hex(uint32_t val) {
 
 // Helper: Print a simple string
 static inline void print_str(const char* s) {
-
-        uart_putc(*s++);
-
+    while (*s) uart_putc(*s++);
 }
 
 #endif
\ No newline at end of file
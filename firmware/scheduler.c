@@ -1,60 +1,107 @@
 #include <stdint.h>
+#include "print.h"
+#include "dma.h"
+#include "smp.h"
+#include "timer.h"
 
+#define CSR_MEPC   (*(volatile uint32_t *)0x40000010)
+#define CSR_MCAUSE (*(volatile uint32_t *)0x40000014)
 
-#include <stdint.h>
+// Trap Causes
+#define CAUSE_SOFTWARE   0x80000003
+#define CAUSE_TIMER      0x80000007
+#define CAUSE_EXTERNAL   0x8000000B
+#define CAUSE_ECALL      0x0000000B
 
-// UART Registers
-#define UART_TX     (*(volatile uint32_t *)0x40000000)
+#define FRAME_BYTES      128  // crt0 trap frame
 
-// Helper: Write char to UART (Bypassing Busy Check for Simulation)
-static inline void uart_putc(char c) {
-    UART_TX = c;
-    
-    // Tiny software delay to let the Verilog $write block catch it
-    // This prevents "overwriting" the bus before the simulator notices.
-    for (volatile int i = 0; i < 5; i++); 
-}
+#define IDLE_STACK_WORDS 64   // Idle loop frame + one trap (frame, handler, scheduler)
 
-// Helper: Print a 32-bit integer as Hex (e.g., "1A2B3C4D")
-static inline void print_hex(uint32_t val) {
-    char hex_chars[] = "0123456789ABCDEF";
-    uart_putc('0'); uart_putc('x');
-    for (int i = 7; i >= 0; i--) {
-        uart_putc(hex_chars[(val >> (i * 4)) & 0xF]);
-    }
-    uart_putc(' '); // Space separator
+// Idle contexts: a hart whose task blocked with nothing else ready spins here on its own stack
+// until an IPI (ipc.c wake-up) or its timer tick. Hart 1's is its boot stack (link.ld).
+extern uint32_t _hart1_stack_top[];
+static uint32_t hart0_idle_stack[IDLE_STACK_WORDS];
+static uint32_t *const idle_stack_top[SMP_HARTS] = { hart0_idle_stack + IDLE_STACK_WORDS, _hart1_stack_top };
+
+static void smp_idle(void) {
+    while (1);
 }
 
-// Helper: Print a simple string
-static inline void print_str(const char* s) {
+// Runs on either hart. Tasks live in one shared table; a hart releases the task it was running
+// and takes the next one (round robin) that the other hart is not running and that is not
+// parked on an IPC object.
+uint32_t scheduler(uint32_t current_sp) {
+    uint32_t hart = HART_ID;
 
-        uart_putc(*s++);
+    // The other hart is switching (or a task holds the lock): keep running, retry next tick
+    if (!hart_trylock()) return current_sp;
 
-}
+    uint32_t current_task = HART_CURRENT[hart];
 
+    // 0. Expire software timers (hart 0 keeps time); sleepers whose tick came are ready again
+    if (hart == 0) timer_run_locked();
 
-#define CSR_MEPC (*(volatile uint32_t *)0x40000010)
+    // 1. Save Context (an idle hart has nothing to resume; a waiting task stays parked)
+    if (current_task != SMP_IDLE) {
+        SMP_TASK_SPS[current_task]   = current_sp;
+        SMP_TASK_PCS[current_task]   = CSR_MEPC;
+        SMP_TASK_OWNER[current_task] = SMP_TASK_WAIT[current_task] ? SMP_BLOCKED : 0;
+    }
 
-// Memory Map
-#define TASK_PCS          ((volatile uint32_t *)0x20000000)
-#define TASK_SPS          ((volatile uint32_t *)0x20000008)
-#define CURRENT_TASK_PTR  ((volatile uint32_t *)0x20000010)
+    // 2. Pick the next ready task (no modulo: RV32I has no divider)
+    uint32_t next_task = SMP_IDLE;
+    uint32_t candidate = (current_task == SMP_IDLE) ? 0 : current_task;
+    for (uint32_t i = 0; i < SMP_TASKS; i++) {
+        if (++candidate >= SMP_TASKS) candidate = 0;
+        if (SMP_TASK_OWNER[candidate] == 0) {
+            next_task = candidate;
+            break;
+        }
+    }
+    if (next_task == SMP_IDLE) {
+        // Nothing ready: the task just parked, so this hart enters its idle context
+        if (current_task != SMP_IDLE) {
+            HART_CURRENT[hart] = SMP_IDLE;
+            CSR_MEPC   = (uint32_t)smp_idle;
+            current_sp = (uint32_t)idle_stack_top[hart] - FRAME_BYTES;
+            ((uint32_t *)current_sp)[FRAME_FP_SAVED] = 0;
+        }
+        hart_unlock();
+        return current_sp;
+    }
 
-uint32_t scheduler(uint32_t current_sp) {
-    int current_task = *CURRENT_TASK_PTR;
+    // 3. Restore Context
+    SMP_TASK_OWNER[next_task] = hart + 1;
+    HART_CURRENT[hart] = next_task;
+    CSR_MEPC = SMP_TASK_PCS[next_task];
+    hart_unlock();
 
-    // 1. Save Context
-    TASK_SPS[current_task] = current_sp;
-    TASK_PCS[current_task] = CSR_MEPC; 
+    return SMP_TASK_SPS[next_task];
+}
 
-    // 2. Toggle Task (0 -> 1 -> 0)
-    int next_task = (current_task == 0) ? 1 : 0;
-    
-    // The scheduler must be fast.
+// Trap entry (crt0): peripheral interrupts are serviced in place and resume the same task;
+// timer ticks, inter-processor interrupts and ECALL (voluntary yield, resumed after the ecall)
+// run the scheduler. Peripheral interrupts are wired to hart 0 only.
+uint32_t trap_handler(uint32_t current_sp) {
+    uint32_t cause = CSR_MCAUSE;
+    if (cause == CAUSE_EXTERNAL) {
+        if (DMA_STATUS & DMA_STATUS_IRQ) dma_isr();
+        uart_tx_isr();
+        return current_sp;
+    }
+    if (cause == CAUSE_SOFTWARE) {
+        uint32_t hart = HART_ID;
+        MSIP[hart] = 0; // Level-sensitive: clear before MRET
+        atomic_add(&IPI_COUNT[hart], 1);
+    }
+    if (cause == CAUSE_TIMER && HART_ID == 0) timer_tick_isr();
+    if (cause == CAUSE_ECALL) CSR_MEPC = CSR_MEPC + 4;
+    return scheduler(current_sp);
+}
 
-    // 3. Restore Context
-    *CURRENT_TASK_PTR = next_task;
-    CSR_MEPC = TASK_PCS[next_task];
-    
-    return TASK_SPS[next_task];
-}
\ No newline at end of file
+// Hart 1 entry (crt0, on its boot stack): idle until a timer tick or an IPI from hart 0
+// schedules a task. The idle context is dropped at the first switch.
+void secondary_main(void) {
+    *HART_ONLINE = 1;
+    while (1);
+}
@@ -0,0 +1,40 @@
+#ifndef SEMIHOST_H
+#define SEMIHOST_H
+
+#include <stdint.h>
+#include "libc.h"
+
+// Semihosting: requests served by the simulation host (sim/soc_top_tb.cpp) at the store that
+// makes the call, so they cost no simulated time. On hardware the stores are ignored.
+#define SEMI_ARG0   (*(volatile uint32_t *)0x40000300)
+#define SEMI_ARG1   (*(volatile uint32_t *)0x40000304)
+#define SEMI_CALL   (*(volatile uint32_t *)0x40000308)
+#define SEMI_RESULT (*(volatile uint32_t *)0x4000030C)
+
+#define SEMI_WRITE  1u  // ARG0 = buffer, ARG1 = length: copy to host stdout
+#define SEMI_EXIT   2u  // ARG0 = exit code: end the simulation
+#define SEMI_CLOCK  3u  // RESULT = host wall clock (microseconds since start)
+
+// Bulk console output: the host reads the buffer from memory (cache-coherent backdoor)
+static inline void semihost_write(const void *buffer, uint32_t length) {
+    SEMI_ARG0 = (uint32_t)buffer;
+    SEMI_ARG1 = length;
+    SEMI_CALL = SEMI_WRITE;
+}
+
+static inline void semihost_puts(const char *s) {
+    semihost_write(s, strlen(s));
+}
+
+static inline void semihost_exit(uint32_t code) {
+    SEMI_ARG0 = code;
+    SEMI_CALL = SEMI_EXIT;
+    while (1);
+}
+
+static inline uint32_t semihost_clock_us(void) {
+    SEMI_CALL = SEMI_CLOCK;
+    return SEMI_RESULT;
+}
+
+#endif
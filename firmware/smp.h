@@ -0,0 +1,100 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+#include "atomic.h"
+
+// Hart-local registers: every hart sees its own ID and trap state at these addresses
+#define HART_ID         (*(volatile uint32_t *)0x4000001C)
+
+// Shared SMP control
+#define MSIP            ((volatile uint32_t *)0x40000030)  // [hart]: bit 0 raises its software interrupt
+#define HART_LOCK       (*(volatile uint32_t *)0x40000040)  // Test-and-set register for code built without RV32A
+#define HART_START      (*(volatile uint32_t *)0x40000044)  // Write 2: release hart 1 from reset
+#define BUS_CONTENTION  (*(volatile uint32_t *)0x40000048)  // Cycles both harts wanted the bus
+
+#define SMP_HARTS       2u
+#define SMP_TASKS       3u
+#define SMP_IDLE        SMP_TASKS  // HART_CURRENT value while a hart runs no task
+#define SMP_BLOCKED     0xFFu      // SMP_TASK_OWNER value of a task parked on an IPC object
+#define FRAME_FP_SAVED  30u        // Trap frame word: f0-f31/FCSR saved below the frame (crt0.S)
+
+/** @brief Shared task table and hart state (kernel data in .bss, kernel.c; guarded by KERNEL_LOCK). */
+typedef struct {
+    volatile uint32_t task_pcs[SMP_TASKS];
+    volatile uint32_t task_sps[SMP_TASKS];
+    volatile uint32_t task_owner[SMP_TASKS];    // Hart + 1 running it, 0 = ready, SMP_BLOCKED
+    volatile uint32_t task_wait[SMP_TASKS];     // 1 while it waits on an IPC object or sleeps
+    volatile uint32_t hart_current[SMP_HARTS];
+    volatile uint32_t hart_online;              // Set by hart 1 once it is running
+    volatile uint32_t ipi_count[SMP_HARTS];     // Software interrupts taken
+    spinlock_t        lock;                     // Task table and TX queue producers
+} smp_kernel_t;
+
+extern smp_kernel_t smp_kernel;
+
+#define SMP_TASK_PCS    (smp_kernel.task_pcs)      // [task]
+#define SMP_TASK_SPS    (smp_kernel.task_sps)      // [task]
+#define SMP_TASK_OWNER  (smp_kernel.task_owner)    // [task]
+#define SMP_TASK_WAIT   (smp_kernel.task_wait)     // [task]
+#define HART_CURRENT    (smp_kernel.hart_current)  // [hart]
+#define HART_ONLINE     (&smp_kernel.hart_online)
+#define IPI_COUNT       (smp_kernel.ipi_count)     // [hart]
+#define KERNEL_LOCK     (&smp_kernel.lock)
+
+// Single attempt: a trap handler must not spin on a lock the code it interrupted may hold
+static inline int hart_trylock(void) {
+    return spin_trylock(KERNEL_LOCK);
+}
+
+static inline void hart_lock(void) {
+    spin_lock(KERNEL_LOCK);
+}
+
+static inline void hart_unlock(void) {
+    spin_unlock(KERNEL_LOCK);
+}
+
+static inline void send_ipi(uint32_t hart) {
+    MSIP[hart] = 1;
+}
+
+// Caller holds KERNEL_LOCK: readies a parked task (a task that has not parked yet only loses its
+// wait flag, so the scheduler saves it as ready)
+static inline void task_wake_locked(uint32_t task) {
+    SMP_TASK_WAIT[task] = 0;
+    if (SMP_TASK_OWNER[task] == SMP_BLOCKED) SMP_TASK_OWNER[task] = 0;
+}
+
+// An idle hart would only see a woken task at its next tick: IPI the first one other than 'self'
+static inline void smp_kick_idle(uint32_t self) {
+    for (uint32_t hart = 0; hart < SMP_HARTS; hart++) {
+        if (hart != self && HART_CURRENT[hart] == SMP_IDLE && (hart == 0 || *HART_ONLINE)) {
+            send_ipi(hart);
+            return;
+        }
+    }
+}
+
+// Task running on the calling hart (SMP_IDLE in the idle context)
+static inline uint32_t smp_current_task(void) {
+    return HART_CURRENT[HART_ID];
+}
+
+// Voluntary reschedule: the trap handler resumes the caller after the ecall
+static inline void task_yield(void) {
+    __asm__ volatile ("ecall" ::: "memory");
+}
+
+// Builds the first trap frame of a task that has not run yet: MRET enters it at its PC
+static inline void task_create(uint32_t task, void (*entry)(void), uint32_t stack_top) {
+    uint32_t* sp = (uint32_t*)stack_top - 32;
+    sp[0] = (uint32_t)entry; // Set Return Address
+    sp[FRAME_FP_SAVED] = 0;  // No FP state yet: crt0.S restores none
+    SMP_TASK_PCS[task]   = (uint32_t)entry;
+    SMP_TASK_SPS[task]   = (uint32_t)sp;
+    SMP_TASK_WAIT[task]  = 0;
+    SMP_TASK_OWNER[task] = 0;
+}
+
+#endif
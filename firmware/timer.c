@@ -0,0 +1,128 @@
+#include <stdint.h>
+#include "timer.h"
+
+#define SLOT_MASK    (TIMER_SLOTS - 1)
+#define WHEEL_RANGE  (1u << (TIMER_LEVELS * TIMER_SLOT_BITS))
+
+// Zeroed by crt0: tick 0, every slot empty, no sleep timer pending
+timer_wheel_t timer_wheel;
+soft_timer_t  sleep_timers[SMP_TASKS];
+
+// Level = how far away the deadline is; slot = the deadline's digit at that level
+static void wheel_insert(timer_wheel_t *wheel, soft_timer_t *timer) {
+    uint32_t delta = timer->expires - wheel->now;
+    uint32_t at = timer->expires, level;
+    if (delta < (1u << TIMER_SLOT_BITS))            level = 0;
+    else if (delta < (1u << (2 * TIMER_SLOT_BITS))) level = 1;
+    else {
+        level = 2;
+        if (delta >= WHEEL_RANGE) at = wheel->now + WHEEL_RANGE - 1; // Placed again on the way down
+    }
+
+    soft_timer_t **head = &wheel->slots[level][(at >> (level * TIMER_SLOT_BITS)) & SLOT_MASK];
+    timer->next  = *head;
+    timer->pprev = head;
+    if (*head) (*head)->pprev = &timer->next;
+    *head = timer;
+}
+
+static void wheel_unlink(soft_timer_t *timer) {
+    *timer->pprev = timer->next;
+    if (timer->next) timer->next->pprev = timer->pprev;
+    timer->pprev = 0;
+}
+
+// Moves every timer of the slot 'now' has reached down to a finer level
+static void wheel_cascade(timer_wheel_t *wheel, uint32_t level) {
+    soft_timer_t **head = &wheel->slots[level][(wheel->now >> (level * TIMER_SLOT_BITS)) & SLOT_MASK];
+    soft_timer_t *timer;
+    while ((timer = *head)) {
+        wheel_unlink(timer);
+        wheel_insert(wheel, timer);
+    }
+}
+
+static void wheel_step(timer_wheel_t *wheel) {
+    uint32_t now = ++wheel->now;
+    if (!(now & SLOT_MASK)) {
+        if (!(now & (SLOT_MASK << TIMER_SLOT_BITS))) wheel_cascade(wheel, 2);
+        wheel_cascade(wheel, 1);
+    }
+
+    // Every timer left in this level-0 slot expires now; a callback may re-arm its own timer
+    soft_timer_t **head = &wheel->slots[0][now & SLOT_MASK];
+    soft_timer_t *timer;
+    while ((timer = *head)) {
+        wheel_unlink(timer);
+        timer->callback(timer);
+    }
+}
+
+void timer_run_locked(void) {
+    timer_wheel_t *wheel = TIMER_WHEEL;
+    while (wheel->pending) {
+        wheel->pending--;
+        wheel_step(wheel);
+    }
+}
+
+void timer_start_locked(soft_timer_t *timer, uint32_t expires) {
+    timer_wheel_t *wheel = TIMER_WHEEL;
+    if (timer->pprev) wheel_unlink(timer);
+    // The current tick's slot has already run: the earliest deadline is the next tick
+    if ((int32_t)(expires - wheel->now) < 1) expires = wheel->now + 1;
+    timer->expires = expires;
+    wheel_insert(wheel, timer);
+}
+
+void timer_cancel_locked(soft_timer_t *timer) {
+    if (timer->pprev) wheel_unlink(timer);
+}
+
+void timer_start_at(soft_timer_t *timer, uint32_t expires, void (*callback)(soft_timer_t *), uint32_t arg) {
+    hart_lock();
+    timer->callback = callback;
+    timer->arg      = arg;
+    timer_start_locked(timer, expires);
+    hart_unlock();
+}
+
+void timer_start(soft_timer_t *timer, uint32_t ticks, void (*callback)(soft_timer_t *), uint32_t arg) {
+    timer_start_at(timer, timer_now() + ticks, callback, arg);
+}
+
+void timer_cancel(soft_timer_t *timer) {
+    hart_lock();
+    timer_cancel_locked(timer);
+    hart_unlock();
+}
+
+// --- TASK SLEEP ---
+static void sleep_expired(soft_timer_t *timer) {
+    task_wake_locked(timer->arg);
+    smp_kick_idle(HART_ID);
+}
+
+// The task parks like an IPC waiter (SMP_TASK_WAIT): it takes no timer slices until the tick
+void task_sleep_until(uint32_t wake) {
+    uint32_t task = smp_current_task();
+    soft_timer_t *timer = &SLEEP_TIMERS[task];
+
+    hart_lock();
+    if ((int32_t)(wake - timer_now()) <= 0) {
+        hart_unlock();
+        return;
+    }
+    timer->callback = sleep_expired;
+    timer->arg      = task;
+    SMP_TASK_WAIT[task] = 1;
+    timer_start_locked(timer, wake);
+    hart_unlock();
+
+    // A yield whose scheduler found the lock busy returns without parking: yield again
+    while (SMP_TASK_WAIT[task]) task_yield();
+}
+
+void task_sleep(uint32_t ticks) {
+    task_sleep_until(timer_now() + ticks);
+}
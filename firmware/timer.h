@@ -0,0 +1,71 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+#include "smp.h"
+
+// Kernel software timers: a hierarchical timer wheel advanced by hart 0's timer trap.
+// Three levels of 16 slots (1, 16 and 256 ticks per slot) cover 4096 ticks; a later deadline
+// waits in the last level and is placed again as it comes into range. Each slot is an intrusive
+// doubly linked list, so start and cancel are O(1), and a tick touches one level-0 slot plus, every
+// 16th and 256th tick, one higher slot whose timers move down a level (each timer moves at most
+// twice in its life). The cost of a tick does not depend on how many timers are pending.
+// Callbacks run in the timer trap with KERNEL_LOCK held: keep them short, use the _locked calls.
+
+#define TIMER_LEVELS     3
+#define TIMER_SLOT_BITS  4
+#define TIMER_SLOTS      (1u << TIMER_SLOT_BITS)
+
+/** @brief One pending timeout: embed it in the object that owns it (no allocation). */
+typedef struct soft_timer {
+    struct soft_timer  *next;
+    struct soft_timer **pprev;          // Link that points at this timer; 0 while not pending
+    uint32_t            expires;        // Tick
+    void              (*callback)(struct soft_timer *timer);
+    uint32_t            arg;
+} soft_timer_t;
+
+typedef struct {
+    volatile uint32_t now;              // Ticks processed
+    volatile uint32_t pending;          // Ticks taken by hart 0 but not processed yet (lock busy)
+    soft_timer_t     *slots[TIMER_LEVELS][TIMER_SLOTS];
+} timer_wheel_t;
+
+// Kernel data (timer.c, guarded by KERNEL_LOCK)
+extern timer_wheel_t timer_wheel;
+extern soft_timer_t  sleep_timers[SMP_TASKS];   // [task]: used by task_sleep_until
+
+#define TIMER_WHEEL   (&timer_wheel)
+#define SLEEP_TIMERS  sleep_timers
+
+// Tick counter: one tick per hart 0 timer period (timerLimit + 1 cycles)
+static inline uint32_t timer_now(void) {
+    return TIMER_WHEEL->now;
+}
+
+static inline int timer_pending(const soft_timer_t *timer) {
+    return timer->pprev != 0;
+}
+
+// Runs 'callback' at tick 'expires' (at the next tick if that has passed); restarts a pending timer
+void timer_start_at(soft_timer_t *timer, uint32_t expires, void (*callback)(soft_timer_t *), uint32_t arg);
+void timer_start(soft_timer_t *timer, uint32_t ticks, void (*callback)(soft_timer_t *), uint32_t arg);
+void timer_cancel(soft_timer_t *timer);
+
+// Same, for callers that hold KERNEL_LOCK (callbacks re-arming themselves)
+void timer_start_locked(soft_timer_t *timer, uint32_t expires);
+void timer_cancel_locked(soft_timer_t *timer);
+
+// Timer trap on hart 0: count the tick; the scheduler processes it once it holds the lock
+static inline void timer_tick_isr(void) {
+    TIMER_WHEEL->pending++;
+}
+
+// Caller holds KERNEL_LOCK (hart 0): advances the wheel by every counted tick
+void timer_run_locked(void);
+
+// Parks the calling task until tick 'wake' (returns at once if it has passed)
+void task_sleep_until(uint32_t wake);
+void task_sleep(uint32_t ticks);
+
+#endif
@@ -1,24 +1,64 @@
 module alu (
     input  logic [31:0] inputA,     // Operand A
     input  logic [31:0] inputB,     // Operand B
-    input  logic [2:0]  aluControl, // Opcode: determines the operation
-    output logic [31:0] aluResult,  
+    input  logic [4:0]  aluControl, // Opcode: determines the operation
+    output logic [31:0] aluResult,
     output logic        zero        // High if aluResult is zero
 );
 
+    // Zbb counts: priority scans over operand A (CLZ/CTZ give 32 for zero)
+    logic [5:0] leadingZeros, trailingZeros, populationCount;
+
+    always_comb begin
+        leadingZeros    = 6'd32;
+        trailingZeros   = 6'd32;
+        populationCount = 6'd0;
+        for (int i = 0; i < 32; i++) begin
+            if (inputA[i]) leadingZeros = 6'(31 - i);
+            if (inputA[31 - i]) trailingZeros = 6'(31 - i);
+            populationCount = populationCount + {5'b0, inputA[i]};
+        end
+    end
+
     always_comb begin
         case (aluControl)
-            3'b000:  aluResult = inputA + inputB;                 // ADD
-            3'b001:  aluResult = inputA - inputB;                 // SUB
-            3'b010:  aluResult = inputA & inputB;                 // AND
-            3'b011:  aluResult = inputA | inputB;                 // OR
-            3'b100:  aluResult = inputA ^ inputB;                 // XOR
-            3'b101:  aluResult = (inputA < inputB) ? 32'b1 : 32'b0; // SLT (Set Less Than)
-            default: aluResult = 32'b0;                           // Default / NOP
+            5'b00000: aluResult = inputA + inputB;                 // ADD
+            5'b00001: aluResult = inputA - inputB;                 // SUB
+            5'b00010: aluResult = inputA & inputB;                 // AND
+            5'b00011: aluResult = inputA | inputB;                 // OR
+            5'b00100: aluResult = inputA ^ inputB;                 // XOR
+            5'b00101: aluResult = ($signed(inputA) < $signed(inputB)) ? 32'b1 : 32'b0; // SLT (Set Less Than)
+            5'b00110: aluResult = (inputA < inputB) ? 32'b1 : 32'b0; // SLTU
+            5'b00111: aluResult = inputA << inputB[4:0];           // SLL
+            5'b01000: aluResult = inputA >> inputB[4:0];           // SRL
+            5'b01001: aluResult = $signed(inputA) >>> inputB[4:0]; // SRA
+            // Zba: address generation (index scaled by 2/4/8, plus base)
+            5'b01010: aluResult = (inputA << 1) + inputB;          // SH1ADD
+            5'b01011: aluResult = (inputA << 2) + inputB;          // SH2ADD
+            5'b01100: aluResult = (inputA << 3) + inputB;          // SH3ADD
+            // Zbb: logic with negate, counts, extension, min/max, rotates, bytes
+            5'b01101: aluResult = inputA & ~inputB;                // ANDN
+            5'b01110: aluResult = inputA | ~inputB;                // ORN
+            5'b01111: aluResult = ~(inputA ^ inputB);              // XNOR
+            5'b10000: aluResult = {26'b0, leadingZeros};           // CLZ
+            5'b10001: aluResult = {26'b0, trailingZeros};          // CTZ
+            5'b10010: aluResult = {26'b0, populationCount};        // CPOP
+            5'b10011: aluResult = {{24{inputA[7]}}, inputA[7:0]};  // SEXT.B
+            5'b10100: aluResult = {{16{inputA[15]}}, inputA[15:0]}; // SEXT.H
+            5'b10101: aluResult = {16'b0, inputA[15:0]};           // ZEXT.H
+            5'b10110: aluResult = ($signed(inputA) < $signed(inputB)) ? inputA : inputB; // MIN
+            5'b10111: aluResult = ($signed(inputA) < $signed(inputB)) ? inputB : inputA; // MAX
+            5'b11000: aluResult = (inputA < inputB) ? inputA : inputB; // MINU
+            5'b11001: aluResult = (inputA < inputB) ? inputB : inputA; // MAXU
+            5'b11010: aluResult = (inputA << inputB[4:0]) | (inputA >> (6'd32 - {1'b0, inputB[4:0]})); // ROL
+            5'b11011: aluResult = (inputA >> inputB[4:0]) | (inputA << (6'd32 - {1'b0, inputB[4:0]})); // ROR/RORI
+            5'b11100: aluResult = {{8{|inputA[31:24]}}, {8{|inputA[23:16]}}, {8{|inputA[15:8]}}, {8{|inputA[7:0]}}}; // ORC.B
+            5'b11101: aluResult = {inputA[7:0], inputA[15:8], inputA[23:16], inputA[31:24]}; // REV8
+            default:  aluResult = 32'b0;                           // Default / NOP
         endcase
     end
 
     // Status flag logic
     assign zero = (aluResult == 32'b0);
 
-endmodule
\ No newline at end of file
+endmodule
@@ -0,0 +1,34 @@
+module bus_arbiter #(
+    parameter dmaWeight = 1 // Consecutive DMA grants allowed while the CPU waits (0: CPU strict priority)
+) (
+    input  logic clock,
+    input  logic resetActiveLow,
+
+    // Requests targeting this slave channel
+    input  logic cpuRequest,
+    input  logic dmaRequest,
+    input  logic grantAccepted, // Granted master completed its handshake this cycle
+
+    // Grant (combinational, so a zero-wait slave can complete in the request cycle)
+    output logic grantValid,
+    output logic grantDma       // 0: CPU owns the slave port, 1: DMA
+);
+
+    // Weighted round-robin: the DMA may win up to dmaWeight contended transfers in a row,
+    // after which the CPU is served. A waiting CPU is therefore bounded to dmaWeight transfers.
+    logic [7:0] dmaStreak;
+
+    assign grantValid = cpuRequest || dmaRequest;
+    assign grantDma   = dmaRequest && (!cpuRequest || (dmaStreak < 8'(dmaWeight)));
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)
+            dmaStreak <= 0;
+        else if (grantAccepted) begin
+            // Only grants that made the CPU wait count against its bound
+            if (grantDma && cpuRequest) dmaStreak <= (dmaStreak == 8'hFF) ? dmaStreak : dmaStreak + 1;
+            else                        dmaStreak <= 0;
+        end
+    end
+
+endmodule
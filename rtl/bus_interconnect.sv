@@ -1,4 +1,7 @@
-module bus_interconnect (
+module bus_interconnect #(
+    parameter maxOutstanding = 4, // Reads in flight per master / per slave (power of 2)
+    parameter dmaWeight      = 1  // Per-slave QoS: DMA grants in a row while the CPU waits
+) (
     input  logic        clock,
     input  logic        resetActiveLow,
 
@@ -7,6 +10,9 @@ module bus_interconnect (
     input  logic [31:0] cpuAxiWriteData,      input  logic cpuAxiWriteValidData, output logic cpuAxiWriteReadyData,
     input  logic [31:0] cpuAxiReadAddress,    input  logic cpuAxiReadValid,      output logic cpuAxiReadReady,
     output logic [31:0] cpuAxiReadData,       output logic cpuAxiReadValidData,  input  logic cpuAxiReadReadyData,
+    // RV32A: LR/AMO reads reserve the word for a hart; conditional writes land only while it holds
+    input  logic        cpuAxiReadReserve,    input  logic cpuAxiReadHart,
+    input  logic        cpuAxiWriteConditional, input logic cpuAxiWriteHart,     output logic cpuAxiWriteFail,
 
     // DMA MASTER
     input  logic [31:0] dmaAxiWriteAddress,   input  logic dmaAxiWriteValid,     output logic dmaAxiWriteReady,
@@ -29,79 +35,286 @@ module bus_interconnect (
     input  logic [31:0] ioAxiReadData,        input  logic ioAxiReadValidData,   output logic ioAxiReadReadyData
 );
 
-    // --- 1. ARBITRATION ---
-    // DMA takes priority; bus returns to CPU only when DMA is idle
-    logic activeMasterReg; 
-    always_ff @(posedge clock or negedge resetActiveLow) begin
-        if (!resetActiveLow) 
-            activeMasterReg <= 1'b0;
-        else if (activeMasterReg == 0 && (dmaAxiReadValid || dmaAxiWriteValid)) 
-            activeMasterReg <= 1'b1;
-        else if (activeMasterReg == 1 && (!dmaAxiReadValid && !dmaAxiWriteValid)) 
-            activeMasterReg <= 1'b0;
+    // 2-master x 3-slave crossbar: every slave port has its own arbiter, so the CPU and the
+    // DMA proceed in the same cycle whenever they target different slaves.
+    localparam SLAVE_ROM = 2'd0;
+    localparam SLAVE_RAM = 2'd1;
+    localparam SLAVE_IO  = 2'd2;
+    localparam PTR_BITS  = (maxOutstanding > 1) ? $clog2(maxOutstanding) : 1;
+
+    function automatic logic [1:0] decodeSlave(input logic [31:0] address);
+        if (address[30])      return SLAVE_IO;  // MMIO (0x4000_0000)
+        else if (address[29]) return SLAVE_RAM; // RAM  (0x2000_0000)
+        else                  return SLAVE_ROM; // ROM  (0x0000_0000)
+    endfunction
+
+    // --- 1. MASTER PORTS (Index 0: CPU, 1: DMA) ---
+    logic [31:0] masterReadAddress  [0:1];
+    logic [31:0] masterWriteAddress [0:1];
+    logic [31:0] masterWriteData    [0:1];
+    logic [1:0]  masterReadValid, masterWriteValid, masterReadReadyData;
+    logic [1:0]  masterReadTarget   [0:1];
+    logic [1:0]  masterWriteTarget  [0:1];
+
+    assign masterReadAddress[0]  = cpuAxiReadAddress;  assign masterReadAddress[1]  = dmaAxiReadAddress;
+    assign masterWriteAddress[0] = cpuAxiWriteAddress; assign masterWriteAddress[1] = dmaAxiWriteAddress;
+    assign masterWriteData[0]    = cpuAxiWriteData;    assign masterWriteData[1]    = dmaAxiWriteData;
+    assign masterReadValid       = {dmaAxiReadValid, cpuAxiReadValid};
+    assign masterWriteValid      = {dmaAxiWriteValid && dmaAxiWriteValidData, cpuAxiWriteValid && cpuAxiWriteValidData};
+    assign masterReadReadyData   = {dmaAxiReadReadyData, cpuAxiReadReadyData};
+
+    always_comb begin
+        for (int m = 0; m < 2; m++) begin
+            masterReadTarget[m]  = decodeSlave(masterReadAddress[m]);
+            masterWriteTarget[m] = decodeSlave(masterWriteAddress[m]);
+        end
     end
 
-    // --- 2. MASTER MUX ---
-    // Routes signals from the active master to the internal bus
-    logic [31:0] currAddr_R, currAddr_W, currData_W;
-    logic        currValid_R, currValid_W;
+    // --- 2. WRITE CHANNEL (RAM & MMIO ports) ---
+    // Writes are posted: a write completes when the granted slave raises Ready (slaves such as the
+    // D-cache write buffer absorb several in-flight stores). Writes to ROM are discarded at once.
+    // A conditional write without a matching reservation (any target but RAM never has one) is
+    // dropped here and completes at once with cpuAxiWriteFail.
+    logic       ramWriteCpuRequest, ramWriteDmaRequest, ramWriteGrantValid, ramWriteGrantDma, ramWriteAccepted;
+    logic       ioWriteCpuRequest,  ioWriteDmaRequest,  ioWriteGrantValid,  ioWriteGrantDma,  ioWriteAccepted;
+    logic       reservationValid   [0:1];
+    logic [29:0] reservationAddress [0:1];
+    logic       cpuWriteReserved, cpuWriteFail;
 
+    assign cpuWriteReserved = (masterWriteTarget[0] == SLAVE_RAM) && reservationValid[cpuAxiWriteHart] &&
+                              (reservationAddress[cpuAxiWriteHart] == cpuAxiWriteAddress[31:2]);
+    assign cpuWriteFail     = masterWriteValid[0] && cpuAxiWriteConditional && !cpuWriteReserved;
+    assign cpuAxiWriteFail  = cpuWriteFail;
+
+    assign ramWriteCpuRequest = masterWriteValid[0] && (masterWriteTarget[0] == SLAVE_RAM) && !cpuWriteFail;
+    assign ramWriteDmaRequest = masterWriteValid[1] && (masterWriteTarget[1] == SLAVE_RAM);
+    assign ioWriteCpuRequest  = masterWriteValid[0] && (masterWriteTarget[0] == SLAVE_IO) && !cpuWriteFail;
+    assign ioWriteDmaRequest  = masterWriteValid[1] && (masterWriteTarget[1] == SLAVE_IO);
+
+    bus_arbiter #(.dmaWeight(dmaWeight)) u_ram_write_arbiter (
+        .clock(clock), .resetActiveLow(resetActiveLow),
+        .cpuRequest(ramWriteCpuRequest), .dmaRequest(ramWriteDmaRequest), .grantAccepted(ramWriteAccepted),
+        .grantValid(ramWriteGrantValid), .grantDma(ramWriteGrantDma)
+    );
+
+    bus_arbiter #(.dmaWeight(dmaWeight)) u_io_write_arbiter (
+        .clock(clock), .resetActiveLow(resetActiveLow),
+        .cpuRequest(ioWriteCpuRequest), .dmaRequest(ioWriteDmaRequest), .grantAccepted(ioWriteAccepted),
+        .grantValid(ioWriteGrantValid), .grantDma(ioWriteGrantDma)
+    );
+
+    assign ramAxiWriteValid     = ramWriteGrantValid;
+    assign ramAxiWriteValidData = ramWriteGrantValid;
+    assign ramAxiWriteAddress   = masterWriteAddress[ramWriteGrantDma];
+    assign ramAxiWriteData      = masterWriteData[ramWriteGrantDma];
+    assign ramWriteAccepted     = ramWriteGrantValid && ramAxiWriteReady && ramAxiWriteReadyData;
+
+    assign ioAxiWriteValid      = ioWriteGrantValid;
+    assign ioAxiWriteValidData  = ioWriteGrantValid;
+    assign ioAxiWriteAddress    = masterWriteAddress[ioWriteGrantDma];
+    assign ioAxiWriteData       = masterWriteData[ioWriteGrantDma];
+    assign ioWriteAccepted      = ioWriteGrantValid && ioAxiWriteReady && ioAxiWriteReadyData;
+
+    logic [1:0] masterWriteReady;
     always_comb begin
-        if (activeMasterReg == 0) begin // CPU
-            currAddr_R  = cpuAxiReadAddress;  currValid_R = cpuAxiReadValid;
-            currAddr_W  = cpuAxiWriteAddress; currValid_W = cpuAxiWriteValid;
-            currData_W  = cpuAxiWriteData;
-        end else begin                 // DMA
-            currAddr_R  = dmaAxiReadAddress;  currValid_R = dmaAxiReadValid;
-            currAddr_W  = dmaAxiWriteAddress; currValid_W = dmaAxiWriteValid;
-            currData_W  = dmaAxiWriteData;
+        for (int m = 0; m < 2; m++) begin
+            case (masterWriteTarget[m])
+                SLAVE_RAM: masterWriteReady[m] = ramWriteAccepted && (ramWriteGrantDma == 1'(m));
+                SLAVE_IO:  masterWriteReady[m] = ioWriteAccepted  && (ioWriteGrantDma  == 1'(m));
+                default:   masterWriteReady[m] = 1'b1;
+            endcase
+        end
+    end
+
+    assign cpuAxiWriteReady = masterWriteReady[0] || cpuWriteFail; assign cpuAxiWriteReadyData = cpuAxiWriteReady;
+    assign dmaAxiWriteReady = masterWriteReady[1]; assign dmaAxiWriteReadyData = masterWriteReady[1];
+
+    // --- 3. READ ADDRESS CHANNEL (ROM, RAM & MMIO ports) ---
+    // A read is issued only if both the master and the target slave have a free tracking slot,
+    // which also guarantees room to buffer the response (slave ReadReadyData is never withheld).
+
+    // Per-master issue order (slave IDs) and per-slave ownership (master IDs), oldest at head
+    logic [1:0]          orderSlave  [0:1][0:maxOutstanding-1];
+    logic [PTR_BITS-1:0] orderHead   [0:1];
+    logic [PTR_BITS-1:0] orderTail   [0:1];
+    logic [PTR_BITS:0]   orderCount  [0:1];
+
+    logic                ownerMaster [0:2][0:maxOutstanding-1];
+    logic [PTR_BITS-1:0] ownerHead   [0:2];
+    logic [PTR_BITS-1:0] ownerTail   [0:2];
+    logic [PTR_BITS:0]   ownerCount  [0:2];
+
+    // Per-slave response buffer for data that returned before its master could take it
+    logic [31:0]         respData    [0:2][0:maxOutstanding-1];
+    logic [PTR_BITS-1:0] respHead    [0:2];
+    logic [PTR_BITS-1:0] respTail    [0:2];
+    logic [PTR_BITS:0]   respCount   [0:2];
+
+    logic [2:0]  readCpuRequest, readDmaRequest, readGrantValid, readGrantDma, readIssue, readAccepted;
+    logic [2:0]  slaveReadReady, slaveReadValidData;
+    logic [31:0] slaveReadData [0:2];
+
+    assign slaveReadReady     = {ioAxiReadReady, ramAxiReadReady, romAxiReadReady};
+    assign slaveReadValidData = {ioAxiReadValidData, ramAxiReadValidData, romAxiReadValidData};
+    assign slaveReadData[SLAVE_ROM] = romAxiReadData;
+    assign slaveReadData[SLAVE_RAM] = ramAxiReadData;
+    assign slaveReadData[SLAVE_IO]  = ioAxiReadData;
+
+    always_comb begin
+        for (int s = 0; s < 3; s++) begin
+            readCpuRequest[s] = masterReadValid[0] && (masterReadTarget[0] == 2'(s)) && (orderCount[0] != maxOutstanding);
+            readDmaRequest[s] = masterReadValid[1] && (masterReadTarget[1] == 2'(s)) && (orderCount[1] != maxOutstanding);
+            readIssue[s]      = readGrantValid[s] && (ownerCount[s] != maxOutstanding);
+            readAccepted[s]   = readIssue[s] && slaveReadReady[s];
+        end
+    end
+
+    genvar g;
+    generate
+        for (g = 0; g < 3; g++) begin : gen_read_arbiter
+            bus_arbiter #(.dmaWeight(dmaWeight)) u_read_arbiter (
+                .clock(clock), .resetActiveLow(resetActiveLow),
+                .cpuRequest(readCpuRequest[g]), .dmaRequest(readDmaRequest[g]), .grantAccepted(readAccepted[g]),
+                .grantValid(readGrantValid[g]), .grantDma(readGrantDma[g])
+            );
         end
+    endgenerate
+
+    assign romAxiReadAddress = masterReadAddress[readGrantDma[SLAVE_ROM]]; assign romAxiReadValid = readIssue[SLAVE_ROM];
+    assign ramAxiReadAddress = masterReadAddress[readGrantDma[SLAVE_RAM]]; assign ramAxiReadValid = readIssue[SLAVE_RAM];
+    assign ioAxiReadAddress  = masterReadAddress[readGrantDma[SLAVE_IO]];  assign ioAxiReadValid  = readIssue[SLAVE_IO];
+
+    // Master m issued this cycle if its target slave accepted it from m
+    logic [1:0] masterIssued;
+    always_comb begin
+        for (int m = 0; m < 2; m++)
+            masterIssued[m] = readAccepted[masterReadTarget[m]] && (readGrantDma[masterReadTarget[m]] == 1'(m));
     end
 
-    // --- 3. SLAVE ROUTING & DECODING ---
+    assign cpuAxiReadReady = masterIssued[0];
+    assign dmaAxiReadReady = masterIssued[1];
+
+    assign romAxiReadReadyData = 1'b1;
+    assign ramAxiReadReadyData = 1'b1;
+    assign ioAxiReadReadyData  = 1'b1;
+
+    // --- 4. READ DATA CHANNEL (In-Order Return) ---
+    // Each master takes data only from the slave at the head of its issue order, and only once that
+    // slave's oldest response belongs to it. Zero-wait slaves bypass the buffers in the issue cycle.
+    logic        liveOwnerValid [0:2];
+    logic        liveOwner      [0:2];
+    logic        headSlaveValid [0:1];
+    logic [1:0]  headSlave      [0:1];
+    logic        deliverValid   [0:1];
+    logic [31:0] deliverData    [0:1];
+    logic        deliverFire    [0:1];
+    logic [2:0]  slaveDelivered;
+
     always_comb begin
-        // Initialize handshakes & outputs to prevent latches
-        cpuAxiWriteReady = 1'b1; cpuAxiWriteReadyData = 1'b1; cpuAxiReadReady = 1'b1;
-        dmaAxiWriteReady = 1'b1; dmaAxiWriteReadyData = 1'b1; dmaAxiReadReady = 1'b1;
-        
-        cpuAxiReadData   = 32'h0; dmaAxiReadData   = 32'h0;
-        ramAxiWriteValid = 0;     ioAxiWriteValid  = 0; 
-        romAxiReadValid  = 0;     ramAxiReadValid  = 0;    ioAxiReadValid  = 0;
-
-        // Broadcast current master lines to all slave address/data ports
-        ramAxiWriteAddress = currAddr_W; ramAxiWriteData = currData_W;
-        ioAxiWriteAddress  = currAddr_W; ioAxiWriteData  = currData_W;
-        ramAxiReadAddress  = currAddr_R; ioAxiReadAddress = currAddr_R;
-        romAxiReadAddress  = currAddr_R;
-
-        // Write Demux (Decoded by Bits [30:29])
-        if (currValid_W) begin
-            if (currAddr_W[30])      ioAxiWriteValid  = 1; // MMIO (0x4000_0000)
-            else if (currAddr_W[29]) ramAxiWriteValid = 1; // RAM  (0x2000_0000)
+        for (int s = 0; s < 3; s++) begin
+            if (ownerCount[s] != 0) begin
+                liveOwnerValid[s] = 1;
+                liveOwner[s]      = ownerMaster[s][ownerHead[s]];
+            end else begin
+                liveOwnerValid[s] = readAccepted[s];
+                liveOwner[s]      = readGrantDma[s];
+            end
         end
 
-        // Read Demux (Decoded by Bits [30:29])
-        if (currValid_R) begin
-            if (currAddr_R[30]) begin // MMIO
-                ioAxiReadValid = 1;
-                if (!activeMasterReg) cpuAxiReadData = ioAxiReadData; else dmaAxiReadData = ioAxiReadData;
-            end else if (currAddr_R[29]) begin // RAM
-                ramAxiReadValid = 1;
-                if (!activeMasterReg) cpuAxiReadData = ramAxiReadData; else dmaAxiReadData = ramAxiReadData;
-            end else begin // ROM (0x0000_0000)
-                romAxiReadValid = 1;
-                if (!activeMasterReg) cpuAxiReadData = romAxiReadData; else dmaAxiReadData = 32'h0;
+        slaveDelivered = 3'b000;
+        for (int m = 0; m < 2; m++) begin
+            headSlaveValid[m] = (orderCount[m] != 0) || masterIssued[m];
+            headSlave[m]      = (orderCount[m] != 0) ? orderSlave[m][orderHead[m]] : masterReadTarget[m];
+            deliverValid[m]   = 0;
+            deliverData[m]    = 32'h0;
+
+            if (headSlaveValid[m]) begin
+                if (respCount[headSlave[m]] != 0) begin
+                    deliverValid[m] = (ownerMaster[headSlave[m]][ownerHead[headSlave[m]]] == 1'(m));
+                    deliverData[m]  = respData[headSlave[m]][respHead[headSlave[m]]];
+                end else begin
+                    deliverValid[m] = slaveReadValidData[headSlave[m]] && liveOwnerValid[headSlave[m]] &&
+                                      (liveOwner[headSlave[m]] == 1'(m));
+                    deliverData[m]  = slaveReadData[headSlave[m]];
+                end
             end
+
+            deliverFire[m] = deliverValid[m] && masterReadReadyData[m];
+            if (deliverFire[m]) slaveDelivered[headSlave[m]] = 1'b1;
         end
     end
 
-    // --- 4. STATIC AXI CONTROL FLAGS ---
-    assign cpuAxiReadValidData  = 1'b1;
-    assign dmaAxiReadValidData  = 1'b1;
-    assign ramAxiWriteValidData = 1'b1;
-    assign ioAxiWriteValidData  = 1'b1;
-    assign romAxiReadReadyData  = 1'b1;
-    assign ramAxiReadReadyData  = 1'b1;
-    assign ioAxiReadReadyData   = 1'b1;
+    assign cpuAxiReadValidData = deliverValid[0]; assign cpuAxiReadData = deliverData[0];
+    assign dmaAxiReadValidData = deliverValid[1]; assign dmaAxiReadData = deliverData[1];
+
+    // --- 5. TRACKING STATE ---
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            for (int m = 0; m < 2; m++) begin
+                orderHead[m] <= 0; orderTail[m] <= 0; orderCount[m] <= 0;
+            end
+            for (int s = 0; s < 3; s++) begin
+                ownerHead[s] <= 0; ownerTail[s] <= 0; ownerCount[s] <= 0;
+                respHead[s]  <= 0; respTail[s]  <= 0; respCount[s]  <= 0;
+            end
+        end else begin
+            for (int m = 0; m < 2; m++) begin
+                if (masterIssued[m]) begin
+                    orderSlave[m][orderTail[m]] <= masterReadTarget[m];
+                    orderTail[m]                <= orderTail[m] + 1;
+                end
+                if (deliverFire[m]) orderHead[m] <= orderHead[m] + 1;
+                orderCount[m] <= orderCount[m] + (masterIssued[m] ? 1 : 0) - (deliverFire[m] ? 1 : 0);
+            end
+
+            for (int s = 0; s < 3; s++) begin
+                logic respPush, respPop;
+                respPop  = slaveDelivered[s] && (respCount[s] != 0);
+                // Data with no read outstanding on the slave has no owner and is dropped
+                respPush = slaveReadValidData[s] && liveOwnerValid[s] && !(slaveDelivered[s] && (respCount[s] == 0));
+
+                if (readAccepted[s]) begin
+                    ownerMaster[s][ownerTail[s]] <= readGrantDma[s];
+                    ownerTail[s]                 <= ownerTail[s] + 1;
+                end
+                if (slaveDelivered[s]) ownerHead[s] <= ownerHead[s] + 1;
+                ownerCount[s] <= ownerCount[s] + (readAccepted[s] ? 1 : 0) - (slaveDelivered[s] ? 1 : 0);
+
+                if (respPush) begin
+                    respData[s][respTail[s]] <= slaveReadData[s];
+                    respTail[s]              <= respTail[s] + 1;
+                end
+                if (respPop) respHead[s] <= respHead[s] + 1;
+                respCount[s] <= respCount[s] + (respPush ? 1 : 0) - (respPop ? 1 : 0);
+            end
+        end
+    end
+
+    // --- 6. RESERVATIONS (LR.W / SC.W / AMO) ---
+    // One reserved word per hart, set when its reserving read is accepted by RAM. Any RAM write to the
+    // word (either master, either hart) clears it, and so does the hart's own conditional write.
+    // A write to the word accepted in the same cycle as the reserving read wins.
+    logic reserveSet;
+    assign reserveSet = readAccepted[SLAVE_RAM] && !readGrantDma[SLAVE_RAM] && cpuAxiReadReserve;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            for (int h = 0; h < 2; h++) begin
+                reservationValid[h]   <= 0;
+                reservationAddress[h] <= 30'b0;
+            end
+        end else begin
+            for (int h = 0; h < 2; h++) begin
+                if (reserveSet && (cpuAxiReadHart == 1'(h))) begin
+                    reservationAddress[h] <= cpuAxiReadAddress[31:2];
+                    reservationValid[h]   <= !(ramWriteAccepted && (ramAxiWriteAddress[31:2] == cpuAxiReadAddress[31:2]));
+                end else if ((ramWriteAccepted && (ramAxiWriteAddress[31:2] == reservationAddress[h])) ||
+                             (masterWriteValid[0] && cpuAxiWriteConditional && cpuAxiWriteReady &&
+                              (cpuAxiWriteHart == 1'(h)))) begin
+                    reservationValid[h] <= 0;
+                end
+            end
+        end
+    end
 
 endmodule
\ No newline at end of file
@@ -0,0 +1,108 @@
+module bus_master_mux #(
+    parameter maxOutstanding = 2 // Reads in flight through the mux (each hart keeps at most one)
+) (
+    input  logic        clock,
+    input  logic        resetActiveLow,
+
+    // HART 0 / HART 1 (write data is presented with the address)
+    input  logic [31:0] hart0WriteAddress, input  logic hart0WriteValid, output logic hart0WriteReady,
+    input  logic [31:0] hart0WriteData,
+    input  logic [31:0] hart0ReadAddress,  input  logic hart0ReadValid,  output logic hart0ReadReady,
+    output logic [31:0] hart0ReadData,     output logic hart0ReadValidData,
+    input  logic        hart0ReadReserve,  input  logic hart0WriteConditional, output logic hart0WriteFail,
+
+    input  logic [31:0] hart1WriteAddress, input  logic hart1WriteValid, output logic hart1WriteReady,
+    input  logic [31:0] hart1WriteData,
+    input  logic [31:0] hart1ReadAddress,  input  logic hart1ReadValid,  output logic hart1ReadReady,
+    output logic [31:0] hart1ReadData,     output logic hart1ReadValidData,
+    input  logic        hart1ReadReserve,  input  logic hart1WriteConditional, output logic hart1WriteFail,
+
+    // Shared master port (bus_interconnect CPU port)
+    output logic [31:0] busWriteAddress,   output logic busWriteValid,   input  logic busWriteReady,
+    output logic [31:0] busWriteData,
+    output logic [31:0] busReadAddress,    output logic busReadValid,    input  logic busReadReady,
+    input  logic [31:0] busReadData,       input  logic busReadValidData,
+    // Reservation sideband: the granted hart's ID travels with its reserving read / conditional write
+    output logic        busReadReserve,    output logic busReadHart,
+    output logic        busWriteConditional, output logic busWriteHart, input logic busWriteFail,
+
+    output logic [31:0] contentionCycles   // Cycles in which both harts wanted the same channel
+);
+
+    // Merges the two harts' data ports into one interconnect master port. Each channel has its own
+    // round-robin arbiter (bus_arbiter with weight 1); read data returns in issue order, so a small
+    // FIFO of hart IDs routes every response back to the hart that issued it.
+    localparam PTR_BITS = (maxOutstanding > 1) ? $clog2(maxOutstanding) : 1;
+
+    // --- 1. WRITE CHANNEL ---
+    logic writeGrantValid, writeGrantHart1, writeAccepted;
+
+    bus_arbiter #(.dmaWeight(1)) u_write_arbiter (
+        .clock(clock), .resetActiveLow(resetActiveLow),
+        .cpuRequest(hart0WriteValid), .dmaRequest(hart1WriteValid), .grantAccepted(writeAccepted),
+        .grantValid(writeGrantValid), .grantDma(writeGrantHart1)
+    );
+
+    assign busWriteValid   = writeGrantValid;
+    assign busWriteAddress = writeGrantHart1 ? hart1WriteAddress : hart0WriteAddress;
+    assign busWriteData    = writeGrantHart1 ? hart1WriteData    : hart0WriteData;
+    assign writeAccepted   = writeGrantValid && busWriteReady;
+    assign hart0WriteReady = writeAccepted && !writeGrantHart1;
+    assign hart1WriteReady = writeAccepted && writeGrantHart1;
+
+    assign busWriteConditional = writeGrantHart1 ? hart1WriteConditional : hart0WriteConditional;
+    assign busWriteHart        = writeGrantHart1;
+    assign hart0WriteFail      = busWriteFail; // Qualified by the hart's WriteReady
+    assign hart1WriteFail      = busWriteFail;
+
+    // --- 2. READ ADDRESS CHANNEL ---
+    logic readGrantValid, readGrantHart1, readAccepted;
+    logic                ownerHart [0:maxOutstanding-1];
+    logic [PTR_BITS-1:0] ownerHead, ownerTail;
+    logic [PTR_BITS:0]   ownerCount;
+
+    bus_arbiter #(.dmaWeight(1)) u_read_arbiter (
+        .clock(clock), .resetActiveLow(resetActiveLow),
+        .cpuRequest(hart0ReadValid), .dmaRequest(hart1ReadValid), .grantAccepted(readAccepted),
+        .grantValid(readGrantValid), .grantDma(readGrantHart1)
+    );
+
+    assign busReadValid   = readGrantValid && (ownerCount != maxOutstanding);
+    assign busReadAddress = readGrantHart1 ? hart1ReadAddress : hart0ReadAddress;
+    assign readAccepted   = busReadValid && busReadReady;
+    assign hart0ReadReady = readAccepted && !readGrantHart1;
+    assign hart1ReadReady = readAccepted && readGrantHart1;
+    assign busReadReserve = readGrantHart1 ? hart1ReadReserve : hart0ReadReserve;
+    assign busReadHart    = readGrantHart1;
+
+    // --- 3. READ DATA CHANNEL ---
+    // Data in the issue cycle (zero-wait slave) belongs to the read just accepted
+    logic responseOwner, responseValid;
+
+    assign responseValid      = busReadValidData && ((ownerCount != 0) || readAccepted);
+    assign responseOwner      = (ownerCount != 0) ? ownerHart[ownerHead] : readGrantHart1;
+    assign hart0ReadData      = busReadData;
+    assign hart1ReadData      = busReadData;
+    assign hart0ReadValidData = responseValid && !responseOwner;
+    assign hart1ReadValidData = responseValid && responseOwner;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            ownerHead        <= 0;
+            ownerTail        <= 0;
+            ownerCount       <= 0;
+            contentionCycles <= 32'b0;
+        end else begin
+            if (readAccepted) begin
+                ownerHart[ownerTail] <= readGrantHart1;
+                ownerTail            <= ownerTail + 1;
+            end
+            if (responseValid) ownerHead <= ownerHead + 1;
+            ownerCount <= ownerCount + (readAccepted ? 1 : 0) - (responseValid ? 1 : 0);
+
+            if ((hart0WriteValid && hart1WriteValid) || (hart0ReadValid && hart1ReadValid))
+                contentionCycles <= contentionCycles + 1;
+        end
+    end
+
+endmodule
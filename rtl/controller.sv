@@ -1,7 +1,10 @@
-module controller (
+module controller #(
+    parameter hasFpu = 1 // 0: the RV32F opcodes raise an illegal-instruction trap
+) (
     input  logic [6:0] opcode,
     input  logic [2:0] funct3,
     input  logic [6:0] funct7,
+    input  logic [4:0] rs2Field,            // Zbb unary ops (CLZ/CTZ/CPOP/SEXT, ZEXT.H, ORC.B/REV8), ECALL vs EBREAK
     input  logic       timerInterrupt,      // Preemption signal from hardware timer
 
     output logic       registerWriteEnable, // Enables register file updates
@@ -9,13 +12,18 @@ module controller (
     output logic       memoryWriteEnable,   // Enables RAM/MMIO writes
     output logic       resultSource,        // 0: ALU result, 1: memory data
     output logic       isBranch,            // High for Jumps/Branches
-    output logic [2:0] aluControlSignal,    // 3-bit opcode for the ALU
+    output logic [4:0] aluControlSignal,    // 5-bit opcode for the ALU
     output logic       csrWriteEnable,      // Captures current PC to MEPC on traps
-    output logic       isTrap,              // High forces jump to 0x00000010
-    output logic       isReturn             // High forces jump to MEPC (MRET)
+    output logic       isTrap,              // High forces jump to MTVEC (interrupt, ECALL or illegal instruction)
+    output logic       isIllegal,           // Trap cause: an RV32F instruction on a hart built without the FPU
+    output logic       isReturn,            // High forces jump to MEPC (MRET)
+    output logic       isAtomic,            // RV32A: LR.W (load), SC.W and AMOs (store + write-back)
+    output logic       isFloat,             // RV32F compute instruction for the FPU
+    output logic       fpRegisterWriteEnable // Enables FP register file updates (FLW, FPU results)
 );
 
     logic [1:0] aluOperationCategory;
+    logic       floatValid, floatWritesInteger;
 
     // --- 1. MAIN INSTRUCTION DECODER ---
     always_comb begin
@@ -28,7 +36,11 @@ module controller (
         aluOperationCategory = 2'b00;
         csrWriteEnable       = 0;
         isTrap               = 0;
+        isIllegal            = 0;
         isReturn             = 0;
+        isAtomic             = 0;
+        isFloat              = 0;
+        fpRegisterWriteEnable = 0;
 
         // Hardware Preemption: Timer takes absolute priority over decoding
         if (timerInterrupt) begin
@@ -55,17 +67,80 @@ module controller (
                     memoryWriteEnable    = 1;
                     aluInputSource       = 1;
                 end
-                7'b1100011: begin // BEQ
+                7'b0101111: begin // AMO (address is rs1: imm_gen gives 0). funct5 00010 = LR.W
+                    if (funct3 == 3'b010) begin
+                        isAtomic             = 1;
+                        registerWriteEnable  = 1;
+                        aluInputSource       = 1;
+                        resultSource         = (funct7[6:2] == 5'b00010);
+                        memoryWriteEnable    = (funct7[6:2] != 5'b00010);
+                    end
+                end
+                // RV32F: without the FPU, every encoding the FPU build executes traps instead
+                7'b0000111: begin // FLW (f[rd] from memory)
+                    if (funct3 == 3'b010) begin
+                        if (hasFpu) begin
+                            fpRegisterWriteEnable = 1;
+                            aluInputSource       = 1;
+                            resultSource         = 1;
+                        end else begin
+                            isIllegal        = 1;
+                        end
+                    end
+                end
+                7'b0100111: begin // FSW (store data from f[rs2])
+                    if (funct3 == 3'b010) begin
+                        if (hasFpu) begin
+                            memoryWriteEnable    = 1;
+                            aluInputSource       = 1;
+                        end else begin
+                            isIllegal        = 1;
+                        end
+                    end
+                end
+                7'b1010011: begin // OP-FP
+                    if (floatValid) begin
+                        if (hasFpu) begin
+                            isFloat              = 1;
+                            registerWriteEnable  = floatWritesInteger;
+                            fpRegisterWriteEnable = !floatWritesInteger;
+                        end else begin
+                            isIllegal        = 1;
+                        end
+                    end
+                end
+                7'b1000011, 7'b1000111, 7'b1001011, 7'b1001111: begin // FMADD FMSUB FNMSUB FNMADD
+                    if (funct7[1:0] == 2'b00) begin
+                        if (hasFpu) begin
+                            isFloat              = 1;
+                            fpRegisterWriteEnable = 1;
+                        end else begin
+                            isIllegal        = 1;
+                        end
+                    end
+                end
+                7'b1100011: begin // BRANCH (condition resolved in the datapath)
                     isBranch             = 1;
                     aluOperationCategory = 2'b01; // Force SUB for comparison
                 end
-                7'b1110011: begin // MRET
-                    isReturn             = 1;
+                7'b1110011: begin // SYSTEM: MRET (funct7 0011000) or ECALL; other encodings are NOPs
+                    // EBREAK (rs2 field 1, also C.EBREAK) is one of those NOPs: there is no debugger
+                    // to trap to, and the kernel's handlers would treat any trap as a yield
+                    if (funct3 == 3'b000 && funct7 == 7'b0011000) begin
+                        isReturn         = 1;
+                    end else if (funct3 == 3'b000 && funct7 == 7'b0000000 && rs2Field == 5'd0) begin
+                        isTrap           = 1;
+                        csrWriteEnable   = 1;
+                    end
                 end
                 7'b0110111: begin // LUI
                     registerWriteEnable  = 1;
                     aluInputSource       = 1;
                 end
+                7'b0010111: begin // AUIPC (operand A is the PC)
+                    registerWriteEnable  = 1;
+                    aluInputSource       = 1;
+                end
                 7'b1101111: begin // JAL
                     registerWriteEnable  = 1;
                     isBranch             = 1;
@@ -78,26 +153,98 @@ module controller (
                 end
                 default: ; // Defaults handled above
             endcase
+
+            if (isIllegal) begin
+                isTrap           = 1;
+                csrWriteEnable   = 1;
+            end
         end
     end
 
     // --- 2. ALU OPERATION DECODER ---
+    // RV32I uses funct7[5] only (SUB/SRA). Zba/Zbb encodings are matched on the whole funct7
+    // (and rs2 for the unary ops); anything else decodes as the RV32I operation of its funct3.
+    logic isRegister;
+    logic [4:0] baseControl;
+
+    assign isRegister = (opcode == 7'b0110011);
+
+    always_comb begin
+        case (funct3)
+            3'b000:  baseControl = (isRegister && funct7[5]) ? 5'b00001 : 5'b00000; // SUB / ADD
+            3'b001:  baseControl = 5'b00111; // SLL
+            3'b010:  baseControl = 5'b00101; // SLT
+            3'b011:  baseControl = 5'b00110; // SLTU
+            3'b100:  baseControl = 5'b00100; // XOR
+            3'b101:  baseControl = funct7[5] ? 5'b01001 : 5'b01000; // SRA / SRL (SRAI: imm[10])
+            3'b110:  baseControl = 5'b00011; // OR
+            3'b111:  baseControl = 5'b00010; // AND
+            default: baseControl = 5'b00000;
+        endcase
+    end
+
     always_comb begin
         case (aluOperationCategory)
-            2'b00: aluControlSignal = 3'b000; // Force ADD
-            2'b01: aluControlSignal = 3'b001; // Force SUB
-            2'b10: begin 
-                case (funct3)
-                    3'b000:  aluControlSignal = (opcode == 7'b0110011 && funct7[5]) ? 3'b001 : 3'b000;
-                    3'b010:  aluControlSignal = 3'b101; // SLT
-                    3'b110:  aluControlSignal = 3'b011; // OR 
-                    3'b111:  aluControlSignal = 3'b010; // AND
-                    3'b100:  aluControlSignal = 3'b100; // XOR
-                    default: aluControlSignal = 3'b000;
-                endcase
+            2'b00: aluControlSignal = 5'b00000; // Force ADD
+            2'b01: aluControlSignal = 5'b00001; // Force SUB
+            2'b10: begin
+                aluControlSignal = baseControl;
+                if (isRegister) begin
+                    case ({funct7, funct3})
+                        {7'b0010000, 3'b010}: aluControlSignal = 5'b01010; // SH1ADD
+                        {7'b0010000, 3'b100}: aluControlSignal = 5'b01011; // SH2ADD
+                        {7'b0010000, 3'b110}: aluControlSignal = 5'b01100; // SH3ADD
+                        {7'b0100000, 3'b111}: aluControlSignal = 5'b01101; // ANDN
+                        {7'b0100000, 3'b110}: aluControlSignal = 5'b01110; // ORN
+                        {7'b0100000, 3'b100}: aluControlSignal = 5'b01111; // XNOR
+                        {7'b0000101, 3'b100}: aluControlSignal = 5'b10110; // MIN
+                        {7'b0000101, 3'b110}: aluControlSignal = 5'b10111; // MAX
+                        {7'b0000101, 3'b101}: aluControlSignal = 5'b11000; // MINU
+                        {7'b0000101, 3'b111}: aluControlSignal = 5'b11001; // MAXU
+                        {7'b0110000, 3'b001}: aluControlSignal = 5'b11010; // ROL
+                        {7'b0110000, 3'b101}: aluControlSignal = 5'b11011; // ROR
+                        {7'b0000100, 3'b100}: if (rs2Field == 5'd0) aluControlSignal = 5'b10101; // ZEXT.H
+                        default: ;
+                    endcase
+                end else begin
+                    case ({funct7, funct3})
+                        {7'b0110000, 3'b001}: // CLZ / CTZ / CPOP / SEXT.B / SEXT.H (operation in rs2)
+                            case (rs2Field)
+                                5'd0:    aluControlSignal = 5'b10000;
+                                5'd1:    aluControlSignal = 5'b10001;
+                                5'd2:    aluControlSignal = 5'b10010;
+                                5'd4:    aluControlSignal = 5'b10011;
+                                5'd5:    aluControlSignal = 5'b10100;
+                                default: ;
+                            endcase
+                        {7'b0110000, 3'b101}: aluControlSignal = 5'b11011; // RORI
+                        {7'b0010100, 3'b101}: if (rs2Field == 5'd7)  aluControlSignal = 5'b11100; // ORC.B
+                        {7'b0110100, 3'b101}: if (rs2Field == 5'd24) aluControlSignal = 5'b11101; // REV8
+                        default: ;
+                    endcase
+                end
             end
-            default: aluControlSignal = 3'b000;
+            default: aluControlSignal = 5'b00000;
         endcase
     end
 
+    // --- 3. RV32F DECODER ---
+    // Single precision only (fmt 00). OP-FP encodings this core executes, by funct5;
+    // compares, FCLASS/FMV.X.W and FCVT.W[U].S write x[rd], everything else f[rd].
+    always_comb begin
+        floatValid = 0;
+        if (funct7[1:0] == 2'b00) begin
+            case (funct7[6:2])
+                5'h00, 5'h01, 5'h02, 5'h03, 5'h0B: floatValid = 1;              // FADD FSUB FMUL FDIV FSQRT
+                5'h04, 5'h14:                      floatValid = (funct3 <= 3'd2); // FSGNJ[N/X], FLE/FLT/FEQ
+                5'h05, 5'h1C:                      floatValid = (funct3 <= 3'd1); // FMIN/FMAX, FMV.X.W/FCLASS
+                5'h18, 5'h1A:                      floatValid = (rs2Field <= 5'd1); // FCVT.W[U].S, FCVT.S.W[U]
+                5'h1E:                             floatValid = (funct3 == 3'd0); // FMV.W.X
+                default: ;
+            endcase
+        end
+    end
+
+    assign floatWritesInteger = (funct7[6:2] == 5'h14) || (funct7[6:2] == 5'h18) || (funct7[6:2] == 5'h1C);
+
 endmodule
\ No newline at end of file
@@ -0,0 +1,416 @@
+module cpu_core #(
+    parameter hartId = 0, // Read back at 0x4000001C
+    parameter hasFpu = 1  // RV32F unit (0: FP opcodes trap as illegal instructions, FCSR/FP_STATUS read 0)
+) (
+    input  logic        clock,            // CPU clock
+    input  logic        resetActiveLow,   // Hart reset (hart 1 is held here until started)
+    input  logic [31:0] timerLimit,       // Timer period minus 1 in CPU cycles
+    input  logic        externalEvent,    // Peripheral request pulse (latched until taken)
+    input  logic        softwareInterrupt, // MSIP level for this hart (0x40000030 + 4 * hartId)
+
+    // Instruction fetch (inst_mem, combinational)
+    output logic [31:0] fetchAddress,
+    input  logic [31:0] fetchData,        // 32 bits at the (halfword-aligned) PC
+
+    // Data master port (bus_master_mux / bus_interconnect CPU port)
+    output logic [31:0] busWriteAddress, output logic busWriteValid, input  logic busWriteReady,
+    output logic [31:0] busWriteData,
+    output logic [31:0] busReadAddress,  output logic busReadValid,  input  logic busReadReady,
+    input  logic [31:0] busReadData,     input  logic busReadValidData,
+    // RV32A sideband: the read sets this hart's reservation; the write only lands while it holds
+    output logic        busReadReserve,  output logic busWriteConditional, input  logic busWriteFail,
+
+    // Debug taps (soc_top_tb, commit trace)
+    output logic [31:0] programCounter,
+    output logic [31:0] instruction,      // Expanded: a compressed instruction shows as its RV32I form
+    output logic        isTrap,
+    output logic        isReturn,
+    output logic        memoryStall,
+    output logic        timerInterrupt,
+    output logic        externalInterrupt,
+    output logic [31:0] trapCause,
+    output logic [31:0] aluResult,
+    output logic [31:0] writeBackData,
+    output logic [31:0] cpuWriteData,
+    output logic        registerWriteEnable,
+    output logic        memoryWriteEnable,
+    output logic        resultSource,
+    output logic [31:0] perfInstret
+);
+
+    // One RV32IAFC (+Zba/Zbb) hart: fetch, decode, execute and write-back in a single CPU cycle, stalled by the
+    // data bus, by FP register hazards and by the FPU operations that finish in decode (pipelined
+    // FP operations write back after they retire). Trap state (MEPC/MCAUSE/MTVEC), the timer, the
+    // performance counters and the FP control/status registers are per hart and live in a
+    // hart-local window (0x40000010-0x4000002F) that never reaches the bus.
+
+    // --- 1. SYSTEM TIMER & INTERRUPTS ---
+    // The timer raises one request per period; it is taken (timerInterrupt, single cycle) at the
+    // first instruction boundary with no load or FPU operation in flight, so a trap never orphans
+    // a bus response, abandons a divide halfway or lands between an FP issue and its write-back.
+    // While a request waits, the FPU issues nothing new (fpuHold) so its pipeline drains.
+    logic [31:0] timerCount;
+    logic        timerPending, externalPending, cpuReadIssued, fpuInFlight, fpuHold;
+    logic        trapActive, interruptTaken, isIllegal;
+
+    // Machine interrupt causes reported through MCAUSE (0x40000014)
+    localparam CAUSE_SOFTWARE = 32'h80000003;
+    localparam CAUSE_TIMER    = 32'h80000007;
+    localparam CAUSE_EXTERNAL = 32'h8000000B;
+    localparam CAUSE_ILLEGAL  = 32'h00000002;
+    localparam CAUSE_ECALL    = 32'h0000000B;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            timerCount   <= 0;
+            timerPending <= 0;
+        end else begin
+            if (timerCount >= timerLimit) timerCount <= 0;
+            else                           timerCount <= timerCount + 1;
+
+            if (timerCount == timerLimit) timerPending <= 1;
+            else if (timerInterrupt)       timerPending <= 0;
+        end
+    end
+
+    // No trap is taken while a handler runs (trapActive, cleared by MRET), so MEPC is never
+    // overwritten by a nested trap. Priority: timer, then software (level, cleared by the handler
+    // through MSIP), then external.
+    assign interruptTaken    = (timerPending || softwareInterrupt || externalPending) && !cpuReadIssued && !fpuInFlight &&
+                               !trapActive;
+    assign fpuHold           = (timerPending || softwareInterrupt || externalPending) && !trapActive;
+    assign timerInterrupt    = interruptTaken && timerPending;
+    assign externalInterrupt = interruptTaken && !timerPending && !softwareInterrupt;
+    assign trapCause         = !interruptTaken ? (isIllegal ? CAUSE_ILLEGAL : CAUSE_ECALL) : timerPending ? CAUSE_TIMER :
+                               softwareInterrupt ? CAUSE_SOFTWARE : CAUSE_EXTERNAL;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            externalPending <= 0;
+            trapActive      <= 0;
+        end else begin
+            if (externalEvent)          externalPending <= 1;
+            else if (externalInterrupt) externalPending <= 0;
+
+            if (isTrap)        trapActive <= 1;
+            else if (isReturn) trapActive <= 0;
+        end
+    end
+
+    // --- 2. INSTRUCTION FETCH & PC LOGIC ---
+    // The PC is halfword-aligned: inst_mem returns the 32 bits starting at it, and rvc_expander
+    // turns a 16-bit instruction into its 32-bit form, so everything below decodes RV32I/A/F.
+    // The sequential PC (fall-through and the JAL/JALR link) steps by the instruction's length.
+    logic [31:0] nextProgramCounter, sequentialProgramCounter, immediateValue, mepcValue, mcauseValue, mtvecValue;
+    logic        isBranch, zeroFlag, branchTaken, isCompressed;
+    logic [31:0] readData1, readData2, fpReadData1, fpReadData2, fpReadData3, fpuResult;
+    logic [7:0]  fpControlStatus /* verilator public_flat */; // FCSR: {frm, fflags} (read by sim/soc_fuzz.cpp)
+    logic [4:0]  fpuFlags;
+    logic        fpDirty;
+
+    assign fetchAddress = programCounter;
+
+    rvc_expander u_rvc_expander (.fetchData(fetchData), .instruction(instruction), .isCompressed(isCompressed));
+
+    assign sequentialProgramCounter = programCounter + (isCompressed ? 32'd2 : 32'd4);
+
+    assign nextProgramCounter =
+        (isTrap || interruptTaken)      ? mtvecValue   :
+        isReturn                        ? mepcValue    :
+        (isBranch && (instruction[6:0] == 7'b1100111)) ? {aluResult[31:1], 1'b0} :
+        (isBranch && (branchTaken || (instruction[6:0] == 7'b1101111))) ? (programCounter + immediateValue) :
+                                          sequentialProgramCounter;
+
+    // Branch condition (the ALU subtracts, so BEQ/BNE use its zero flag)
+    always_comb begin
+        case (instruction[14:12])
+            3'b000:  branchTaken = zeroFlag;                                 // BEQ
+            3'b001:  branchTaken = !zeroFlag;                                // BNE
+            3'b100:  branchTaken = $signed(readData1) <  $signed(readData2); // BLT
+            3'b101:  branchTaken = $signed(readData1) >= $signed(readData2); // BGE
+            3'b110:  branchTaken = readData1 <  readData2;                   // BLTU
+            3'b111:  branchTaken = readData1 >= readData2;                   // BGEU
+            default: branchTaken = 1'b0;
+        endcase
+    end
+
+    // Hold the PC (and suppress write-back) while the data bus has not completed the access.
+    // Loads: address handshake (ReadValid/ReadReady), then wait for ReadValidData.
+    // Stores: held on WriteValid until the target slave raises WriteReady.
+    // SB/SH to memory: the bus moves whole words, so the word is read first (storeReadPhase)
+    // and the merged word is written back; MMIO takes the byte lanes directly. In RAM the read
+    // reserves the word and the write is conditional, like an AMO: if the other hart or the DMA
+    // wrote the word in between, the write fails and the store reads again instead of writing
+    // back stale bytes. (The store takes over this hart's LR.W reservation, so an SC.W after it fails.)
+    // Hart-local registers complete in the access cycle without a bus transfer.
+    // FPU: the instruction stays in decode until the unit has its result or its registers are
+    // written (fpuBusy); an FLW/FSW held by such a hazard starts no bus transfer. FCSR and
+    // FP_STATUS accesses wait for the pipeline to drain (fpCsrWait), so they see the flags and
+    // dirty bit of every FP instruction before them.
+    // Atomics: LR.W is a load that reserves the word. An AMO reads the word the same way (through
+    // the merge register) and writes the result conditionally; if another write took the word in
+    // between, the write fails and the AMO reads again. SC.W is a conditional store; it fails
+    // without a bus transfer once this hart has trapped since its LR.W.
+    logic isSubWordStore, isMergedStore, storeReadPhase, storeMergeValid, dataRead, dataWrite, localAccess, fpuBusy;
+    logic fpCsrWait;
+    logic isAtomic, isLoadReserved, isStoreConditional, isAmo, reservationArmed, conditionalFail;
+    logic [31:0] storeMergeWord, storeLaneData, storeSource, localReadData, amoResult;
+
+    assign isLoadReserved     = isAtomic && (instruction[31:27] == 5'b00010);
+    assign isStoreConditional = isAtomic && (instruction[31:27] == 5'b00011);
+    assign isAmo              = isAtomic && !isLoadReserved && !isStoreConditional;
+
+    assign localAccess    = (aluResult[31:6] == 26'h1000000) && (aluResult[5:4] == 2'b01 || aluResult[5:4] == 2'b10);
+    assign fpCsrWait      = localAccess && (aluResult[5:3] == 3'b101) && (resultSource || memoryWriteEnable) && fpuInFlight;
+    assign isSubWordStore = memoryWriteEnable && (instruction[13:12] != 2'b10);
+    assign isMergedStore  = isSubWordStore && !aluResult[30];
+    assign storeReadPhase = (isMergedStore || isAmo) && !storeMergeValid;
+    assign dataRead       = ((resultSource && !localAccess) || storeReadPhase) && !fpuBusy;
+    assign dataWrite      = memoryWriteEnable && !storeReadPhase && !localAccess &&
+                            !(isStoreConditional && !reservationArmed) && !fpuBusy;
+
+    // Reservations live in the RAM path of bus_interconnect; AMOs and merged stores elsewhere are
+    // plain read + write
+    assign busReadReserve      = isLoadReserved || isAmo || isMergedStore;
+    assign busWriteConditional = isStoreConditional || ((isAmo || isMergedStore) && aluResult[29] && !aluResult[30]);
+    assign conditionalFail     = isStoreConditional && (!reservationArmed || busWriteFail);
+
+    assign busReadValid = dataRead && !cpuReadIssued;
+    assign memoryStall  = (dataRead && !busReadValidData) || storeReadPhase || (dataWrite && !busWriteReady) ||
+                          ((isAmo || isMergedStore) && dataWrite && busWriteFail) || fpuBusy || fpCsrWait;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)                            reservationArmed <= 0;
+        else if (isTrap || (isStoreConditional && !memoryStall)) reservationArmed <= 0;
+        else if (isLoadReserved && !memoryStall)        reservationArmed <= 1;
+    end
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            storeMergeValid <= 0;
+            storeMergeWord  <= 32'b0;
+        end else if (interruptTaken || (dataWrite && busWriteReady)) begin
+            storeMergeValid <= 0;
+        end else if (storeReadPhase && busReadValidData) begin
+            storeMergeValid <= 1;
+            storeMergeWord  <= busReadData;
+        end
+    end
+
+    // FSW stores f[rs2]
+    assign storeSource = (instruction[6:0] == 7'b0100111) ? fpReadData2 : readData2;
+
+    always_comb begin
+        storeLaneData = (instruction[13:12] == 2'b00) ? {4{storeSource[7:0]}} :
+                        (instruction[13:12] == 2'b01) ? {2{storeSource[15:0]}} : storeSource;
+        cpuWriteData  = storeLaneData;
+        if (isMergedStore) begin
+            cpuWriteData = storeMergeWord;
+            if (instruction[13:12] == 2'b00) cpuWriteData[aluResult[1:0]*8 +: 8]  = storeSource[7:0];
+            else                             cpuWriteData[aluResult[1]*16 +: 16]  = storeSource[15:0];
+        end
+        if (isAmo) cpuWriteData = amoResult;
+    end
+
+    // AMO operation (funct5) on the word read (storeMergeWord) and rs2
+    always_comb begin
+        case (instruction[31:27])
+            5'b00001: amoResult = readData2;                                                        // AMOSWAP
+            5'b00100: amoResult = storeMergeWord ^ readData2;                                       // AMOXOR
+            5'b01000: amoResult = storeMergeWord | readData2;                                       // AMOOR
+            5'b01100: amoResult = storeMergeWord & readData2;                                       // AMOAND
+            5'b10000: amoResult = ($signed(storeMergeWord) < $signed(readData2)) ? storeMergeWord : readData2; // AMOMIN
+            5'b10100: amoResult = ($signed(storeMergeWord) < $signed(readData2)) ? readData2 : storeMergeWord; // AMOMAX
+            5'b11000: amoResult = (storeMergeWord < readData2) ? storeMergeWord : readData2;        // AMOMINU
+            5'b11100: amoResult = (storeMergeWord < readData2) ? readData2 : storeMergeWord;        // AMOMAXU
+            default:  amoResult = storeMergeWord + readData2;                                       // AMOADD
+        endcase
+    end
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)                   cpuReadIssued <= 0;
+        else if (busReadValidData)             cpuReadIssued <= 0;
+        else if (busReadValid && busReadReady) cpuReadIssued <= 1;
+    end
+
+    assign busWriteAddress = aluResult;
+    assign busWriteValid   = dataWrite;
+    assign busWriteData    = cpuWriteData;
+    assign busReadAddress  = aluResult;
+
+    pc_reg u_pc (
+        .clock(clock), .resetActiveLow(resetActiveLow), .enable(!memoryStall),
+        .nextProgramCounter(nextProgramCounter), .programCounter(programCounter)
+    );
+
+    // Performance counters (read-only, hart-local): CPU cycles (0x40000020) and retired
+    // instructions (0x40000024). An instruction retires when the PC advances past it; traps retire nothing.
+    logic [31:0] perfCycles;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            perfCycles  <= 32'b0;
+            perfInstret <= 32'b0;
+        end else begin
+            perfCycles <= perfCycles + 1;
+            if (!memoryStall && !isTrap) perfInstret <= perfInstret + 1;
+        end
+    end
+
+    // Hart-local register reads
+    always_comb begin
+        case (aluResult[5:0])
+            6'h10:   localReadData = mepcValue;
+            6'h14:   localReadData = mcauseValue;
+            6'h18:   localReadData = mtvecValue;
+            6'h1C:   localReadData = 32'(hartId);
+            6'h20:   localReadData = perfCycles;
+            6'h24:   localReadData = perfInstret;
+            6'h28:   localReadData = {24'b0, fpControlStatus};
+            6'h2C:   localReadData = {31'b0, fpDirty};
+            default: localReadData = 32'b0;
+        endcase
+    end
+
+    // --- 3. CORE DATAPATH & CONTROL ---
+    logic [31:0] loadData, alignedReadData;
+    logic [4:0]  aluControl;
+    logic        aluInputSource, csrWriteEnable, isFloat, fpRegisterWriteEnable;
+
+    controller #(.hasFpu(hasFpu)) u_ctrl (
+        .opcode(instruction[6:0]), .funct3(instruction[14:12]), .funct7(instruction[31:25]), .rs2Field(instruction[24:20]),
+        .timerInterrupt(interruptTaken), .registerWriteEnable(registerWriteEnable),
+        .aluInputSource(aluInputSource), .memoryWriteEnable(memoryWriteEnable),
+        .resultSource(resultSource), .isBranch(isBranch), .aluControlSignal(aluControl),
+        .csrWriteEnable(csrWriteEnable), .isTrap(isTrap), .isIllegal(isIllegal), .isReturn(isReturn), .isAtomic(isAtomic),
+        .isFloat(isFloat), .fpRegisterWriteEnable(fpRegisterWriteEnable)
+    );
+
+    // Load lane extraction: LB/LH sign-extend, LBU/LHU zero-extend, LW passes the word
+    logic [7:0]  loadByte;
+    logic [15:0] loadHalf;
+
+    assign loadData = localAccess ? localReadData : busReadData;
+    assign loadByte = loadData[aluResult[1:0]*8 +: 8];
+    assign loadHalf = loadData[aluResult[1]*16 +: 16];
+
+    always_comb begin
+        alignedReadData = loadData;
+        if (instruction[6:0] == 7'b0000011) begin
+            case (instruction[14:12])
+                3'b000:  alignedReadData = {{24{loadByte[7]}}, loadByte};
+                3'b001:  alignedReadData = {{16{loadHalf[15]}}, loadHalf};
+                3'b100:  alignedReadData = {24'b0, loadByte};
+                3'b101:  alignedReadData = {16'b0, loadHalf};
+                default: alignedReadData = loadData;
+            endcase
+        end
+    end
+
+    // SC.W writes 0 on success, 1 on failure; AMOs write the word they read. FP compares,
+    // FCLASS, FMV.X.W and FCVT.W[U].S write the FPU result.
+    assign writeBackData = resultSource ? alignedReadData :
+                           isStoreConditional ? {31'b0, conditionalFail} :
+                           isAmo ? storeMergeWord :
+                           isFloat ? fpuResult :
+                           (instruction[6:0] == 7'b1101111 || instruction[6:0] == 7'b1100111) ? sequentialProgramCounter : aluResult;
+
+    regfile u_rf (
+        .clock(clock), .registerWriteEnable(registerWriteEnable && !memoryStall),
+        .readAddress0(instruction[19:15]), .readAddress1(instruction[24:20]),
+        .writeAddress(instruction[11:7]),
+        .writeData(writeBackData),
+        .readData0(readData1), .readData1(readData2)
+    );
+
+    alu u_alu (
+        .inputA((instruction[6:0] == 7'b0110111) ? 32'b0 :
+                (instruction[6:0] == 7'b0010111) ? programCounter : readData1),
+        .inputB(aluInputSource ? immediateValue : readData2),
+        .aluControl(aluControl), .aluResult(aluResult), .zero(zeroFlag)
+    );
+
+    imm_gen u_imm_gen (.instruction(instruction), .immediateValue(immediateValue));
+
+    // MEPC (0x40000010) and MTVEC (0x40000018) are written by hart-local stores (FCSR and
+    // FP_STATUS ones once the FPU pipeline has drained)
+    logic localStore;
+    assign localStore = memoryWriteEnable && localAccess && !fpCsrWait;
+
+    csr_unit u_csr (
+        .clock(clock), .resetActiveLow(resetActiveLow),
+        .csrWriteEnable(csrWriteEnable), .pcFromCore(programCounter),
+        .trapCause(trapCause),
+        .busWriteEnable((localStore && (aluResult[5:0] == 6'h10)) || interruptTaken),
+        .busWriteData(interruptTaken ? programCounter : cpuWriteData),
+        .mtvecWriteEnable(localStore && (aluResult[5:0] == 6'h18)),
+        .mepcValue(mepcValue), .mcauseValue(mcauseValue), .mtvecValue(mtvecValue)
+    );
+
+    // --- 4. FLOATING POINT (RV32F) ---
+    // f0-f31 and the FPU. FLW writes the loaded word, FPU results go to f[rd] or x[rd]: through
+    // the decode port when the instruction retires, or through the pipeline port two cycles
+    // after a pipelined operation retired. FCSR (0x40000028) holds {frm, fflags}; the flags of
+    // each FPU result are ORed in as it is written. FP_STATUS (0x4000002C) bit 0 is the dirty bit
+    // for lazy context switching: set whenever an f register or FCSR changes, cleared only by
+    // software (crt0.S trap_vector).
+    logic fpRetire, fpuPipelined, fpPipeWrite;
+    logic [4:0]  fpPipeAddress, fpPipeFlags;
+    logic [31:0] fpPipeData;
+
+    assign fpRetire = isFloat && !memoryStall && !fpuPipelined;
+
+    // Without the FPU (hasFpu = 0) neither block is built; the controller never raises isFloat
+    // or an FP register write, so the tie-offs below are never selected.
+    generate
+        if (hasFpu) begin : gen_fpu
+            fp_regfile u_fprf (
+                .clock(clock), .registerWriteEnable(fpRegisterWriteEnable && !memoryStall && !fpuPipelined),
+                .readAddress0(instruction[19:15]), .readAddress1(instruction[24:20]), .readAddress2(instruction[31:27]),
+                .writeAddress(instruction[11:7]),
+                .writeData(isFloat ? fpuResult : alignedReadData),
+                .pipeWriteEnable(fpPipeWrite), .pipeWriteAddress(fpPipeAddress), .pipeWriteData(fpPipeData),
+                .readData0(fpReadData1), .readData1(fpReadData2), .readData2(fpReadData3)
+            );
+
+            fpu u_fpu (
+                .clock(clock), .resetActiveLow(resetActiveLow), .start(isFloat), .hold(fpuHold),
+                .instruction(instruction),
+                .operandA(fpReadData1), .operandB(fpReadData2), .operandC(fpReadData3), .integerOperand(readData1),
+                .dynamicRounding(fpControlStatus[7:5]), .result(fpuResult), .exceptionFlags(fpuFlags),
+                .pipelined(fpuPipelined), .busy(fpuBusy), .inFlight(fpuInFlight),
+                .pipeWriteEnable(fpPipeWrite), .pipeWriteAddress(fpPipeAddress), .pipeWriteData(fpPipeData),
+                .pipeWriteFlags(fpPipeFlags)
+            );
+        end else begin : gen_no_fpu
+            assign fpReadData1   = 32'b0; assign fpReadData2 = 32'b0; assign fpReadData3 = 32'b0;
+            assign fpuResult     = 32'b0;
+            assign fpuFlags      = 5'b0;
+            assign fpuPipelined  = 1'b0;
+            assign fpuBusy       = 1'b0;
+            assign fpuInFlight   = 1'b0;
+            assign fpPipeWrite   = 1'b0;
+            assign fpPipeAddress = 5'b0;
+            assign fpPipeData    = 32'b0;
+            assign fpPipeFlags   = 5'b0;
+        end
+    endgenerate
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            fpControlStatus <= 8'b0;
+            fpDirty         <= 0;
+        end else if (hasFpu) begin
+            if (localStore && (aluResult[5:0] == 6'h28)) begin
+                fpControlStatus <= cpuWriteData[7:0];
+                fpDirty         <= 1;
+            end else if (localStore && (aluResult[5:0] == 6'h2C)) begin
+                fpDirty         <= cpuWriteData[0];
+            end else begin
+                fpControlStatus[4:0] <= fpControlStatus[4:0] | (fpRetire ? fpuFlags : 5'b0) | (fpPipeWrite ? fpPipeFlags : 5'b0);
+                if ((fpRegisterWriteEnable && !memoryStall) || (fpRetire && fpuFlags != 0) || fpPipeWrite) fpDirty <= 1;
+            end
+        end
+    end
+
+endmodule
@@ -5,16 +5,20 @@ module csr_unit (
     // Hardware Trap Interface
     input  logic        csrWriteEnable, // Signal from Controller to capture PC
     input  logic [31:0] pcFromCore,     // Current PC to be saved
+    input  logic [31:0] trapCause,      // Interrupt source, latched into MCAUSE with the PC
     
     // Software Bus Interface (MMIO: 0x40000010)
     input  logic        busWriteEnable, // Write request from Bus Interconnect
     input  logic [31:0] busWriteData,   // Data from Bus Interconnect
+    input  logic        mtvecWriteEnable, // Software write to MTVEC (MMIO: 0x40000018)
     
     // Output to Program Counter Logic
-    output logic [31:0] mepcValue       // Value stored in MEPC register
+    output logic [31:0] mepcValue,      // Value stored in MEPC register
+    output logic [31:0] mcauseValue,    // Source of the last trap (read-only, MMIO: 0x40000014)
+    output logic [31:0] mtvecValue      // Trap vector; lets an image loaded into program RAM own traps
 );
 
-    logic [31:0] mepc;
+    logic [31:0] mepc, mcause, mtvec;
 
     // MEPC Register Logic
     always_ff @(posedge clock or negedge resetActiveLow) begin
@@ -31,7 +35,21 @@ module csr_unit (
         end
     end
 
+    // MCAUSE Register Logic (hardware only)
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)     mcause <= 32'h00000000;
+        else if (csrWriteEnable) mcause <= trapCause;
+    end
+
+    // MTVEC Register Logic (software only; resets to the ROM vector)
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)       mtvec <= 32'h00000010;
+        else if (mtvecWriteEnable) mtvec <= busWriteData;
+    end
+
     // Continuous assignment to output
-    assign mepcValue = mepc;
+    assign mepcValue   = mepc;
+    assign mcauseValue = mcause;
+    assign mtvecValue  = mtvec;
 
 endmodule
\ No newline at end of file
@@ -0,0 +1,227 @@
+module dcache #(
+    parameter numLines         = 16, // Direct-mapped sets
+    parameter lineWords        = 4,  // 32-bit words per line (power of 2)
+    parameter writeBufferDepth = 4   // Posted stores awaiting drain (power of 2)
+) (
+    input  logic                    clock,
+    input  logic                    resetActiveLow,
+
+    // Bus Slave Interface (drop-in for data_mem on the RAM port)
+    input  logic [31:0]             ramAxiWriteAddress,
+    input  logic [31:0]             ramAxiWriteData,
+    input  logic                    ramAxiWriteValid,
+    output logic                    ramAxiWriteReady,    // Low while the write buffer is full or a load is pending
+    input  logic [31:0]             ramAxiReadAddress,
+    input  logic                    ramAxiReadValid,
+    output logic                    ramAxiReadReady,     // One load in flight; accepted even while a miss is serviced
+    output logic [31:0]             ramAxiReadData,
+    output logic                    ramAxiReadValidData, // Same cycle on hit/forward, after the fill on a miss
+    input  logic                    ramAxiReadReadyData,
+
+    // Backing Store Interface (ram_backend)
+    output logic                    memRequest,
+    output logic                    memWrite,
+    output logic [31:0]             memLineAddress,
+    output logic [lineWords*32-1:0] memWriteLine,
+    input  logic [lineWords*32-1:0] memReadLine,
+    input  logic                    memDone,
+
+    // Performance Counters
+    output logic [31:0]             statHits,
+    output logic [31:0]             statMisses,
+    output logic [31:0]             statWritebacks,
+    output logic [31:0]             statStallCycles
+);
+
+    // Address split: | tag | index | offset | byte |
+    localparam OFFSET_BITS = $clog2(lineWords);
+    localparam INDEX_BITS  = $clog2(numLines);
+    localparam INDEX_LSB   = 2 + OFFSET_BITS;
+    localparam TAG_LSB     = INDEX_LSB + INDEX_BITS;
+    localparam PTR_BITS    = (writeBufferDepth > 1) ? $clog2(writeBufferDepth) : 1;
+
+    localparam stateIdle      = 2'b00;
+    localparam stateWriteback = 2'b01;
+    localparam stateFill      = 2'b10;
+
+    // --- 1. STORAGE ---
+    // Public so the testbench can read memory coherently (semihosting backdoor)
+    logic [31:0]          lineData  [0:numLines-1][0:lineWords-1] /* verilator public_flat */;
+    logic [31:TAG_LSB]    lineTag   [0:numLines-1]                /* verilator public_flat */;
+    logic [numLines-1:0]  lineValid /* verilator public_flat */;
+    logic [numLines-1:0]  lineDirty;
+
+    logic [31:0]          bufferAddress [0:writeBufferDepth-1] /* verilator public_flat */;
+    logic [31:0]          bufferData    [0:writeBufferDepth-1] /* verilator public_flat */;
+    logic [PTR_BITS-1:0]  bufferHead /* verilator public_flat */;
+    logic [PTR_BITS-1:0]  bufferTail;
+    logic [PTR_BITS:0]    bufferCount /* verilator public_flat */;
+
+    logic [1:0]           cacheState;
+    logic [31:0]          missAddress;
+    logic                 readMissPending, drainMissPending;
+    logic                 responsePending; // Load accepted, data not yet taken by the bus
+    logic [31:0]          responseAddress;
+
+    // --- 2. READ LOOKUP (Combinational, zero-wait on hit) ---
+    // A newly accepted load is looked up directly; a pending one replays its latched address
+    logic                   readAccepted, lookupActive, responseTaken;
+    logic [31:0]            lookupAddress;
+    logic [INDEX_BITS-1:0]  readIndex;
+    logic [OFFSET_BITS-1:0] readOffset;
+    logic                   readHit, forwardHit;
+    logic [31:0]            forwardData;
+    logic [PTR_BITS-1:0]    forwardSlot;
+
+    assign ramAxiReadReady = !responsePending;
+    assign readAccepted    = ramAxiReadValid && ramAxiReadReady;
+    assign lookupActive    = responsePending || readAccepted;
+    assign lookupAddress   = responsePending ? responseAddress : ramAxiReadAddress;
+
+    assign readIndex  = lookupAddress[TAG_LSB-1:INDEX_LSB];
+    assign readOffset = lookupAddress[INDEX_LSB-1:2];
+    assign readHit    = lineValid[readIndex] && (lineTag[readIndex] == lookupAddress[31:TAG_LSB]);
+
+    // Store-to-load forwarding: the youngest matching buffered store wins
+    always_comb begin
+        forwardHit  = 0;
+        forwardData = 32'b0;
+        for (int i = 0; i < writeBufferDepth; i++) begin
+            forwardSlot = bufferHead + PTR_BITS'(i);
+            if (i < bufferCount && bufferAddress[forwardSlot][31:2] == lookupAddress[31:2]) begin
+                forwardHit  = 1;
+                forwardData = bufferData[forwardSlot];
+            end
+        end
+    end
+
+    assign ramAxiReadData      = forwardHit ? forwardData : lineData[readIndex][readOffset];
+    assign ramAxiReadValidData = lookupActive && (forwardHit || readHit);
+    assign responseTaken       = ramAxiReadValidData && ramAxiReadReadyData;
+
+    // Stores are held off while a load is pending so a younger store can never be forwarded to it
+    assign ramAxiWriteReady    = (bufferCount != writeBufferDepth) && !responsePending;
+
+    // --- 3. WRITE BUFFER DRAIN LOOKUP ---
+    logic [31:0]            drainAddress;
+    logic [INDEX_BITS-1:0]  drainIndex;
+    logic [OFFSET_BITS-1:0] drainOffset;
+    logic                   drainValid, drainHit;
+
+    assign drainAddress = bufferAddress[bufferHead];
+    assign drainIndex   = drainAddress[TAG_LSB-1:INDEX_LSB];
+    assign drainOffset  = drainAddress[INDEX_LSB-1:2];
+    assign drainValid   = (bufferCount != 0);
+    assign drainHit     = drainValid && lineValid[drainIndex] && (lineTag[drainIndex] == drainAddress[31:TAG_LSB]);
+
+    // --- 4. MISS HANDLING (Write-back, write-allocate) ---
+    // Read misses take priority over draining so loads are never stuck behind posted stores
+    logic                   readMiss, drainMiss, drainPop, bufferPush;
+    logic [31:0]            allocateAddress;
+    logic [INDEX_BITS-1:0]  allocateIndex, missIndex;
+
+    assign readMiss        = lookupActive && !forwardHit && !readHit;
+    assign drainMiss       = !readMiss && drainValid && !drainHit;
+    assign drainPop        = (cacheState == stateIdle) && !readMiss && drainHit;
+    assign bufferPush      = ramAxiWriteValid && ramAxiWriteReady;
+    assign allocateAddress = readMiss ? lookupAddress : drainAddress;
+    assign allocateIndex   = allocateAddress[TAG_LSB-1:INDEX_LSB];
+    assign missIndex       = missAddress[TAG_LSB-1:INDEX_LSB];
+
+    logic readHitEvent, drainHitEvent;
+    assign readHitEvent  = responseTaken && !readMissPending;
+    assign drainHitEvent = drainPop && !drainMissPending;
+
+    always_comb begin
+        memRequest     = (cacheState != stateIdle);
+        memWrite       = (cacheState == stateWriteback);
+        memLineAddress = (cacheState == stateWriteback) ?
+                         {lineTag[missIndex], missIndex, {INDEX_LSB{1'b0}}} :
+                         {missAddress[31:INDEX_LSB], {INDEX_LSB{1'b0}}};
+        for (int w = 0; w < lineWords; w++)
+            memWriteLine[w*32 +: 32] = lineData[missIndex][w];
+    end
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            cacheState       <= stateIdle;
+            missAddress      <= 32'b0;
+            lineValid        <= '0;
+            lineDirty        <= '0;
+            bufferHead       <= 0;
+            bufferTail       <= 0;
+            bufferCount      <= 0;
+            readMissPending  <= 0;
+            drainMissPending <= 0;
+            responsePending  <= 0;
+            responseAddress  <= 32'b0;
+            statHits         <= 0;
+            statMisses       <= 0;
+            statWritebacks   <= 0;
+            statStallCycles  <= 0;
+        end else begin
+            // Enqueue posted store
+            if (bufferPush) begin
+                bufferAddress[bufferTail] <= ramAxiWriteAddress;
+                bufferData[bufferTail]    <= ramAxiWriteData;
+                bufferTail                <= bufferTail + 1;
+            end
+            if (bufferPush && !drainPop)      bufferCount <= bufferCount + 1;
+            else if (!bufferPush && drainPop) bufferCount <= bufferCount - 1;
+
+            case (cacheState)
+                stateIdle: begin
+                    if (readMiss || drainMiss) begin
+                        missAddress <= allocateAddress;
+                        cacheState  <= (lineValid[allocateIndex] && lineDirty[allocateIndex]) ? stateWriteback : stateFill;
+                        statMisses  <= statMisses + 1;
+                        if (readMiss) readMissPending  <= 1;
+                        else          drainMissPending <= 1;
+                    end else if (drainPop) begin
+                        lineData[drainIndex][drainOffset] <= bufferData[bufferHead];
+                        lineDirty[drainIndex]             <= 1;
+                        bufferHead                        <= bufferHead + 1;
+                        drainMissPending                  <= 0;
+                    end
+                end
+
+                stateWriteback: begin
+                    if (memDone) begin
+                        lineDirty[missIndex] <= 0;
+                        statWritebacks       <= statWritebacks + 1;
+                        cacheState           <= stateFill;
+                    end
+                end
+
+                stateFill: begin
+                    if (memDone) begin
+                        for (int w = 0; w < lineWords; w++)
+                            lineData[missIndex][w] <= memReadLine[w*32 +: 32];
+                        lineTag[missIndex]   <= missAddress[31:TAG_LSB];
+                        lineValid[missIndex] <= 1;
+                        lineDirty[missIndex] <= 0;
+                        cacheState           <= stateIdle;
+                    end
+                end
+
+                default: cacheState <= stateIdle;
+            endcase
+
+            // Hold the load until the bus takes its data
+            if (readAccepted && !responseTaken) begin
+                responsePending <= 1;
+                responseAddress <= ramAxiReadAddress;
+            end else if (responseTaken) begin
+                responsePending <= 0;
+            end
+
+            // Served accesses count as hits unless they are the replay of a miss
+            if (responseTaken) readMissPending <= 0;
+            statHits <= statHits + 32'(readHitEvent) + 32'(drainHitEvent);
+
+            if ((lookupActive && !ramAxiReadValidData) || (ramAxiWriteValid && !ramAxiWriteReady))
+                statStallCycles <= statStallCycles + 1;
+        end
+    end
+
+endmodule
@@ -0,0 +1,189 @@
+module dma_controller (
+    input  logic        clock,
+    input  logic        resetActiveLow,
+
+    // Register Interface (MMIO slave window 0x40000100 - 0x400001FF)
+    input  logic        regWriteEnable,
+    input  logic [7:0]  regWriteAddress,
+    input  logic [31:0] regWriteData,
+    input  logic [7:0]  regReadAddress,
+    output logic [31:0] regReadData,
+
+    // Bus Master Interface (dmaAxi* port of bus_interconnect; ReadReadyData is always 1)
+    output logic [31:0] dmaAxiWriteAddress,
+    output logic [31:0] dmaAxiWriteData,
+    output logic        dmaAxiWriteValid,
+    input  logic        dmaAxiWriteReady,
+    output logic [31:0] dmaAxiReadAddress,
+    output logic        dmaAxiReadValid,
+    input  logic        dmaAxiReadReady,
+    input  logic [31:0] dmaAxiReadData,
+    input  logic        dmaAxiReadValidData,
+
+    // Peripheral Flow Control & Completion
+    input  logic        peripheralReady, // Target of a to-peripheral transfer can take a byte now
+    output logic        irqPulse         // Single cycle: a transfer with irqEnable has finished
+);
+
+    // Register offsets
+    localparam REG_SRC    = 8'h00; // Source address (fill value in fill mode)
+    localparam REG_DST    = 8'h04; // Destination address (fixed in to-peripheral mode)
+    localparam REG_CTRL   = 8'h08; // [15:0] length, [17:16] mode, [18] irqEnable, [31] start
+    localparam REG_NEXT   = 8'h0C; // Next descriptor address (0: end of chain)
+    localparam REG_STATUS = 8'h10; // [0] busy, [1] irq flag (write 1 to clear)
+    localparam REG_COUNT  = 8'h14; // Units moved since reset (performance counter)
+
+    localparam modeCopy   = 2'd0;  // Word copy, both addresses increment
+    localparam modeFill   = 2'd1;  // Word fill with the SRC value
+    localparam modePeriph = 2'd2;  // Byte stream from memory to a fixed peripheral register
+
+    localparam stateIdle   = 3'd0;
+    localparam stateFetch  = 3'd1; // Loading a 4-word descriptor {next, src, dst, ctrl}
+    localparam stateRead   = 3'd2;
+    localparam stateWrite  = 3'd3;
+    localparam stateFinish = 3'd4;
+
+    // --- 1. CHANNEL REGISTERS ---
+    logic [31:0] sourceAddress, destinationAddress, nextDescriptor, fetchAddress, dataBuffer, unitCount;
+    logic [15:0] remainingUnits;
+    logic [1:0]  transferMode, fetchIndex;
+    logic        irqEnable, irqFlag, readIssued;
+    logic [2:0]  dmaState;
+    logic        busy;
+
+    assign busy = (dmaState != stateIdle);
+
+    always_comb begin
+        case (regReadAddress)
+            REG_SRC:    regReadData = sourceAddress;
+            REG_DST:    regReadData = destinationAddress;
+            REG_CTRL:   regReadData = {busy, 12'b0, irqEnable, transferMode, remainingUnits};
+            REG_NEXT:   regReadData = nextDescriptor;
+            REG_STATUS: regReadData = {30'b0, irqFlag, busy};
+            REG_COUNT:  regReadData = unitCount;
+            default:    regReadData = 32'b0;
+        endcase
+    end
+
+    // --- 2. BUS MASTER REQUESTS ---
+    // One read in flight; zero-wait slaves may answer in the issue cycle
+    logic readAccepted, writeAccepted, dataArrived;
+
+    assign dmaAxiReadValid    = (dmaState == stateFetch || dmaState == stateRead) && !readIssued;
+    assign dmaAxiReadAddress  = (dmaState == stateFetch)   ? (fetchAddress + {28'b0, fetchIndex, 2'b00}) :
+                                (transferMode == modePeriph) ? {sourceAddress[31:2], 2'b00} : sourceAddress;
+    assign readAccepted       = dmaAxiReadValid && dmaAxiReadReady;
+    assign dataArrived        = dmaAxiReadValidData && (readIssued || readAccepted);
+
+    // To-peripheral writes are paced by the peripheral's request line so the DMA never parks on a
+    // wait-stated MMIO port (which would block CPU accesses to other MMIO registers)
+    assign dmaAxiWriteValid   = (dmaState == stateWrite) && (transferMode != modePeriph || peripheralReady);
+    assign dmaAxiWriteAddress = destinationAddress;
+    assign dmaAxiWriteData    = (transferMode == modeFill) ? sourceAddress : dataBuffer;
+    assign writeAccepted      = dmaAxiWriteValid && dmaAxiWriteReady;
+
+    // --- 3. TRANSFER ENGINE ---
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            dmaState           <= stateIdle;
+            sourceAddress      <= 32'b0;
+            destinationAddress <= 32'b0;
+            nextDescriptor     <= 32'b0;
+            fetchAddress       <= 32'b0;
+            dataBuffer         <= 32'b0;
+            remainingUnits     <= 16'b0;
+            transferMode       <= modeCopy;
+            fetchIndex         <= 2'b0;
+            irqEnable          <= 0;
+            irqFlag            <= 0;
+            irqPulse           <= 0;
+            readIssued         <= 0;
+            unitCount          <= 32'b0;
+        end else begin
+            irqPulse <= 0;
+
+            if (dataArrived)       readIssued <= 0;
+            else if (readAccepted) readIssued <= 1;
+
+            // Software access: the channel registers are only writable while idle
+            if (regWriteEnable && regWriteAddress == REG_STATUS && regWriteData[1]) irqFlag <= 0;
+            if (regWriteEnable && !busy) begin
+                case (regWriteAddress)
+                    REG_SRC:  sourceAddress      <= regWriteData;
+                    REG_DST:  destinationAddress <= regWriteData;
+                    REG_NEXT: nextDescriptor     <= regWriteData;
+                    REG_CTRL: begin
+                        remainingUnits <= regWriteData[15:0];
+                        transferMode   <= regWriteData[17:16];
+                        irqEnable      <= regWriteData[18];
+                        if (regWriteData[31])
+                            dmaState <= (regWriteData[15:0] == 16'b0) ? stateFinish :
+                                        (regWriteData[17:16] == modeFill) ? stateWrite : stateRead;
+                    end
+                    default: ;
+                endcase
+            end
+
+            case (dmaState)
+                stateFetch: begin
+                    if (dataArrived) begin
+                        case (fetchIndex)
+                            2'd0: nextDescriptor     <= dmaAxiReadData;
+                            2'd1: sourceAddress      <= dmaAxiReadData;
+                            2'd2: destinationAddress <= dmaAxiReadData;
+                            2'd3: begin
+                                remainingUnits <= dmaAxiReadData[15:0];
+                                transferMode   <= dmaAxiReadData[17:16];
+                                irqEnable      <= dmaAxiReadData[18];
+                                dmaState       <= (dmaAxiReadData[15:0] == 16'b0) ? stateFinish :
+                                                  (dmaAxiReadData[17:16] == modeFill) ? stateWrite : stateRead;
+                            end
+                        endcase
+                        fetchIndex <= fetchIndex + 1;
+                    end
+                end
+
+                stateRead: begin
+                    if (dataArrived) begin
+                        // To-peripheral mode moves the addressed byte lane into the low byte
+                        dataBuffer <= (transferMode == modePeriph) ?
+                                      (dmaAxiReadData >> {sourceAddress[1:0], 3'b000}) : dmaAxiReadData;
+                        dmaState   <= stateWrite;
+                    end
+                end
+
+                stateWrite: begin
+                    if (writeAccepted) begin
+                        unitCount      <= unitCount + 1;
+                        remainingUnits <= remainingUnits - 1;
+                        if (transferMode == modePeriph) sourceAddress <= sourceAddress + 1;
+                        else begin
+                            if (transferMode == modeCopy) sourceAddress <= sourceAddress + 4;
+                            destinationAddress <= destinationAddress + 4;
+                        end
+                        if (remainingUnits == 16'd1)        dmaState <= stateFinish;
+                        else if (transferMode != modeFill)  dmaState <= stateRead;
+                    end
+                end
+
+                stateFinish: begin
+                    if (irqEnable) begin
+                        irqFlag  <= 1;
+                        irqPulse <= 1;
+                    end
+                    // Follow the chain: the next descriptor replaces the channel registers
+                    if (nextDescriptor != 32'b0) begin
+                        fetchAddress <= nextDescriptor;
+                        fetchIndex   <= 2'b0;
+                        dmaState     <= stateFetch;
+                    end else begin
+                        dmaState     <= stateIdle;
+                    end
+                end
+
+                default: ;
+            endcase
+        end
+    end
+
+endmodule
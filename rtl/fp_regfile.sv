@@ -0,0 +1,34 @@
+module fp_regfile (
+    input logic clock,
+    input logic registerWriteEnable,
+    input logic [4:0] readAddress0,   // rs1
+    input logic [4:0] readAddress1,   // rs2 (FSW store data)
+    input logic [4:0] readAddress2,   // rs3 (fused multiply-add)
+    input logic [4:0] writeAddress,
+    input logic [31:0] writeData,
+    input logic pipeWriteEnable,      // FPU pipeline write-back (an operation issued two cycles ago)
+    input logic [4:0] pipeWriteAddress,
+    input logic [31:0] pipeWriteData,
+    output logic [31:0] readData0,
+    output logic [31:0] readData1,
+    output logic [31:0] readData2
+);
+
+// f0-f31 for the FPU: unlike x0, f0 is an ordinary register
+logic [31:0] registerFile [31:0] /* verilator public_flat */; // Read by sim/soc_fuzz.cpp
+
+// The hart never lets both ports write the same register in one cycle (fpu.sv hazard check)
+always_ff @(posedge clock) begin
+    if (registerWriteEnable) begin
+        registerFile[writeAddress] <= writeData;
+    end
+    if (pipeWriteEnable) begin
+        registerFile[pipeWriteAddress] <= pipeWriteData;
+    end
+end
+
+assign readData0 = registerFile[readAddress0];
+assign readData1 = registerFile[readAddress1];
+assign readData2 = registerFile[readAddress2];
+
+endmodule
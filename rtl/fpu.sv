@@ -0,0 +1,610 @@
+module fpu (
+    input  logic        clock,
+    input  logic        resetActiveLow,
+    input  logic        start,            // FP compute instruction in decode (held there while busy)
+    input  logic        hold,             // An interrupt waits: issue nothing until the pipeline drains
+    input  logic [31:0] instruction,      // The instruction in decode (FLW/FSW too, for the hazard check)
+    input  logic [31:0] operandA,         // f[rs1]
+    input  logic [31:0] operandB,         // f[rs2]
+    input  logic [31:0] operandC,         // f[rs3] (fused multiply-add)
+    input  logic [31:0] integerOperand,   // x[rs1] (FCVT.S.W[U], FMV.W.X)
+    input  logic [2:0]  dynamicRounding,  // FCSR frm, used when the instruction's rm is 111
+    output logic [31:0] result,           // To f[rd], or x[rd] for compares/FCLASS/FMV.X.W/FCVT.W[U].S
+    output logic [4:0]  exceptionFlags,   // {NV, DZ, OF, UF, NX}, valid with the result
+    output logic        pipelined,        // The instruction retires on issue; the pipeline writes f[rd]
+    output logic        busy,             // Result not ready or a register hazard: the hart holds the instruction
+    output logic        inFlight,         // An operation has issued and not written its result yet
+    output logic        pipeWriteEnable,  // Stage 3 result for f[pipeWriteAddress] (second FP write port)
+    output logic [4:0]  pipeWriteAddress,
+    output logic [31:0] pipeWriteData,
+    output logic [4:0]  pipeWriteFlags
+);
+
+    // Single-precision RV32F arithmetic for the single-issue hart. Sign injection, min/max,
+    // compares, FCLASS and the moves finish in the cycle they issue. Add/subtract/multiply/FMA and
+    // the integer conversions go through a three-stage pipeline (unpack and multiply, align and
+    // add, normalize and round). An operation with an f destination retires when it issues and
+    // stage 3 writes its result through a second FP register port two cycles later, so one can
+    // issue every cycle. FCVT.W[U].S writes x[rd] and is held in decode for its 3 cycles.
+    // Divide and square root wait for the pipeline to drain, then produce one quotient/root bit
+    // per cycle and share the rounding stage: 29 cycles in decode.
+    // Hazards: an instruction in decode that reads an f register, or writes one through the
+    // decode port, while stage 1 or 2 still owes that register is held until it is written
+    // (no bypass: a dependent operation issues 3 cycles after its producer).
+    // Every result is exact until the one rounding step (an 80-bit window holds the full product
+    // and the aligned addend). Reserved rounding modes round to nearest even. The C++ reference
+    // is sim/rv32f_model.h.
+
+    localparam RNE = 3'd0;
+    localparam RTZ = 3'd1;
+    localparam RDN = 3'd2;
+    localparam RUP = 3'd3;
+    localparam RMM = 3'd4;
+
+    localparam FLAG_NX = 5'b00001;
+    localparam FLAG_UF = 5'b00010;
+    localparam FLAG_OF = 5'b00100;
+    localparam FLAG_DZ = 5'b01000;
+    localparam FLAG_NV = 5'b10000;
+
+    localparam CANONICAL_NAN = 32'h7FC00000;
+    localparam ONE           = 32'h3F800000; // FADD/FSUB: a * 1.0 + b
+
+    // --- 1. HELPERS ---
+    function automatic logic isNan(input logic [31:0] x);
+        return (x[30:23] == 8'hFF) && (x[22:0] != 0);
+    endfunction
+
+    function automatic logic isSignallingNan(input logic [31:0] x);
+        return isNan(x) && !x[22];
+    endfunction
+
+    function automatic logic isInf(input logic [31:0] x);
+        return x[30:0] == 31'h7F800000;
+    endfunction
+
+    function automatic logic isZero(input logic [31:0] x);
+        return x[30:0] == 31'b0;
+    endfunction
+
+    // Left shift that brings a subnormal's leading one to bit 23
+    function automatic logic [4:0] subnormalShift(input logic [22:0] mantissa);
+        subnormalShift = 5'd0;
+        for (int i = 0; i < 23; i++) if (mantissa[i]) subnormalShift = 5'(23 - i);
+    endfunction
+
+    // A finite operand is significandOf(x) * 2^(exponentOf(x) - 23), bit 23 set unless x is zero
+    function automatic logic [23:0] significandOf(input logic [31:0] x);
+        return (x[30:23] != 0) ? {1'b1, x[22:0]} : ({1'b0, x[22:0]} << subnormalShift(x[22:0]));
+    endfunction
+
+    function automatic logic signed [11:0] exponentOf(input logic [31:0] x);
+        return (x[30:23] != 0) ? $signed({4'b0, x[30:23]}) - 12'sd127
+                               : -12'sd126 - $signed({7'b0, subnormalShift(x[22:0])});
+    endfunction
+
+    function automatic logic [6:0] msbIndex(input logic [79:0] value);
+        msbIndex = 7'd0;
+        for (int i = 0; i < 80; i++) if (value[i]) msbIndex = 7'(i);
+    endfunction
+
+    // Right shift that ORs the bits shifted out into bit 0 (they only ever decide rounding)
+    function automatic logic [79:0] shiftRightJam(input logic [79:0] value, input logic [11:0] amount);
+        logic [79:0] lost;
+        if (amount == 0)  return value;
+        if (amount >= 80) return {79'b0, value != 0};
+        lost = value & ((80'b1 << amount) - 80'b1);
+        return (value >> amount) | {79'b0, lost != 0};
+    endfunction
+
+    function automatic logic roundIncrement(input logic [2:0] mode, input logic sign, input logic lsb,
+                                            input logic roundBit, input logic stickyBit);
+        case (mode)
+            RTZ:     return 1'b0;
+            RDN:     return sign && (roundBit || stickyBit);
+            RUP:     return !sign && (roundBit || stickyBit);
+            RMM:     return roundBit;
+            default: return roundBit && (stickyBit || lsb);
+        endcase
+    endfunction
+
+    // a < b for non-NaN values; 'signedZero' orders -0 below +0
+    function automatic logic less(input logic [31:0] a, input logic [31:0] b, input logic signedZero);
+        if (a[31] != b[31]) return a[31] && (signedZero || ((a[30:0] | b[30:0]) != 0));
+        return a[31] ? (a[30:0] > b[30:0]) : (a[30:0] < b[30:0]);
+    endfunction
+
+    function automatic logic [31:0] classify(input logic [31:0] x);
+        if (x[30:23] == 8'hFF)
+            return (x[22:0] != 0) ? (x[22] ? 32'h200 : 32'h100) : (x[31] ? 32'h001 : 32'h080);
+        if (x[30:23] == 8'h00)
+            return (x[22:0] != 0) ? (x[31] ? 32'h004 : 32'h020) : (x[31] ? 32'h008 : 32'h010);
+        return x[31] ? 32'h002 : 32'h040;
+    endfunction
+
+    // --- 2. DECODE & SEQUENCING ---
+    logic [6:0]  opcode;
+    logic [4:0]  funct5;
+    logic [2:0]  funct3, roundingMode;
+    logic        isFused, isAdd, isMultiply, isDivide, isSquareRoot, isToInteger, isFromInteger;
+    logic        isPiped, isStaged, isIterative, isSignedConversion, issue, hazard, pipeBusy;
+    logic [4:0]  cycleCount;
+
+    assign opcode             = instruction[6:0];
+    assign funct3             = instruction[14:12];
+    assign funct5             = instruction[31:27];
+    assign isSignedConversion = (instruction[24:20] == 5'd0);
+    assign roundingMode       = (funct3 == 3'b111) ? ((dynamicRounding > RMM) ? RNE : dynamicRounding) :
+                                (funct3 > RMM) ? RNE : funct3;
+
+    assign isFused       = (opcode != 7'b1010011); // FMADD/FMSUB/FNMSUB/FNMADD
+    assign isAdd         = !isFused && (funct5 == 5'h00 || funct5 == 5'h01);
+    assign isMultiply    = !isFused && (funct5 == 5'h02);
+    assign isDivide      = !isFused && (funct5 == 5'h03);
+    assign isSquareRoot  = !isFused && (funct5 == 5'h0B);
+    assign isToInteger   = !isFused && (funct5 == 5'h18);
+    assign isFromInteger = !isFused && (funct5 == 5'h1A);
+    assign isPiped       = isFused || isAdd || isMultiply || isFromInteger;
+    assign isStaged      = isPiped || isToInteger;
+    assign isIterative   = isDivide || isSquareRoot;
+
+    // Per-stage state of the operation in flight: destination, whether it goes to f[rd] through
+    // the pipeline port (FCVT.W[U].S does not), and its rounding mode
+    logic       s1Valid, s2Valid, s1WritesFloat, s2WritesFloat;
+    logic [4:0] s1Destination, s2Destination;
+    logic [2:0] s1Mode, s2Mode;
+
+    assign pipeBusy = s1Valid || s2Valid;
+
+    // --- 2a. HAZARDS ---
+    // Registers the instruction in decode reads from f0-f31 (FSW: the store data), and whether it
+    // writes f[rd] through the decode port (FLW and the single-cycle/iterative operations)
+    logic isOpFp, isFusedOp, readsRs1, readsRs2, readsRs3, writesDecodePort;
+    logic [4:0] rs1, rs2, rs3, rd;
+
+    assign rs1       = instruction[19:15];
+    assign rs2       = instruction[24:20];
+    assign rs3       = instruction[31:27];
+    assign rd        = instruction[11:7];
+    assign isOpFp    = (opcode == 7'b1010011);
+    assign isFusedOp = (opcode[6:4] == 3'b100) && (opcode[1:0] == 2'b11);
+
+    assign readsRs1 = isFusedOp || (isOpFp && funct5 != 5'h1A && funct5 != 5'h1E);
+    assign readsRs2 = isFusedOp || (opcode == 7'b0100111) ||
+                      (isOpFp && (funct5 <= 5'h05 || funct5 == 5'h14));
+    assign readsRs3 = isFusedOp;
+    assign writesDecodePort = (opcode == 7'b0000111) ||
+                              (isOpFp && (funct5 == 5'h03 || funct5 == 5'h0B || funct5 == 5'h04 ||
+                                          funct5 == 5'h05 || funct5 == 5'h1E));
+
+    function automatic logic owed(input logic [4:0] register, input logic s1Owes, input logic s2Owes,
+                                  input logic [4:0] s1Register, input logic [4:0] s2Register);
+        return (s1Owes && s1Register == register) || (s2Owes && s2Register == register);
+    endfunction
+
+    // Only checked before an operation issues: once it has, the stages ahead of it were clear
+    assign hazard = (cycleCount == 5'd0) &&
+                    ((readsRs1 && owed(rs1, s1Valid && s1WritesFloat, s2Valid && s2WritesFloat, s1Destination, s2Destination)) ||
+                     (readsRs2 && owed(rs2, s1Valid && s1WritesFloat, s2Valid && s2WritesFloat, s1Destination, s2Destination)) ||
+                     (readsRs3 && owed(rs3, s1Valid && s1WritesFloat, s2Valid && s2WritesFloat, s1Destination, s2Destination)) ||
+                     (writesDecodePort && owed(rd, s1Valid && s1WritesFloat, s2Valid && s2WritesFloat, s1Destination, s2Destination)) ||
+                     (start && pipeBusy && (isIterative || hold)));
+
+    // --- 2b. SEQUENCING ---
+    // A staged operation enters stage 1 in its issue cycle. Piped ones leave decode at once;
+    // FCVT.W[U].S takes its result from stage 3 in cycle 2, divide/square root in cycle 28.
+    assign issue     = start && isStaged && (cycleCount == 5'd0) && !hazard;
+    assign pipelined = start && isPiped;
+    assign busy      = hazard || (start && ((isToInteger && cycleCount != 5'd2) || (isIterative && cycleCount != 5'd28)));
+    assign inFlight  = (cycleCount != 5'd0) || pipeBusy;
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)     cycleCount <= 5'd0;
+        else if (busy && !hazard) cycleCount <= cycleCount + 5'd1;
+        else if (!busy)          cycleCount <= 5'd0;
+    end
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            s1Valid <= 0;
+            s2Valid <= 0;
+        end else begin
+            s1Valid <= issue;
+            s2Valid <= s1Valid;
+        end
+    end
+
+    always_ff @(posedge clock) begin
+        if (issue) begin
+            s1WritesFloat <= isPiped;
+            s1Destination <= rd;
+            s1Mode        <= roundingMode;
+        end
+        if (s1Valid) begin
+            s2WritesFloat <= s1WritesFloat;
+            s2Destination <= s1Destination;
+            s2Mode        <= s1Mode;
+        end
+    end
+
+    // --- 3. STAGE 1: UNPACK, SPECIAL VALUES, MULTIPLY ---
+    // (-1)^negateProduct * mulA * mulB + (-1)^negateAddend * addC. FADD/FSUB multiply by 1.0;
+    // FMUL has no addend (a zero that takes the product's sign).
+    logic [31:0] mulA, mulB, addC;
+    logic        negateProduct, negateAddend, productSign, addendSign;
+    logic        productInvalid, productInf, productZero, addendZero;
+    logic [23:0] sigA, sigB, sigC;
+    logic [47:0] product;
+    logic signed [11:0] expA, expB, expC;
+
+    logic        unpackSpecial, unpackProductSign, unpackAddendSign, unpackProductZero, unpackAddendZero;
+    logic [31:0] unpackResult;
+    logic [4:0]  unpackFlags;
+    logic [79:0] unpackProductTerm, unpackAddendTerm;
+    logic signed [11:0] unpackProductLsb, unpackAddendLsb;
+
+    // FCVT.W[U].S: rounded as 32.32 fixed point
+    logic signed [11:0] fixedShift;
+    logic [79:0] fixedJam;
+    logic [63:0] fixedValue;
+    logic [32:0] fixedRounded;
+    logic        fixedOverflow;
+    logic [31:0] saturatePositive, saturateNegative, magnitude;
+
+    assign mulA = operandA;
+    assign mulB = isAdd ? ONE : operandB;
+    assign addC = isAdd ? operandB : isMultiply ? 32'b0 : operandC;
+
+    assign negateProduct = isFused && opcode[3];
+    assign negateAddend  = (isFused && opcode[2]) || (isAdd && funct5[0]);
+    assign productSign   = mulA[31] ^ mulB[31] ^ negateProduct;
+    assign addendSign    = isMultiply ? productSign : (addC[31] ^ negateAddend);
+
+    assign productInvalid = (isInf(mulA) && isZero(mulB)) || (isZero(mulA) && isInf(mulB));
+    assign productInf     = (isInf(mulA) || isInf(mulB)) && !productInvalid;
+    assign productZero    = isZero(mulA) || isZero(mulB);
+    assign addendZero     = isZero(addC);
+
+    assign sigA = significandOf(mulA);
+    assign sigB = significandOf(mulB);
+    assign sigC = significandOf(addC);
+    assign product = sigA * sigB;
+    assign expA = exponentOf(mulA);
+    assign expB = exponentOf(mulB);
+    assign expC = exponentOf(addC);
+
+    assign saturatePositive = isSignedConversion ? 32'h7FFFFFFF : 32'hFFFFFFFF;
+    assign saturateNegative = isSignedConversion ? 32'h80000000 : 32'h00000000;
+    assign fixedShift       = expA + 12'sd9;
+    assign magnitude        = (isSignedConversion && integerOperand[31]) ? -integerOperand : integerOperand;
+
+    always_comb begin
+        fixedJam      = shiftRightJam({56'b0, sigA}, 12'(-fixedShift));
+        fixedValue    = (fixedShift >= 0) ? ({40'b0, sigA} << fixedShift[5:0]) : fixedJam[63:0];
+        fixedRounded  = {1'b0, fixedValue[63:32]} +
+                        33'(roundIncrement(roundingMode, mulA[31], fixedValue[32], fixedValue[31], fixedValue[30:0] != 0));
+        fixedOverflow = isSignedConversion ? (fixedRounded > (mulA[31] ? 33'h080000000 : 33'h07FFFFFFF))
+                                           : (mulA[31] ? (fixedRounded != 0) : fixedRounded[32]);
+    end
+
+    always_comb begin
+        unpackSpecial     = 1'b0;
+        unpackResult      = 32'b0;
+        unpackFlags       = 5'b0;
+        unpackProductSign = productSign;
+        unpackAddendSign  = addendSign;
+        unpackProductZero = productZero;
+        unpackAddendZero  = addendZero;
+        unpackProductTerm = {1'b0, product, 31'b0};     // 48-bit product at [78:31]
+        unpackAddendTerm  = {1'b0, sigC, 55'b0};        // Addend at [78:55]
+        unpackProductLsb  = expA + expB - 12'sd77;
+        unpackAddendLsb   = expC - 12'sd78;
+
+        if (isToInteger) begin
+            unpackSpecial = 1'b1;
+            if (isNan(mulA)) begin
+                unpackResult = saturatePositive;
+                unpackFlags  = FLAG_NV;
+            end else if (isInf(mulA) || (!isZero(mulA) && (expA >= 12'sd32 || fixedOverflow))) begin
+                unpackResult = mulA[31] ? saturateNegative : saturatePositive;
+                unpackFlags  = FLAG_NV;
+            end else if (!isZero(mulA)) begin
+                unpackResult = mulA[31] ? -fixedRounded[31:0] : fixedRounded[31:0];
+                unpackFlags  = (fixedValue[31:0] != 0) ? FLAG_NX : 5'b0;
+            end
+        end else if (isFromInteger) begin
+            // The magnitude at [79:48] is the addend of a zero product
+            unpackSpecial     = (magnitude == 0);
+            unpackProductZero = 1'b1;
+            unpackAddendZero  = 1'b0;
+            unpackAddendSign  = isSignedConversion && integerOperand[31];
+            unpackAddendTerm  = {magnitude, 48'b0};
+            unpackAddendLsb   = -12'sd48;
+        end else begin
+            unpackSpecial = 1'b1;
+            if (isSignallingNan(mulA) || isSignallingNan(mulB) || isSignallingNan(addC)) unpackFlags = FLAG_NV;
+            if (productInvalid) begin // Even with a quiet NaN addend
+                unpackResult = CANONICAL_NAN;
+                unpackFlags  = FLAG_NV;
+            end else if (isNan(mulA) || isNan(mulB) || isNan(addC)) begin
+                unpackResult = CANONICAL_NAN;
+            end else if (productInf && isInf(addC) && productSign != addendSign) begin
+                unpackResult = CANONICAL_NAN;
+                unpackFlags  = FLAG_NV;
+            end else if (productInf) begin
+                unpackResult = {productSign, 31'h7F800000};
+            end else if (isInf(addC)) begin
+                unpackResult = {addendSign, 31'h7F800000};
+            end else if (productZero && addendZero) begin
+                unpackResult = {(productSign == addendSign) ? productSign : (roundingMode == RDN), 31'b0};
+            end else begin
+                unpackSpecial = 1'b0;
+            end
+        end
+    end
+
+    logic        s1Special, s1ProductSign, s1AddendSign, s1ProductZero, s1AddendZero;
+    logic [31:0] s1Result;
+    logic [4:0]  s1Flags;
+    logic [79:0] s1ProductTerm, s1AddendTerm;
+    logic signed [11:0] s1ProductLsb, s1AddendLsb;
+
+    always_ff @(posedge clock) begin
+        if (issue) begin
+            s1Special     <= unpackSpecial;
+            s1Result      <= unpackResult;
+            s1Flags       <= unpackFlags;
+            s1ProductSign <= unpackProductSign;
+            s1AddendSign  <= unpackAddendSign;
+            s1ProductZero <= unpackProductZero;
+            s1AddendZero  <= unpackAddendZero;
+            s1ProductTerm <= unpackProductTerm;
+            s1AddendTerm  <= unpackAddendTerm;
+            s1ProductLsb  <= unpackProductLsb;
+            s1AddendLsb   <= unpackAddendLsb;
+        end
+    end
+
+    // --- 4. STAGE 2: ALIGN & ADD ---
+    // The term with the finer LSB is shifted onto the other's grid
+    logic        productFirst, bigSign, smallSign, sumSign, sumSpecial;
+    logic [79:0] bigTerm, smallTerm, sum;
+    logic signed [11:0] sumLsb;
+    logic [31:0] sumResult;
+
+    assign productFirst = (s1ProductLsb >= s1AddendLsb);
+    assign bigTerm      = productFirst ? s1ProductTerm : s1AddendTerm;
+    assign bigSign      = productFirst ? s1ProductSign : s1AddendSign;
+    assign smallSign    = productFirst ? s1AddendSign : s1ProductSign;
+    assign smallTerm    = productFirst ? shiftRightJam(s1AddendTerm, 12'(s1ProductLsb - s1AddendLsb))
+                                       : shiftRightJam(s1ProductTerm, 12'(s1AddendLsb - s1ProductLsb));
+
+    always_comb begin
+        sumSpecial = s1Special;
+        sumResult  = s1Result;
+        if (s1AddendZero) begin
+            sum = s1ProductTerm; sumSign = s1ProductSign; sumLsb = s1ProductLsb;
+        end else if (s1ProductZero) begin
+            sum = s1AddendTerm;  sumSign = s1AddendSign;  sumLsb = s1AddendLsb;
+        end else begin
+            sumLsb = productFirst ? s1ProductLsb : s1AddendLsb;
+            if (bigSign == smallSign) begin
+                sum = bigTerm + smallTerm;   sumSign = bigSign;
+            end else if (bigTerm >= smallTerm) begin
+                sum = bigTerm - smallTerm;   sumSign = bigSign;
+            end else begin
+                sum = smallTerm - bigTerm;   sumSign = smallSign;
+            end
+            if (sum == 0 && !s1Special) begin // Exact cancellation
+                sumSpecial = 1'b1;
+                sumResult  = {s1Mode == RDN, 31'b0};
+            end
+        end
+    end
+
+    logic        s2Special, s2Sign;
+    logic [31:0] s2Result;
+    logic [4:0]  s2Flags;
+    logic [79:0] s2Sum;
+    logic signed [11:0] s2Lsb;
+
+    always_ff @(posedge clock) begin
+        if (s1Valid) begin
+            s2Special <= sumSpecial;
+            s2Result  <= sumResult;
+            s2Flags   <= s1Flags;
+            s2Sum     <= sum;
+            s2Sign    <= sumSign;
+            s2Lsb     <= sumLsb;
+        end
+    end
+
+    // --- 5. DIVIDE & SQUARE ROOT (one bit per cycle) ---
+    // Cycle 0 loads the significands, cycles 1-27 each produce one quotient/root bit, and the
+    // remainder becomes the sticky bit. Restoring division; the root is digit by digit over a
+    // 54-bit radicand (the significand, shifted once more for an odd exponent).
+    logic [26:0] iterRoot;        // Quotient or root
+    logic [31:0] iterRemainder;
+    logic [23:0] iterDivisor;
+    logic [53:0] iterRadicand;
+    logic signed [11:0] iterLsb, rootExponent;
+    logic        iterSign, iterSpecial;
+    logic [31:0] iterResult, rootRemainder;
+    logic [28:0] rootTrial;
+    logic [4:0]  iterFlags;
+
+    assign rootExponent  = expA - 12'sd23;
+    assign rootRemainder = {iterRemainder[29:0], iterRadicand[53:52]};
+    assign rootTrial     = {iterRoot, 2'b01};
+
+    always_ff @(posedge clock) begin
+        if (busy && !hazard && isIterative) begin
+            if (cycleCount == 5'd0) begin
+                iterRoot  <= 27'b0;
+                iterSign  <= isDivide && (operandA[31] ^ operandB[31]);
+                if (isDivide) begin
+                    iterRemainder <= {8'b0, sigA};
+                    iterDivisor   <= sigB;
+                    iterLsb       <= expA - expB - 12'sd79;
+                end else begin
+                    iterRemainder <= 32'b0;
+                    iterRadicand  <= rootExponent[0] ? {1'b0, sigA, 29'b0} : {2'b0, sigA, 28'b0};
+                    iterLsb       <= ((rootExponent - $signed({11'b0, rootExponent[0]}) - 12'sd28) >>> 1) - 12'sd53;
+                end
+            end else if (isDivide) begin
+                iterRoot      <= {iterRoot[25:0], iterRemainder >= {8'b0, iterDivisor}};
+                iterRemainder <= ((iterRemainder >= {8'b0, iterDivisor}) ? iterRemainder - {8'b0, iterDivisor}
+                                                                       : iterRemainder) << 1;
+            end else begin
+                iterRoot      <= {iterRoot[25:0], rootRemainder >= {3'b0, rootTrial}};
+                iterRemainder <= (rootRemainder >= {3'b0, rootTrial}) ? rootRemainder - {3'b0, rootTrial}
+                                                                      : rootRemainder;
+                iterRadicand  <= iterRadicand << 2;
+            end
+        end
+    end
+
+    // Special operands (the operands are still in decode when the result is taken)
+    always_comb begin
+        iterSpecial = 1'b1;
+        iterResult  = 32'b0;
+        iterFlags   = 5'b0;
+        if (isDivide) begin
+            if (isSignallingNan(operandA) || isSignallingNan(operandB)) iterFlags = FLAG_NV;
+            if (isNan(operandA) || isNan(operandB)) begin
+                iterResult = CANONICAL_NAN;
+            end else if ((isInf(operandA) && isInf(operandB)) || (isZero(operandA) && isZero(operandB))) begin
+                iterResult = CANONICAL_NAN;
+                iterFlags  = FLAG_NV;
+            end else if (isInf(operandA) || isZero(operandB)) begin
+                iterResult = {operandA[31] ^ operandB[31], 31'h7F800000};
+                if (!isInf(operandA)) iterFlags = FLAG_DZ;
+            end else if (isZero(operandA) || isInf(operandB)) begin
+                iterResult = {operandA[31] ^ operandB[31], 31'b0};
+            end else begin
+                iterSpecial = 1'b0;
+            end
+        end else begin
+            if (isSignallingNan(operandA)) iterFlags = FLAG_NV;
+            if (isNan(operandA)) begin
+                iterResult = CANONICAL_NAN;
+            end else if (isZero(operandA)) begin
+                iterResult = operandA;
+            end else if (operandA[31]) begin
+                iterResult = CANONICAL_NAN;
+                iterFlags  = FLAG_NV;
+            end else if (isInf(operandA)) begin
+                iterResult = operandA;
+            end else begin
+                iterSpecial = 1'b0;
+            end
+        end
+    end
+
+    // --- 6. STAGE 3: NORMALIZE & ROUND (shared: divide/square root only run with the pipeline empty) ---
+    // Rounds sig * 2^lsb (leading one at bit 23 or above) to single precision. Tininess is
+    // detected after rounding: only an exponent of -127 can round up to 2^-126.
+    logic        roundSign, roundBit, stickyBit, inexact, tiny, tinyRoundBit, tinyStickyBit, toInf;
+    logic [2:0]  roundMode;
+    logic [79:0] roundSig, keptWide, halfWide, tinyKeptWide, tinyHalfWide;
+    logic signed [11:0] roundLsb, roundExp, shiftWide, biased;
+    logic [6:0]  roundMsb, roundShift, tinyShift;
+    logic [24:0] rounded;
+    logic [31:0] roundResult;
+    logic [4:0]  roundFlags;
+
+    assign roundSign = s2Valid ? s2Sign : iterSign;
+    assign roundLsb  = s2Valid ? s2Lsb : iterLsb;
+    assign roundSig  = s2Valid ? s2Sum : {iterRoot, 53'b0} | {79'b0, iterRemainder != 0};
+    assign roundMode = s2Valid ? s2Mode : roundingMode;
+
+    always_comb begin
+        roundMsb   = msbIndex(roundSig);
+        roundExp   = roundLsb + $signed({5'b0, roundMsb});
+        shiftWide  = (roundExp >= -12'sd126) ? $signed({5'b0, roundMsb}) - 12'sd23 : -12'sd149 - roundLsb;
+        roundShift = (shiftWide > 12'sd81) ? 7'd81 : shiftWide[6:0];
+
+        keptWide  = roundSig >> roundShift;
+        halfWide  = roundSig >> (roundShift - 7'd1);
+        roundBit  = (roundShift != 0) && halfWide[0];
+        stickyBit = (roundShift > 1) && ((roundSig & ((80'b1 << (roundShift - 7'd1)) - 80'b1)) != 0);
+        rounded   = keptWide[24:0] + 25'(roundIncrement(roundMode, roundSign, keptWide[0], roundBit, stickyBit));
+        inexact   = roundBit || stickyBit;
+
+        tinyShift     = roundMsb - 7'd23;
+        tinyKeptWide  = roundSig >> tinyShift;
+        tinyHalfWide  = roundSig >> (tinyShift - 7'd1);
+        tinyRoundBit  = (tinyShift != 0) && tinyHalfWide[0];
+        tinyStickyBit = (tinyShift > 1) && ((roundSig & ((80'b1 << (tinyShift - 7'd1)) - 80'b1)) != 0);
+        tiny          = (roundExp < -12'sd126) &&
+                        !(roundExp == -12'sd127 && tinyKeptWide[23:0] == 24'hFFFFFF &&
+                          roundIncrement(roundMode, roundSign, 1'b1, tinyRoundBit, tinyStickyBit));
+
+        roundFlags = {3'b0, tiny && inexact, inexact};
+        biased     = roundExp + 12'sd127 + $signed({11'b0, rounded[24]});
+        toInf      = (roundMode == RNE) || (roundMode == RMM) || (roundMode == RDN && roundSign) ||
+                     (roundMode == RUP && !roundSign);
+
+        if (roundExp < -12'sd126) begin
+            roundResult = {roundSign, 7'b0, rounded[23:0]}; // Subnormal; a carry into bit 23 gives 2^-126
+        end else if (biased >= 12'sd255) begin
+            roundResult = toInf ? {roundSign, 31'h7F800000} : {roundSign, 31'h7F7FFFFF};
+            roundFlags  = FLAG_OF | FLAG_NX;
+        end else begin
+            roundResult = {roundSign, biased[7:0], rounded[22:0]};
+        end
+    end
+
+    // --- 7. SINGLE-CYCLE OPERATIONS & RESULT ---
+    logic [31:0] singleResult, minMaxPick;
+    logic [4:0]  singleFlags;
+    logic        anyNan, equal;
+
+    assign anyNan = isNan(operandA) || isNan(operandB);
+    assign equal  = (operandA == operandB) || ((operandA[30:0] | operandB[30:0]) == 0);
+
+    always_comb begin
+        singleFlags = 5'b0;
+        minMaxPick  = (less(operandA, operandB, 1'b1) != funct3[0]) ? operandA : operandB;
+        case (funct5)
+            5'h04: // FSGNJ / FSGNJN / FSGNJX: no flags, NaN payloads kept
+                singleResult = {(funct3 == 3'd0) ? operandB[31] : (funct3 == 3'd1) ? !operandB[31] :
+                                operandA[31] ^ operandB[31], operandA[30:0]};
+            5'h05: begin // FMIN / FMAX: a NaN operand yields the other one
+                if (isSignallingNan(operandA) || isSignallingNan(operandB)) singleFlags = FLAG_NV;
+                singleResult = (isNan(operandA) && isNan(operandB)) ? CANONICAL_NAN :
+                               isNan(operandA) ? operandB : isNan(operandB) ? operandA : minMaxPick;
+            end
+            5'h14: begin // FLE / FLT (signalling), FEQ (quiet)
+                if ((funct3 == 3'd2) ? (isSignallingNan(operandA) || isSignallingNan(operandB)) : anyNan)
+                    singleFlags = FLAG_NV;
+                singleResult = {31'b0, !anyNan && ((funct3 == 3'd2) ? equal :
+                                                   (funct3 == 3'd1) ? less(operandA, operandB, 1'b0) :
+                                                   (less(operandA, operandB, 1'b0) || equal))};
+            end
+            5'h1C:   singleResult = (funct3 == 3'd0) ? operandA : classify(operandA); // FMV.X.W / FCLASS
+            default: singleResult = integerOperand;                                     // FMV.W.X
+        endcase
+    end
+
+    // Pipeline write-back (f destinations) and the decode result (FCVT.W[U].S reads stage 3 in
+    // its last cycle; a piped operation's decode result is unused)
+    assign pipeWriteEnable  = s2Valid && s2WritesFloat;
+    assign pipeWriteAddress = s2Destination;
+    assign pipeWriteData    = s2Special ? s2Result : roundResult;
+    assign pipeWriteFlags   = s2Special ? s2Flags : roundFlags;
+
+    always_comb begin
+        if (isStaged) begin
+            result         = s2Special ? s2Result : roundResult;
+            exceptionFlags = s2Special ? s2Flags : roundFlags;
+        end else if (isIterative) begin
+            result         = iterSpecial ? iterResult : roundResult;
+            exceptionFlags = iterSpecial ? iterFlags : roundFlags;
+        end else begin
+            result         = singleResult;
+            exceptionFlags = singleFlags;
+        end
+    end
+
+endmodule
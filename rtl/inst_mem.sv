@@ -3,23 +3,49 @@ module inst_mem (
     input  logic [31:0] romAxiReadAddress, 
     output logic [31:0] romAxiReadData,
     
+    // Port D: Instruction Fetch for hart 1
+    input  logic [31:0] hart1ReadAddress,
+    output logic [31:0] hart1ReadData,
+
     // Port B: Data Bus Read (Allows CPU/DMA to read ROM constants)
     input  logic [31:0] busReadAddress,
-    output logic [31:0] busReadData
+    output logic [31:0] busReadData,
+
+    // Port C: Program RAM Load (bootloader, 0x00004000 - 0x00007FFF only)
+    input  logic        clock,
+    input  logic        loadWriteEnable,
+    input  logic [31:0] loadWriteAddress,
+    input  logic [31:0] loadWriteData
 );
 
-    // 4KB ROM: 1024 words (32-bit each) 
-    logic [31:0] romArray [0:1023];
+    // 32KB: 16KB boot ROM (0x0000) + 16KB program RAM (0x4000), 8192 words (32-bit each)
+    logic [31:0] romArray [0:8191] /* verilator public_flat */;
 
     // Initialize memory from hex file at startup 
     initial begin
         $readmemh("firmware/firmware.hex", romArray);
     end
 
-    // Port A Read: Word-aligned indexing using address bits [11:2]
-    assign romAxiReadData = romArray[romAxiReadAddress[11:2]];
+    // Ports A/D Read: the 32 bits starting at a halfword-aligned PC (RV32C). At PC[1] = 1 the
+    // window is the upper half of the word and the lower half of the next one, so a 32-bit
+    // instruction that straddles two words is fetched in one cycle.
+    logic [12:0] fetchIndex0, fetchIndex1;
+
+    assign fetchIndex0 = romAxiReadAddress[14:2];
+    assign fetchIndex1 = hart1ReadAddress[14:2];
+
+    assign romAxiReadData = romAxiReadAddress[1] ? {romArray[fetchIndex0 + 13'd1][15:0], romArray[fetchIndex0][31:16]} :
+                                                   romArray[fetchIndex0];
+    assign hart1ReadData  = hart1ReadAddress[1]  ? {romArray[fetchIndex1 + 13'd1][15:0], romArray[fetchIndex1][31:16]} :
+                                                   romArray[fetchIndex1];
     
     // Port B Read: Enables "Von Neumann access" to ROM data 
-    assign busReadData    = romArray[busReadAddress[11:2]];
+    assign busReadData    = romArray[busReadAddress[14:2]];
+
+    // Port C Write: the boot ROM half stays read-only
+    always_ff @(posedge clock) begin
+        if (loadWriteEnable && loadWriteAddress[14])
+            romArray[loadWriteAddress[14:2]] <= loadWriteData;
+    end
 
 endmodule
\ No newline at end of file
@@ -0,0 +1,53 @@
+module ram_backend #(
+    parameter latencyCycles = 8,    // Cycles per line transfer (>= 1); models SRAM/DRAM access time
+    parameter lineWords     = 4,    // 32-bit words moved per request (matches dcache line size)
+    parameter ramWords      = 1024  // Capacity in words (default 4KB)
+) (
+    input  logic                    clock,
+    input  logic                    resetActiveLow,
+
+    // Line Interface (driven by dcache)
+    input  logic                    memRequest,     // Held high until memDone
+    input  logic                    memWrite,       // 1: write-back, 0: line fill
+    input  logic [31:0]             memLineAddress, // Line-aligned byte address
+    input  logic [lineWords*32-1:0] memWriteLine,   // Dirty line being evicted
+    output logic [lineWords*32-1:0] memReadLine,    // Line returned for a fill
+    output logic                    memDone         // Single-cycle completion strobe
+);
+
+    localparam WORD_BITS = $clog2(ramWords);
+
+    logic [31:0] ramArray [0:ramWords-1] /* verilator public_flat */;
+    logic [15:0] latencyCounter;
+    logic [WORD_BITS-1:0] baseIndex;
+
+    assign baseIndex = memLineAddress[WORD_BITS+1:2];
+
+    // --- 1. LATENCY MODEL ---
+    // Counts up while a request is held; the access completes on the last cycle
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow)
+            latencyCounter <= 0;
+        else if (!memRequest || memDone)
+            latencyCounter <= 0;
+        else
+            latencyCounter <= latencyCounter + 1;
+    end
+
+    assign memDone = memRequest && (latencyCounter == 16'(latencyCycles - 1));
+
+    // --- 2. LINE WRITE (Evictions) ---
+    always_ff @(posedge clock) begin
+        if (memDone && memWrite) begin
+            for (int w = 0; w < lineWords; w++)
+                ramArray[baseIndex + WORD_BITS'(w)] <= memWriteLine[w*32 +: 32];
+        end
+    end
+
+    // --- 3. LINE READ (Fills) ---
+    always_comb begin
+        for (int w = 0; w < lineWords; w++)
+            memReadLine[w*32 +: 32] = ramArray[baseIndex + WORD_BITS'(w)];
+    end
+
+endmodule
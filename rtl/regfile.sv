@@ -9,7 +9,7 @@ module regfile (
     output logic [31:0] readData1
 );
 
-logic [31:0] registerFile [31:0]; //32 registers, 32 bits each
+logic [31:0] registerFile [31:0] /* verilator public_flat */; //32 registers, 32 bits each (read by sim/soc_fuzz.cpp)
 
 //On clock positive edge
 always_ff @(posedge clock) begin
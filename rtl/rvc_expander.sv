@@ -0,0 +1,113 @@
+module rvc_expander (
+    input  logic [31:0] fetchData,     // 32 bits at the PC (the upper half is unused by a compressed instruction)
+    output logic [31:0] instruction,   // RV32I/A/F instruction for controller/imm_gen
+    output logic        isCompressed   // 16-bit instruction: the PC advances by 2
+);
+
+    // RV32C decompressor in front of the decoder, so the rest of the hart only sees 32-bit encodings.
+    // C.FLW/C.FSW(SP) expand to FLW/FSW for the FPU; reserved encodings and the double-precision
+    // loads/stores expand to 0, which the controller executes as a NOP. The C++ reference is
+    // sim/rv32c_expand.h.
+
+    logic [15:0] c;
+    logic [4:0]  rd, rs2, rdp, rs1p;   // rd'/rs2' and rs1'/rd' select x8-x15
+    logic [31:0] imm6;
+    logic [11:0] offsetW;
+    logic [11:0] addi4spnImm, lwspImm, swspImm, addi16spImm;
+    logic [20:0] offsetJ;
+    logic [12:0] offsetB;
+    logic [31:0] expanded;
+
+    assign c            = fetchData[15:0];
+    assign isCompressed = (c[1:0] != 2'b11);
+
+    assign rd       = c[11:7];
+    assign rs2      = c[6:2];
+    assign rdp      = {2'b01, c[4:2]};
+    assign rs1p     = {2'b01, c[9:7]};
+    assign imm6     = {{26{c[12]}}, c[12], c[6:2]};
+
+    // Scaled immediates of the compressed formats
+    assign offsetW     = {5'b0, c[5], c[12:10], c[6], 2'b0};                       // C.LW/C.SW
+    assign addi4spnImm = {2'b0, c[10:7], c[12:11], c[5], c[6], 2'b0};
+    assign lwspImm     = {4'b0, c[3:2], c[12], c[6:4], 2'b0};
+    assign swspImm     = {4'b0, c[8:7], c[12:9], 2'b0};
+    assign addi16spImm = {{3{c[12]}}, c[4:3], c[5], c[2], c[6], 4'b0};
+    assign offsetJ     = {{10{c[12]}}, c[8], c[10:9], c[6], c[7], c[2], c[11], c[5:3], 1'b0};
+    assign offsetB     = {{5{c[12]}}, c[6:5], c[2], c[11:10], c[4:3], 1'b0};
+
+    always_comb begin
+        expanded = 32'b0;
+        case ({c[15:13], c[1:0]})
+            // --- Quadrant 0 ---
+            5'b000_00: // C.ADDI4SPN -> addi rd', sp, nzuimm
+                if (addi4spnImm != 0) expanded = {addi4spnImm, 5'd2, 3'b000, rdp, 7'b0010011};
+            5'b010_00: // C.LW -> lw rd', uimm(rs1')
+                expanded = {offsetW, rs1p, 3'b010, rdp, 7'b0000011};
+            5'b110_00: // C.SW -> sw rs2', uimm(rs1')
+                expanded = {offsetW[11:5], rdp, rs1p, 3'b010, offsetW[4:0], 7'b0100011};
+            5'b011_00: // C.FLW -> flw rd', uimm(rs1')
+                expanded = {offsetW, rs1p, 3'b010, rdp, 7'b0000111};
+            5'b111_00: // C.FSW -> fsw rs2', uimm(rs1')
+                expanded = {offsetW[11:5], rdp, rs1p, 3'b010, offsetW[4:0], 7'b0100111};
+
+            // --- Quadrant 1 ---
+            5'b000_01: // C.ADDI (C.NOP) -> addi rd, rd, imm
+                expanded = {imm6[11:0], rd, 3'b000, rd, 7'b0010011};
+            5'b001_01: // C.JAL -> jal ra, offset
+                expanded = {offsetJ[20], offsetJ[10:1], offsetJ[11], offsetJ[19:12], 5'd1, 7'b1101111};
+            5'b010_01: // C.LI -> addi rd, zero, imm
+                expanded = {imm6[11:0], 5'd0, 3'b000, rd, 7'b0010011};
+            5'b011_01:
+                if (rd == 5'd2) begin // C.ADDI16SP -> addi sp, sp, nzimm
+                    if (addi16spImm != 0) expanded = {addi16spImm, 5'd2, 3'b000, 5'd2, 7'b0010011};
+                end else if (imm6 != 0) begin // C.LUI -> lui rd, nzimm
+                    expanded = {imm6[19:0], rd, 7'b0110111};
+                end
+            5'b100_01: // Arithmetic on rd' (shift amounts above 31 and the RV64 forms are reserved)
+                case (c[11:10])
+                    2'b00: if (!c[12]) expanded = {7'b0000000, rs2, rs1p, 3'b101, rs1p, 7'b0010011}; // C.SRLI
+                    2'b01: if (!c[12]) expanded = {7'b0100000, rs2, rs1p, 3'b101, rs1p, 7'b0010011}; // C.SRAI
+                    2'b10: expanded = {imm6[11:0], rs1p, 3'b111, rs1p, 7'b0010011};                           // C.ANDI
+                    default:
+                        if (!c[12]) begin
+                            case (c[6:5])
+                                2'b00:   expanded = {7'b0100000, rdp, rs1p, 3'b000, rs1p, 7'b0110011}; // C.SUB
+                                2'b01:   expanded = {7'b0000000, rdp, rs1p, 3'b100, rs1p, 7'b0110011}; // C.XOR
+                                2'b10:   expanded = {7'b0000000, rdp, rs1p, 3'b110, rs1p, 7'b0110011}; // C.OR
+                                default: expanded = {7'b0000000, rdp, rs1p, 3'b111, rs1p, 7'b0110011}; // C.AND
+                            endcase
+                        end
+                endcase
+            5'b101_01: // C.J -> jal zero, offset
+                expanded = {offsetJ[20], offsetJ[10:1], offsetJ[11], offsetJ[19:12], 5'd0, 7'b1101111};
+            5'b110_01, 5'b111_01: // C.BEQZ / C.BNEZ -> beq/bne rs1', zero, offset
+                expanded = {offsetB[12], offsetB[10:5], 5'd0, rs1p, 2'b00, c[13], offsetB[4:1], offsetB[11], 7'b1100011};
+
+            // --- Quadrant 2 ---
+            5'b000_10: // C.SLLI -> slli rd, rd, shamt
+                if (!c[12]) expanded = {7'b0000000, rs2, rd, 3'b001, rd, 7'b0010011};
+            5'b010_10: // C.LWSP -> lw rd, uimm(sp)
+                if (rd != 0) expanded = {lwspImm, 5'd2, 3'b010, rd, 7'b0000011};
+            5'b100_10:
+                if (!c[12]) begin
+                    if (rs2 != 0)     expanded = {7'b0, rs2, 5'd0, 3'b000, rd, 7'b0110011};   // C.MV -> add rd, zero, rs2
+                    else if (rd != 0) expanded = {12'b0, rd, 3'b000, 5'd0, 7'b1100111};      // C.JR -> jalr zero, 0(rs1)
+                end else begin
+                    if (rs2 != 0)     expanded = {7'b0, rs2, rd, 3'b000, rd, 7'b0110011};     // C.ADD -> add rd, rd, rs2
+                    else if (rd != 0) expanded = {12'b0, rd, 3'b000, 5'd1, 7'b1100111};      // C.JALR -> jalr ra, 0(rs1)
+                    else              expanded = 32'h00100073;                                 // C.EBREAK
+                end
+            5'b110_10: // C.SWSP -> sw rs2, uimm(sp)
+                expanded = {swspImm[11:5], rs2, 5'd2, 3'b010, swspImm[4:0], 7'b0100011};
+            5'b011_10: // C.FLWSP -> flw rd, uimm(sp) (any f register, f0 included)
+                expanded = {lwspImm, 5'd2, 3'b010, rd, 7'b0000111};
+            5'b111_10: // C.FSWSP -> fsw rs2, uimm(sp)
+                expanded = {swspImm[11:5], rs2, 5'd2, 3'b010, swspImm[4:0], 7'b0100111};
+            default: ; // C.FLD/FSD(SP) and the reserved quadrant-0 slot
+        endcase
+    end
+
+    assign instruction = isCompressed ? expanded : fetchData;
+
+endmodule
@@ -0,0 +1,51 @@
+module sync_fifo #(
+    parameter dataWidth = 8,  // Bits per entry
+    parameter depth     = 16  // Entries (power of 2)
+) (
+    input  logic                      clock,
+    input  logic                      resetActiveLow,
+
+    // Write Side (ignored while full)
+    input  logic                      pushValid,
+    input  logic [dataWidth-1:0]      pushData,
+
+    // Read Side (popData is the head entry, valid while !isEmpty)
+    input  logic                      popReady,
+    output logic [dataWidth-1:0]      popData,
+
+    // Status
+    output logic                      isEmpty,
+    output logic                      isFull,
+    output logic [$clog2(depth):0]    level
+);
+
+    localparam PTR_BITS = (depth > 1) ? $clog2(depth) : 1;
+
+    logic [dataWidth-1:0] fifoArray [0:depth-1];
+    logic [PTR_BITS-1:0]  headPointer, tailPointer;
+    logic                 doPush, doPop;
+
+    assign isEmpty = (level == 0);
+    assign isFull  = (level == ($clog2(depth)+1)'(depth));
+    assign doPush  = pushValid && !isFull;
+    assign doPop   = popReady && !isEmpty;
+    assign popData = fifoArray[headPointer];
+
+    always_ff @(posedge clock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            headPointer <= 0;
+            tailPointer <= 0;
+            level       <= 0;
+        end else begin
+            if (doPush) begin
+                fifoArray[tailPointer] <= pushData;
+                tailPointer            <= tailPointer + 1;
+            end
+            if (doPop) headPointer <= headPointer + 1;
+
+            if (doPush && !doPop)      level <= level + 1;
+            else if (!doPush && doPop) level <= level - 1;
+        end
+    end
+
+endmodule
@@ -0,0 +1,113 @@
+module uart_rx #(parameter clocksPerBit = 108) (
+    input  logic       systemClock,
+    input  logic       resetActiveLow,
+    input  logic       serialDataInput,
+    output logic [7:0] receivedByte,
+    output logic       isReceiveValid,  // Single cycle: receivedByte holds a new frame
+    output logic       isFramingError   // Single cycle: stop bit sampled low (frame dropped)
+);
+
+    // State machine encodings
+    localparam stateIdle          = 2'b00;
+    localparam stateReceiveStart  = 2'b01;
+    localparam stateReceiveData   = 2'b10;
+    localparam stateReceiveStop   = 2'b11;
+
+    // Oversampling: three samples around the bit centre, majority vote
+    localparam SAMPLE_EARLY  = clocksPerBit / 2 - 1;
+    localparam SAMPLE_CENTRE = clocksPerBit / 2;
+    localparam SAMPLE_LATE   = clocksPerBit / 2 + 1;
+
+    logic [1:0]  mainStateMachine;
+    logic [15:0] clockCycleCounter;
+    logic [2:0]  bitIndexCounter;
+    logic [7:0]  receiveDataBuffer;
+    logic [2:0]  sampleVotes;
+    logic [1:0]  inputSynchronizer;
+    logic        serialSample, bitValue;
+
+    // Two-flop synchronizer: the line is asynchronous to systemClock
+    always_ff @(posedge systemClock or negedge resetActiveLow) begin
+        if (!resetActiveLow) inputSynchronizer <= 2'b11;
+        else                 inputSynchronizer <= {inputSynchronizer[0], serialDataInput};
+    end
+
+    assign serialSample = inputSynchronizer[1];
+    assign bitValue     = (sampleVotes[0] & sampleVotes[1]) | (sampleVotes[0] & sampleVotes[2]) |
+                          (sampleVotes[1] & sampleVotes[2]);
+
+    always_ff @(posedge systemClock or negedge resetActiveLow) begin
+        if (!resetActiveLow) begin
+            mainStateMachine  <= stateIdle;
+            clockCycleCounter <= 0;
+            bitIndexCounter   <= 0;
+            receiveDataBuffer <= 0;
+            sampleVotes       <= 3'b111;
+            isReceiveValid    <= 0;
+            isFramingError    <= 0;
+        end else begin
+            isReceiveValid <= 0;
+            isFramingError <= 0;
+
+            // Collect votes while a bit period is running
+            if (mainStateMachine != stateIdle) begin
+                if (clockCycleCounter == 16'(SAMPLE_EARLY))  sampleVotes[0] <= serialSample;
+                if (clockCycleCounter == 16'(SAMPLE_CENTRE)) sampleVotes[1] <= serialSample;
+                if (clockCycleCounter == 16'(SAMPLE_LATE))   sampleVotes[2] <= serialSample;
+            end
+
+            case (mainStateMachine)
+
+                // Wait for the falling edge of a start bit
+                stateIdle: begin
+                    clockCycleCounter <= 0;
+                    bitIndexCounter   <= 0;
+                    if (serialSample == 1'b0) mainStateMachine <= stateReceiveStart;
+                end
+
+                // Start bit must still be low at its centre, otherwise it was a glitch
+                stateReceiveStart: begin
+                    if (clockCycleCounter < clocksPerBit - 1) begin
+                        clockCycleCounter <= clockCycleCounter + 1;
+                    end else begin
+                        clockCycleCounter <= 0;
+                        mainStateMachine  <= bitValue ? stateIdle : stateReceiveData;
+                    end
+                end
+
+                // Shift in 8 bits, LSB first
+                stateReceiveData: begin
+                    if (clockCycleCounter < clocksPerBit - 1) begin
+                        clockCycleCounter <= clockCycleCounter + 1;
+                    end else begin
+                        clockCycleCounter <= 0;
+                        receiveDataBuffer <= {bitValue, receiveDataBuffer[7:1]};
+                        if (bitIndexCounter < 7) begin
+                            bitIndexCounter  <= bitIndexCounter + 1;
+                        end else begin
+                            bitIndexCounter  <= 0;
+                            mainStateMachine <= stateReceiveStop;
+                        end
+                    end
+                end
+
+                // Deliver at the stop-bit centre so the next start edge is not missed
+                stateReceiveStop: begin
+                    if (clockCycleCounter < SAMPLE_LATE + 1) begin
+                        clockCycleCounter <= clockCycleCounter + 1;
+                    end else begin
+                        clockCycleCounter <= 0;
+                        isReceiveValid    <= bitValue;
+                        isFramingError    <= !bitValue;
+                        mainStateMachine  <= stateIdle;
+                    end
+                end
+
+                default: mainStateMachine <= stateIdle;
+            endcase
+        end
+    end
+
+    assign receivedByte = receiveDataBuffer;
+
+endmodule
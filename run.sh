@@ -11,13 +11,54 @@ else
 fi
 
 if [ -z "$1" ]; then
-    echo "Usage: ./run.sh <module_name>"
+    echo "Usage: ./run.sh <module_name> [testbench args]"
     echo "Example: ./run.sh soc_top"
+    echo "         ./run.sh bench     (every firmware/bench image on soc_top -> bench_results.csv)"
+    echo "         ./run.sh batch     (every benchmark image in parallel in one process -> bench_results.csv)"
+    echo "         ./run.sh fuzz      (random programs on soc_top vs the reference model)"
+    echo "         ./run.sh vp        (firmware on the fast virtual platform, no Verilator)"
+    echo "         ./run.sh trace     (decode commit_trace.bin from ./run.sh soc_top +commit-trace=commit_trace.bin)"
     exit 1
 fi
 
 MODULE=$1
 
+# Benchmark mode runs the soc_top testbench once per benchmark image
+BENCH_MODE=0
+if [ "$MODULE" == "bench" ]; then
+    BENCH_MODE=1
+    MODULE=soc_top
+fi
+
+# Batch mode runs the same images on one soc_top model per core (sim/soc_batch.cpp)
+BATCH_MODE=0
+if [ "$MODULE" == "batch" ]; then
+    BATCH_MODE=1
+    MODULE=soc_top
+fi
+
+# Fuzz mode diffs random programs on soc_top against vp/soc_vp.h (sim/soc_fuzz.cpp)
+FUZZ_MODE=0
+if [ "$MODULE" == "fuzz" ]; then
+    FUZZ_MODE=1
+    MODULE=soc_top
+fi
+
+# Virtual platform mode builds the same firmware and runs firmware.elf on vp/soc_vp.cpp
+VP_MODE=0
+if [ "$MODULE" == "vp" ]; then
+    VP_MODE=1
+    MODULE=soc_top
+fi
+
+# Trace mode decodes an existing commit trace against the firmware that produced it (no rebuild)
+if [ "$MODULE" == "trace" ]; then
+    mkdir -p build/trace
+    g++ -std=c++17 -O2 -pthread -Isim sim/trace_dump.cpp -o build/trace/trace_dump || { echo "Trace tool build failed"; exit 1; }
+    ./build/trace/trace_dump +trace=commit_trace.bin +elf=firmware/firmware.elf "${@:2}"
+    exit $?
+fi
+
 # ---------------------------------------------------------
 # 1. COMPILE FIRMWARE
 # ---------------------------------------------------------
@@ -29,6 +70,9 @@ if [ "$MODULE" == "soc_top" ]; then
     
     # Pass the toolchain variables to Make
     make CC="$CC" OBJCOPY="$OBJCOPY" CFLAGS="$CFLAGS" || { echo "Firmware build failed"; exit 1; }
+    if [ $BENCH_MODE -eq 1 ] || [ $BATCH_MODE -eq 1 ]; then
+        make bench CC="$CC" OBJCOPY="$OBJCOPY" CFLAGS="$CFLAGS" || { echo "Benchmark build failed"; exit 1; }
+    fi
     
     # --- NEW: SYMBOL TABLE DUMP ---
     # Attempt to use the cross-compiler 'nm' (e.g. riscv64-unknown-elf-nm)
@@ -62,7 +106,55 @@ if [ "$MODULE" == "soc_top" ]; then
 fi
 
 # ---------------------------------------------------------
-# 2. RUN VERILATOR
+# 2. VIRTUAL PLATFORM (fast pre-check, seconds instead of minutes)
+# ---------------------------------------------------------
+if [ $VP_MODE -eq 1 ] || [ $BENCH_MODE -eq 1 ]; then
+    echo "--- BUILDING VIRTUAL PLATFORM ---"
+    mkdir -p build/vp
+    g++ -std=c++17 -O2 -Isim vp/soc_vp.cpp -o build/vp/soc_vp || { echo "Virtual platform build failed"; exit 1; }
+fi
+
+if [ $VP_MODE -eq 1 ]; then
+    echo "--- STARTING VIRTUAL PLATFORM ---"
+    ./build/vp/soc_vp +elf=firmware/firmware.elf "${@:2}"
+    exit $?
+fi
+
+# Benchmarks must pass on the virtual platform before the RTL run
+if [ $BENCH_MODE -eq 1 ]; then
+    echo "--- BENCHMARK PRE-CHECK (virtual platform) ---"
+    for ELF in firmware/bench_*.elf; do
+        ./build/vp/soc_vp +elf=$ELF +noirq +max-cycles=5000000 > /dev/null \
+            || { echo "Pre-check failed: $ELF (./build/vp/soc_vp +elf=$ELF)"; exit 1; }
+    done
+    echo "All images pass on the virtual platform"
+fi
+
+# Batch mode: one multi-threaded binary runs every image (or +jobs=<file>, +timer-limits=<sweep>)
+if [ $BATCH_MODE -eq 1 ]; then
+    echo "--- BUILDING BATCH RUNNER ---"
+    rm -rf obj_batch
+    verilator --cc rtl/soc_top.sv --exe sim/soc_batch.cpp -Irtl -Isim --top-module soc_top -Mdir obj_batch \
+        -LDFLAGS -pthread > /dev/null || { echo "Verilator compilation failed!"; exit 1; }
+    make -C obj_batch -f Vsoc_top.mk -j"$(nproc)" > /dev/null || { echo "Batch runner build failed"; exit 1; }
+    rm -f bench_results.csv
+    ./obj_batch/Vsoc_top +images=$(ls firmware/bench_*.bin | paste -sd, -) +report=bench_results.csv "${@:2}"
+    exit $?
+fi
+
+# Fuzz mode: generated programs replace the ROM, so the firmware only satisfies $readmemh
+if [ $FUZZ_MODE -eq 1 ]; then
+    echo "--- BUILDING FUZZER ---"
+    rm -rf obj_fuzz
+    verilator --cc rtl/soc_top.sv --exe sim/soc_fuzz.cpp -Irtl -Isim --top-module soc_top -Mdir obj_fuzz \
+        -CFLAGS -O2 -LDFLAGS -pthread > /dev/null || { echo "Verilator compilation failed!"; exit 1; }
+    make -C obj_fuzz -f Vsoc_top.mk -j"$(nproc)" > /dev/null || { echo "Fuzzer build failed"; exit 1; }
+    ./obj_fuzz/Vsoc_top "${@:2}"
+    exit $?
+fi
+
+# ---------------------------------------------------------
+# 3. RUN VERILATOR
 # ---------------------------------------------------------
 echo "--- SIMULATING $MODULE ---"
 
@@ -83,7 +175,8 @@ rm -f *.vcd
 # --cc: Generate C++ output
 # --exe: Link our custom C++ testbench
 # --trace: Enable waveform generation
-verilator --cc rtl/$MODULE.sv --exe $TB_FILE --trace -Irtl -Isim --top-module $MODULE
+# -pthread: the commit-trace writer thread (sim/commit_trace.h)
+verilator --cc rtl/$MODULE.sv --exe $TB_FILE --trace -Irtl -Isim --top-module $MODULE -LDFLAGS -pthread
 
 if [ $? -ne 0 ]; then
     echo "Verilator compilation failed!"
@@ -93,10 +186,24 @@ fi
 # Build the C++ Simulation Binary
 make -C obj_dir -f V$MODULE.mk > /dev/null
 
+# Benchmark mode: one simulation per image, results appended to bench_results.csv
+if [ $BENCH_MODE -eq 1 ] && [ -f ./obj_dir/V$MODULE ]; then
+    echo "--- RUNNING BENCHMARKS ---"
+    rm -f bench_results.csv
+    FAILED=0
+    for IMAGE in firmware/bench_*.bin; do
+        ./obj_dir/V$MODULE +image=$IMAGE +notrace +max-cycles=5000000 +report=bench_results.csv "${@:2}" \
+            || { echo "Benchmark failed: $IMAGE"; FAILED=1; }
+    done
+    echo "--- RESULTS (bench_results.csv) ---"
+    cat bench_results.csv
+    exit $FAILED
+fi
+
 # Execute the Simulation
 if [ -f ./obj_dir/V$MODULE ]; then
     echo "--- STARTING SIMULATION ---"
-    ./obj_dir/V$MODULE
+    ./obj_dir/V$MODULE "${@:2}"  # Extra arguments go to the testbench (e.g. +boot=firmware/firmware_app.bin)
 else
     echo "Build Failed at the Make stage!"
     exit 1
@@ -15,7 +15,36 @@ uint32_t solve_golden(uint32_t a, uint32_t b, int op) {
         case 2: return a & b;       // 010: AND
         case 3: return a | b;       // 011: OR
         case 4: return a ^ b;       // 100: XOR
-        case 5: return (a < b) ? 1 : 0; // 101: SLT
+        case 5: return ((int32_t)a < (int32_t)b) ? 1 : 0; // 0101: SLT (signed)
+        case 6: return (a < b) ? 1 : 0; // 0110: SLTU
+        case 7: return a << (b & 31);   // 0111: SLL
+        case 8: return a >> (b & 31);   // 1000: SRL
+        case 9: return (uint32_t)((int32_t)a >> (b & 31)); // 1001: SRA
+        // Zba / Zbb
+        case 10: return (a << 1) + b;   // SH1ADD
+        case 11: return (a << 2) + b;   // SH2ADD
+        case 12: return (a << 3) + b;   // SH3ADD
+        case 13: return a & ~b;         // ANDN
+        case 14: return a | ~b;         // ORN
+        case 15: return ~(a ^ b);       // XNOR
+        case 16: return a ? __builtin_clz(a) : 32;  // CLZ
+        case 17: return a ? __builtin_ctz(a) : 32;  // CTZ
+        case 18: return __builtin_popcount(a);      // CPOP
+        case 19: return (uint32_t)(int8_t)a;        // SEXT.B
+        case 20: return (uint32_t)(int16_t)a;       // SEXT.H
+        case 21: return a & 0xFFFF;                 // ZEXT.H
+        case 22: return (int32_t)a < (int32_t)b ? a : b; // MIN
+        case 23: return (int32_t)a < (int32_t)b ? b : a; // MAX
+        case 24: return a < b ? a : b;              // MINU
+        case 25: return a < b ? b : a;              // MAXU
+        case 26: return (a << (b & 31)) | (a >> ((32 - (b & 31)) & 31) & -(uint32_t)((b & 31) != 0)); // ROL
+        case 27: return (a >> (b & 31)) | (a << ((32 - (b & 31)) & 31) & -(uint32_t)((b & 31) != 0)); // ROR
+        case 28: {                                  // ORC.B
+            uint32_t r = 0;
+            for (int i = 0; i < 32; i += 8) if ((a >> i) & 0xFF) r |= 0xFFu << i;
+            return r;
+        }
+        case 29: return __builtin_bswap32(a);       // REV8
         default: return 0;
     }
 }
@@ -37,7 +66,9 @@ int main(int argc, char** argv) {
         // Use 32-bit random numbers (rand() is usually 15-bit, so we shift/mix)
         uint32_t a = (rand() << 16) | rand();
         uint32_t b = (rand() << 16) | rand();
-        int op = rand() % 6; // Valid ops are 0-5
+        int op = rand() % 30; // Valid ops are 0-29
+        // Counts and byte ops also need sparse operands (zero, single bits, zero bytes)
+        if (i % 4 == 0) a &= (1u << (rand() % 32)) | ((rand() % 2) ? 0xFF00FF00u : 0u);
 
         // 2. Drive the Hardware Inputs
         alu->inputA = a;
@@ -0,0 +1,50 @@
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Benchmark result posted by firmware/bench/bench.h (semihost call 4).
+ * Target layout: { name, iterations, cycles, instret, checksum } as 32-bit words.
+ * Shared by soc_top_tb and the virtual platform (vp/soc_vp.cpp).
+ */
+struct BenchReport {
+    std::string name;
+    uint32_t    iterations, cycles, instret, checksum;
+
+    // 'memory' is any target view with word(address) and string(address)
+    template <typename Memory>
+    static BenchReport read(const Memory &memory, uint32_t address) {
+        return { memory.string(memory.word(address)), memory.word(address + 4), memory.word(address + 8),
+                 memory.word(address + 12), memory.word(address + 16) };
+    }
+
+    double cpi() const   { return instret ? (double)cycles / instret : 0.0; }
+    double score() const { return cycles ? 1e6 * iterations / cycles : 0.0; } // iterations per Mcycle
+
+    void print(std::ostream &out = std::cout) const {
+        out << "[PERF] " << std::left << std::setw(12) << std::setfill(' ') << name << std::right << std::dec
+            << " cycles: " << std::setw(9) << cycles << " | instret: " << std::setw(9) << instret
+            << " | CPI: " << std::fixed << std::setprecision(3) << cpi()
+            << " | score: " << std::setprecision(2) << score() << " iter/Mcycle" << std::endl;
+    }
+
+    // One CSV row per result; the header is written when the file is new
+    void append(const std::string &path, const std::string &image) const {
+        std::ifstream existing(path);
+        bool isNew = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+        std::ofstream out(path, std::ios::app);
+        if (isNew) out << "image,benchmark,iterations,cycles,instret,cpi,score,checksum\n";
+        char checksumText[16];
+        snprintf(checksumText, sizeof checksumText, "0x%08x", checksum);
+        out << image << "," << name << "," << iterations << "," << cycles << "," << instret << ","
+            << std::fixed << std::setprecision(4) << cpi() << "," << score() << "," << checksumText << "\n";
+    }
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <verilated.h>
+#include "Vbus_arbiter.h"
+
+// PARAMETERS FROM RTL DEFAULTS
+const int DMA_WEIGHT = 1;
+
+// Helper to step the clock
+void tick(Vbus_arbiter* top) {
+    top->clock = 0; top->eval();
+    top->clock = 1; top->eval();
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    Vbus_arbiter* arb = new Vbus_arbiter;
+
+    std::cout << "[TEST] Starting Bus Arbiter Verification...\n";
+
+    arb->resetActiveLow = 0;
+    tick(arb);
+    arb->resetActiveLow = 1;
+
+    // ==========================================
+    // TEST 1: UNCONTENDED GRANTS
+    // ==========================================
+    arb->cpuRequest = 0; arb->dmaRequest = 1; arb->grantAccepted = 1;
+    arb->eval();
+    bool dmaAlone = arb->grantValid && arb->grantDma;
+    arb->cpuRequest = 1; arb->dmaRequest = 0;
+    arb->eval();
+    bool cpuAlone = arb->grantValid && !arb->grantDma;
+
+    if (dmaAlone && cpuAlone) {
+        std::cout << "[PASS] Lone Requester Granted Immediately.\n";
+    } else {
+        std::cout << "[FAIL] Uncontended Grant. DMA: " << dmaAlone << " CPU: " << cpuAlone << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 2: WEIGHTED ROUND-ROBIN UNDER CONTENTION
+    // ==========================================
+    // The CPU may wait at most DMA_WEIGHT accepted DMA transfers
+    arb->cpuRequest = 1; arb->dmaRequest = 1;
+    int dmaRun = 0, maxDmaRun = 0, cpuGrants = 0;
+    for (int i = 0; i < 20; i++) {
+        arb->eval();
+        if (arb->grantDma) { dmaRun++; if (dmaRun > maxDmaRun) maxDmaRun = dmaRun; }
+        else               { dmaRun = 0; cpuGrants++; }
+        tick(arb);
+    }
+
+    if (maxDmaRun == DMA_WEIGHT && cpuGrants == 10) {
+        std::cout << "[PASS] CPU Wait Bounded to " << maxDmaRun << " DMA Grant(s).\n";
+    } else {
+        std::cout << "[FAIL] Contention. Max DMA Run: " << maxDmaRun << " CPU Grants: " << cpuGrants << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 3: STALLED GRANT HOLDS THE STREAK
+    // ==========================================
+    // A grant the slave has not accepted yet must not advance the round-robin state
+    arb->grantAccepted = 0;
+    arb->eval();
+    bool before = arb->grantDma;
+    tick(arb); tick(arb);
+    arb->eval();
+
+    if (arb->grantDma == before) {
+        std::cout << "[PASS] Grant Stable While Slave Stalls.\n";
+    } else {
+        std::cout << "[FAIL] Grant switched mid-transfer.\n";
+        return 1;
+    }
+
+    std::cout << "------------------------------------------\n";
+    std::cout << "[SUCCESS] Bus Arbiter Verified.\n";
+
+    delete arb;
+    return 0;
+}
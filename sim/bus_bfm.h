@@ -0,0 +1,458 @@
+#ifndef BUS_BFM_H
+#define BUS_BFM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Transaction-level bus functional models for bus_interconnect (sim/bus_interconnect_tb.cpp).
+ *
+ * Master BFMs drive the CPU and DMA ports from scripted or random traffic; slave BFMs answer on
+ * the ROM, RAM and MMIO ports with memory, configurable read latency and back-pressure. A
+ * scoreboard pairs every master handshake with the slave handshake of the same cycle (the
+ * interconnect issues reads and posts writes combinationally) and checks routing, write data
+ * and the in-order return of read data. BusBfmEnv runs them together and reports throughput,
+ * latency percentiles and arbitration fairness.
+ */
+
+// Verilated port types: 1-bit signals are CData (uint8_t), 32-bit are IData (uint32_t)
+struct BusChannelPorts {
+    uint32_t *writeAddress = nullptr, *writeData = nullptr, *readAddress = nullptr, *readData = nullptr;
+    uint8_t  *writeValid = nullptr, *writeReady = nullptr, *writeValidData = nullptr, *writeReadyData = nullptr;
+    uint8_t  *readValid = nullptr, *readReady = nullptr, *readValidData = nullptr, *readReadyData = nullptr;
+};
+
+#define BUS_PORTS(model, prefix) BusChannelPorts{                                                  \
+    &(model)->prefix##AxiWriteAddress, &(model)->prefix##AxiWriteData,                            \
+    &(model)->prefix##AxiReadAddress,  &(model)->prefix##AxiReadData,                             \
+    &(model)->prefix##AxiWriteValid,   &(model)->prefix##AxiWriteReady,                           \
+    &(model)->prefix##AxiWriteValidData, &(model)->prefix##AxiWriteReadyData,                     \
+    &(model)->prefix##AxiReadValid,    &(model)->prefix##AxiReadReady,                            \
+    &(model)->prefix##AxiReadValidData, &(model)->prefix##AxiReadReadyData }
+
+// The ROM port has no write channel
+#define BUS_READ_PORTS(model, prefix) BusChannelPorts{                                             \
+    nullptr, nullptr, &(model)->prefix##AxiReadAddress, &(model)->prefix##AxiReadData,            \
+    nullptr, nullptr, nullptr, nullptr,                                                           \
+    &(model)->prefix##AxiReadValid, &(model)->prefix##AxiReadReady,                               \
+    &(model)->prefix##AxiReadValidData, &(model)->prefix##AxiReadReadyData }
+
+enum BusSlaveId { BUS_ROM = 0, BUS_RAM = 1, BUS_IO = 2 };
+
+// Same decode as bus_interconnect: bit 30 MMIO, bit 29 RAM, else ROM
+static inline int busDecode(uint32_t address) {
+    return (address & 0x40000000) ? BUS_IO : (address & 0x20000000) ? BUS_RAM : BUS_ROM;
+}
+
+/**
+ * @brief Latency samples with percentile and histogram summaries.
+ */
+struct BusLatency {
+    std::vector<uint32_t> samples;
+
+    void add(uint64_t cycles) { samples.push_back((uint32_t)cycles); }
+
+    uint32_t percentile(double p) {
+        if (samples.empty()) return 0;
+        size_t rank = std::min(samples.size() - 1, (size_t)(p / 100.0 * samples.size()));
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        return samples[rank];
+    }
+
+    double mean() const {
+        uint64_t sum = 0;
+        for (uint32_t s : samples) sum += s;
+        return samples.empty() ? 0.0 : (double)sum / samples.size();
+    }
+};
+
+/**
+ * @brief One bus master. Scripted requests run first, in order; then random traffic at 'rate'
+ * (probability of a new request in an idle cycle). One request is presented at a time, as the
+ * CPU and the DMA engine do; up to 'maxReads' reads stay outstanding.
+ */
+class BusMasterBfm {
+public:
+    struct Request {
+        bool     write;
+        uint32_t address, data;
+    };
+
+    std::string         name;
+    std::deque<Request> script;
+    double              rate          = 0.0;  // Random traffic (0: scripted only)
+    double              writeFraction = 0.5;
+    std::vector<uint32_t> regions;             // Random addresses: base + word offset in 'window'
+    uint32_t            window        = 0x100;
+    uint32_t            maxReads      = 1;
+    double              readyData     = 1.0;  // Probability of accepting read data in a cycle
+
+    // Results
+    uint64_t   reads = 0, writes = 0, waitCycles = 0, maxWait = 0;
+    BusLatency readLatency, writeLatency;     // Cycles from first presentation to data / acceptance
+    std::vector<uint32_t> readValues;         // Read data in arrival order
+
+    BusMasterBfm(const std::string &masterName, BusChannelPorts masterPorts, uint32_t seed)
+        : name(masterName), ports(masterPorts), rng(seed) {}
+
+    bool idle() const { return !pending && inFlight.empty() && script.empty(); }
+
+    // Request currently on the bus, if any (arbitration statistics)
+    bool presenting(int &slave, bool &write) const {
+        if (!pending) return false;
+        slave = busDecode(current.address);
+        write = current.write;
+        return true;
+    }
+
+    void drive(uint64_t cycle) {
+        // A master with 'maxReads' loads in flight stalls, like the core waiting on a load
+        if (!pending && inFlight.size() < maxReads) {
+            if (!script.empty()) {
+                current = script.front();
+                script.pop_front();
+                start(cycle);
+            } else if (rate > 0 && !regions.empty() && uniform() < rate) {
+                current.write   = uniform() < writeFraction;
+                current.address = regions[rng() % regions.size()] + 4 * (rng() % (window / 4));
+                current.data    = (uint32_t)rng();
+                start(cycle);
+            }
+        }
+        *ports.writeValid     = pending && current.write;
+        *ports.writeValidData = pending && current.write;
+        *ports.writeAddress   = current.address;
+        *ports.writeData      = current.data;
+        *ports.readValid      = pending && !current.write;
+        *ports.readAddress    = current.address;
+        *ports.readReadyData  = uniform() < readyData;
+    }
+
+    // Handshakes of this cycle, reported to the scoreboard by BusBfmEnv
+    bool writeFired() const { return *ports.writeValid && *ports.writeReady && *ports.writeReadyData; }
+    bool readFired() const  { return *ports.readValid && *ports.readReady; }
+    bool dataFired() const  { return *ports.readValidData && *ports.readReadyData; }
+    uint32_t readData() const { return *ports.readData; }
+    const Request &request() const { return current; }
+
+    void sample(uint64_t cycle) {
+        if (pending && (writeFired() || readFired())) {
+            if (current.write) {
+                writes++;
+                writeLatency.add(cycle - presentedAt);
+            } else {
+                inFlight.push_back(presentedAt);
+            }
+            pending = false;
+        } else if (pending) {
+            waitCycles++;
+            maxWait = std::max<uint64_t>(maxWait, cycle - presentedAt + 1);
+        }
+        if (dataFired() && !inFlight.empty()) {
+            reads++;
+            readValues.push_back(*ports.readData);
+            readLatency.add(cycle - inFlight.front());
+            inFlight.pop_front();
+        }
+    }
+
+private:
+    BusChannelPorts      ports;
+    std::mt19937         rng;
+    bool                 pending = false;
+    Request              current = { false, 0, 0 };
+    uint64_t             presentedAt = 0;
+    std::deque<uint64_t> inFlight;           // Presentation cycle of each issued read
+
+    void   start(uint64_t cycle) { pending = true; presentedAt = cycle; }
+    double uniform() { return (rng() >> 8) * (1.0 / 16777216.0); }
+};
+
+/**
+ * @brief One slave port with its own memory. Read data is captured when the read is accepted and
+ * returned in order after 'minLatency'..'maxLatency' cycles (0: in the accept cycle);
+ * 'maxReads' bounds reads in flight. Ready probabilities inject back-pressure.
+ */
+class BusSlaveBfm {
+public:
+    std::string name;
+    uint32_t    minLatency = 0, maxLatency = 0, maxReads = 4;
+    double      readReady  = 1.0;
+    double      writeReady = 1.0;
+
+    // Results
+    uint64_t reads = 0, writes = 0;
+
+    BusSlaveBfm(const std::string &slaveName, BusChannelPorts slavePorts, uint32_t seed)
+        : name(slaveName), ports(slavePorts), rng(seed) {}
+
+    bool hasWritePort() const { return ports.writeValid != nullptr; }
+    bool idle() const { return responses.empty(); }
+
+    uint32_t &memory(uint32_t address) { return words[address & ~3u]; }
+
+    // Phase 1: ready signals and any response due this cycle
+    void drive() {
+        *ports.readReady = responses.size() < maxReads && uniform() < readReady;
+        bool due = !responses.empty() && responses.front().countdown == 0;
+        *ports.readValidData = due;
+        *ports.readData      = due ? responses.front().data : 0;
+        nextLatency = minLatency + (maxLatency > minLatency ? rng() % (maxLatency - minLatency + 1) : 0);
+        if (hasWritePort()) {
+            bool ready = uniform() < writeReady;
+            *ports.writeReady     = ready;
+            *ports.writeReadyData = ready;
+        }
+    }
+
+    // Phase 2 (after eval): a zero-latency read accepted with nothing queued answers at once.
+    // Returns true if an input changed and the model needs another eval.
+    bool bypass() {
+        bypassed = false;
+        if (!(readFired() && responses.empty() && nextLatency == 0)) return false;
+        *ports.readValidData = 1;
+        *ports.readData      = memory(*ports.readAddress);
+        bypassed = true;
+        return true;
+    }
+
+    bool     readFired() const  { return *ports.readValid && *ports.readReady; }
+    bool     writeFired() const { return hasWritePort() && *ports.writeValid && *ports.writeReady && *ports.writeReadyData; }
+    uint32_t readAddress() const  { return *ports.readAddress; }
+    uint32_t writeAddress() const { return *ports.writeAddress; }
+    uint32_t writeData() const    { return *ports.writeData; }
+
+    // Data this cycle's accepted read will return (valid when readFired())
+    uint32_t acceptedData() { return memory(*ports.readAddress); }
+
+    void sample() {
+        if (*ports.readValidData && *ports.readReadyData && !bypassed) responses.pop_front();
+        for (Response &response : responses) if (response.countdown) response.countdown--;
+        if (readFired()) {
+            reads++;
+            if (!bypassed) responses.push_back({ memory(*ports.readAddress), nextLatency ? nextLatency - 1 : 0 });
+        }
+        if (writeFired()) {
+            writes++;
+            memory(*ports.writeAddress) = *ports.writeData;
+        }
+    }
+
+private:
+    struct Response {
+        uint32_t data, countdown;
+    };
+
+    BusChannelPorts                        ports;
+    std::mt19937                           rng;
+    std::deque<Response>                   responses;
+    std::unordered_map<uint32_t, uint32_t> words;
+    uint32_t                               nextLatency = 0;
+    bool                                   bypassed    = false;
+
+    double uniform() { return (rng() >> 8) * (1.0 / 16777216.0); }
+};
+
+/**
+ * @brief Cycle-by-cycle checker. Every master read or write handshake must meet a handshake of
+ * the same address (and data) on the decoded slave in the same cycle; read data must come back
+ * to the issuing master in issue order with the value the slave returned.
+ */
+class BusScoreboard {
+public:
+    uint64_t checked = 0, errors = 0;
+
+    void check(uint64_t cycle, std::vector<BusMasterBfm *> &masters, std::vector<BusSlaveBfm *> &slaves) {
+        bool slaveReadClaimed[3] = {}, slaveWriteClaimed[3] = {};
+        for (size_t m = 0; m < masters.size(); m++) {
+            BusMasterBfm &master = *masters[m];
+            const BusMasterBfm::Request &request = master.request();
+            int s = busDecode(request.address);
+
+            if (master.writeFired()) {
+                checked++;
+                if (s != BUS_ROM) {
+                    BusSlaveBfm &slave = *slaves[s];
+                    if (!slave.writeFired() || slaveWriteClaimed[s] || slave.writeAddress() != request.address ||
+                        slave.writeData() != request.data) {
+                        fail(cycle, master.name + " write to " + hex(request.address) + " not seen on " + slave.name);
+                    }
+                    slaveWriteClaimed[s] = true;
+                }
+            }
+            if (master.readFired()) {
+                checked++;
+                BusSlaveBfm &slave = *slaves[s];
+                if (!slave.readFired() || slaveReadClaimed[s] || slave.readAddress() != request.address) {
+                    fail(cycle, master.name + " read of " + hex(request.address) + " not issued to " + slave.name);
+                } else {
+                    expected[m].push_back(slave.acceptedData());
+                }
+                slaveReadClaimed[s] = true;
+            }
+            if (master.dataFired()) {
+                checked++;
+                if (expected[m].empty()) {
+                    fail(cycle, master.name + " received unrequested data " + hex(master.readData()));
+                } else {
+                    if (master.readData() != expected[m].front()) {
+                        fail(cycle, master.name + " read data " + hex(master.readData()) + ", expected " +
+                                    hex(expected[m].front()));
+                    }
+                    expected[m].pop_front();
+                }
+            }
+        }
+        for (size_t s = 0; s < slaves.size(); s++) {
+            if (slaves[s]->readFired() && !slaveReadClaimed[s])   fail(cycle, slaves[s]->name + " accepted a read no master issued");
+            if (slaves[s]->writeFired() && !slaveWriteClaimed[s]) fail(cycle, slaves[s]->name + " accepted a write no master issued");
+        }
+    }
+
+    size_t outstanding() const { return expected[0].size() + expected[1].size(); }
+
+private:
+    std::deque<uint32_t> expected[2];
+
+    void fail(uint64_t cycle, const std::string &message) {
+        if (errors++ < 10) std::cout << "[FAIL] Scoreboard @" << std::dec << cycle << ": " << message << "\n";
+    }
+
+    static std::string hex(uint32_t value) {
+        char text[16];
+        snprintf(text, sizeof text, "0x%08x", value);
+        return text;
+    }
+};
+
+/**
+ * @brief Two masters, three slaves and a scoreboard around one Verilated bus_interconnect.
+ * Contention counts cycles in which both masters present a request to the same slave channel;
+ * fairness is Jain's index over the grants each master won in those cycles (1.0 = even split).
+ */
+template <typename Model>
+class BusBfmEnv {
+public:
+    BusMasterBfm  cpu, dma;
+    BusSlaveBfm   rom, ram, io;
+    BusScoreboard scoreboard;
+
+    uint64_t cycles = 0, contendedCycles = 0, contendedGrants[2] = {};
+
+    BusBfmEnv(Model *busModel, uint32_t seed)
+        : cpu("CPU", BUS_PORTS(busModel, cpu), seed), dma("DMA", BUS_PORTS(busModel, dma), seed + 1),
+          rom("ROM", BUS_READ_PORTS(busModel, rom), seed + 2), ram("RAM", BUS_PORTS(busModel, ram), seed + 3),
+          io("MMIO", BUS_PORTS(busModel, io), seed + 4), bus(busModel) {}
+
+    // Idles every port and pulses reset, so each scenario starts with empty tracking queues.
+    // Call before adding traffic.
+    void reset() {
+        std::vector<BusMasterBfm *> masters = { &cpu, &dma };
+        std::vector<BusSlaveBfm *>  slaves  = { &rom, &ram, &io };
+        for (BusMasterBfm *master : masters) master->drive(cycles);
+        for (BusSlaveBfm *slave : slaves) slave->drive();
+        bus->resetActiveLow = 0;
+        tick();
+        bus->resetActiveLow = 1;
+    }
+
+    void run(uint64_t count) {
+        std::vector<BusMasterBfm *> masters = { &cpu, &dma };
+        std::vector<BusSlaveBfm *>  slaves  = { &rom, &ram, &io };
+        for (uint64_t end = cycles + count; cycles < end; cycles++) step(masters, slaves);
+    }
+
+    // Stops new traffic and runs until every read has returned (bounded)
+    bool drain(uint64_t limit = 1000) {
+        cpu.rate = dma.rate = 0;
+        std::vector<BusMasterBfm *> masters = { &cpu, &dma };
+        std::vector<BusSlaveBfm *>  slaves  = { &rom, &ram, &io };
+        for (uint64_t i = 0; i < limit && !(cpu.idle() && dma.idle() && scoreboard.outstanding() == 0); i++, cycles++) {
+            step(masters, slaves);
+        }
+        return cpu.idle() && dma.idle() && scoreboard.outstanding() == 0;
+    }
+
+    double fairness() const {
+        double a = contendedGrants[0], b = contendedGrants[1];
+        return (a + b) > 0 ? (a + b) * (a + b) / (2 * (a * a + b * b)) : 1.0;
+    }
+
+    // [PERF] lines; with 'csvPath', one row per master (written with a header when new)
+    void report(const std::string &scenario, const std::string &csvPath = "") {
+        std::cout << "[PERF] " << scenario << " (" << std::dec << cycles << " cycles): "
+                  << std::fixed << std::setprecision(3)
+                  << (double)(cpu.reads + cpu.writes + dma.reads + dma.writes) / cycles << " txn/cycle";
+        if (contendedCycles) {
+            std::cout << " | contended " << contendedCycles << " cycles, CPU " << contendedGrants[0]
+                      << " / DMA " << contendedGrants[1] << " grants, fairness " << fairness();
+        }
+        std::cout << "\n";
+        for (BusMasterBfm *master : { &cpu, &dma }) {
+            if (!master->reads && !master->writes) continue;
+            std::cout << "         " << master->name << ": " << std::setprecision(3)
+                      << (double)(master->reads + master->writes) / cycles << " txn/cycle | reads "
+                      << std::setw(6) << master->reads << " latency avg " << std::setprecision(2)
+                      << master->readLatency.mean() << " p50 " << master->readLatency.percentile(50)
+                      << " p99 " << master->readLatency.percentile(99) << " max " << master->readLatency.percentile(100)
+                      << " | writes " << std::setw(6) << master->writes << " wait p99 "
+                      << master->writeLatency.percentile(99) << " | longest wait " << master->maxWait << "\n";
+        }
+        if (csvPath.empty()) return;
+        std::ifstream existing(csvPath);
+        bool isNew = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+        std::ofstream out(csvPath, std::ios::app);
+        if (isNew) out << "scenario,master,cycles,txn_per_cycle,reads,read_avg,read_p50,read_p99,read_max,writes,write_p99,longest_wait,fairness\n";
+        for (BusMasterBfm *master : { &cpu, &dma }) {
+            out << "\"" << scenario << "\"," << master->name << "," << cycles << "," << std::setprecision(4)
+                << (double)(master->reads + master->writes) / cycles << "," << master->reads << ","
+                << master->readLatency.mean() << "," << master->readLatency.percentile(50) << ","
+                << master->readLatency.percentile(99) << "," << master->readLatency.percentile(100) << ","
+                << master->writes << "," << master->writeLatency.percentile(99) << "," << master->maxWait << ","
+                << fairness() << "\n";
+        }
+    }
+
+private:
+    Model *bus;
+
+    void tick() {
+        bus->clock = 1; bus->eval();
+        bus->clock = 0; bus->eval();
+    }
+
+    void step(std::vector<BusMasterBfm *> &masters, std::vector<BusSlaveBfm *> &slaves) {
+        for (BusMasterBfm *master : masters) master->drive(cycles);
+        for (BusSlaveBfm *slave : slaves) slave->drive();
+        bus->eval();
+        bool again = false;
+        for (BusSlaveBfm *slave : slaves) again |= slave->bypass();
+        if (again) bus->eval();
+
+        // Contention: both masters present to the same slave channel
+        int  cpuSlave, dmaSlave;
+        bool cpuWrite, dmaWrite;
+        if (cpu.presenting(cpuSlave, cpuWrite) && dma.presenting(dmaSlave, dmaWrite) &&
+            cpuSlave == dmaSlave && cpuWrite == dmaWrite && !(cpuWrite && cpuSlave == BUS_ROM)) {
+            contendedCycles++;
+            if (cpu.readFired() || cpu.writeFired()) contendedGrants[0]++;
+            if (dma.readFired() || dma.writeFired()) contendedGrants[1]++;
+        }
+
+        scoreboard.check(cycles, masters, slaves);
+        for (BusMasterBfm *master : masters) master->sample(cycles);
+        for (BusSlaveBfm *slave : slaves) slave->sample();
+        tick();
+    }
+};
+
+#endif
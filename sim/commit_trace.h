@@ -0,0 +1,359 @@
+#ifndef COMMIT_TRACE_H
+#define COMMIT_TRACE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief One entry of the instruction-commit trace: a retired instruction or a trap entry.
+ */
+struct CommitRecord {
+    uint64_t index   = 0;  // Record number (0-based)
+    uint64_t cycle   = 0;  // CPU cycle of the instruction's last clock
+    uint32_t pc      = 0;  // Retired instruction, or the instruction a trap interrupted
+    uint8_t  flags   = 0;  // CommitTrace::FLAG_*
+    uint8_t  rd      = 0;
+    uint32_t rdValue = 0;
+    uint32_t address = 0;  // Load/store address (bus address, before lane extraction)
+    uint32_t data    = 0;  // Store data as driven on the bus (merged word for SB/SH to memory)
+    uint32_t cause   = 0;  // MCAUSE of a trap record
+};
+
+/**
+ * @brief Binary commit-trace format, shared by the writer (soc_top_tb +commit-trace=) and the
+ * reader (sim/trace_dump.cpp).
+ *
+ * File: "RVCT" | version | records | keyframe index | index entries (LE32) | "RVCX"
+ * A record is a header byte of FLAG_* bits, then the fields those flags select:
+ *   FLAG_CYCLES  varint  cycles since the previous record, minus 1 (absent when 1)
+ *   FLAG_JUMP    varint  zigzag((pc - previous pc - 4) / 2) (absent for sequential code)
+ *   FLAG_REG     byte rd, varint zigzag(value - previous value of rd)
+ *   FLAG_LOAD / FLAG_STORE  varint zigzag(address - previous address); stores add varint data
+ *   FLAG_TRAP    varint cause (no instruction retires)
+ * Every KEYFRAME_INTERVAL records a KEYFRAME (header 0x80) carries the full decoder state, so
+ * decoding can start at any keyframe. The index at the end lists each one as
+ * {file offset, record index} (LE64). A run killed before close() leaves no index, but the
+ * records before the cut still decode.
+ */
+class CommitTrace {
+public:
+    static constexpr uint8_t FLAG_CYCLES = 0x01;
+    static constexpr uint8_t FLAG_JUMP   = 0x02;
+    static constexpr uint8_t FLAG_REG    = 0x04;
+    static constexpr uint8_t FLAG_LOAD   = 0x08;
+    static constexpr uint8_t FLAG_STORE  = 0x10;
+    static constexpr uint8_t FLAG_TRAP   = 0x20;
+    static constexpr uint8_t KEYFRAME    = 0x80;
+
+    static constexpr uint8_t  VERSION           = 1;
+    static constexpr uint32_t KEYFRAME_INTERVAL = 65536;
+
+protected:
+    // Delta bases, identical on both sides
+    uint64_t index = 0, cycle = 0;
+    uint32_t pc = 0, address = 0;
+    uint32_t regs[32] = {};
+
+    static uint32_t zigzag(int32_t value)    { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+    static int32_t  unzigzag(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+};
+
+/**
+ * @brief Streams records to a file. The simulation thread only encodes into a buffer; a
+ * background thread writes full buffers, so the simulation waits only when the disk falls
+ * behind by more than BUFFER_COUNT buffers.
+ */
+class CommitTraceWriter : public CommitTrace {
+public:
+    static constexpr size_t BUFFER_BYTES = 1 << 20;
+    static constexpr size_t BUFFER_COUNT = 4;
+
+    ~CommitTraceWriter() { close(); }
+
+    bool open(const std::string &path) {
+        file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+        for (size_t i = 0; i < BUFFER_COUNT; i++) {
+            freeBuffers.emplace_back();
+            freeBuffers.back().reserve(BUFFER_BYTES + 256);
+        }
+        takeBuffer();
+        const uint8_t header[5] = { 'R', 'V', 'C', 'T', VERSION };
+        buffer.insert(buffer.end(), header, header + 5);
+        writer = std::thread(&CommitTraceWriter::writeLoop, this);
+        return true;
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    // 'record.index' is assigned here
+    void append(const CommitRecord &record) {
+        if (index % KEYFRAME_INTERVAL == 0) keyframe(record.cycle);
+
+        uint8_t flags = record.flags & (FLAG_REG | FLAG_LOAD | FLAG_STORE | FLAG_TRAP);
+        if (record.flags & FLAG_REG && record.rd == 0) flags &= ~FLAG_REG;
+        uint64_t cycleDelta = record.cycle - cycle;
+        if (cycleDelta != 1)      flags |= FLAG_CYCLES;
+        if (record.pc != pc + 4) flags |= FLAG_JUMP;
+
+        buffer.push_back(flags);
+        if (flags & FLAG_CYCLES) putVarint(cycleDelta - 1);
+        if (flags & FLAG_JUMP)   putVarint(zigzag((int32_t)(record.pc - pc - 4) >> 1));
+        if (flags & FLAG_REG) {
+            buffer.push_back(record.rd);
+            putVarint(zigzag((int32_t)(record.rdValue - regs[record.rd])));
+            regs[record.rd] = record.rdValue;
+        }
+        if (flags & (FLAG_LOAD | FLAG_STORE)) {
+            putVarint(zigzag((int32_t)(record.address - address)));
+            address = record.address;
+        }
+        if (flags & FLAG_STORE) putVarint(record.data);
+        if (flags & FLAG_TRAP)  putVarint(record.cause);
+
+        cycle = record.cycle;
+        pc    = record.pc;
+        index++;
+        if (buffer.size() >= BUFFER_BYTES) handOff();
+    }
+
+    // Flushes the last buffer, appends the keyframe index and waits for the writer thread
+    void close() {
+        if (!file) return;
+        std::vector<uint64_t> entries;
+        for (const auto &entry : keyframes) {
+            entries.push_back(entry.first);
+            entries.push_back(entry.second);
+        }
+        for (uint64_t value : entries) putFixed(value, 8);
+        putFixed((uint32_t)keyframes.size(), 4);
+        const uint8_t footer[4] = { 'R', 'V', 'C', 'X' };
+        buffer.insert(buffer.end(), footer, footer + 4);
+        handOff();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+        }
+        wake.notify_all();
+        writer.join();
+        fclose(file);
+        file = nullptr;
+    }
+
+    uint64_t records() const { return index; }
+    uint64_t bytes() const   { return bytesWritten + buffer.size(); }
+
+private:
+    FILE                             *file = nullptr;
+    std::vector<uint8_t>              buffer;
+    std::deque<std::vector<uint8_t>>  fullBuffers, freeBuffers;
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes; // {file offset, record index}
+    std::mutex                        mutex;
+    std::condition_variable           wake;
+    std::thread                       writer;
+    bool                              finished     = false;
+    uint64_t                          bytesWritten = 0;    // Bytes handed to the writer thread
+
+    void keyframe(uint64_t recordCycle) {
+        keyframes.push_back({ bytes(), index });
+        buffer.push_back(KEYFRAME);
+        putFixed(index, 8);
+        putFixed(cycle ? cycle : recordCycle - 1, 8);
+        if (!cycle) cycle = recordCycle - 1; // The first record then encodes a delta of 1
+        putFixed(pc, 4);
+        putFixed(address, 4);
+        for (int r = 1; r < 32; r++) putFixed(regs[r], 4);
+    }
+
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back((uint8_t)(value | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back((uint8_t)value);
+    }
+
+    void putFixed(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) buffer.push_back((uint8_t)(value >> (8 * i)));
+    }
+
+    void takeBuffer() {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this] { return !freeBuffers.empty(); });
+        buffer = std::move(freeBuffers.front());
+        freeBuffers.pop_front();
+        buffer.clear();
+    }
+
+    void handOff() {
+        bytesWritten += buffer.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            fullBuffers.push_back(std::move(buffer));
+        }
+        wake.notify_all();
+        takeBuffer();
+    }
+
+    void writeLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return finished || !fullBuffers.empty(); });
+            if (fullBuffers.empty()) return;
+            std::vector<uint8_t> chunk = std::move(fullBuffers.front());
+            fullBuffers.pop_front();
+            lock.unlock();
+            fwrite(chunk.data(), 1, chunk.size(), file);
+            lock.lock();
+            freeBuffers.push_back(std::move(chunk));
+            wake.notify_all();
+        }
+    }
+};
+
+/**
+ * @brief Sequential reader with keyframe seeking.
+ */
+class CommitTraceReader : public CommitTrace {
+public:
+    ~CommitTraceReader() { if (file) fclose(file); }
+
+    bool open(const std::string &path) {
+        file = fopen(path.c_str(), "rb");
+        if (!file) return false;
+        uint8_t header[5];
+        if (fread(header, 1, 5, file) != 5 || memcmp(header, "RVCT", 4) != 0 || header[4] != VERSION) return false;
+
+        // Footer: index of keyframes; without it (interrupted run) records run to end of file
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        recordsEnd = size;
+        uint8_t footer[8];
+        if (size >= 13 && fseek(file, size - 8, SEEK_SET) == 0 && fread(footer, 1, 8, file) == 8 &&
+            memcmp(footer + 4, "RVCX", 4) == 0) {
+            uint32_t count = footer[0] | (footer[1] << 8) | (footer[2] << 16) | ((uint32_t)footer[3] << 24);
+            recordsEnd = size - 8 - (long)count * 16;
+            std::vector<uint8_t> table((size_t)count * 16);
+            fseek(file, recordsEnd, SEEK_SET);
+            if (fread(table.data(), 1, table.size(), file) == table.size()) {
+                for (uint32_t i = 0; i < count; i++) {
+                    keyframes.push_back({ fixed(&table[16 * i], 8), fixed(&table[16 * i + 8], 8) });
+                }
+            }
+        }
+        seekOffset(5);
+        return true;
+    }
+
+    bool indexed() const { return !keyframes.empty(); }
+
+    // Positions the reader so the next record returned is 'target' (or the first one after it)
+    void seek(uint64_t target) {
+        long offset = 5;
+        index = 0;
+        for (const auto &entry : keyframes) {
+            if (entry.second > target) break;
+            offset = (long)entry.first;
+            index  = entry.second;
+        }
+        seekOffset(offset);
+        CommitRecord skipped;
+        while (index < target && next(skipped)) {}
+    }
+
+    bool next(CommitRecord &record) {
+        int header = get();
+        if (header < 0) return false;
+        if (header == KEYFRAME) {
+            index   = fixedFromStream(8);
+            cycle   = fixedFromStream(8);
+            pc      = (uint32_t)fixedFromStream(4);
+            address = (uint32_t)fixedFromStream(4);
+            for (int r = 1; r < 32; r++) regs[r] = (uint32_t)fixedFromStream(4);
+            header = get();
+            if (header < 0) return false;
+        }
+
+        record         = CommitRecord();
+        record.index   = index++;
+        record.flags   = (uint8_t)(header & (FLAG_REG | FLAG_LOAD | FLAG_STORE | FLAG_TRAP));
+        record.cycle   = cycle + 1 + ((header & FLAG_CYCLES) ? varint() : 0);
+        record.pc      = pc + 4 + ((header & FLAG_JUMP) ? (uint32_t)(unzigzag((uint32_t)varint()) * 2) : 0);
+        if (header & FLAG_REG) {
+            record.rd      = (uint8_t)(get() & 0x1F);
+            record.rdValue = regs[record.rd] + (uint32_t)unzigzag((uint32_t)varint());
+            regs[record.rd] = record.rdValue;
+        }
+        if (header & (FLAG_LOAD | FLAG_STORE)) {
+            address       += (uint32_t)unzigzag((uint32_t)varint());
+            record.address = address;
+        }
+        if (header & FLAG_STORE) record.data  = (uint32_t)varint();
+        if (header & FLAG_TRAP)  record.cause = (uint32_t)varint();
+        cycle = record.cycle;
+        pc    = record.pc;
+        return true;
+    }
+
+private:
+    FILE                 *file = nullptr;
+    long                  recordsEnd = 0;
+    long                  position   = 0; // File offset of chunk[0]
+    std::vector<uint8_t>  chunk;
+    size_t                chunkAt = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes;
+
+    void seekOffset(long offset) {
+        position = offset;
+        chunk.clear();
+        chunkAt = 0;
+        fseek(file, offset, SEEK_SET);
+    }
+
+    // Byte stream over [5, recordsEnd), read in 1MB chunks
+    int get() {
+        if (chunkAt == chunk.size()) {
+            position += (long)chunk.size();
+            long remaining = recordsEnd - position;
+            if (remaining <= 0) return -1;
+            chunk.resize((size_t)std::min<long>(remaining, 1 << 20));
+            chunk.resize(fread(chunk.data(), 1, chunk.size(), file));
+            chunkAt = 0;
+            if (chunk.empty()) return -1;
+        }
+        return chunk[chunkAt++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int byte = get();
+            if (byte < 0) break;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        return value;
+    }
+
+    uint64_t fixedFromStream(int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= (uint64_t)(get() & 0xFF) << (8 * i);
+        return value;
+    }
+
+    static uint64_t fixed(const uint8_t *at, int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= (uint64_t)at[i] << (8 * i);
+        return value;
+    }
+};
+
+#endif
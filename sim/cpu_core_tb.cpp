@@ -0,0 +1,258 @@
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <verilated.h>
+#include "Vcpu_core.h"
+#include "Vcpu_core___024root.h"
+
+// --- TEST PROGRAM ---
+// 0x000: store/load through the bus, hart-local reads (HARTID) and writes (MTVEC), then ECALL.
+// 0x100: handler reads MCAUSE/MEPC, skips the trapping instruction and returns with MRET.
+const uint32_t PROGRAM[] = {
+    0x00500093, // 0x00  addi x1, x0, 5
+    0x20000137, // 0x04  lui  x2, 0x20000
+    0x00112023, // 0x08  sw   x1, 0(x2)
+    0x00012183, // 0x0C  lw   x3, 0(x2)
+    0x40000237, // 0x10  lui  x4, 0x40000
+    0x01C22283, // 0x14  lw   x5, 0x1C(x4)   HARTID
+    0x10000313, // 0x18  addi x6, x0, 0x100
+    0x00622C23, // 0x1C  sw   x6, 0x18(x4)   MTVEC
+    0x00000073, // 0x20  ecall
+    0x0000006F, // 0x24  j .
+    0x0000006F, // 0x28  j .
+};
+const uint32_t HANDLER[] = {
+    0x01422383, // 0x100 lw   x7, 0x14(x4)   MCAUSE
+    0x01022403, // 0x104 lw   x8, 0x10(x4)   MEPC
+    0x00440413, // 0x108 addi x8, x8, 4
+    0x00822823, // 0x10C sw   x8, 0x10(x4)
+    0x30200073, // 0x110 mret
+};
+
+// 0x000 after a second reset: LR/SC pair, SC without a reservation, then AMOADD/AMOSWAP/AMOOR
+const uint32_t ATOMIC_PROGRAM[] = {
+    0x20000137, // 0x00  lui       x2, 0x20000
+    0x00700093, // 0x04  addi      x1, x0, 7
+    0x00112023, // 0x08  sw        x1, 0(x2)
+    0x100121AF, // 0x0C  lr.w      x3, (x2)
+    0x00118193, // 0x10  addi      x3, x3, 1
+    0x1831222F, // 0x14  sc.w      x4, x3, (x2)    succeeds: RAM = 8
+    0x183122AF, // 0x18  sc.w      x5, x3, (x2)    fails: reservation consumed
+    0x00500313, // 0x1C  addi      x6, x0, 5
+    0x006123AF, // 0x20  amoadd.w  x7, x6, (x2)
+    0x0811242F, // 0x24  amoswap.w x8, x1, (x2)
+    0x0F000493, // 0x28  addi      x9, x0, 0xF0
+    0x4091252F, // 0x2C  amoor.w   x10, x9, (x2)
+    0x0000006F, // 0x30  j .
+};
+
+// 0x000 after a third reset: RV32C. Two halfwords per word, low half first; the ADDI at 0x02
+// straddles a word boundary (inst_mem returns the 32 bits at any halfword-aligned PC).
+const uint32_t COMPRESSED_PROGRAM[] = {
+    0x04934415, // 0x00  c.li   x8, 5        | 0x02 addi x9, x0, 7 (low half)
+    0x94260070, //       (addi high half)    | 0x06 c.add  x8, x9
+    0x45052019, // 0x08  c.jal  0x0E         | 0x0A c.li   x10, 1   (skipped)
+    0x85864509, // 0x0C  c.li   x10, 2 (skipped) | 0x0E c.mv x11, x1 (the link, 0x0A)
+    0x460DC011, // 0x10  c.beqz x8, 0x14     | 0x12 c.li   x12, 3   (not taken: PC + 2)
+    0x0001A001, // 0x14  c.j    .            | 0x16 c.nop
+};
+
+// 0x000 after a fourth reset: SB into a word that another master overwrites between the
+// store's read and its write
+const uint32_t MERGE_PROGRAM[] = {
+    0x20000137, // 0x00  lui  x2, 0x20000
+    0x123450B7, // 0x04  lui  x1, 0x12345
+    0x00112023, // 0x08  sw   x1, 0(x2)
+    0x05500193, // 0x0C  addi x3, x0, 0x55
+    0x00310023, // 0x10  sb   x3, 0(x2)
+    0x0000006F, // 0x14  j .
+};
+
+// RAM with the interconnect's per-hart reservation (one hart here)
+struct Bus {
+    std::map<uint32_t, uint32_t> memory;
+    int reads = 0, writes = 0, reserveReads = 0;
+    bool reservationValid = false;
+    uint32_t reservationAddress = 0;
+    int interfereAtReserve = 0; // Nth reserving read is followed by a foreign store of 100
+};
+
+const uint32_t* program     = PROGRAM;
+size_t          programSize = sizeof(PROGRAM);
+
+uint16_t fetchHalf(uint32_t pc) {
+    uint32_t shift = (pc & 2) * 8;
+    if (pc < programSize) return program[pc / 4] >> shift;
+    if (pc >= 0x100 && pc < 0x100 + sizeof(HANDLER)) return HANDLER[(pc - 0x100) / 4] >> shift;
+    return 0x00000013 >> shift; // NOP
+}
+
+// The 32 bits at a halfword-aligned PC, like inst_mem's fetch port
+uint32_t fetch(uint32_t pc) {
+    return fetchHalf(pc) | ((uint32_t)fetchHalf(pc + 2) << 16);
+}
+
+// One CPU cycle: zero-wait instruction and data memory, then the clock edge
+void cycle(Vcpu_core* core, Bus& bus) {
+    core->fetchData = fetch(core->fetchAddress);
+    core->eval();
+    core->busReadValidData = core->busReadValid;
+    core->busReadData      = bus.memory[core->busReadAddress];
+    core->busWriteFail     = core->busWriteValid && core->busWriteConditional &&
+                             !(bus.reservationValid && bus.reservationAddress == core->busWriteAddress);
+    core->eval();
+    if (core->busReadValid) {
+        bus.reads++;
+        if (core->busReadReserve) {
+            bus.reservationValid   = true;
+            bus.reservationAddress = core->busReadAddress;
+            if (++bus.reserveReads == bus.interfereAtReserve) {
+                bus.memory[core->busReadAddress] = 100;
+                bus.reservationValid = false;
+            }
+        }
+    }
+    if (core->busWriteValid && core->busWriteReady) {
+        if (core->busWriteConditional) bus.reservationValid = false;
+        if (!core->busWriteFail) {
+            bus.memory[core->busWriteAddress] = core->busWriteData;
+            bus.writes++;
+            if (core->busWriteAddress == bus.reservationAddress) bus.reservationValid = false;
+        }
+    }
+    core->clock = 1; core->eval();
+    core->clock = 0; core->eval();
+}
+
+uint32_t reg(Vcpu_core* core, int index) {
+    return core->rootp->cpu_core__DOT__u_rf__DOT__registerFile[index];
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    Vcpu_core* core = new Vcpu_core;
+    Bus bus;
+
+    std::cout << "[TEST] Starting CPU Core (Hart) Verification...\n";
+
+    core->timerLimit     = 0xFFFFFFFF; // No timer interrupts
+    core->busWriteReady  = 1;
+    core->busReadReady   = 1;
+    core->resetActiveLow = 0;
+    core->eval();
+    core->resetActiveLow = 1;
+
+    // --- TEST 1: BUS LOAD/STORE ---
+    for (int i = 0; i < 5; i++) cycle(core, bus);
+    if (bus.memory[0x20000000] == 5 && reg(core, 3) == 5) {
+        std::cout << "[PASS] Test 1: Store and Load Through the Data Port.\n";
+    } else {
+        std::cout << "[FAIL] Test 1: RAM[0] = " << bus.memory[0x20000000] << ", x3 = " << reg(core, 3) << "\n";
+        return 1;
+    }
+
+    // --- TEST 2: HART-LOCAL REGISTERS STAY OFF THE BUS ---
+    int readsBefore = bus.reads, writesBefore = bus.writes;
+    for (int i = 0; i < 3; i++) cycle(core, bus);
+    if (reg(core, 5) == 0 && bus.reads == readsBefore && bus.writes == writesBefore) {
+        std::cout << "[PASS] Test 2: HARTID Read and MTVEC Write Completed Locally.\n";
+    } else {
+        std::cout << "[FAIL] Test 2: HARTID " << reg(core, 5) << ", bus reads +" << bus.reads - readsBefore
+                  << ", writes +" << bus.writes - writesBefore << "\n";
+        return 1;
+    }
+
+    // --- TEST 3: ECALL TRAPS TO MTVEC ---
+    for (int i = 0; i < 8; i++) cycle(core, bus);
+    if (reg(core, 7) == 0x0000000B && reg(core, 8) == 0x24 && core->fetchAddress == 0x24) {
+        std::cout << "[PASS] Test 3: ECALL Trapped to MTVEC, Returned Past the Call.\n";
+    } else {
+        std::cout << "[FAIL] Test 3: MCAUSE 0x" << std::hex << reg(core, 7) << " MEPC 0x" << reg(core, 8)
+                  << " PC 0x" << core->fetchAddress << "\n";
+        return 1;
+    }
+
+    // --- TEST 4: SOFTWARE INTERRUPT (IPI) ---
+    // MSIP is a level: the trap is taken at once and again after MRET until the line drops
+    core->softwareInterrupt = 1;
+    cycle(core, bus);
+    core->softwareInterrupt = 0;
+    for (int i = 0; i < 8; i++) cycle(core, bus);
+    if (reg(core, 7) == 0x80000003 && core->fetchAddress == 0x28) {
+        std::cout << "[PASS] Test 4: Software Interrupt Taken (MCAUSE 0x80000003).\n";
+    } else {
+        std::cout << "[FAIL] Test 4: MCAUSE 0x" << std::hex << reg(core, 7) << " PC 0x" << core->fetchAddress << "\n";
+        return 1;
+    }
+
+    // --- TEST 5: LR/SC AND AMOS ---
+    // A foreign store lands between AMOADD's read and write: its conditional write fails and the
+    // AMO reads again, so it adds to the new value (100 + 5) and is never torn.
+    program     = ATOMIC_PROGRAM;
+    programSize = sizeof(ATOMIC_PROGRAM);
+    bus = Bus();
+    bus.interfereAtReserve = 2;
+    core->resetActiveLow = 0;
+    core->eval();
+    core->resetActiveLow = 1;
+    for (int i = 0; i < 30; i++) cycle(core, bus);
+
+    bool lrSc = reg(core, 3) == 8 && reg(core, 4) == 0 && reg(core, 5) == 1;
+    bool amos = reg(core, 7) == 100 && reg(core, 8) == 105 && reg(core, 10) == 7 && bus.memory[0x20000000] == 0xF7;
+    if (lrSc && amos && bus.reserveReads == 5 && core->fetchAddress == 0x30) {
+        std::cout << "[PASS] Test 5: LR/SC Pair, Lost Reservation, AMO Retried After Interference.\n";
+    } else {
+        std::cout << "[FAIL] Test 5: x3 " << reg(core, 3) << " x4 " << reg(core, 4) << " x5 " << reg(core, 5)
+                  << " x7 " << reg(core, 7) << " x8 " << reg(core, 8) << " x10 " << reg(core, 10) << " RAM 0x"
+                  << std::hex << bus.memory[0x20000000] << std::dec << " reserving reads " << bus.reserveReads << "\n";
+        return 1;
+    }
+
+    // --- TEST 6: COMPRESSED INSTRUCTIONS (RV32C) ---
+    // 16-bit instructions advance the PC by 2, the 32-bit one between them is fetched across a
+    // word boundary, C.JAL links PC + 2 and a not-taken C.BEQZ falls through to PC + 2
+    program     = COMPRESSED_PROGRAM;
+    programSize = sizeof(COMPRESSED_PROGRAM);
+    uint32_t x10Before = reg(core, 10);
+    core->resetActiveLow = 0;
+    core->eval();
+    core->resetActiveLow = 1;
+    for (int i = 0; i < 10; i++) cycle(core, bus);
+
+    bool sequence = reg(core, 8) == 12 && reg(core, 9) == 7 && reg(core, 12) == 3 && reg(core, 10) == x10Before;
+    bool link     = reg(core, 1) == 0x0A && reg(core, 11) == 0x0A;
+    if (sequence && link && core->fetchAddress == 0x14) {
+        std::cout << "[PASS] Test 6: RV32C Expanded, PC + 2 Sequencing, Straddling 32-bit Fetch, C.JAL Link.\n";
+    } else {
+        std::cout << "[FAIL] Test 6: x8 " << reg(core, 8) << " x9 " << reg(core, 9) << " x10 " << reg(core, 10)
+                  << " x12 " << reg(core, 12) << std::hex << " ra 0x" << reg(core, 1) << " x11 0x" << reg(core, 11)
+                  << " PC 0x" << core->fetchAddress << "\n";
+        return 1;
+    }
+
+    // --- TEST 7: SUB-WORD STORE MERGE ---
+    // The SB's read reserves the word; the foreign store of 100 breaks the reservation, so the
+    // merged write fails and the SB reads again instead of writing back the stale 0x12345000
+    program     = MERGE_PROGRAM;
+    programSize = sizeof(MERGE_PROGRAM);
+    bus = Bus();
+    bus.interfereAtReserve = 1;
+    core->resetActiveLow = 0;
+    core->eval();
+    core->resetActiveLow = 1;
+    for (int i = 0; i < 12; i++) cycle(core, bus);
+
+    if (bus.memory[0x20000000] == 0x55 && bus.reserveReads == 2 && core->fetchAddress == 0x14) {
+        std::cout << "[PASS] Test 7: SB Merge Retried After a Foreign Store to the Word.\n";
+    } else {
+        std::cout << "[FAIL] Test 7: RAM 0x" << std::hex << bus.memory[0x20000000] << std::dec << " reserving reads "
+                  << bus.reserveReads << " PC 0x" << std::hex << core->fetchAddress << "\n";
+        return 1;
+    }
+
+    std::cout << "------------------------------------------\n";
+    std::cout << "[SUCCESS] CPU Core Verified.\n";
+
+    delete core;
+    return 0;
+}
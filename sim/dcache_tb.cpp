@@ -0,0 +1,206 @@
+#include <iostream>
+#include <verilated.h>
+#include "Vdcache.h"
+
+// --- CACHE GEOMETRY (Must match dcache defaults) ---
+const int LINE_WORDS   = 4;
+const int BUFFER_DEPTH = 4;
+const int MEM_LATENCY  = 5;
+
+// --- BACKING STORE MODEL ---
+// Stands in for ram_backend: serves line requests after MEM_LATENCY cycles
+uint32_t backingStore[1024];
+int      latencyCounter = 0;
+
+void serviceBackend(Vdcache* top) {
+    top->memDone = 0;
+    if (!top->memRequest) { latencyCounter = 0; return; }
+
+    uint32_t base = (top->memLineAddress >> 2) & 0x3FF;
+    for (int w = 0; w < LINE_WORDS; w++) top->memReadLine[w] = backingStore[base + w];
+
+    if (latencyCounter == MEM_LATENCY - 1) {
+        top->memDone = 1;
+        if (top->memWrite) {
+            for (int w = 0; w < LINE_WORDS; w++) backingStore[base + w] = top->memWriteLine[w];
+        }
+    }
+}
+
+// Helper to step the clock (backend responds combinationally before the edge)
+void tick(Vdcache* top) {
+    top->clock = 0; top->eval();
+    serviceBackend(top); top->eval();
+    top->clock = 1; top->eval();
+    latencyCounter = (top->memRequest && !top->memDone) ? latencyCounter + 1 : 0;
+}
+
+// Issues a load (address handshake) and waits for the data handshake; returns stall cycles
+int readWord(Vdcache* top, uint32_t address, uint32_t &data) {
+    int stalls = 0;
+    top->ramAxiReadAddress   = address;
+    top->ramAxiReadValid     = 1;
+    top->ramAxiReadReadyData = 1;
+    top->eval();
+    while (!top->ramAxiReadValidData) {
+        bool accepted = top->ramAxiReadReady;
+        tick(top);
+        if (accepted) top->ramAxiReadValid = 0; // Request is now outstanding
+        top->eval();
+        stalls++;
+        if (stalls > 100) break;
+    }
+    data = top->ramAxiReadData;
+    tick(top);
+    top->ramAxiReadValid = 0;
+    return stalls;
+}
+
+// Posts a store; returns cycles spent waiting for a write-buffer slot
+int writeWord(Vdcache* top, uint32_t address, uint32_t data) {
+    int stalls = 0;
+    top->ramAxiWriteAddress = address;
+    top->ramAxiWriteData    = data;
+    top->ramAxiWriteValid   = 1;
+    top->eval();
+    while (!top->ramAxiWriteReady) {
+        tick(top);
+        stalls++;
+        if (stalls > 100) break;
+    }
+    tick(top);
+    top->ramAxiWriteValid = 0;
+    return stalls;
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    Vdcache* cache = new Vdcache;
+
+    std::cout << "[TEST] Starting Data Cache Verification...\n";
+
+    for (int i = 0; i < 1024; i++) backingStore[i] = 0xA0000000 | i;
+
+    cache->resetActiveLow = 0;
+    tick(cache);
+    cache->resetActiveLow = 1;
+    tick(cache);
+
+    // ==========================================
+    // TEST 1: COLD MISS THEN HIT
+    // ==========================================
+    uint32_t data = 0;
+    int missStalls = readWord(cache, 0x20000040, data);
+    if (missStalls >= MEM_LATENCY && data == (0xA0000000 | 0x10)) {
+        std::cout << "[PASS] Cold Miss Filled Line (" << missStalls << " stall cycles).\n";
+    } else {
+        std::cout << "[FAIL] Cold Miss. Stalls: " << missStalls << " Data: " << std::hex << data << "\n";
+        return 1;
+    }
+
+    // Neighbouring word in the same line must now hit with zero wait states
+    int hitStalls = readWord(cache, 0x20000044, data);
+    if (hitStalls == 0 && data == (0xA0000000 | 0x11)) {
+        std::cout << "[PASS] Same-Line Access Hits (Zero Wait).\n";
+    } else {
+        std::cout << "[FAIL] Expected hit. Stalls: " << hitStalls << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 2: POSTED STORES & FORWARDING
+    // ==========================================
+    // A store to an uncached line must retire immediately into the write buffer
+    int storeStalls = writeWord(cache, 0x20000100, 0xDEADBEEF);
+    cache->ramAxiReadAddress = 0x20000100;
+    cache->ramAxiReadValid   = 1;
+    cache->eval();
+    bool forwarded = cache->ramAxiReadValidData && cache->ramAxiReadData == 0xDEADBEEF;
+    cache->ramAxiReadValid   = 0;
+
+    if (storeStalls == 0 && forwarded) {
+        std::cout << "[PASS] Store Retired Without Stall & Forwarded to Load.\n";
+    } else {
+        std::cout << "[FAIL] Posted Store. Stalls: " << storeStalls << " Forwarded: " << forwarded << "\n";
+        return 1;
+    }
+
+    // Let the buffer drain (write-allocate fill + merge)
+    for (int i = 0; i < 4 * MEM_LATENCY; i++) tick(cache);
+    readWord(cache, 0x20000100, data);
+    if (data == 0xDEADBEEF) {
+        std::cout << "[PASS] Write-Allocate Merged Store Into Line.\n";
+    } else {
+        std::cout << "[FAIL] Write-Allocate. Got: " << std::hex << data << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 3: DIRTY EVICTION (WRITE-BACK)
+    // ==========================================
+    // 0x20000500 maps to the same set as 0x20000100 (16 lines x 16 bytes)
+    if (backingStore[0x40] != (0xA0000000 | 0x40)) {
+        std::cout << "[FAIL] Write-through detected: backing store updated before eviction.\n";
+        return 1;
+    }
+    readWord(cache, 0x20000500, data);
+    if (backingStore[0x40] == 0xDEADBEEF && data == (0xA0000000 | 0x140)) {
+        std::cout << "[PASS] Dirty Line Written Back on Eviction.\n";
+    } else {
+        std::cout << "[FAIL] Write-Back. Memory: " << std::hex << backingStore[0x40] << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 4: HELD RESPONSE (READY-DATA LOW)
+    // ==========================================
+    // A hit the bus cannot take yet must be held and must block further loads and stores
+    cache->ramAxiReadAddress   = 0x20000044;
+    cache->ramAxiReadValid     = 1;
+    cache->ramAxiReadReadyData = 0;
+    tick(cache);
+    cache->ramAxiReadValid     = 0;
+    cache->ramAxiWriteValid    = 1;
+    cache->ramAxiWriteAddress  = 0x20000044;
+    cache->eval();
+    bool held = cache->ramAxiReadValidData && !cache->ramAxiReadReady && !cache->ramAxiWriteReady;
+    cache->ramAxiWriteValid    = 0;
+    cache->ramAxiReadReadyData = 1;
+    cache->eval();
+    bool heldData = cache->ramAxiReadData == (0xA0000000 | 0x11);
+    tick(cache);
+    cache->eval();
+
+    if (held && heldData && cache->ramAxiReadReady) {
+        std::cout << "[PASS] Response Held Until Taken; Port Blocked Meanwhile.\n";
+    } else {
+        std::cout << "[FAIL] Held Response Handshake.\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 5: WRITE BUFFER BACK-PRESSURE
+    // ==========================================
+    // Stores to distinct cold lines queue behind fills; the buffer must eventually fill
+    int totalStalls = 0;
+    for (int i = 0; i < BUFFER_DEPTH + 2; i++) {
+        totalStalls += writeWord(cache, 0x20000800 + i * 0x10, 0x1000 + i);
+    }
+    if (totalStalls > 0) {
+        std::cout << "[PASS] Full Write Buffer Applies Back-Pressure (" << std::dec << totalStalls << " cycles).\n";
+    } else {
+        std::cout << "[FAIL] Write buffer never filled.\n";
+        return 1;
+    }
+
+    std::cout << "[INFO] Hits: " << std::dec << cache->statHits
+              << " Misses: " << cache->statMisses
+              << " Writebacks: " << cache->statWritebacks
+              << " Stall Cycles: " << cache->statStallCycles << "\n";
+
+    std::cout << "------------------------------------------\n";
+    std::cout << "[SUCCESS] Data Cache Verified.\n";
+
+    delete cache;
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <verilated.h>
+#include "Vfpu.h"
+#include "rv32f_model.h"
+
+void tick(Vfpu* dut) {
+    dut->clock = 0; dut->eval();
+    dut->clock = 1; dut->eval();
+}
+
+// Issues one instruction the way cpu_core does: 'start' held while busy, the result read in the
+// last cycle and retired on the following edge. A pipelined operation retires at once and its
+// result is taken from the pipeline write port. Returns the cycles from issue until the result
+// can be read (1 for single-cycle ops).
+uint32_t issue(Vfpu* dut, uint32_t insn, uint32_t a, uint32_t b, uint32_t c, uint32_t x, uint32_t frm,
+               uint32_t& result, uint32_t& flags) {
+    dut->start = 1;
+    dut->instruction = insn;
+    dut->operandA = a;
+    dut->operandB = b;
+    dut->operandC = c;
+    dut->integerOperand = x;
+    dut->dynamicRounding = frm;
+    dut->eval();
+    uint32_t cycles = 1;
+    while (dut->busy && cycles < 100) {
+        tick(dut);
+        cycles++;
+    }
+    bool pipelined = dut->pipelined;
+    result = dut->result;
+    flags  = dut->exceptionFlags;
+    tick(dut);
+    dut->start = 0;
+    dut->instruction = 0;
+    dut->eval();
+    if (pipelined) {
+        while (!dut->pipeWriteEnable && cycles < 100) {
+            tick(dut);
+            cycles++;
+        }
+        result = dut->pipeWriteData;
+        flags  = dut->pipeWriteFlags;
+        tick(dut); // Written at this edge: readable in the next cycle
+        cycles++;
+        dut->eval();
+    }
+    return cycles;
+}
+
+// Puts 'insn' in decode (start: an FP compute instruction, otherwise FLW/FSW) until the FPU lets
+// it go, then retires it. Returns the cycles it was held.
+uint32_t held(Vfpu* dut, uint32_t insn, bool start) {
+    dut->start = start;
+    dut->instruction = insn;
+    dut->eval();
+    uint32_t cycles = 0;
+    while (dut->busy && cycles < 100) {
+        tick(dut);
+        cycles++;
+    }
+    tick(dut);
+    dut->start = 0;
+    dut->instruction = 0;
+    dut->eval();
+    return cycles;
+}
+
+// Waits until the pipeline has written its last result
+void drain(Vfpu* dut) {
+    for (int i = 0; i < 100 && dut->inFlight; i++) tick(dut);
+}
+
+uint32_t opFp(uint32_t funct7, uint32_t rm, uint32_t rs2, uint32_t rs1 = 1, uint32_t rd = 2) {
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (rm << 12) | (rd << 7) | 0x53;
+}
+
+// --- KNOWN RESULTS (IEEE 754 single precision) ---
+struct Case {
+    uint32_t    insn, a, b, c, x;
+    uint32_t    result, flags;
+    const char* text;
+};
+
+const Case CASES[] = {
+    { opFp(0x00, 0, 0), 0x3F800000, 0x40000000, 0, 0, 0x40400000, 0,                     "fadd 1 + 2 = 3" },
+    { opFp(0x04, 0, 0), 0x3F800000, 0x3F800000, 0, 0, 0x00000000, 0,                     "fsub 1 - 1 = +0" },
+    { opFp(0x04, 2, 0), 0x3F800000, 0x3F800000, 0, 0, 0x80000000, 0,                     "fsub 1 - 1 = -0 (RDN)" },
+    { opFp(0x08, 0, 0), 0x7F7FFFFF, 0x40000000, 0, 0, 0x7F800000, Rv32fModel::OF | Rv32fModel::NX, "fmul max * 2 = inf" },
+    { opFp(0x08, 1, 0), 0x7F7FFFFF, 0x40000000, 0, 0, 0x7F7FFFFF, Rv32fModel::OF | Rv32fModel::NX, "fmul max * 2 = max (RTZ)" },
+    { opFp(0x08, 0, 0), 0x00800000, 0x3F000000, 0, 0, 0x00400000, 0,                     "fmul min normal / 2 (exact subnormal)" },
+    { opFp(0x08, 0, 0), 0x7F800000, 0x00000000, 0, 0, Rv32fModel::CANONICAL_NAN, Rv32fModel::NV, "fmul inf * 0 = NaN" },
+    { opFp(0x0C, 0, 0), 0x3F800000, 0x40400000, 0, 0, 0x3EAAAAAB, Rv32fModel::NX,        "fdiv 1 / 3" },
+    { opFp(0x0C, 1, 0), 0x3F800000, 0x40400000, 0, 0, 0x3EAAAAAA, Rv32fModel::NX,        "fdiv 1 / 3 (RTZ)" },
+    { opFp(0x0C, 0, 0), 0xBF800000, 0x00000000, 0, 0, 0xFF800000, Rv32fModel::DZ,        "fdiv -1 / 0 = -inf" },
+    { opFp(0x2C, 0, 0), 0x40000000, 0,          0, 0, 0x3FB504F3, Rv32fModel::NX,        "fsqrt 2" },
+    { opFp(0x2C, 0, 0), 0x41800000, 0,          0, 0, 0x40800000, 0,                     "fsqrt 16 = 4" },
+    { opFp(0x2C, 0, 0), 0xBF800000, 0,          0, 0, Rv32fModel::CANONICAL_NAN, Rv32fModel::NV, "fsqrt -1 = NaN" },
+    { 0x18208143,       0x3FC00000, 0x40000000, 0x3F800000, 0, 0x40800000, 0,            "fmadd 1.5 * 2 + 1 = 4" },
+    { 0x1820814B,       0x3FC00000, 0x40000000, 0x3F800000, 0, 0xC0000000, 0,            "fnmsub -(1.5 * 2) + 1 = -2" },
+    { opFp(0x60, 0, 0), 0x40200000, 0,          0, 0, 0x00000002, Rv32fModel::NX,        "fcvt.w.s 2.5 = 2 (RNE)" },
+    { opFp(0x60, 4, 0), 0x40200000, 0,          0, 0, 0x00000003, Rv32fModel::NX,        "fcvt.w.s 2.5 = 3 (RMM)" },
+    { opFp(0x60, 0, 1), 0xBF800000, 0,          0, 0, 0x00000000, Rv32fModel::NV,        "fcvt.wu.s -1 = 0" },
+    { opFp(0x60, 0, 0), 0x7FC00000, 0,          0, 0, 0x7FFFFFFF, Rv32fModel::NV,        "fcvt.w.s NaN = INT_MAX" },
+    { opFp(0x68, 0, 0), 0,          0,          0, 0xFFFFFFFF, 0xBF800000, 0,            "fcvt.s.w -1" },
+    { opFp(0x68, 0, 0), 0,          0,          0, 0x01000001, 0x4B800000, Rv32fModel::NX, "fcvt.s.w 2^24 + 1 (rounds)" },
+    { opFp(0x14, 0, 0), 0x00000000, 0x80000000, 0, 0, 0x80000000, 0,                     "fmin +0, -0 = -0" },
+    { opFp(0x14, 1, 0), 0x7F800001, 0x3F800000, 0, 0, 0x3F800000, Rv32fModel::NV,        "fmax sNaN, 1 = 1" },
+    { opFp(0x50, 2, 0), 0x7FC00000, 0x7FC00000, 0, 0, 0,          0,                     "feq qNaN, qNaN = 0 (quiet)" },
+    { opFp(0x50, 1, 0), 0x7FC00000, 0x3F800000, 0, 0, 0,          Rv32fModel::NV,        "flt qNaN, 1 = 0 (signalling)" },
+    { opFp(0x50, 0, 0), 0x80000000, 0x00000000, 0, 0, 1,          0,                     "fle -0, +0 = 1" },
+    { opFp(0x70, 1, 0), 0x00000001, 0,          0, 0, 1u << 5,    0,                     "fclass +subnormal" },
+    { opFp(0x10, 1, 0), 0x3F800000, 0x3F800000, 0, 0, 0xBF800000, 0,                     "fsgnjn 1, 1 = -1" },
+};
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    Vfpu* dut = new Vfpu;
+
+    std::cout << "[TEST] Starting FPU Verification...\n";
+
+    dut->resetActiveLow = 0;
+    dut->start = 0;
+    dut->hold = 0;
+    tick(dut);
+    dut->resetActiveLow = 1;
+    tick(dut);
+
+    // ==========================================
+    // TEST 1: KNOWN RESULTS AND FLAGS
+    // ==========================================
+    for (const Case& c : CASES) {
+        uint32_t result, flags;
+        issue(dut, c.insn, c.a, c.b, c.c, c.x, 0, result, flags);
+        if (result != c.result || flags != c.flags) {
+            std::cout << "[FAIL] " << c.text << ": got 0x" << std::hex << std::setw(8) << std::setfill('0') << result
+                      << " flags 0x" << flags << ", expected 0x" << std::setw(8) << c.result << " flags 0x"
+                      << c.flags << "\n";
+            return 1;
+        }
+    }
+    std::cout << "[PASS] Known Results: " << sizeof(CASES) / sizeof(CASES[0]) << " operations and their flags.\n";
+
+    // ==========================================
+    // TEST 2: DYNAMIC ROUNDING MODE
+    // ==========================================
+    // rm = 111 takes FCSR.frm; the reserved values 101/110 round to nearest even
+    {
+        uint32_t up, down, reserved, flags;
+        issue(dut, opFp(0x0C, 7, 0), 0x3F800000, 0x40400000, 0, 0, 3, up, flags);
+        issue(dut, opFp(0x0C, 7, 0), 0x3F800000, 0x40400000, 0, 0, 2, down, flags);
+        issue(dut, opFp(0x0C, 7, 0), 0x3F800000, 0x40400000, 0, 0, 6, reserved, flags);
+        if (up != 0x3EAAAAAB || down != 0x3EAAAAAA || reserved != 0x3EAAAAAB) {
+            std::cout << "[FAIL] Dynamic Rounding: 1/3 RUP 0x" << std::hex << up << ", RDN 0x" << down
+                      << ", frm 110 0x" << reserved << "\n";
+            return 1;
+        }
+        std::cout << "[PASS] Dynamic Rounding: frm selects RUP/RDN, reserved modes round to nearest.\n";
+    }
+
+    // ==========================================
+    // TEST 3: LATENCY
+    // ==========================================
+    // Results become readable after exactly the cycles the VP charges (Rv32fModel::latency)
+    {
+        const uint32_t insns[] = { opFp(0x10, 0, 0), opFp(0x50, 2, 0), opFp(0x78, 0, 0), opFp(0x00, 0, 0),
+                                   opFp(0x08, 0, 0), 0x18208143, opFp(0x60, 0, 0), opFp(0x68, 0, 0),
+                                   opFp(0x0C, 0, 0), opFp(0x2C, 0, 0) };
+        for (uint32_t insn : insns) {
+            uint32_t result, flags;
+            uint32_t cycles = issue(dut, insn, 0x40400000, 0x3F800000, 0x3F800000, 5, 0, result, flags);
+            if (cycles != Rv32fModel::latency(insn)) {
+                std::cout << "[FAIL] Latency of 0x" << std::hex << insn << ": " << std::dec << cycles
+                          << " cycles, expected " << Rv32fModel::latency(insn) << "\n";
+                return 1;
+            }
+        }
+        std::cout << "[PASS] Latency: 1 cycle (moves, compares), " << Rv32fModel::PIPELINE_CYCLES
+                  << " (add/mul/FMA/convert), " << Rv32fModel::ITERATIVE_CYCLES << " (div/sqrt).\n";
+    }
+
+    // ==========================================
+    // TEST 4: RANDOM OPERATIONS (REFERENCE MODEL)
+    // ==========================================
+    // Every compute encoding, every rounding mode, operands biased towards zeros, infinities,
+    // NaNs, subnormals and near-ties, against sim/rv32f_model.h (used by the VP)
+    {
+        std::mt19937 rng(2024);
+        const uint32_t edges[] = { 0x00000000, 0x80000000, 0x3F800000, 0xBF800000, 0x7F800000, 0xFF800000,
+                                   0x7FC00000, 0x7F800001, 0x00000001, 0x007FFFFF, 0x00800000, 0x7F7FFFFF,
+                                   0x4F000000, 0xCF000000, 0x4F800000, 0x3F000000 };
+        auto operand = [&]() -> uint32_t {
+            switch (rng() % 4) {
+                case 0:  return edges[rng() % 16];
+                case 1:  return edges[rng() % 16] ^ (rng() & 0x3);                         // Next to an edge
+                case 2:  return (rng() & 0x80000000) | ((0x60 + rng() % 0x40) << 23) | (rng() & 0x7FFFFF);
+                default: return rng();
+            }
+        };
+        const uint32_t funct7s[] = { 0x00, 0x04, 0x08, 0x0C, 0x2C, 0x10, 0x14, 0x50, 0x60, 0x68, 0x70, 0x78 };
+        const uint32_t RUNS = 100000;
+        for (uint32_t i = 0; i < RUNS; i++) {
+            uint32_t insn;
+            do {
+                insn = (rng() & 3) ? opFp(funct7s[rng() % 12], rng() % 8, rng() % 2)
+                                   : ((rng() % 32) << 27) | (rng() & 0x01FFFF80) | (0x43 + 4 * (rng() % 4));
+                insn &= ~(3u << 25);
+            } while (!Rv32fModel::isCompute(insn) || ((insn >> 12) & 7) == 5 || ((insn >> 12) & 7) == 6);
+            uint32_t a = operand(), b = operand(), c = operand(), x = rng() % 3 ? rng() : edges[rng() % 16];
+            uint32_t frm = rng() % 8, result, flags, expectedFlags;
+            uint32_t expected = Rv32fModel::execute(insn, a, b, c, x, frm, expectedFlags);
+            issue(dut, insn, a, b, c, x, frm, result, flags);
+            if (result != expected || flags != expectedFlags) {
+                std::cout << "[FAIL] Random: insn 0x" << std::hex << std::setw(8) << std::setfill('0') << insn
+                          << " a 0x" << a << " b 0x" << b << " c 0x" << c << " x 0x" << x << " frm " << frm
+                          << ": got 0x" << result << "/" << flags << ", reference 0x" << expected << "/"
+                          << expectedFlags << "\n";
+                return 1;
+            }
+        }
+        std::cout << "[PASS] Random: " << RUNS << " operations match the reference model.\n";
+    }
+
+    // ==========================================
+    // TEST 5: PIPELINE THROUGHPUT
+    // ==========================================
+    // Independent add/mul/FMA/convert issue on consecutive cycles; each result is written to its
+    // own f register through the pipeline port PIPELINE_CYCLES - 1 cycles after it issued
+    {
+        struct Op { uint32_t insn, a, b, c, x; };
+        const Op ops[] = {
+            { opFp(0x00, 0, 1, 1, 3),   0x3F800000, 0x40000000, 0,          0 },          // fadd f3
+            { opFp(0x08, 0, 5, 6, 4),   0x40400000, 0x40400000, 0,          0 },          // fmul f4
+            { 0x50B60343,               0x3FC00000, 0x40000000, 0x3F800000, 0 },          // fmadd f6, f12, f11, f10
+            { opFp(0x68, 0, 0, 9, 8),   0,          0,          0,          0xFFFFFFFF }, // fcvt.s.w f8
+            { opFp(0x04, 1, 11, 10, 9), 0x3F800000, 0x3F800000, 0,          0 },          // fsub f9 (RTZ)
+        };
+        const uint32_t N = sizeof(ops) / sizeof(ops[0]);
+        uint32_t writes = 0;
+        for (uint32_t t = 0; t < N + 4; t++) {
+            dut->start = t < N;
+            if (t < N) {
+                dut->instruction = ops[t].insn;
+                dut->operandA = ops[t].a;
+                dut->operandB = ops[t].b;
+                dut->operandC = ops[t].c;
+                dut->integerOperand = ops[t].x;
+            }
+            dut->eval();
+            if (t < N && (dut->busy || !dut->pipelined)) {
+                std::cout << "[FAIL] Throughput: operation " << t << " did not issue in cycle " << t << "\n";
+                return 1;
+            }
+            if (dut->pipeWriteEnable) {
+                const Op& op = ops[writes];
+                uint32_t flags, expected = Rv32fModel::execute(op.insn, op.a, op.b, op.c, op.x, 0, flags);
+                if (t != writes + Rv32fModel::PIPELINE_CYCLES - 1 || dut->pipeWriteAddress != ((op.insn >> 7) & 0x1F) ||
+                    dut->pipeWriteData != expected || dut->pipeWriteFlags != flags) {
+                    std::cout << "[FAIL] Throughput: cycle " << t << " wrote f" << (uint32_t)dut->pipeWriteAddress
+                              << " = 0x" << std::hex << dut->pipeWriteData << ", expected operation " << std::dec
+                              << writes << " (0x" << std::hex << expected << ")\n";
+                    return 1;
+                }
+                writes++;
+            }
+            tick(dut);
+        }
+        dut->start = 0;
+        dut->eval();
+        if (writes != N || dut->inFlight) {
+            std::cout << "[FAIL] Throughput: " << writes << " of " << N << " results written\n";
+            return 1;
+        }
+        std::cout << "[PASS] Throughput: " << N << " independent operations in " << N
+                  << " cycles, written back in order.\n";
+    }
+
+    // ==========================================
+    // TEST 6: REGISTER HAZARDS
+    // ==========================================
+    // An instruction that reads f2 (or writes it through the decode port) right after a pipelined
+    // write to f2 is held until the write-back; unrelated instructions are not. Divide and square
+    // root, and anything while an interrupt waits (hold), wait for the pipeline to drain.
+    {
+        const uint32_t producer = opFp(0x00, 0, 1, 1, 2); // fadd f2, f1, f1
+        const uint32_t fsw      = (2u << 20) | (5u << 15) | (2u << 12) | 0x27;  // fsw f2, 0(x5)
+        const uint32_t flw      = (5u << 15) | (2u << 12) | (2u << 7) | 0x07;  // flw f2, 0(x5)
+        struct Check { uint32_t insn; bool start, hold; uint32_t expected; const char* text; };
+        const Check checks[] = {
+            { opFp(0x08, 0, 3, 2, 4),  true,  false, 2, "fmul f4, f2, f3 (rs1)" },
+            { opFp(0x08, 0, 2, 3, 4),  true,  false, 2, "fmul f4, f3, f2 (rs2)" },
+            { 0x10000043 | (3u << 15) | (4u << 20) | (5u << 7), true, false, 2, "fmadd f5, f3, f4, f2 (rs3)" },
+            { opFp(0x70, 0, 0, 2, 6),  true,  false, 2, "fmv.x.w x6, f2" },
+            { opFp(0x10, 0, 3, 3, 2),  true,  false, 2, "fsgnj f2, f3, f3 (decode port write)" },
+            { fsw,                      false, false, 2, "fsw f2" },
+            { flw,                      false, false, 2, "flw f2" },
+            { opFp(0x00, 0, 3, 3, 2),  true,  false, 0, "fadd f2, f3, f3 (pipeline write, in order)" },
+            { opFp(0x08, 0, 3, 4, 5),  true,  false, 0, "fmul f5, f4, f3 (independent)" },
+            { opFp(0x68, 0, 0, 2, 6),  true,  false, 0, "fcvt.s.w f6, x2 (integer source)" },
+            { opFp(0x0C, 0, 3, 4, 5),  true,  false, 2 + Rv32fModel::ITERATIVE_CYCLES - 1, "fdiv f5, f4, f3 (drain)" },
+            { opFp(0x08, 0, 3, 4, 5),  true,  true,  2, "fmul f5, f4, f3 with an interrupt waiting" },
+        };
+        for (const Check& check : checks) {
+            dut->hold = 0;
+            dut->start = 1;
+            dut->instruction = producer;
+            dut->eval();
+            tick(dut); // The producer issues and retires
+            dut->hold = check.hold;
+            uint32_t cycles = held(dut, check.insn, check.start);
+            dut->hold = 0;
+            drain(dut);
+            if (cycles != check.expected) {
+                std::cout << "[FAIL] Hazards: " << check.text << " held " << cycles << " cycles, expected "
+                          << check.expected << "\n";
+                return 1;
+            }
+        }
+        std::cout << "[PASS] Hazards: " << sizeof(checks) / sizeof(checks[0])
+                  << " dependent and independent instructions after a pipelined write.\n";
+    }
+
+    std::cout << "------------------------------------------\n";
+    std::cout << "[SUCCESS] FPU Verified.\n";
+
+    delete dut;
+    return 0;
+}
@@ -86,6 +86,65 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // ==========================================
+    // TEST 4: PROGRAM RAM LOAD (PORT C)
+    // ==========================================
+    // Loads above 0x4000 become fetchable; the boot ROM half must ignore writes
+    rom->loadWriteEnable  = 1;
+    rom->loadWriteAddress = 0x00004000;
+    rom->loadWriteData    = 0x00100073;
+    rom->clock = 0; rom->eval(); rom->clock = 1; rom->eval();
+    rom->loadWriteAddress = 0x00000000;
+    rom->loadWriteData    = 0x0BADC0DE;
+    rom->clock = 0; rom->eval(); rom->clock = 1; rom->eval();
+    rom->loadWriteEnable  = 0;
+
+    rom->romAxiReadAddress = 0x00004000;
+    rom->busReadAddress    = 0x00000000;
+    rom->eval();
+
+    if (rom->romAxiReadData == 0x00100073 && rom->busReadData == 0xDEADBEEF) {
+        std::cout << "[PASS] Program RAM Loaded; Boot ROM Write-Protected.\n";
+    } else {
+        std::cout << "[FAIL] Program RAM Load. Fetch: " << std::hex << rom->romAxiReadData
+                  << " ROM[0]: " << rom->busReadData << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 5: SECOND FETCH PORT (PORT D, HART 1)
+    // ==========================================
+    // Both harts fetch different words in the same cycle
+    rom->romAxiReadAddress = 0x00000004;
+    rom->hart1ReadAddress  = 0x00004000;
+    rom->eval();
+
+    if (rom->romAxiReadData == 0xCAFEBABE && rom->hart1ReadData == 0x00100073) {
+        std::cout << "[PASS] Port D: Hart 1 fetches independently of hart 0.\n";
+    } else {
+        std::cout << "[FAIL] Port D. Hart 0: " << std::hex << rom->romAxiReadData
+                  << " Hart 1: " << rom->hart1ReadData << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 6: HALFWORD FETCH (RV32C)
+    // ==========================================
+    // PC 0x2 returns the upper half of word 0 and the lower half of word 1 (a straddling
+    // 32-bit instruction); the bus port stays word-aligned
+    rom->romAxiReadAddress = 0x00000002;
+    rom->hart1ReadAddress  = 0x00000006;
+    rom->busReadAddress    = 0x00000006;
+    rom->eval();
+
+    if (rom->romAxiReadData == 0xBABEDEAD && rom->hart1ReadData == 0x5678CAFE && rom->busReadData == 0xCAFEBABE) {
+        std::cout << "[PASS] Halfword Fetch: 32-bit window across a word boundary on both fetch ports.\n";
+    } else {
+        std::cout << "[FAIL] Halfword Fetch. Hart 0: " << std::hex << rom->romAxiReadData
+                  << " Hart 1: " << rom->hart1ReadData << " Bus: " << rom->busReadData << "\n";
+        return 1;
+    }
+
     std::cout << "------------------------------------------\n";
     std::cout << "[SUCCESS] Instruction Memory Verified.\n";
 
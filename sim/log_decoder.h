@@ -0,0 +1,128 @@
+#ifndef LOG_DECODER_H
+#define LOG_DECODER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Host side of firmware/log.h: rebuilds deferred log frames from the UART byte stream.
+ * Plain text passes through unchanged; frames are expanded using the .logstr section of the
+ * firmware ELF (tokens are offsets into it).
+ */
+class LogDecoder {
+public:
+    static const uint8_t MARKER = 0x1E;
+
+    // Loads the string table from an ELF32 image; returns false if it has no .logstr section
+    bool loadElf(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::vector<uint8_t> elf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (elf.size() < 52 || memcmp(elf.data(), "\x7f" "ELF", 4) != 0 || elf[4] != 1) return false;
+
+        uint32_t sectionOffset = read32(elf, 32);
+        uint16_t sectionSize   = read16(elf, 46);
+        uint16_t sectionCount  = read16(elf, 48);
+        uint16_t namesIndex    = read16(elf, 50);
+        if (sectionOffset + (size_t)sectionCount * sectionSize > elf.size()) return false;
+
+        uint32_t namesOffset = read32(elf, sectionOffset + namesIndex * sectionSize + 16);
+        for (uint16_t i = 0; i < sectionCount; i++) {
+            size_t   header = sectionOffset + (size_t)i * sectionSize;
+            uint32_t name   = read32(elf, header);
+            if (strcmp((const char*)&elf[namesOffset + name], ".logstr") != 0) continue;
+
+            uint32_t offset = read32(elf, header + 16);
+            uint32_t size   = read32(elf, header + 20);
+            if (offset + size > elf.size()) return false;
+            stringTable.assign(elf.begin() + offset, elf.begin() + offset + size);
+            return true;
+        }
+        return false;
+    }
+
+    // Feeds one UART byte; decoded text (or the passed-through byte) is written to 'out'
+    void feed(uint8_t byte, std::ostream& out) {
+        if (frameBytes.empty() && byte != MARKER) {
+            out << (char)byte;
+            return;
+        }
+        frameBytes.push_back(byte);
+        if (frameBytes.size() < 3) return;
+
+        uint16_t header = frameBytes[1] | (frameBytes[2] << 8);
+        size_t   nargs  = header >> 13;
+        if (frameBytes.size() < 3 + 4 * nargs) return;
+
+        std::vector<uint32_t> args;
+        for (size_t i = 0; i < nargs; i++) {
+            size_t at = 3 + 4 * i;
+            args.push_back(frameBytes[at] | (frameBytes[at + 1] << 8) | (frameBytes[at + 2] << 16) |
+                           ((uint32_t)frameBytes[at + 3] << 24));
+        }
+        out << format(header & 0x1FFF, args);
+        framesDecoded++;
+        bytesReceived += frameBytes.size();
+        frameBytes.clear();
+    }
+
+    // Expands one token: printf-style integer conversions only (arguments are raw words)
+    std::string format(uint32_t token, const std::vector<uint32_t>& args) const {
+        if (token >= stringTable.size()) {
+            std::string raw = "<log 0x" + hex(token);
+            for (uint32_t arg : args) raw += " 0x" + hex(arg);
+            return raw + ">\n";
+        }
+        const char* fmt = (const char*)&stringTable[token];
+        std::string text;
+        size_t argIndex = 0;
+        for (const char* p = fmt; *p && p < (const char*)stringTable.data() + stringTable.size(); p++) {
+            if (*p != '%') { text += *p; continue; }
+            if (p[1] == '%') { text += '%'; p++; continue; }
+
+            // Copy the conversion spec ("%08x") and render it with the next argument
+            std::string spec = "%";
+            while (*++p && strchr("-+ #0123456789.lh", *p)) if (*p != 'l' && *p != 'h') spec += *p;
+            if (!*p) break;
+            char buffer[64];
+            uint32_t value = argIndex < args.size() ? args[argIndex++] : 0;
+            switch (*p) {
+                case 'd': case 'i': snprintf(buffer, sizeof buffer, (spec + "d").c_str(), (int32_t)value); break;
+                case 'u': case 'x': case 'X': case 'o': case 'c':
+                          snprintf(buffer, sizeof buffer, (spec + *p).c_str(), value); break;
+                case 'p': snprintf(buffer, sizeof buffer, "0x%08x", value); break;
+                default:  snprintf(buffer, sizeof buffer, "<%%%c?>", *p); break;
+            }
+            text += buffer;
+        }
+        return text;
+    }
+
+    bool     loaded() const { return !stringTable.empty(); }
+    uint64_t frames() const { return framesDecoded; }
+    uint64_t frameBytesReceived() const { return bytesReceived; }
+
+private:
+    std::vector<uint8_t> stringTable;
+    std::vector<uint8_t> frameBytes;
+    uint64_t             framesDecoded = 0;
+    uint64_t             bytesReceived = 0;
+
+    static uint16_t read16(const std::vector<uint8_t>& b, size_t at) { return b[at] | (b[at + 1] << 8); }
+    static uint32_t read32(const std::vector<uint8_t>& b, size_t at) {
+        return b[at] | (b[at + 1] << 8) | (b[at + 2] << 16) | ((uint32_t)b[at + 3] << 24);
+    }
+    static std::string hex(uint32_t value) {
+        char buffer[16];
+        snprintf(buffer, sizeof buffer, "%x", value);
+        return buffer;
+    }
+};
+
+#endif
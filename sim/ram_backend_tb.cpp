@@ -0,0 +1,104 @@
+#include <iostream>
+#include <verilated.h>
+#include "Vram_backend.h"
+
+// PARAMETERS FROM RTL DEFAULTS
+const int LATENCY_CYCLES = 8;
+const int LINE_WORDS     = 4;
+
+// Helper to step the clock
+void tick(Vram_backend* top) {
+    top->clock = 0; top->eval();
+    top->clock = 1; top->eval();
+}
+
+// Holds a request until memDone and returns how many cycles it took
+int waitForDone(Vram_backend* top) {
+    int cycles = 0;
+    top->eval();
+    while (!top->memDone && cycles < 100) {
+        tick(top);
+        cycles++;
+    }
+    return cycles + 1; // Completion cycle itself
+}
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+    Vram_backend* ram = new Vram_backend;
+
+    std::cout << "[TEST] Starting RAM Backend Verification...\n";
+
+    ram->resetActiveLow = 0;
+    tick(ram);
+    ram->resetActiveLow = 1;
+
+    // ==========================================
+    // TEST 1: LINE WRITE LATENCY
+    // ==========================================
+    ram->memRequest     = 1;
+    ram->memWrite       = 1;
+    ram->memLineAddress = 0x20000040;
+    for (int w = 0; w < LINE_WORDS; w++) ram->memWriteLine[w] = 0x11110000 + w;
+
+    int writeCycles = waitForDone(ram);
+    tick(ram); // Commit on the completion edge
+    ram->memRequest = 0;
+    tick(ram);
+
+    if (writeCycles == LATENCY_CYCLES) {
+        std::cout << "[PASS] Write Completed After " << writeCycles << " Cycles.\n";
+    } else {
+        std::cout << "[FAIL] Write Latency. Expected " << LATENCY_CYCLES << ", Got: " << writeCycles << "\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 2: LINE READ-BACK
+    // ==========================================
+    ram->memRequest     = 1;
+    ram->memWrite       = 0;
+    ram->memLineAddress = 0x20000040;
+
+    int readCycles = waitForDone(ram);
+    bool lineOk = true;
+    for (int w = 0; w < LINE_WORDS; w++) lineOk &= (ram->memReadLine[w] == (uint32_t)(0x11110000 + w));
+    tick(ram);
+    ram->memRequest = 0;
+    tick(ram);
+
+    if (readCycles == LATENCY_CYCLES && lineOk) {
+        std::cout << "[PASS] Line Read-Back Verified.\n";
+    } else {
+        std::cout << "[FAIL] Line Read-Back Failed.\n";
+        return 1;
+    }
+
+    // ==========================================
+    // TEST 3: BACK-TO-BACK REQUESTS RESTART LATENCY
+    // ==========================================
+    // A held request (write-back followed by fill) must pay the latency twice
+    ram->memRequest     = 1;
+    ram->memWrite       = 1;
+    ram->memLineAddress = 0x20000080;
+    int first = waitForDone(ram);
+    tick(ram);
+    ram->memWrite       = 0;
+    ram->memLineAddress = 0x20000040;
+    int second = waitForDone(ram);
+    tick(ram);
+    ram->memRequest = 0;
+
+    if (first == LATENCY_CYCLES && second == LATENCY_CYCLES) {
+        std::cout << "[PASS] Back-to-Back Requests Each Pay Full Latency.\n";
+    } else {
+        std::cout << "[FAIL] Back-to-Back Latency. Got: " << first << ", " << second << "\n";
+        return 1;
+    }
+
+    std::cout << "------------------------------------------\n";
+    std::cout << "[SUCCESS] RAM Backend Verified.\n";
+
+    delete ram;
+    return 0;
+}
@@ -0,0 +1,234 @@
+#ifndef RV32_DISASM_H
+#define RV32_DISASM_H
+
+#include "rv32c_expand.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/**
+ * @brief RV32I/A/F (+Zba/Zbb) disassembler for host tools (sim/trace_dump.cpp).
+ * Covers what controller.sv decodes, plus MRET/ECALL; anything else prints as ".word".
+ * A compressed instruction prints as the RV32I instruction rvc_expander.sv turns it into.
+ */
+class Rv32Disassembler {
+public:
+    static const char *regName(uint32_t index) {
+        static const char *names[32] = {
+            "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2", "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+            "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
+        };
+        return names[index & 0x1F];
+    }
+
+    static const char *fregName(uint32_t index) {
+        static const char *names[32] = {
+            "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "fs0", "fs1", "fa0", "fa1", "fa2", "fa3", "fa4", "fa5",
+            "fa6", "fa7", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7", "fs8", "fs9", "fs10", "fs11", "ft8", "ft9", "ft10", "ft11"
+        };
+        return names[index & 0x1F];
+    }
+
+    // Register index from an ABI name or "x<N>"; -1 if unknown
+    static int regIndex(const std::string &name) {
+        if (name.size() > 1 && name[0] == 'x') {
+            int index = atoi(name.c_str() + 1);
+            return (index >= 0 && index < 32) ? index : -1;
+        }
+        if (name == "fp") return 8;
+        for (int i = 0; i < 32; i++) if (name == regName(i)) return i;
+        return -1;
+    }
+
+    // 'insn' is the 32 bits at 'pc' (only the low half is used if it is compressed);
+    // 'pc' resolves branch and jump targets
+    static std::string disassemble(uint32_t insn, uint32_t pc) {
+        if (Rv32cExpander::isCompressed(insn)) insn = Rv32cExpander::expand((uint16_t)insn);
+        uint32_t opcode = insn & 0x7F, funct3 = (insn >> 12) & 7, funct7 = insn >> 25;
+        uint32_t rd = (insn >> 7) & 0x1F, rs1 = (insn >> 15) & 0x1F, rs2 = (insn >> 20) & 0x1F;
+        int32_t  immI = (int32_t)insn >> 20;
+        char text[64];
+
+        switch (opcode) {
+            case 0x33: {
+                static const char *ops[8] = { "add", "sll", "slt", "sltu", "xor", "srl", "or", "and" };
+                const char *name = (funct7 == 0x20 && funct3 == 0) ? "sub" : (funct7 == 0x20 && funct3 == 5) ? "sra" : ops[funct3];
+                if (const char *bitName = bitmanipR(funct7, funct3)) name = bitName;
+                if (funct7 == 0x04 && funct3 == 4 && rs2 == 0) {
+                    snprintf(text, sizeof text, "%-7s %s,%s", "zext.h", regName(rd), regName(rs1));
+                    break;
+                }
+                snprintf(text, sizeof text, "%-7s %s,%s,%s", name, regName(rd), regName(rs1), regName(rs2));
+                break;
+            }
+            case 0x13: {
+                static const char *ops[8] = { "addi", "slli", "slti", "sltiu", "xori", "srli", "ori", "andi" };
+                const char *name = (funct3 == 5 && (funct7 & 0x20)) ? "srai" : ops[funct3];
+                if (insn == 0x00000013) return "nop";
+                if (const char *bitName = bitmanipUnary(funct7, funct3, rs2)) {
+                    snprintf(text, sizeof text, "%-7s %s,%s", bitName, regName(rd), regName(rs1));
+                    break;
+                }
+                if (funct3 == 5 && funct7 == 0x30) name = "rori";
+                if (funct3 == 1 || funct3 == 5) immI &= 0x1F;
+                snprintf(text, sizeof text, "%-7s %s,%s,%d", name, regName(rd), regName(rs1), immI);
+                break;
+            }
+            case 0x03: {
+                static const char *ops[8] = { "lb", "lh", "lw", "lw?", "lbu", "lhu", "lw?", "lw?" };
+                snprintf(text, sizeof text, "%-7s %s,%d(%s)", ops[funct3], regName(rd), immI, regName(rs1));
+                break;
+            }
+            case 0x23: {
+                static const char *ops[4] = { "sb", "sh", "sw", "sh?" };
+                int32_t immS = (((int32_t)insn >> 25) << 5) | ((insn >> 7) & 0x1F);
+                snprintf(text, sizeof text, "%-7s %s,%d(%s)", ops[funct3 & 3], regName(rs2), immS, regName(rs1));
+                break;
+            }
+            case 0x63: {
+                static const char *ops[8] = { "beq", "bne", "b?", "b?", "blt", "bge", "bltu", "bgeu" };
+                int32_t offset = (((int32_t)insn >> 31) << 12) | ((insn & 0x80) << 4) | ((insn >> 20) & 0x7E0) |
+                                 ((insn >> 7) & 0x1E);
+                snprintf(text, sizeof text, "%-7s %s,%s,0x%x", ops[funct3], regName(rs1), regName(rs2), pc + offset);
+                break;
+            }
+            case 0x37: snprintf(text, sizeof text, "%-7s %s,0x%x", "lui", regName(rd), insn >> 12); break;
+            case 0x17: snprintf(text, sizeof text, "%-7s %s,0x%x", "auipc", regName(rd), insn >> 12); break;
+            case 0x6F: {
+                int32_t offset = (((int32_t)insn >> 31) << 20) | (insn & 0xFF000) | ((insn >> 9) & 0x800) |
+                                 ((insn >> 20) & 0x7FE);
+                if (rd == 0) snprintf(text, sizeof text, "%-7s 0x%x", "j", pc + offset);
+                else         snprintf(text, sizeof text, "%-7s %s,0x%x", "jal", regName(rd), pc + offset);
+                break;
+            }
+            case 0x67:
+                if (insn == 0x00008067) return "ret";
+                snprintf(text, sizeof text, "%-7s %s,%d(%s)", "jalr", regName(rd), immI, regName(rs1));
+                break;
+            case 0x73:
+                if (insn == 0x30200073) return "mret";
+                if (insn == 0x00000073) return "ecall";
+                if (insn == 0x00100073) return "ebreak";
+                snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn);
+                break;
+            case 0x07:
+                if (funct3 != 2) { snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn); break; }
+                snprintf(text, sizeof text, "%-7s %s,%d(%s)", "flw", fregName(rd), immI, regName(rs1));
+                break;
+            case 0x27: {
+                int32_t immS = (((int32_t)insn >> 25) << 5) | ((insn >> 7) & 0x1F);
+                if (funct3 != 2) { snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn); break; }
+                snprintf(text, sizeof text, "%-7s %s,%d(%s)", "fsw", fregName(rs2), immS, regName(rs1));
+                break;
+            }
+            case 0x43: case 0x47: case 0x4B: case 0x4F: {
+                static const char *ops[4] = { "fmadd.s", "fmsub.s", "fnmsub.s", "fnmadd.s" };
+                if (funct7 & 3) { snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn); break; }
+                snprintf(text, sizeof text, "%-7s %s,%s,%s,%s%s", ops[(opcode >> 2) & 3], fregName(rd), fregName(rs1),
+                         fregName(rs2), fregName(insn >> 27), roundingSuffix(funct3));
+                break;
+            }
+            case 0x53: return floatOp(insn);
+            case 0x0F: return "fence";
+            case 0x2F: {
+                static const char *ops[32] = {
+                    "amoadd.w", "amoswap.w", "lr.w", "sc.w", "amoxor.w", nullptr, nullptr, nullptr,
+                    "amoor.w", nullptr, nullptr, nullptr, "amoand.w", nullptr, nullptr, nullptr,
+                    "amomin.w", nullptr, nullptr, nullptr, "amomax.w", nullptr, nullptr, nullptr,
+                    "amominu.w", nullptr, nullptr, nullptr, "amomaxu.w", nullptr, nullptr, nullptr };
+                const char *name = (funct3 == 2) ? ops[insn >> 27] : nullptr;
+                if (!name)               snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn);
+                else if ((insn >> 27) == 2) snprintf(text, sizeof text, "%-9s %s,(%s)", name, regName(rd), regName(rs1));
+                else snprintf(text, sizeof text, "%-9s %s,%s,(%s)", name, regName(rd), regName(rs2), regName(rs1));
+                break;
+            }
+            default:
+                snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn);
+                break;
+        }
+        return text;
+    }
+
+private:
+    // ",rtz" etc.; nothing for the dynamic mode (FCSR frm)
+    static const char *roundingSuffix(uint32_t rm) {
+        static const char *names[8] = { ",rne", ",rtz", ",rdn", ",rup", ",rmm", ",rm5", ",rm6", "" };
+        return names[rm & 7];
+    }
+
+    // OP-FP, single precision (the encodings controller.sv executes)
+    static std::string floatOp(uint32_t insn) {
+        uint32_t funct5 = insn >> 27, funct3 = (insn >> 12) & 7, fmt = (insn >> 25) & 3;
+        uint32_t rd = (insn >> 7) & 0x1F, rs1 = (insn >> 15) & 0x1F, rs2 = (insn >> 20) & 0x1F;
+        const char *rm = roundingSuffix(funct3);
+        char text[64];
+        snprintf(text, sizeof text, "%-7s 0x%08x", ".word", insn);
+        if (fmt != 0) return text;
+        switch (funct5) {
+            case 0x00: case 0x01: case 0x02: case 0x03: {
+                static const char *ops[4] = { "fadd.s", "fsub.s", "fmul.s", "fdiv.s" };
+                snprintf(text, sizeof text, "%-7s %s,%s,%s%s", ops[funct5], fregName(rd), fregName(rs1), fregName(rs2), rm);
+                break;
+            }
+            case 0x0B: snprintf(text, sizeof text, "%-7s %s,%s%s", "fsqrt.s", fregName(rd), fregName(rs1), rm); break;
+            case 0x04: case 0x05: case 0x14: {
+                static const char *ops[3][3] = { { "fsgnj.s", "fsgnjn.s", "fsgnjx.s" }, { "fmin.s", "fmax.s", nullptr },
+                                                 { "fle.s", "flt.s", "feq.s" } };
+                const char *name = funct3 < 3 ? ops[funct5 == 0x04 ? 0 : funct5 == 0x05 ? 1 : 2][funct3] : nullptr;
+                if (!name) break;
+                if (funct5 == 0x14) snprintf(text, sizeof text, "%-7s %s,%s,%s", name, regName(rd), fregName(rs1), fregName(rs2));
+                else                snprintf(text, sizeof text, "%-7s %s,%s,%s", name, fregName(rd), fregName(rs1), fregName(rs2));
+                break;
+            }
+            case 0x18:
+                if (rs2 > 1) break;
+                snprintf(text, sizeof text, "%-7s %s,%s%s", rs2 ? "fcvt.wu.s" : "fcvt.w.s", regName(rd), fregName(rs1), rm);
+                break;
+            case 0x1A:
+                if (rs2 > 1) break;
+                snprintf(text, sizeof text, "%-7s %s,%s%s", rs2 ? "fcvt.s.wu" : "fcvt.s.w", fregName(rd), regName(rs1), rm);
+                break;
+            case 0x1C:
+                if (funct3 > 1) break;
+                snprintf(text, sizeof text, "%-7s %s,%s", funct3 ? "fclass.s" : "fmv.x.w", regName(rd), fregName(rs1));
+                break;
+            case 0x1E:
+                if (funct3 != 0) break;
+                snprintf(text, sizeof text, "%-7s %s,%s", "fmv.w.x", fregName(rd), regName(rs1));
+                break;
+            default: break;
+        }
+        return text;
+    }
+
+    // Zba/Zbb register-register forms (controller.sv matches the whole funct7)
+    static const char *bitmanipR(uint32_t funct7, uint32_t funct3) {
+        switch ((funct7 << 3) | funct3) {
+            case 0x10 << 3 | 2: return "sh1add";
+            case 0x10 << 3 | 4: return "sh2add";
+            case 0x10 << 3 | 6: return "sh3add";
+            case 0x20 << 3 | 7: return "andn";
+            case 0x20 << 3 | 6: return "orn";
+            case 0x20 << 3 | 4: return "xnor";
+            case 0x05 << 3 | 4: return "min";
+            case 0x05 << 3 | 5: return "minu";
+            case 0x05 << 3 | 6: return "max";
+            case 0x05 << 3 | 7: return "maxu";
+            case 0x30 << 3 | 1: return "rol";
+            case 0x30 << 3 | 5: return "ror";
+            default:            return nullptr;
+        }
+    }
+
+    // Zbb single-operand forms: OP-IMM encodings with the operation in the rs2 field
+    static const char *bitmanipUnary(uint32_t funct7, uint32_t funct3, uint32_t rs2) {
+        static const char *counts[8] = { "clz", "ctz", "cpop", nullptr, "sext.b", "sext.h", nullptr, nullptr };
+        if (funct3 == 1 && funct7 == 0x30 && rs2 < 8) return counts[rs2];
+        if (funct3 == 5 && funct7 == 0x14 && rs2 == 7)  return "orc.b";
+        if (funct3 == 5 && funct7 == 0x34 && rs2 == 24) return "rev8";
+        return nullptr;
+    }
+};
+
+#endif
@@ -0,0 +1,399 @@
+#ifndef RV32_FUZZ_H
+#define RV32_FUZZ_H
+
+#include "rv32_disasm.h"
+#include "rv32c_expand.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Constrained random RV32IFC (+Zba/Zbb) program for differential testing (sim/soc_fuzz.cpp).
+ *
+ * ROM layout: 0x000 jumps to the body at 0x100; the trap handler sits at the reset MTVEC (0x10).
+ * The body is a list of items (one instruction, or AUIPC+JALR for a jump through a register).
+ * RV32C items pack two compressed ALU instructions into a word, or put a 32-bit ALU instruction
+ * between two of them so that it straddles a word boundary; every item starts word-aligned.
+ * Control flow only goes forward, so every program reaches the epilogue, which exits through
+ * semihosting. Branch and jump targets are item indices, so the shrinker can delete any item
+ * and re-encode the rest.
+ *
+ * Register use: gp = RAM base, tp = MMIO base (set by the fixed prologue), t5/t6 belong to the
+ * trap handler, which saves and restores them. The body draws from every other register.
+ * f0-f31 start from FMV.W.X of the initial integer values (some of them float edge cases: zeros,
+ * infinities, NaNs, subnormals); FCSR is read and written through tp like any MMIO register.
+ * The handler writes MEPC back on every trap and skips the instruction on ECALL (MEPC + 4),
+ * counting ECALLs in RAM. Timer traps leave no other trace, so the final state does not depend
+ * on when the interrupts hit.
+ */
+class Rv32FuzzProgram {
+public:
+    static constexpr uint32_t BODY_BASE    = 0x100;
+    static constexpr uint32_t ROM_BYTES    = 0x1000;
+    static constexpr uint32_t RAM_BASE     = 0x20000000;
+    static constexpr uint32_t DATA_BYTES   = 0x400;          // Body loads/stores: gp + [0, 0x400)
+    static constexpr uint32_t ECALL_COUNT  = DATA_BYTES;     // Compared with the data window
+    static constexpr uint32_t STATE_WORDS  = DATA_BYTES / 4 + 1;
+    static constexpr uint32_t SAVE_T5      = DATA_BYTES + 4; // Handler scratch: depends on trap timing
+    static constexpr uint32_t SAVE_T6      = DATA_BYTES + 8;
+    static constexpr uint32_t MAX_ITEMS    = (ROM_BYTES - BODY_BASE) / 4 / 2 - 8;
+
+    enum ItemKind : uint8_t { PLAIN, BRANCH, JAL, JALR, COMPRESSED, STRADDLE };
+
+    struct Item {
+        uint8_t  kind   = PLAIN;
+        uint8_t  base   = 0;  // JALR: register that AUIPC loads
+        uint32_t insn   = 0;  // PLAIN/STRADDLE: the instruction; BRANCH/JAL/JALR: encoding without the offset
+        uint32_t target = 0;  // Item index (body size = the epilogue)
+        uint32_t halves = 0;  // COMPRESSED/STRADDLE: first (low) and last (high) 16-bit instruction
+    };
+
+    std::vector<Item> items;
+    uint32_t          timerLimit = 10000;
+
+    // Random program of 'count' items; 'timerLimit' controls how often traps interleave
+    static Rv32FuzzProgram generate(uint64_t seed, uint32_t count, bool interrupts) {
+        std::mt19937_64 rng(seed);
+        auto pick = [&](uint32_t n) { return (uint32_t)(rng() % n); };
+        Rv32FuzzProgram program;
+        program.timerLimit = interrupts ? 40 + pick(400) : 0xFFFFFFFF;
+        if (count > MAX_ITEMS) count = MAX_ITEMS;
+
+        // Initial values: small, large and boundary constants exercise compares and shifts, and
+        // float edge cases (±1, ±inf, quiet/signalling NaN, smallest subnormal/normal, largest) the FPU
+        static const uint8_t bodyRegs[] = { 1, 2, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17,
+                                            18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 };
+        auto reg = [&]() { return bodyRegs[pick(sizeof bodyRegs)]; };
+        auto anyReg = [&]() { return pick(4) ? reg() : (uint32_t)0; }; // x0 as a source or a sink
+        for (uint32_t r : bodyRegs) {
+            if (program.items.size() + 2 > count) break;
+            static const uint32_t edges[] = { 0, 1, 0xFFFFFFFF, 0x80000000, 0x7FFFFFFF, 31, 32,
+                                              0x3F800000, 0xBF800000, 0x7F800000, 0xFF800000, 0x7FC00000,
+                                              0x7F800001, 0x00800000, 0x7F7FFFFF };
+            uint32_t value = pick(3) ? (uint32_t)rng() : edges[pick(sizeof edges / 4)];
+            uint32_t upper = (value + 0x800) >> 12;
+            program.items.push_back(plain(encodeU(0x37, r, upper)));
+            program.items.push_back(plain(encodeI(0x13, 0, r, r, value & 0xFFF)));
+        }
+        for (uint32_t f = 0; f < 32 && program.items.size() < count; f++) {
+            program.items.push_back(plain(encodeR(0x53, 0, 0x78, f, reg(), 0)));  // fmv.w.x f, x
+        }
+
+        while (program.items.size() < count) {
+            uint32_t index = program.items.size();
+            uint32_t rd = anyReg(), rs1 = anyReg(), rs2 = anyReg();
+            uint32_t choice = pick(135);
+            if (choice < 22) {        // R-type: ADD SUB SLL SLT SLTU XOR SRL SRA OR AND
+                static const uint16_t ops[10] = { 0x000, 0x100, 0x001, 0x002, 0x003, 0x004, 0x005, 0x105, 0x006, 0x007 };
+                uint16_t op = ops[pick(10)];
+                program.items.push_back(plain(encodeR(0x33, op & 7, (op >> 8) ? 0x20 : 0, rd, rs1, rs2)));
+            } else if (choice < 42) { // I-type ALU, shifts with a 5-bit amount
+                uint32_t funct3 = pick(8);
+                uint32_t imm    = pick(4) ? (uint32_t)rng() & 0xFFF : (pick(2) ? 0x7FF : 0x800);
+                if (funct3 == 1) imm = pick(32);
+                if (funct3 == 5) imm = pick(32) | (pick(2) ? 0x400 : 0);
+                program.items.push_back(plain(encodeI(0x13, funct3, rd, rs1, imm)));
+            } else if (choice < 47) { // LUI / AUIPC
+                program.items.push_back(plain(encodeU(pick(2) ? 0x37 : 0x17, rd, (uint32_t)rng() & 0xFFFFF)));
+            } else if (choice < 60) { // Loads from the data window, naturally aligned
+                static const uint32_t funct3s[5] = { 0, 1, 2, 4, 5 };
+                uint32_t funct3 = funct3s[pick(5)];
+                uint32_t size   = 1u << (funct3 & 3);
+                program.items.push_back(plain(encodeI(0x03, funct3, rd, 3, pick(DATA_BYTES) & ~(size - 1))));
+            } else if (choice < 74) { // Stores to the data window
+                uint32_t funct3 = pick(3);
+                uint32_t size   = 1u << funct3;
+                program.items.push_back(plain(encodeS(funct3, 3, rs2, pick(DATA_BYTES) & ~(size - 1))));
+            } else if (choice < 88) { // Forward branches
+                static const uint32_t funct3s[6] = { 0, 1, 4, 5, 6, 7 };
+                program.items.push_back({ BRANCH, 0, encodeB(funct3s[pick(6)], rs1, rs2, 0), forward(index, count, pick) });
+            } else if (choice < 93) { // JAL (links into a body register or x0)
+                program.items.push_back({ JAL, 0, encodeJ(rd, 0), forward(index, count, pick) });
+            } else if (choice < 97) { // JALR through a register loaded by AUIPC
+                uint8_t base = (uint8_t)reg();
+                program.items.push_back({ JALR, base, encodeI(0x67, 0, rd, base, 0), forward(index, count, pick) });
+            } else if (choice < 100) { // ECALL: the handler writes MEPC + 4
+                program.items.push_back(plain(0x00000073));
+            } else if (choice < 105) { // Two compressed ALU instructions in one word
+                uint32_t halves = compressedAlu(rng) | (compressedAlu(rng) << 16);
+                program.items.push_back({ COMPRESSED, 0, 0, 0, halves });
+            } else if (choice < 110) { // ADD/ADDI across a word boundary, between two compressed ones
+                uint32_t insn   = pick(2) ? encodeR(0x33, 0, 0, rd, rs1, rs2) : encodeI(0x13, 0, rd, rs1, (uint32_t)rng());
+                uint32_t halves = compressedAlu(rng) | (compressedAlu(rng) << 16);
+                program.items.push_back({ STRADDLE, 0, insn, 0, halves });
+            } else if (choice < 115) { // Zba/Zbb register forms (funct7 << 3 | funct3), ZEXT.H has rs2 = 0
+                static const uint16_t ops[13] = { 0x82, 0x84, 0x86, 0x107, 0x106, 0x104, 0x2C, 0x2D, 0x2E, 0x2F,
+                                                  0x181, 0x185, 0x24 };
+                uint16_t op = ops[pick(13)];
+                program.items.push_back(plain(encodeR(0x33, op & 7, op >> 3, rd, rs1, op == 0x24 ? 0 : rs2)));
+            } else if (choice < 120) { // Zbb immediate forms: CLZ CTZ CPOP SEXT.B SEXT.H, RORI, ORC.B, REV8
+                static const uint16_t imms[8] = { 0x600, 0x601, 0x602, 0x604, 0x605, 0x600, 0x287, 0x698 };
+                uint32_t which = pick(8);
+                uint32_t imm   = imms[which] | (which == 5 ? pick(32) : 0);
+                program.items.push_back(plain(encodeI(0x13, which < 5 ? 1 : 5, rd, rs1, imm)));
+            } else if (choice < 129) { // RV32F compute, moves, compares and conversions
+                program.items.push_back(plain(floatOp(pick, rd, rs1)));
+            } else if (choice < 132) { // FLW/FSW in the data window
+                uint32_t offset = pick(DATA_BYTES) & ~3u;
+                program.items.push_back(plain(pick(2) ? encodeI(0x07, 2, pick(32), 3, offset)
+                                                      : (encodeS(2, 3, pick(32), offset) & ~0x7Fu) | 0x27));
+            } else {                   // FCSR (frm, fflags) and FP_STATUS (dirty) through tp
+                uint32_t offset = pick(3) ? 0x28 : 0x2C;
+                program.items.push_back(plain(pick(2) ? encodeI(0x03, 2, rd, 4, offset) : encodeS(2, 4, rs2, offset)));
+            }
+        }
+        return program;
+    }
+
+    // ROM image: entry jump, trap handler, prologue, body, epilogue
+    std::vector<uint8_t> encode() const {
+        std::vector<uint32_t> words(BODY_BASE / 4, 0x00000013);
+        words[0] = encodeJ(0, BODY_BASE);
+        const uint32_t handler[] = {
+            encodeS(2, 3, 30, SAVE_T5),             // sw   t5, SAVE_T5(gp)
+            encodeS(2, 3, 31, SAVE_T6),             // sw   t6, SAVE_T6(gp)
+            encodeI(0x03, 2, 30, 4, 0x10),          // lw   t5, MEPC(tp)
+            encodeI(0x03, 2, 31, 4, 0x14),          // lw   t6, MCAUSE(tp)
+            encodeI(0x13, 0, 31, 31, (uint32_t)-11), // addi t6, t6, -11
+            encodeB(1, 31, 0, 20),                  // bnez t6, 1f (not ECALL: resume at MEPC)
+            encodeI(0x13, 0, 30, 30, 4),            // addi t5, t5, 4
+            encodeI(0x03, 2, 31, 3, ECALL_COUNT),   // lw   t6, ECALL_COUNT(gp)
+            encodeI(0x13, 0, 31, 31, 1),            // addi t6, t6, 1
+            encodeS(2, 3, 31, ECALL_COUNT),         // sw   t6, ECALL_COUNT(gp)
+            encodeS(2, 4, 30, 0x10),                // 1: sw t5, MEPC(tp)
+            encodeI(0x03, 2, 30, 3, SAVE_T5),       // lw   t5, SAVE_T5(gp)
+            encodeI(0x03, 2, 31, 3, SAVE_T6),       // lw   t6, SAVE_T6(gp)
+            0x30200073                              // mret
+        };
+        for (size_t i = 0; i < sizeof handler / 4; i++) words[4 + i] = handler[i];
+
+        // Prologue: gp = RAM, tp = MMIO
+        words.push_back(encodeU(0x37, 3, RAM_BASE >> 12));
+        words.push_back(encodeU(0x37, 4, 0x40000));
+
+        std::vector<uint32_t> itemPc(items.size() + 1);
+        uint32_t pc = BODY_BASE + 8;
+        for (size_t i = 0; i < items.size(); i++) {
+            itemPc[i] = pc;
+            pc += (items[i].kind == JALR || items[i].kind == STRADDLE) ? 8 : 4;
+        }
+        itemPc[items.size()] = pc;
+
+        for (size_t i = 0; i < items.size(); i++) {
+            const Item &item = items[i];
+            uint32_t here   = itemPc[i];
+            uint32_t target = itemPc[item.target < items.size() ? item.target : items.size()];
+            switch (item.kind) {
+                case PLAIN:  words.push_back(item.insn); break;
+                case BRANCH: words.push_back(item.insn | encodeB(0, 0, 0, target - here)); break;
+                case JAL:    words.push_back(item.insn | encodeJ(0, target - here)); break;
+                case JALR: // Offset from the AUIPC; forward targets stay within 12 bits
+                    words.push_back(encodeU(0x17, item.base, 0));
+                    words.push_back(item.insn | ((target - here) << 20));
+                    break;
+                case COMPRESSED: words.push_back(item.halves); break;
+                case STRADDLE: // c.x | insn[15:0], then insn[31:16] | c.y
+                    words.push_back((item.halves & 0xFFFF) | (item.insn << 16));
+                    words.push_back((item.insn >> 16) | (item.halves & 0xFFFF0000));
+                    break;
+            }
+        }
+
+        // Epilogue: semihost EXIT(0), then spin
+        words.push_back(encodeS(2, 4, 0, 0x300));              // sw   zero, SEMI_ARG0(tp)
+        words.push_back(encodeI(0x13, 0, 31, 0, 2));           // li   t6, 2
+        words.push_back(encodeS(2, 4, 31, 0x308));             // sw   t6, SEMI_CALL(tp)
+        words.push_back(encodeJ(0, 0));                        // j    .
+
+        std::vector<uint8_t> image;
+        for (uint32_t word : words) {
+            for (int b = 0; b < 4; b++) image.push_back((uint8_t)(word >> (8 * b)));
+        }
+        return image;
+    }
+
+    // Disassembly of the encoded image (reproducers)
+    std::string listing() const {
+        std::vector<uint8_t> image = encode();
+        std::string text;
+        char line[96];
+        snprintf(line, sizeof line, "# timer-limit=%u, %zu items\n", timerLimit, items.size());
+        text += line;
+        for (uint32_t pc = 0; pc < image.size();) {
+            uint32_t word = image[pc] | (image[pc + 1] << 8);
+            if (pc + 2 < image.size()) word |= (image[pc + 2] << 16) | ((uint32_t)image[pc + 3] << 24);
+            uint32_t size = Rv32cExpander::isCompressed(word) ? 2 : 4;
+            if (pc < 0x48 || pc >= BODY_BASE) { // Skip the padding after the handler
+                if (size == 2) snprintf(line, sizeof line, "%08x:      %04x  %s\n", pc, word & 0xFFFF, Rv32Disassembler::disassemble(word, pc).c_str());
+                else           snprintf(line, sizeof line, "%08x:  %08x  %s\n", pc, word, Rv32Disassembler::disassemble(word, pc).c_str());
+                text += line;
+            }
+            pc += size;
+        }
+        return text;
+    }
+
+    // Copy without items [first, first + count); targets of removed items move to the next survivor
+    Rv32FuzzProgram without(size_t first, size_t count) const {
+        Rv32FuzzProgram smaller;
+        smaller.timerLimit = timerLimit;
+        std::vector<uint32_t> newIndex(items.size() + 1);
+        uint32_t kept = 0;
+        for (size_t i = 0; i <= items.size(); i++) {
+            newIndex[i] = kept;
+            if (i < items.size() && (i < first || i >= first + count)) kept++;
+        }
+        for (size_t i = 0; i < items.size(); i++) {
+            if (i >= first && i < first + count) continue;
+            Item item   = items[i];
+            item.target = newIndex[item.target];
+            smaller.items.push_back(item);
+        }
+        return smaller;
+    }
+
+    // Delta-debugging reduction: drops ever smaller runs of items while 'fails' still holds
+    template <typename Predicate>
+    static Rv32FuzzProgram shrink(Rv32FuzzProgram program, Predicate fails) {
+        for (size_t chunk = program.items.size() / 2; chunk >= 1; chunk /= 2) {
+            bool progress = true;
+            while (progress) {
+                progress = false;
+                for (size_t first = 0; first < program.items.size();) {
+                    Rv32FuzzProgram candidate = program.without(first, chunk);
+                    if (fails(candidate)) {
+                        program  = candidate;
+                        progress = true;
+                    } else {
+                        first += chunk;
+                    }
+                }
+            }
+        }
+        // Interrupts off, if the failure does not need them
+        Rv32FuzzProgram quiet = program;
+        quiet.timerLimit = 0xFFFFFFFF;
+        return fails(quiet) ? quiet : program;
+    }
+
+private:
+    static Item plain(uint32_t insn) { return { PLAIN, 0, insn, 0, 0 }; }
+
+    // Random compressed instruction that expands to an ALU op, LI or LUI and leaves gp, tp,
+    // t5 and t6 alone (C.ADDI16SP/C.ADDI4SPN and C.MV/C.ADD are drawn too)
+    template <typename Rng>
+    static uint32_t compressedAlu(Rng &rng) {
+        for (;;) {
+            uint16_t half = (uint16_t)rng();
+            if (!Rv32cExpander::isCompressed(half)) continue;
+            uint32_t insn = Rv32cExpander::expand(half), opcode = insn & 0x7F, rd = (insn >> 7) & 0x1F;
+            if (opcode != 0x13 && opcode != 0x33 && opcode != 0x37) continue;
+            if (rd == 3 || rd == 4 || rd == 30 || rd == 31) continue;
+            return half;
+        }
+    }
+
+    // Random OP-FP or fused multiply-add with a legal rounding mode (RNE..RMM or dynamic);
+    // 'rd'/'rs1' are used when the destination or source is an integer register
+    template <typename Pick>
+    static uint32_t floatOp(Pick &pick, uint32_t rd, uint32_t rs1) {
+        static const uint32_t modes[6] = { 0, 1, 2, 3, 4, 7 };
+        uint32_t fd = pick(32), fs1 = pick(32), fs2 = pick(32), rm = modes[pick(6)];
+        switch (pick(14)) {
+            case 0:  return encodeR(0x53, rm, 0x00, fd, fs1, fs2);                // FADD.S
+            case 1:  return encodeR(0x53, rm, 0x04, fd, fs1, fs2);                // FSUB.S
+            case 2:  return encodeR(0x53, rm, 0x08, fd, fs1, fs2);                // FMUL.S
+            case 3:  return encodeR(0x53, rm, 0x0C, fd, fs1, fs2);                // FDIV.S
+            case 4:  return encodeR(0x53, rm, 0x2C, fd, fs1, 0);                  // FSQRT.S
+            case 5:  return encodeR(0x53, pick(3), 0x10, fd, fs1, fs2);           // FSGNJ[N/X].S
+            case 6:  return encodeR(0x53, pick(2), 0x14, fd, fs1, fs2);           // FMIN.S / FMAX.S
+            case 7:  return encodeR(0x53, pick(3), 0x50, rd, fs1, fs2);           // FLE/FLT/FEQ.S
+            case 8:  return encodeR(0x53, rm, 0x60, rd, fs1, pick(2));            // FCVT.W[U].S
+            case 9:  return encodeR(0x53, rm, 0x68, fd, rs1, pick(2));            // FCVT.S.W[U]
+            case 10: return encodeR(0x53, pick(2), 0x70, rd, fs1, 0);             // FMV.X.W / FCLASS.S
+            case 11: return encodeR(0x53, 0, 0x78, fd, rs1, 0);                   // FMV.W.X
+            default: return encodeR(0x43 + 4 * pick(4), rm, pick(32) << 2, fd, fs1, fs2); // F[N]MADD/F[N]MSUB.S
+        }
+    }
+
+    template <typename Pick>
+    static uint32_t forward(uint32_t index, uint32_t count, Pick &pick) {
+        uint32_t target = index + 1 + pick(12);
+        return target < count ? target : count;
+    }
+
+    static uint32_t encodeR(uint32_t op, uint32_t funct3, uint32_t funct7, uint32_t rd, uint32_t rs1, uint32_t rs2) {
+        return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | op;
+    }
+    static uint32_t encodeI(uint32_t op, uint32_t funct3, uint32_t rd, uint32_t rs1, uint32_t imm) {
+        return ((imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | op;
+    }
+    static uint32_t encodeS(uint32_t funct3, uint32_t rs1, uint32_t rs2, uint32_t imm) {
+        return (((imm >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((imm & 0x1F) << 7) | 0x23;
+    }
+    static uint32_t encodeB(uint32_t funct3, uint32_t rs1, uint32_t rs2, uint32_t offset) {
+        return (((offset >> 12) & 1) << 31) | (((offset >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) |
+               (funct3 << 12) | (((offset >> 1) & 0xF) << 8) | (((offset >> 11) & 1) << 7) | 0x63;
+    }
+    static uint32_t encodeJ(uint32_t rd, uint32_t offset) {
+        return (((offset >> 20) & 1) << 31) | (((offset >> 1) & 0x3FF) << 21) | (((offset >> 11) & 1) << 20) |
+               (((offset >> 12) & 0xFF) << 12) | (rd << 7) | 0x6F;
+    }
+    static uint32_t encodeU(uint32_t op, uint32_t rd, uint32_t upper) { return ((upper & 0xFFFFF) << 12) | (rd << 7) | op; }
+};
+
+/**
+ * @brief Architectural state compared after a program: x1-x31, f0-f31, FCSR and the RAM window
+ * it can touch.
+ */
+struct Rv32FuzzState {
+    bool                  exited = false;
+    uint32_t              regs[32] = {};
+    uint32_t              fregs[32] = {};
+    uint32_t              fcsr = 0;
+    std::vector<uint32_t> ram;
+
+    bool operator==(const Rv32FuzzState &other) const {
+        if (exited != other.exited || fcsr != other.fcsr || ram != other.ram) return false;
+        for (int r = 1; r < 32; r++) if (regs[r] != other.regs[r]) return false;
+        for (int r = 0; r < 32; r++) if (fregs[r] != other.fregs[r]) return false;
+        return true;
+    }
+    bool operator!=(const Rv32FuzzState &other) const { return !(*this == other); }
+
+    // "name: dut vs reference" for every difference
+    static std::string diff(const Rv32FuzzState &dut, const Rv32FuzzState &reference) {
+        std::string text;
+        char line[96];
+        if (dut.exited != reference.exited) {
+            snprintf(line, sizeof line, "  exit:        %-10s vs %s\n", dut.exited ? "yes" : "no", reference.exited ? "yes" : "no");
+            text += line;
+        }
+        for (int r = 1; r < 32; r++) {
+            if (dut.regs[r] == reference.regs[r]) continue;
+            snprintf(line, sizeof line, "  %-4s         0x%08x vs 0x%08x\n", Rv32Disassembler::regName(r), dut.regs[r], reference.regs[r]);
+            text += line;
+        }
+        for (int r = 0; r < 32; r++) {
+            if (dut.fregs[r] == reference.fregs[r]) continue;
+            snprintf(line, sizeof line, "  %-4s         0x%08x vs 0x%08x\n", Rv32Disassembler::fregName(r), dut.fregs[r], reference.fregs[r]);
+            text += line;
+        }
+        if (dut.fcsr != reference.fcsr) {
+            snprintf(line, sizeof line, "  fcsr         0x%08x vs 0x%08x\n", dut.fcsr, reference.fcsr);
+            text += line;
+        }
+        for (size_t i = 0; i < dut.ram.size() && i < reference.ram.size(); i++) {
+            if (dut.ram[i] == reference.ram[i]) continue;
+            snprintf(line, sizeof line, "  [0x%08x] 0x%08x vs 0x%08x\n", Rv32FuzzProgram::RAM_BASE + (uint32_t)i * 4,
+                     dut.ram[i], reference.ram[i]);
+            text += line;
+        }
+        return text;
+    }
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef RV32C_EXPAND_H
+#define RV32C_EXPAND_H
+
+#include <cstdint>
+
+/**
+ * @brief RV32C decompressor: the reference for rtl/rvc_expander.sv (vp/soc_vp.h, sim/trace_dump.cpp).
+ * Maps a 16-bit instruction to the RV32I/A/F instruction it stands for. Reserved encodings and
+ * the double-precision loads/stores expand to 0, which controller.sv executes as a NOP.
+ */
+class Rv32cExpander {
+public:
+    // The low two bits of every 32-bit instruction are 11
+    static bool isCompressed(uint32_t insn) { return (insn & 3) != 3; }
+
+    static uint32_t expand(uint16_t half) {
+        uint32_t c = half;
+        uint32_t rd = bits(c, 11, 7), rs2 = bits(c, 6, 2);
+        uint32_t rdp = 8 + bits(c, 4, 2), rs1p = 8 + bits(c, 9, 7); // rd'/rs2' and rs1'/rd' (x8-x15)
+        int32_t  imm6 = sext((bits(c, 12, 12) << 5) | bits(c, 6, 2), 6);
+
+        switch ((bits(c, 15, 13) << 2) | (c & 3)) {
+            // --- Quadrant 0 ---
+            case 0x00: { // C.ADDI4SPN -> addi rd', sp, nzuimm
+                uint32_t imm = (bits(c, 10, 7) << 6) | (bits(c, 12, 11) << 4) | (bits(c, 5, 5) << 3) |
+                               (bits(c, 6, 6) << 2);
+                return imm ? typeI(0x13, rdp, 0, 2, imm) : 0;
+            }
+            case 0x08: // C.LW -> lw rd', uimm(rs1')
+                return typeI(0x03, rdp, 2, rs1p, offsetW(c));
+            case 0x18: // C.SW -> sw rs2', uimm(rs1')
+                return typeS(0x23, 2, rs1p, rdp, offsetW(c));
+            case 0x0C: // C.FLW -> flw rd', uimm(rs1')
+                return typeI(0x07, rdp, 2, rs1p, offsetW(c));
+            case 0x1C: // C.FSW -> fsw rs2', uimm(rs1')
+                return typeS(0x27, 2, rs1p, rdp, offsetW(c));
+
+            // --- Quadrant 1 ---
+            case 0x01: // C.ADDI (C.NOP) -> addi rd, rd, imm
+                return typeI(0x13, rd, 0, rd, imm6);
+            case 0x05: // C.JAL -> jal ra, offset
+                return typeJ(1, offsetJ(c));
+            case 0x09: // C.LI -> addi rd, zero, imm
+                return typeI(0x13, rd, 0, 0, imm6);
+            case 0x0D:
+                if (rd == 2) { // C.ADDI16SP -> addi sp, sp, nzimm
+                    int32_t imm = sext((bits(c, 12, 12) << 9) | (bits(c, 4, 3) << 7) | (bits(c, 5, 5) << 6) |
+                                       (bits(c, 2, 2) << 5) | (bits(c, 6, 6) << 4), 10);
+                    return imm ? typeI(0x13, 2, 0, 2, imm) : 0;
+                }
+                return imm6 ? ((uint32_t)imm6 << 12) | (rd << 7) | 0x37 : 0; // C.LUI -> lui rd, nzimm
+            case 0x11: // Arithmetic on rd'
+                switch (bits(c, 11, 10)) {
+                    case 0: return bits(c, 12, 12) ? 0 : typeI(0x13, rs1p, 5, rs1p, rs2);              // C.SRLI
+                    case 1: return bits(c, 12, 12) ? 0 : typeI(0x13, rs1p, 5, rs1p, 0x400 | rs2);      // C.SRAI
+                    case 2: return typeI(0x13, rs1p, 7, rs1p, imm6);                                   // C.ANDI
+                    default: {
+                        static const uint32_t funct3[4] = { 0, 4, 6, 7 };                            // SUB XOR OR AND
+                        if (bits(c, 12, 12)) return 0;                                                // RV64 only
+                        uint32_t funct7 = bits(c, 6, 5) == 0 ? 0x20 : 0;
+                        return typeR(funct7, rs1p, rs1p, funct3[bits(c, 6, 5)], rdp);
+                    }
+                }
+            case 0x15: // C.J -> jal zero, offset
+                return typeJ(0, offsetJ(c));
+            case 0x19: // C.BEQZ -> beq rs1', zero, offset
+            case 0x1D: // C.BNEZ -> bne rs1', zero, offset
+                return typeB(bits(c, 13, 13), rs1p, offsetB(c));
+
+            // --- Quadrant 2 ---
+            case 0x02: // C.SLLI -> slli rd, rd, shamt
+                return bits(c, 12, 12) ? 0 : typeI(0x13, rd, 1, rd, rs2);
+            case 0x0A: { // C.LWSP -> lw rd, uimm(sp)
+                uint32_t imm = (bits(c, 3, 2) << 6) | (bits(c, 12, 12) << 5) | (bits(c, 6, 4) << 2);
+                return rd ? typeI(0x03, rd, 2, 2, imm) : 0;
+            }
+            case 0x12:
+                if (!bits(c, 12, 12)) {
+                    if (rs2) return typeR(0, rd, 0, 0, rs2);              // C.MV -> add rd, zero, rs2
+                    return rd ? typeI(0x67, 0, 0, rd, 0) : 0;             // C.JR -> jalr zero, 0(rs1)
+                }
+                if (rs2) return typeR(0, rd, rd, 0, rs2);                 // C.ADD -> add rd, rd, rs2
+                return rd ? typeI(0x67, 1, 0, rd, 0) : 0x00100073;        // C.JALR -> jalr ra, 0(rs1); C.EBREAK
+            case 0x1A: { // C.SWSP -> sw rs2, uimm(sp)
+                uint32_t imm = (bits(c, 8, 7) << 6) | (bits(c, 12, 9) << 2);
+                return typeS(0x23, 2, 2, rs2, imm);
+            }
+            case 0x0E: { // C.FLWSP -> flw rd, uimm(sp) (any f register, f0 included)
+                uint32_t imm = (bits(c, 3, 2) << 6) | (bits(c, 12, 12) << 5) | (bits(c, 6, 4) << 2);
+                return typeI(0x07, rd, 2, 2, imm);
+            }
+            case 0x1E: { // C.FSWSP -> fsw rs2, uimm(sp)
+                uint32_t imm = (bits(c, 8, 7) << 6) | (bits(c, 12, 9) << 2);
+                return typeS(0x27, 2, 2, rs2, imm);
+            }
+            default: // C.FLD/FSD(SP) and the reserved quadrant-0 slot
+                return 0;
+        }
+    }
+
+private:
+    static uint32_t bits(uint32_t value, int high, int low) {
+        return (value >> low) & ((1u << (high - low + 1)) - 1);
+    }
+
+    static int32_t sext(uint32_t value, int width) {
+        return (int32_t)(value << (32 - width)) >> (32 - width);
+    }
+
+    // Scaled offsets of the compressed formats (CL/CS word, CJ, CB)
+    static uint32_t offsetW(uint32_t c) {
+        return (bits(c, 5, 5) << 6) | (bits(c, 12, 10) << 3) | (bits(c, 6, 6) << 2);
+    }
+
+    static int32_t offsetJ(uint32_t c) {
+        return sext((bits(c, 12, 12) << 11) | (bits(c, 8, 8) << 10) | (bits(c, 10, 9) << 8) | (bits(c, 6, 6) << 7) |
+                    (bits(c, 7, 7) << 6) | (bits(c, 2, 2) << 5) | (bits(c, 11, 11) << 4) | (bits(c, 5, 3) << 1), 12);
+    }
+
+    static int32_t offsetB(uint32_t c) {
+        return sext((bits(c, 12, 12) << 8) | (bits(c, 6, 5) << 6) | (bits(c, 2, 2) << 5) | (bits(c, 11, 10) << 3) |
+                    (bits(c, 4, 3) << 1), 9);
+    }
+
+    // 32-bit encoders
+    static uint32_t typeR(uint32_t funct7, uint32_t rd, uint32_t rs1, uint32_t funct3, uint32_t rs2) {
+        return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | 0x33;
+    }
+
+    static uint32_t typeI(uint32_t opcode, uint32_t rd, uint32_t funct3, uint32_t rs1, int32_t imm) {
+        return ((uint32_t)imm << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+    }
+
+    static uint32_t typeS(uint32_t opcode, uint32_t funct3, uint32_t rs1, uint32_t rs2, int32_t imm) {
+        return (((uint32_t)imm >> 5) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((imm & 0x1F) << 7) | opcode;
+    }
+
+    static uint32_t typeB(uint32_t funct3, uint32_t rs1, int32_t imm) {
+        uint32_t u = (uint32_t)imm;
+        return (bits(u, 12, 12) << 31) | (bits(u, 10, 5) << 25) | (rs1 << 15) | (funct3 << 12) |
+               (bits(u, 4, 1) << 8) | (bits(u, 11, 11) << 7) | 0x63;
+    }
+
+    static uint32_t typeJ(uint32_t rd, int32_t imm) {
+        uint32_t u = (uint32_t)imm;
+        return (bits(u, 20, 20) << 31) | (bits(u, 10, 1) << 21) | (bits(u, 11, 11) << 20) | (bits(u, 19, 12) << 12) |
+               (rd << 7) | 0x6F;
+    }
+};
+
+#endif
@@ -0,0 +1,381 @@
+#ifndef RV32F_MODEL_H
+#define RV32F_MODEL_H
+
+#include <cstdint>
+
+/**
+ * @brief RV32F arithmetic: the reference for rtl/fpu.sv (vp/soc_vp.h, sim/fpu_tb.cpp).
+ * Single precision on bit patterns, computed the way the RTL does it (an exact product and sum
+ * in an 80-bit window, one rounding step shared by every operation), so it can be read side by
+ * side with fpu.sv. All five rounding modes; tininess is detected after rounding; NaN results are
+ * the canonical NaN. Reserved rounding modes (in the instruction or in frm) round to nearest even.
+ */
+class Rv32fModel {
+public:
+    // fflags bits (FCSR[4:0])
+    static const uint32_t NX = 1, UF = 2, OF = 4, DZ = 8, NV = 16;
+    enum Rounding : uint32_t { RNE, RTZ, RDN, RUP, RMM };
+
+    static const uint32_t CANONICAL_NAN    = 0x7FC00000;
+    static const uint32_t PIPELINE_CYCLES  = 3;  // Issue to write-back of add/multiply/FMA and conversions (three stages)
+    static const uint32_t ITERATIVE_CYCLES = 29; // Divide and square root (27 iterations + unpack + round)
+
+    // --- 1. DECODE (as controller.sv) ---
+    // Single precision only (fmt 00); other encodings of the FP opcodes are NOPs
+    static bool isLoad(uint32_t insn)  { return (insn & 0x707F) == 0x2007; }  // FLW
+    static bool isStore(uint32_t insn) { return (insn & 0x707F) == 0x2027; }  // FSW
+    static bool isFused(uint32_t insn) { return (insn & 0x73) == 0x43; }      // FMADD/FMSUB/FNMSUB/FNMADD
+
+    // OP-FP or FMADD/FMSUB/FNMSUB/FNMADD that this unit executes
+    static bool isCompute(uint32_t insn) {
+        uint32_t opcode = insn & 0x7F, funct3 = (insn >> 12) & 7, funct5 = insn >> 27, rs2 = (insn >> 20) & 0x1F;
+        if (((insn >> 25) & 3) != 0) return false;
+        if (isFused(insn)) return true;                // R4 forms
+        if (opcode != 0x53) return false;
+        switch (funct5) {
+            case 0x00: case 0x01: case 0x02: case 0x03: case 0x0B: return true; // FADD FSUB FMUL FDIV FSQRT
+            case 0x04: case 0x14: return funct3 <= 2;                            // FSGNJ[N/X], FLE/FLT/FEQ
+            case 0x05: case 0x1C: return funct3 <= 1;                            // FMIN/FMAX, FMV.X.W/FCLASS
+            case 0x18: case 0x1A: return rs2 <= 1;                               // FCVT.W[U].S, FCVT.S.W[U]
+            case 0x1E: return funct3 == 0;                                       // FMV.W.X
+            default:   return false;
+        }
+    }
+
+    // Result goes to x[rd] (compares, FCLASS, FMV.X.W, FCVT.W[U].S), otherwise to f[rd]
+    static bool writesInteger(uint32_t insn) {
+        uint32_t funct5 = insn >> 27;
+        return (insn & 0x7F) == 0x53 && (funct5 == 0x14 || funct5 == 0x18 || funct5 == 0x1C);
+    }
+
+    // Add/subtract/multiply/FMA and FCVT.S.W[U]: retire on issue, f[rd] is written through the
+    // pipeline port PIPELINE_CYCLES later (one can issue every cycle)
+    static bool isPipelined(uint32_t insn) {
+        uint32_t funct5 = insn >> 27;
+        return (insn & 0x7F) != 0x53 || funct5 <= 0x02 || funct5 == 0x1A;
+    }
+
+    // f registers the instruction reads (FSW: the store data) and whether it writes f[rd] in
+    // decode (FLW, single-cycle and iterative operations): fpu.sv's hazard check
+    static bool readsRs1(uint32_t insn) {
+        uint32_t funct5 = insn >> 27;
+        return isFused(insn) || ((insn & 0x7F) == 0x53 && funct5 != 0x1A && funct5 != 0x1E);
+    }
+    static bool readsRs2(uint32_t insn) {
+        uint32_t funct5 = insn >> 27;
+        return isFused(insn) || (insn & 0x7F) == 0x27 || ((insn & 0x7F) == 0x53 && (funct5 <= 0x05 || funct5 == 0x14));
+    }
+    static bool readsRs3(uint32_t insn) { return isFused(insn); }
+    static bool writesInDecode(uint32_t insn) {
+        uint32_t funct5 = insn >> 27;
+        return (insn & 0x7F) == 0x07 || ((insn & 0x7F) == 0x53 && (funct5 == 0x03 || funct5 == 0x0B ||
+                                         funct5 == 0x04 || funct5 == 0x05 || funct5 == 0x1E));
+    }
+
+    // Cycles the hart holds the instruction in decode (fpu.sv busy), register hazards aside
+    static uint32_t cycles(uint32_t insn) {
+        uint32_t funct5 = insn >> 27;
+        if (isPipelined(insn)) return 1;
+        if (funct5 == 0x03 || funct5 == 0x0B) return ITERATIVE_CYCLES;
+        if (funct5 == 0x18) return PIPELINE_CYCLES;
+        return 1;
+    }
+
+    // Cycles from issue until the result can be read
+    static uint32_t latency(uint32_t insn) { return isPipelined(insn) ? PIPELINE_CYCLES : cycles(insn); }
+
+    // --- 2. EXECUTE ---
+    // a/b/c: f[rs1], f[rs2], f[rs3]; x: x[rs1]; frm: FCSR[7:5]. 'flags' gets the exception bits.
+    static uint32_t execute(uint32_t insn, uint32_t a, uint32_t b, uint32_t c, uint32_t x, uint32_t frm,
+                            uint32_t &flags) {
+        uint32_t opcode = insn & 0x7F, funct3 = (insn >> 12) & 7, funct5 = insn >> 27, rs2 = (insn >> 20) & 0x1F;
+        uint32_t rm = (funct3 == 7) ? frm : funct3;
+        if (rm > RMM) rm = RNE;
+        flags = 0;
+
+        if (opcode != 0x53) { // FMADD 0x43, FMSUB 0x47, FNMSUB 0x4B, FNMADD 0x4F
+            bool negateProduct = (opcode & 0x08) != 0, negateAddend = (opcode & 0x04) != 0;
+            return fusedMultiplyAdd(a, b, c, negateProduct, negateAddend, false, rm, flags);
+        }
+        switch (funct5) {
+            case 0x00: return fusedMultiplyAdd(a, ONE, b, false, false, false, rm, flags);  // FADD
+            case 0x01: return fusedMultiplyAdd(a, ONE, b, false, true, false, rm, flags);   // FSUB
+            case 0x02: return fusedMultiplyAdd(a, b, 0, false, false, true, rm, flags);     // FMUL
+            case 0x03: return divide(a, b, rm, flags);
+            case 0x0B: return squareRoot(a, rm, flags);
+            case 0x04: { // FSGNJ / FSGNJN / FSGNJX: no flags, NaN payloads kept
+                uint32_t sign = (funct3 == 0) ? b : (funct3 == 1) ? ~b : a ^ b;
+                return (a & 0x7FFFFFFF) | (sign & 0x80000000);
+            }
+            case 0x05: return minMax(a, b, funct3 == 1, flags);
+            case 0x14: { // FLE / FLT (signalling), FEQ (quiet)
+                bool nan = isNan(a) || isNan(b);
+                if (funct3 == 2 ? (isSignallingNan(a) || isSignallingNan(b)) : nan) flags |= NV;
+                if (nan) return 0;
+                bool equal = a == b || ((a | b) & 0x7FFFFFFF) == 0;
+                return funct3 == 2 ? equal : funct3 == 1 ? less(a, b, false) : (less(a, b, false) || equal);
+            }
+            case 0x18: return toInteger(a, rs2 == 0, rm, flags);
+            case 0x1A: return fromInteger(x, rs2 == 0, rm, flags);
+            case 0x1C: return funct3 == 0 ? a : classify(a);
+            default:   return x; // FMV.W.X
+        }
+    }
+
+    static uint32_t classify(uint32_t a) {
+        bool sign = a >> 31;
+        uint32_t exponent = (a >> 23) & 0xFF, mantissa = a & 0x7FFFFF;
+        if (exponent == 0xFF) return mantissa ? (isSignallingNan(a) ? 1u << 8 : 1u << 9) : (sign ? 1u << 0 : 1u << 7);
+        if (exponent == 0)    return mantissa ? (sign ? 1u << 2 : 1u << 5) : (sign ? 1u << 3 : 1u << 4);
+        return sign ? 1u << 1 : 1u << 6;
+    }
+
+private:
+    typedef unsigned __int128 Window;         // Bits [79:0] are used, as fpu.sv's sum
+    static const uint32_t ONE = 0x3F800000;   // FADD/FSUB: a * 1.0 + b
+
+    static bool isNan(uint32_t a)           { return (a & 0x7FFFFFFF) > 0x7F800000; }
+    static bool isSignallingNan(uint32_t a) { return isNan(a) && !(a & 0x00400000); }
+    static bool isInf(uint32_t a)           { return (a & 0x7FFFFFFF) == 0x7F800000; }
+    static bool isZero(uint32_t a)          { return (a & 0x7FFFFFFF) == 0; }
+
+    // Finite operand as sig * 2^(exp - 23) with bit 23 of sig set (subnormals normalized)
+    struct Unpacked {
+        bool     sign;
+        int      exp;
+        uint32_t sig;
+    };
+
+    static Unpacked unpack(uint32_t a) {
+        Unpacked u;
+        uint32_t exponent = (a >> 23) & 0xFF, mantissa = a & 0x7FFFFF;
+        u.sign = a >> 31;
+        if (exponent) {
+            u.sig = mantissa | 0x800000;
+            u.exp = (int)exponent - 127;
+        } else {
+            int shift = mantissa ? __builtin_clz(mantissa) - 8 : 0;
+            u.sig = mantissa << shift;
+            u.exp = -126 - shift;
+        }
+        return u;
+    }
+
+    static int msbIndex(Window value) {
+        uint64_t high = (uint64_t)(value >> 64);
+        return high ? 127 - __builtin_clzll(high) : 63 - __builtin_clzll((uint64_t)value);
+    }
+
+    // Right shift that ORs the bits shifted out into bit 0 (they only ever decide rounding)
+    static Window shiftRightJam(Window value, int amount) {
+        if (amount <= 0) return value;
+        if (amount >= 80) return value != 0;
+        Window lost = value & (((Window)1 << amount) - 1);
+        return (value >> amount) | (lost != 0);
+    }
+
+    static bool roundUp(uint32_t rm, bool sign, bool lsb, bool round, bool sticky) {
+        switch (rm) {
+            case RTZ: return false;
+            case RDN: return sign && (round || sticky);
+            case RUP: return !sign && (round || sticky);
+            case RMM: return round;
+            default:  return round && (sticky || lsb);
+        }
+    }
+
+    // --- 3. ROUNDING (fpu.sv stage 3) ---
+    // Rounds sig * 2^lsbExp (sig != 0, bit 0 may be a jammed sticky bit, leading one at bit 23 or
+    // above) to single precision
+    static uint32_t roundPack(bool sign, int lsbExp, Window sig, uint32_t rm, uint32_t &flags) {
+        int msb   = msbIndex(sig);
+        int exp   = lsbExp + msb;                                  // Exponent of the leading one
+        int shift = (exp >= -126) ? msb - 23 : -149 - lsbExp;      // Bits below the result's LSB
+        if (shift > 81) shift = 81;
+        Window   below    = sig & (((Window)1 << (shift - 1)) - 1);
+        bool     round    = shift <= 80 && ((sig >> (shift - 1)) & 1);
+        bool     sticky   = (shift > 80 ? sig : below) != 0;
+        uint32_t kept     = shift >= 80 ? 0 : (uint32_t)(sig >> shift);
+        uint32_t rounded  = kept + roundUp(rm, sign, kept & 1, round, sticky);
+        bool     inexact  = round || sticky;
+
+        // Tiny after rounding: below 2^-126 once rounded to 24 bits with an unbounded exponent.
+        // Only exp = -127 can round up to 2^-126.
+        if (exp < -126) {
+            bool tiny = true;
+            if (exp == -127) {
+                int      shiftU  = msb - 23;
+                uint32_t keptU   = (uint32_t)(sig >> shiftU) & 0xFFFFFF;
+                bool     roundU  = (sig >> (shiftU - 1)) & 1;
+                bool     stickyU = (sig & (((Window)1 << (shiftU - 1)) - 1)) != 0;
+                if (keptU == 0xFFFFFF && roundUp(rm, sign, true, roundU, stickyU)) tiny = false;
+            }
+            if (tiny && inexact) flags |= UF;
+        }
+        if (inexact) flags |= NX;
+
+        uint32_t signBit = (uint32_t)sign << 31;
+        if (exp < -126) return signBit | rounded; // Subnormal; a carry into bit 23 gives 2^-126
+        int biased = exp + 127 + (int)(rounded >> 24);
+        if (biased >= 255) {
+            flags |= OF | NX;
+            bool toInf = rm == RNE || rm == RMM || (rm == RDN && sign) || (rm == RUP && !sign);
+            return signBit | (toInf ? 0x7F800000 : 0x7F7FFFFF);
+        }
+        return signBit | ((uint32_t)biased << 23) | (rounded & 0x7FFFFF);
+    }
+
+    // --- 4. OPERATIONS ---
+    // (-1)^negateProduct * a * b + (-1)^negateAddend * c, rounded once. FADD/FSUB pass b = 1.0;
+    // FMUL has no addend (a zero that takes the product's sign).
+    static uint32_t fusedMultiplyAdd(uint32_t a, uint32_t b, uint32_t c, bool negateProduct, bool negateAddend,
+                                     bool noAddend, uint32_t rm, uint32_t &flags) {
+        if (noAddend) c = 0;
+        bool productSign = ((a ^ b) >> 31) != negateProduct;
+        bool addendSign  = noAddend ? productSign : ((c >> 31) != 0) != negateAddend;
+        bool productInvalid = (isInf(a) && isZero(b)) || (isZero(a) && isInf(b));
+        bool productInf     = (isInf(a) || isInf(b)) && !productInvalid;
+        bool anyNan         = isNan(a) || isNan(b) || isNan(c);
+
+        if (isSignallingNan(a) || isSignallingNan(b) || isSignallingNan(c)) flags |= NV;
+        if (productInvalid) { flags |= NV; return CANONICAL_NAN; } // Even with a quiet NaN addend
+        if (anyNan) return CANONICAL_NAN;
+        if (productInf && isInf(c) && productSign != addendSign) { flags |= NV; return CANONICAL_NAN; }
+        if (productInf) return productSign ? 0xFF800000 : 0x7F800000;
+        if (isInf(c))   return addendSign ? 0xFF800000 : 0x7F800000;
+
+        bool productZero = isZero(a) || isZero(b), addendZero = isZero(c);
+        if (productZero && addendZero) {
+            bool sign = (productSign == addendSign) ? productSign : rm == RDN;
+            return (uint32_t)sign << 31;
+        }
+
+        // Product (48 bits, leading one at bit 46 or 47) placed at [78:31]; addend at [78:55]
+        Unpacked ua = unpack(a), ub = unpack(b), uc = unpack(c);
+        Window productTerm = (Window)((uint64_t)ua.sig * ub.sig) << 31;
+        Window addendTerm  = (Window)uc.sig << 55;
+        int    productLsb  = ua.exp + ub.exp - 77;
+        int    addendLsb   = uc.exp - 78;
+
+        Window sum;
+        bool   sign;
+        int    lsbExp;
+        if (addendZero) {
+            sum = productTerm, sign = productSign, lsbExp = productLsb;
+        } else if (productZero) {
+            sum = addendTerm, sign = addendSign, lsbExp = addendLsb;
+        } else {
+            // The term with the finer LSB is shifted onto the other's grid
+            Window big, small;
+            bool   bigSign, smallSign;
+            if (productLsb >= addendLsb) {
+                big = productTerm, bigSign = productSign, lsbExp = productLsb;
+                small = shiftRightJam(addendTerm, productLsb - addendLsb), smallSign = addendSign;
+            } else {
+                big = addendTerm, bigSign = addendSign, lsbExp = addendLsb;
+                small = shiftRightJam(productTerm, addendLsb - productLsb), smallSign = productSign;
+            }
+            if (bigSign == smallSign)  sum = big + small, sign = bigSign;
+            else if (big >= small)     sum = big - small, sign = bigSign;
+            else                       sum = small - big, sign = smallSign;
+            if (sum == 0) return (uint32_t)(rm == RDN) << 31; // Exact cancellation
+        }
+        return roundPack(sign, lsbExp, sum, rm, flags);
+    }
+
+    // 27 quotient bits (restoring division), remainder as sticky
+    static uint32_t divide(uint32_t a, uint32_t b, uint32_t rm, uint32_t &flags) {
+        uint32_t sign = (a ^ b) & 0x80000000;
+        if (isSignallingNan(a) || isSignallingNan(b)) flags |= NV;
+        if (isNan(a) || isNan(b)) return CANONICAL_NAN;
+        if ((isInf(a) && isInf(b)) || (isZero(a) && isZero(b))) { flags |= NV; return CANONICAL_NAN; }
+        if (isInf(a) || isZero(b)) {
+            if (!isInf(a)) flags |= DZ;
+            return sign | 0x7F800000;
+        }
+        if (isZero(a) || isInf(b)) return sign;
+
+        Unpacked ua = unpack(a), ub = unpack(b);
+        uint32_t remainder = ua.sig, quotient = 0;
+        for (int i = 0; i < 27; i++) {
+            quotient <<= 1;
+            if (remainder >= ub.sig) remainder -= ub.sig, quotient |= 1;
+            remainder <<= 1;
+        }
+        Window sig = ((Window)quotient << 53) | (remainder != 0);
+        return roundPack(sign != 0, ua.exp - ub.exp - 26 - 53, sig, rm, flags);
+    }
+
+    // 27 root bits (digit by digit over a 54-bit radicand), remainder as sticky
+    static uint32_t squareRoot(uint32_t a, uint32_t rm, uint32_t &flags) {
+        if (isSignallingNan(a)) flags |= NV;
+        if (isNan(a)) return CANONICAL_NAN;
+        if (isZero(a)) return a;
+        if (a >> 31) { flags |= NV; return CANONICAL_NAN; }
+        if (isInf(a)) return a;
+
+        Unpacked ua = unpack(a);
+        int      exp = ua.exp - 23;                        // a = sig * 2^exp
+        uint64_t radicand = (uint64_t)ua.sig << 28;
+        if (exp & 1) radicand <<= 1, exp--;
+        uint64_t remainder = 0, root = 0;
+        for (int i = 26; i >= 0; i--) {
+            remainder = (remainder << 2) | ((radicand >> (2 * i)) & 3);
+            uint64_t trial = (root << 2) | 1;
+            root <<= 1;
+            if (remainder >= trial) remainder -= trial, root |= 1;
+        }
+        Window sig = ((Window)root << 53) | (remainder != 0);
+        return roundPack(false, (exp - 28) / 2 - 53, sig, rm, flags);
+    }
+
+    // FMIN/FMAX: a NaN operand yields the other one; -0 is below +0
+    static uint32_t minMax(uint32_t a, uint32_t b, bool max, uint32_t &flags) {
+        if (isSignallingNan(a) || isSignallingNan(b)) flags |= NV;
+        if (isNan(a) && isNan(b)) return CANONICAL_NAN;
+        if (isNan(a)) return b;
+        if (isNan(b)) return a;
+        return (less(a, b, true) != max) ? a : b;
+    }
+
+    // a < b for non-NaN values; 'signedZero' orders -0 below +0
+    static bool less(uint32_t a, uint32_t b, bool signedZero) {
+        bool signA = a >> 31, signB = b >> 31;
+        if (signA != signB) return signA && (signedZero || ((a | b) & 0x7FFFFFFF) != 0);
+        return signA ? (a & 0x7FFFFFFF) > (b & 0x7FFFFFFF) : (a & 0x7FFFFFFF) < (b & 0x7FFFFFFF);
+    }
+
+    // FCVT.W.S / FCVT.WU.S: rounded as 32.32 fixed point; out of range saturates with NV (no NX)
+    static uint32_t toInteger(uint32_t a, bool isSigned, uint32_t rm, uint32_t &flags) {
+        bool     sign     = a >> 31;
+        uint32_t positive = isSigned ? 0x7FFFFFFF : 0xFFFFFFFF;
+        uint32_t negative = isSigned ? 0x80000000 : 0;
+        if (isNan(a))  { flags |= NV; return positive; }
+        if (isInf(a))  { flags |= NV; return sign ? negative : positive; }
+        if (isZero(a)) return 0;
+
+        Unpacked ua = unpack(a);
+        if (ua.exp >= 32) { flags |= NV; return sign ? negative : positive; }
+        uint64_t fixed   = (ua.exp + 9 >= 0) ? (uint64_t)ua.sig << (ua.exp + 9)
+                                             : (uint64_t)shiftRightJam(ua.sig, -(ua.exp + 9));
+        uint32_t whole   = (uint32_t)(fixed >> 32);
+        bool     round   = (fixed >> 31) & 1, sticky = (fixed & 0x7FFFFFFF) != 0;
+        uint64_t rounded = (uint64_t)whole + roundUp(rm, sign, whole & 1, round, sticky);
+
+        bool overflow = isSigned ? rounded > (sign ? 0x80000000ull : 0x7FFFFFFFull)
+                                 : (sign ? rounded != 0 : rounded > 0xFFFFFFFFull);
+        if (overflow) { flags |= NV; return sign ? negative : positive; }
+        if (round || sticky) flags |= NX;
+        return sign ? (uint32_t)-(uint32_t)rounded : (uint32_t)rounded;
+    }
+
+    // FCVT.S.W / FCVT.S.WU: the magnitude at [79:48]
+    static uint32_t fromInteger(uint32_t x, bool isSigned, uint32_t rm, uint32_t &flags) {
+        bool     sign      = isSigned && (x >> 31);
+        uint32_t magnitude = sign ? 0u - x : x;
+        if (!magnitude) return 0;
+        return roundPack(sign, -48, (Window)magnitude << 48, rm, flags);
+    }
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SERIAL_HOST_H
+#define SERIAL_HOST_H
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Host side of the UART link (8N1), driving the SoC's uartReceive pin.
+ * Advance with step() once per CPU clock; line() is the level to apply to the pin.
+ */
+class SerialHost {
+public:
+    explicit SerialHost(int clocksPerBit = 108) : clocksPerBit(clocksPerBit) {}
+
+    void send(uint8_t byte) { txQueue.push_back(byte); }
+
+    void sendWord(uint32_t word) {
+        for (int i = 0; i < 4; i++) send((word >> (8 * i)) & 0xFF);
+    }
+
+    // Queues a bootloader frame: "BOOT" | length | image (padded to words) | word checksum
+    bool sendBootImage(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        while (image.size() % 4) image.push_back(0);
+
+        uint32_t checksum = 0;
+        for (size_t i = 0; i < image.size(); i += 4) {
+            checksum += image[i] | (image[i + 1] << 8) | (image[i + 2] << 16) | ((uint32_t)image[i + 3] << 24);
+        }
+        for (char c : std::string("BOOT")) send((uint8_t)c);
+        sendWord((uint32_t)image.size());
+        for (uint8_t byte : image) send(byte);
+        sendWord(checksum);
+        return true;
+    }
+
+    // One CPU clock: shifts start bit, 8 data bits (LSB first) and stop bit
+    void step() {
+        if (bitPosition < 0) {
+            if (txQueue.empty()) return;
+            currentByte = txQueue.front();
+            txQueue.pop_front();
+            bitPosition = 0;
+            clockCount  = 0;
+        }
+        lineLevel = (bitPosition == 0) ? 0 : (bitPosition <= 8) ? ((currentByte >> (bitPosition - 1)) & 1) : 1;
+        if (++clockCount == clocksPerBit) {
+            clockCount = 0;
+            if (++bitPosition == 10) bitPosition = -1;
+        }
+    }
+
+    uint8_t line() const { return lineLevel; }
+    bool    idle() const { return bitPosition < 0 && txQueue.empty(); }
+    size_t  pending() const { return txQueue.size(); }
+
+private:
+    int                 clocksPerBit;
+    std::deque<uint8_t> txQueue;
+    uint8_t             currentByte = 0;
+    uint8_t             lineLevel   = 1;
+    int                 bitPosition = -1; // -1: idle, 0: start, 1-8: data, 9: stop
+    int                 clockCount  = 0;
+};
+
+#endif
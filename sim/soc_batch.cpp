@@ -0,0 +1,263 @@
+#include "Vsoc_top.h"
+#include "Vsoc_top___024root.h"
+#include "verilated.h"
+#include "log_decoder.h"
+#include "bench_report.h"
+#include "target_memory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Batch runner: many independent soc_top simulations in one process (run.sh batch).
+ * Each job gets its own VerilatedContext and model on a pool of worker threads, so a
+ * regression or sweep uses every core without paying process start-up per run.
+ *   +jobs=<file>              One job per line: "<image.bin> [timer-limit=N] [max-cycles=N] [elf=<path>]"
+ *   +images=<a.bin>,<b.bin>   Jobs for these images (instead of +jobs)
+ *   +timer-limits=<N>,<M>     Run every image once per timer limit (sweep; default 10000)
+ *   +max-cycles=<N>           Default budget per job in CPU cycles (default 5000000)
+ *   +threads=<N>              Worker threads (default: hardware concurrency)
+ *   +report=<csv>             Append benchmark results in job order, as soc_top_tb does
+ *   +log-dir=<dir>            Write each job's console to <dir>/job<N>.log
+ * The process fails if any job exits non-zero or never exits.
+ */
+
+/**
+ * @brief One simulation: a ROM image and its run settings.
+ */
+struct BatchJob {
+    std::string image, elf;
+    uint32_t    timerLimit = 10000;
+    uint64_t    maxCycles  = 5000000;
+
+    std::string label() const {
+        return timerLimit == 10000 ? image : image + ":timer-limit=" + std::to_string(timerLimit);
+    }
+};
+
+/**
+ * @brief Outcome of a job, collected by the main thread once all workers finish.
+ */
+struct BatchResult {
+    int                      exitCode = -1; // -1: no semihost exit within the budget
+    uint64_t                 cycles = 0, instret = 0;
+    double                   hostSeconds = 0;
+    std::string              console, error;
+    std::vector<BenchReport> reports;
+};
+
+// Same loop as soc_top_tb without waveforms, interrupt logging or the serial host
+static BatchResult runJob(const BatchJob &job) {
+    BatchResult result;
+    auto hostStart = std::chrono::steady_clock::now();
+
+    std::unique_ptr<VerilatedContext> context(new VerilatedContext);
+    std::unique_ptr<Vsoc_top>         dut(new Vsoc_top(context.get(), "TOP"));
+    dut->clock          = 0;
+    dut->resetActiveLow = 0;
+    dut->uartReceive    = 1;
+    dut->bootStrap      = 0;
+    dut->semihostResult = 0;
+    dut->timerLimit     = job.timerLimit;
+    dut->eval(); // $readmemh before the backdoor load
+
+    TargetMemory targetMemory{dut.get()};
+    size_t imageBytes = 0;
+    result.error = targetMemory.loadRom(job.image, imageBytes);
+    if (!result.error.empty()) return result;
+
+    std::ostringstream console;
+    LogDecoder logDecoder;
+    logDecoder.loadElf(job.elf);
+
+    bool lastWriteValid = false, lastCpuClock = false;
+    const uint64_t maxTicks = 16 * job.maxCycles;
+    uint64_t tick = 0;
+    for (; tick < maxTicks && result.exitCode < 0; tick++) {
+        dut->clock ^= 1;
+        if (tick > 20) dut->resetActiveLow = 1;
+        dut->eval();
+        if (dut->clock != 1) continue;
+
+        bool currentWriteValid = dut->rootp->soc_top__DOT__ioWriteValid && dut->rootp->soc_top__DOT__ioWriteReady;
+        if (currentWriteValid && !lastWriteValid && dut->rootp->soc_top__DOT__ioWriteAddress == 0x40000000) {
+            logDecoder.feed((uint8_t)dut->rootp->soc_top__DOT__ioWriteData, console);
+        }
+        lastWriteValid = currentWriteValid;
+
+        bool currentCpuClock = dut->rootp->soc_top__DOT__cpuClock;
+        if (!currentCpuClock && lastCpuClock && currentWriteValid &&
+            dut->rootp->soc_top__DOT__ioWriteAddress == 0x40000308) {
+            uint32_t arg0 = dut->rootp->soc_top__DOT__semihostArg0;
+            uint32_t arg1 = dut->rootp->soc_top__DOT__semihostArg1;
+            switch (dut->rootp->soc_top__DOT__ioWriteData) {
+                case 1:
+                    for (uint32_t i = 0; i < arg1; i++) console << (char)targetMemory.byte(arg0 + i);
+                    break;
+                case 2:
+                    result.exitCode = (int)(arg0 & 0xFF);
+                    break;
+                case 3:
+                    dut->semihostResult = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - hostStart).count();
+                    break;
+                case 4: {
+                    BenchReport report = BenchReport::read(targetMemory, arg0);
+                    report.print(console);
+                    result.reports.push_back(report);
+                    break;
+                }
+                default:
+                    console << "\n[SYS] Unknown semihost call " << dut->rootp->soc_top__DOT__ioWriteData << "\n";
+                    break;
+            }
+        }
+        lastCpuClock = currentCpuClock;
+    }
+
+    dut->final();
+    result.cycles      = tick / 16;
+    result.instret     = dut->rootp->soc_top__DOT__perfInstret;
+    result.console     = console.str();
+    result.hostSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+    return result;
+}
+
+// Value of "+name=value"; empty when absent
+static std::string plusArg(int argc, char **argv, const std::string &name) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, name.size() + 2, "+" + name + "=") == 0) return arg.substr(name.size() + 2);
+    }
+    return "";
+}
+
+static std::vector<std::string> splitList(const std::string &text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    for (std::string item; std::getline(stream, item, ',');) if (!item.empty()) items.push_back(item);
+    return items;
+}
+
+static std::string elfFor(const std::string &image) { return image.substr(0, image.rfind('.')) + ".elf"; }
+
+int main(int argc, char **argv) {
+    std::string jobsPath   = plusArg(argc, argv, "jobs");
+    std::string reportPath = plusArg(argc, argv, "report");
+    std::string logDir     = plusArg(argc, argv, "log-dir");
+    std::string cyclesArg  = plusArg(argc, argv, "max-cycles");
+    std::string threadsArg = plusArg(argc, argv, "threads");
+    uint64_t defaultCycles = !cyclesArg.empty() ? std::stoull(cyclesArg) : 5000000;
+
+    // --- 1. JOB LIST ---
+    std::vector<BatchJob> jobs;
+    if (!jobsPath.empty()) {
+        std::ifstream file(jobsPath);
+        if (!file) {
+            std::cout << "[SYS] Cannot open job list: " << jobsPath << std::endl;
+            return 1;
+        }
+        for (std::string line; std::getline(file, line);) {
+            std::istringstream fields(line);
+            BatchJob job;
+            job.maxCycles = defaultCycles;
+            if (!(fields >> job.image) || job.image[0] == '#') continue;
+            for (std::string field; fields >> field;) {
+                std::string value = field.substr(field.find('=') + 1);
+                if      (field.compare(0, 12, "timer-limit=") == 0) job.timerLimit = std::stoul(value);
+                else if (field.compare(0, 11, "max-cycles=") == 0)  job.maxCycles  = std::stoull(value);
+                else if (field.compare(0, 4, "elf=") == 0)          job.elf        = value;
+                else std::cout << "[SYS] Ignoring '" << field << "' in " << jobsPath << std::endl;
+            }
+            if (job.elf.empty()) job.elf = elfFor(job.image);
+            jobs.push_back(job);
+        }
+    } else {
+        std::vector<std::string> limits = splitList(plusArg(argc, argv, "timer-limits"));
+        if (limits.empty()) limits.push_back("10000");
+        for (const std::string &image : splitList(plusArg(argc, argv, "images"))) {
+            for (const std::string &limit : limits) {
+                BatchJob job;
+                job.image      = image;
+                job.elf        = elfFor(image);
+                job.timerLimit = std::stoul(limit);
+                job.maxCycles  = defaultCycles;
+                jobs.push_back(job);
+            }
+        }
+    }
+    if (jobs.empty()) {
+        std::cout << "[SYS] No jobs (use +jobs=<file> or +images=<a.bin>,<b.bin>)" << std::endl;
+        return 1;
+    }
+
+    unsigned threads = !threadsArg.empty() ? std::stoul(threadsArg) : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads ? threads : 1, jobs.size()));
+    std::cout << "\033[1;32m[SYS] Batch: " << jobs.size() << " jobs on " << threads << " threads\033[0m" << std::endl;
+    std::cout << "---------------------------------------------" << std::endl;
+
+    // --- 2. WORKER POOL ---
+    // Workers take the next job index; results land in their own slot, so only printing is locked
+    std::vector<BatchResult> results(jobs.size());
+    std::atomic<size_t>      nextJob(0);
+    std::mutex               printLock;
+    auto batchStart = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        for (size_t index; (index = nextJob++) < jobs.size();) {
+            results[index] = runJob(jobs[index]);
+            const BatchResult &result = results[index];
+            std::lock_guard<std::mutex> lock(printLock);
+            const char *status = (result.error.empty() && result.exitCode == 0) ? "[PASS]" : "[FAIL]";
+            std::cout << status << " job " << std::setw(3) << index << " " << jobs[index].label();
+            if (!result.error.empty()) {
+                std::cout << ": " << result.error << std::endl;
+                continue;
+            }
+            std::cout << ": " << (result.exitCode < 0 ? "no exit" : "exit " + std::to_string(result.exitCode))
+                      << ", " << result.cycles << " cycles, " << result.instret << " instret in " << std::fixed
+                      << std::setprecision(2) << result.hostSeconds << " s" << std::endl;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++) pool.emplace_back(worker);
+    for (std::thread &thread : pool) thread.join();
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+
+    // --- 3. AGGREGATE ---
+    // Reports and logs in job order, independent of which worker finished first
+    int failed = 0;
+    uint64_t totalCycles = 0;
+    double   jobSeconds  = 0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const BatchResult &result = results[i];
+        if (!result.error.empty() || result.exitCode != 0) failed++;
+        totalCycles += result.cycles;
+        jobSeconds  += result.hostSeconds;
+        if (!reportPath.empty()) {
+            for (const BenchReport &report : result.reports) report.append(reportPath, jobs[i].label());
+        }
+        if (!logDir.empty()) std::ofstream(logDir + "/job" + std::to_string(i) + ".log") << result.console;
+    }
+
+    std::cout << "---------------------------------------------" << std::endl;
+    std::cout << "[PERF] Batch: " << jobs.size() << " jobs, " << totalCycles << " CPU cycles in " << std::fixed
+              << std::setprecision(2) << wallSeconds << " s (" << std::setprecision(0)
+              << (wallSeconds > 0 ? totalCycles / wallSeconds : 0.0) << " cycles/s, " << std::setprecision(1)
+              << (wallSeconds > 0 ? jobSeconds / wallSeconds : 0.0) << "x over sequential)" << std::endl;
+    if (failed) {
+        std::cout << "[FAIL] " << failed << " of " << jobs.size() << " jobs failed" << std::endl;
+        return 1;
+    }
+    std::cout << "[SUCCESS] All " << jobs.size() << " jobs passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include "Vsoc_top.h"
+#include "Vsoc_top___024root.h"
+#include "verilated.h"
+#include "target_memory.h"
+#include "rv32_fuzz.h"
+#include "../vp/soc_vp.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Differential fuzzer (run.sh fuzz): random RV32IFC programs (sim/rv32_fuzz.h) run on
+ * soc_top and on the virtual platform's reference model (vp/soc_vp.h); the architectural state
+ * at semihost exit must match. The first mismatch is shrunk to a minimal program and written
+ * as a ROM image (soc_top_tb +image=) with its disassembly.
+ *   +programs=<N>      Programs to run (default 1000)
+ *   +seed=<S>          Seed of program 0; program i uses S + i (default 1)
+ *   +items=<N>         Maximum body length in items (default 200)
+ *   +threads=<N>       Worker threads (default: hardware concurrency)
+ *   +max-cycles=<N>    Budget per program in CPU cycles (default 100000)
+ *   +noirq             No timer interrupts (ECALL traps only)
+ *   +out=<prefix>      Reproducer files <prefix>_<seed>.bin/.s (default fuzz_fail)
+ */
+
+// Plays the program on soc_top: same loop as soc_batch, stopping at the semihost EXIT
+static Rv32FuzzState runRtl(const Rv32FuzzProgram &program, uint64_t maxCycles) {
+    std::unique_ptr<VerilatedContext> context(new VerilatedContext);
+    std::unique_ptr<Vsoc_top>         dut(new Vsoc_top(context.get(), "TOP"));
+    dut->clock          = 0;
+    dut->resetActiveLow = 0;
+    dut->uartReceive    = 1;
+    dut->bootStrap      = 0;
+    dut->semihostResult = 0;
+    dut->timerLimit     = program.timerLimit;
+    dut->eval();
+
+    TargetMemory targetMemory{dut.get()};
+    targetMemory.loadRom(program.encode());
+
+    Rv32FuzzState state;
+    bool lastCpuClock = false;
+    for (uint64_t tick = 0; tick < 16 * maxCycles && !state.exited; tick++) {
+        dut->clock ^= 1;
+        if (tick > 20) dut->resetActiveLow = 1;
+        dut->eval();
+        if (dut->clock != 1) continue;
+
+        bool currentCpuClock = dut->rootp->soc_top__DOT__cpuClock;
+        if (!currentCpuClock && lastCpuClock && dut->rootp->soc_top__DOT__ioWriteValid &&
+            dut->rootp->soc_top__DOT__ioWriteReady && dut->rootp->soc_top__DOT__ioWriteAddress == 0x40000308) {
+            state.exited = true;
+        }
+        lastCpuClock = currentCpuClock;
+    }
+
+    // The EXIT store retires at the next edge; the registers are final already
+    for (int r = 1; r < 32; r++) state.regs[r] = dut->rootp->soc_top__DOT__u_hart0__DOT__u_rf__DOT__registerFile[r];
+    for (int r = 0; r < 32; r++) state.fregs[r] = dut->rootp->soc_top__DOT__u_hart0__DOT__gen_fpu__DOT__u_fprf__DOT__registerFile[r];
+    state.fcsr = dut->rootp->soc_top__DOT__u_hart0__DOT__fpControlStatus;
+    for (uint32_t i = 0; i < Rv32FuzzProgram::STATE_WORDS; i++) {
+        state.ram.push_back(targetMemory.word(Rv32FuzzProgram::RAM_BASE + 4 * i));
+    }
+    dut->final();
+    return state;
+}
+
+static Rv32FuzzState runReference(const Rv32FuzzProgram &program, uint64_t maxCycles) {
+    std::unique_ptr<SocPlatform> platform(new SocPlatform);
+    platform->traceInterrupts = false;
+    platform->consoleByte     = [](uint8_t) {};
+    platform->hostText        = [](const std::string &) {};
+    platform->benchReport     = [](uint32_t) {};
+    platform->timerLimit      = program.timerLimit;
+    platform->loadImage(program.encode());
+    platform->run(maxCycles);
+
+    Rv32FuzzState state;
+    state.exited = platform->exitCode >= 0;
+    for (int r = 1; r < 32; r++) state.regs[r] = platform->reg(r);
+    for (int r = 0; r < 32; r++) state.fregs[r] = platform->freg(r);
+    state.fcsr = platform->fcsrValue();
+    for (uint32_t i = 0; i < Rv32FuzzProgram::STATE_WORDS; i++) {
+        state.ram.push_back(platform->word(Rv32FuzzProgram::RAM_BASE + 4 * i));
+    }
+    return state;
+}
+
+// Value of "+name=value" (or "+name" for flags, returned as "1"); empty when absent
+static std::string plusArg(int argc, char **argv, const std::string &name) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, name.size() + 1, "+" + name) != 0) continue;
+        if (arg.size() == name.size() + 1) return "1";
+        if (arg[name.size() + 1] == '=') return arg.substr(name.size() + 2);
+    }
+    return "";
+}
+
+int main(int argc, char **argv) {
+    std::string programsArg = plusArg(argc, argv, "programs"), seedArg   = plusArg(argc, argv, "seed");
+    std::string itemsArg    = plusArg(argc, argv, "items"),    threadsArg = plusArg(argc, argv, "threads");
+    std::string cyclesArg   = plusArg(argc, argv, "max-cycles"), outArg  = plusArg(argc, argv, "out");
+    const uint64_t programs  = !programsArg.empty() ? std::stoull(programsArg) : 1000;
+    const uint64_t seed      = !seedArg.empty() ? std::stoull(seedArg) : 1;
+    const uint32_t maxItems  = std::max(16ul, !itemsArg.empty() ? std::stoul(itemsArg) : 200ul);
+    const uint64_t maxCycles = !cyclesArg.empty() ? std::stoull(cyclesArg) : 100000;
+    const bool     interrupts = plusArg(argc, argv, "noirq").empty();
+    const std::string outPrefix = !outArg.empty() ? outArg : "fuzz_fail";
+
+    unsigned threads = !threadsArg.empty() ? std::stoul(threadsArg) : std::thread::hardware_concurrency();
+    threads = std::max(1u, (unsigned)std::min<uint64_t>(threads ? threads : 1, programs));
+    std::cout << "\033[1;32m[SYS] Differential fuzz: " << programs << " programs from seed " << seed << " on "
+              << threads << " threads\033[0m" << std::endl;
+
+    auto generate = [&](uint64_t programSeed) {
+        uint32_t count = 16 + (uint32_t)((programSeed * 0x9E3779B97F4A7C15ull) >> 40) % (maxItems - 15);
+        return Rv32FuzzProgram::generate(programSeed, count, interrupts);
+    };
+
+    // --- 1. SEARCH ---
+    // Workers stop at the first mismatch; the lowest failing seed is kept so reruns agree
+    std::atomic<uint64_t> nextProgram(0), completed(0), failingSeed(UINT64_MAX);
+    std::mutex            printLock;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        for (uint64_t index; (index = nextProgram++) < programs && failingSeed == UINT64_MAX;) {
+            Rv32FuzzProgram program = generate(seed + index);
+            Rv32FuzzState   dut = runRtl(program, maxCycles), reference = runReference(program, maxCycles);
+            if (dut != reference || !dut.exited) {
+                uint64_t expected = UINT64_MAX;
+                while (seed + index < (expected = failingSeed) && !failingSeed.compare_exchange_weak(expected, seed + index)) {}
+                continue;
+            }
+            uint64_t done = ++completed;
+            if (done % 500 == 0) {
+                std::lock_guard<std::mutex> lock(printLock);
+                std::cout << "[INFO] " << done << " programs passed" << std::endl;
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++) pool.emplace_back(worker);
+    for (std::thread &thread : pool) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[PERF] Fuzz: " << completed << " programs in " << std::fixed << std::setprecision(2) << seconds
+              << " s (" << std::setprecision(0) << (seconds > 0 ? 60 * completed / seconds : 0.0)
+              << " programs/min)" << std::endl;
+    if (failingSeed == UINT64_MAX) {
+        std::cout << "[SUCCESS] soc_top matches the reference model on all programs" << std::endl;
+        return 0;
+    }
+
+    // --- 2. SHRINK ---
+    Rv32FuzzProgram program = generate(failingSeed);
+    std::cout << "[FAIL] Mismatch on seed " << failingSeed << " (" << program.items.size()
+              << " items); shrinking..." << std::endl;
+    auto fails = [&](const Rv32FuzzProgram &candidate) {
+        Rv32FuzzState dut = runRtl(candidate, maxCycles), reference = runReference(candidate, maxCycles);
+        return dut != reference || !dut.exited;
+    };
+    Rv32FuzzProgram reduced = Rv32FuzzProgram::shrink(program, fails);
+
+    Rv32FuzzState dut = runRtl(reduced, maxCycles), reference = runReference(reduced, maxCycles);
+    std::string path = outPrefix + "_" + std::to_string(failingSeed);
+    std::vector<uint8_t> image = reduced.encode();
+    std::ofstream(path + ".bin", std::ios::binary).write((const char *)image.data(), image.size());
+    std::ofstream(path + ".s") << reduced.listing();
+
+    std::cout << "[FAIL] Reduced to " << reduced.items.size() << " items (timer-limit " << reduced.timerLimit
+              << "); soc_top vs reference:" << std::endl;
+    std::cout << Rv32FuzzState::diff(dut, reference);
+    std::cout << "[INFO] Reproducer: " << path << ".bin (soc_top_tb +image=" << path << ".bin +timer-limit="
+              << reduced.timerLimit << "), listing in " << path << ".s" << std::endl;
+    return 1;
+}
@@ -2,8 +2,51 @@
 #include "Vsoc_top___024root.h" 
 #include "verilated.h"
 #include "verilated_vcd_c.h"
+#include "serial_host.h"
+#include "log_decoder.h"
+#include "bench_report.h"
+#include "target_memory.h"
+#include "commit_trace.h"
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Snapshot of the D-cache performance counters exposed by soc_top.
+ */
+struct CacheStats {
+    uint64_t hits = 0, misses = 0, writebacks = 0, stalls = 0;
+
+    static CacheStats sample(Vsoc_top *dut) {
+        CacheStats s;
+        s.hits       = dut->rootp->soc_top__DOT__dcacheHits;
+        s.misses     = dut->rootp->soc_top__DOT__dcacheMisses;
+        s.writebacks = dut->rootp->soc_top__DOT__dcacheWritebacks;
+        s.stalls     = dut->rootp->soc_top__DOT__dcacheStalls;
+        return s;
+    }
+
+    void accumulate(const CacheStats &end, const CacheStats &start) {
+        hits       += end.hits       - start.hits;
+        misses     += end.misses     - start.misses;
+        writebacks += end.writebacks - start.writebacks;
+        stalls     += end.stalls     - start.stalls;
+    }
+
+    void report(const char *label) const {
+        uint64_t accesses = hits + misses;
+        double hitRate = accesses ? (100.0 * hits / accesses) : 0.0;
+        std::cout << "[PERF] " << std::left << std::setw(18) << std::setfill(' ') << label << std::right << std::dec
+                  << " accesses: " << std::setw(8) << accesses
+                  << " | hit rate: " << std::fixed << std::setprecision(2) << std::setw(6) << hitRate << "%"
+                  << " | writebacks: " << std::setw(6) << writebacks
+                  << " | stall cycles: " << std::setw(8) << stalls << std::endl;
+    }
+};
 
 /**
  * @brief RISC-V SoC Verification Environment
@@ -16,44 +59,130 @@ int main(int argc, char **argv) {
     Vsoc_top *dut = new Vsoc_top;
     VerilatedVcdC *m_trace = new VerilatedVcdC;
     
-    // Waveform configuration
-    dut->trace(m_trace, 5);
-    m_trace->open("simulation_trace.vcd");
+    // Waveform configuration (+notrace skips the VCD for long benchmark runs)
+    bool tracing = std::string(Verilated::commandArgsPlusMatch("notrace")).empty();
+    if (tracing) {
+        dut->trace(m_trace, 5);
+        m_trace->open("simulation_trace.vcd");
+    }
 
     // Initial hardware state
     dut->clock = 0;
     dut->resetActiveLow = 0;
+    dut->uartReceive = 1; // Idle line
+    dut->semihostResult = 0;
+    // +timer-limit=<N> sets the timer period to N + 1 CPU cycles (default 10000)
+    std::string timerArg = Verilated::commandArgsPlusMatch("timer-limit=");
+    dut->timerLimit = !timerArg.empty() ? std::stoul(timerArg.substr(timerArg.find('=') + 1)) : 10000;
+    dut->eval(); // Runs the ROM's $readmemh before any backdoor load
+
+    // +image=<image.bin> replaces the ROM contents (benchmarks; linked with link.ld)
+    std::string imageArg  = Verilated::commandArgsPlusMatch("image=");
+    std::string imagePath = imageArg.empty() ? "firmware/firmware.bin" : imageArg.substr(imageArg.find('=') + 1);
+    if (!imageArg.empty()) {
+        size_t imageBytes = 0;
+        std::string error = TargetMemory{dut}.loadRom(imagePath, imageBytes);
+        if (!error.empty()) {
+            std::cout << "[SYS] " << error << ": " << imagePath << std::endl;
+            return 1;
+        }
+        std::cout << "[SYS] ROM image: " << imagePath << " (" << imageBytes << " bytes)" << std::endl;
+    }
+    std::string reportArg  = Verilated::commandArgsPlusMatch("report=");
+    std::string reportPath = reportArg.empty() ? "" : reportArg.substr(reportArg.find('=') + 1);
+
+    // +commit-trace=<file> records every retired instruction and trap (decode with sim/trace_dump)
+    CommitTraceWriter commitTrace;
+    std::string commitTraceArg = Verilated::commandArgsPlusMatch("commit-trace=");
+    if (!commitTraceArg.empty()) {
+        std::string commitTracePath = commitTraceArg.substr(commitTraceArg.find('=') + 1);
+        if (!commitTrace.open(commitTracePath)) {
+            std::cout << "[SYS] Cannot create commit trace: " << commitTracePath << std::endl;
+            return 1;
+        }
+        std::cout << "[SYS] Commit trace: " << commitTracePath << std::endl;
+    }
+
+    // Host side of the serial link; +boot=<image.bin> streams an image to the ROM bootloader
+    SerialHost host;
+    std::string bootArg = Verilated::commandArgsPlusMatch("boot=");
+    if (!bootArg.empty()) {
+        std::string bootPath = bootArg.substr(bootArg.find('=') + 1);
+        if (!host.sendBootImage(bootPath)) {
+            std::cout << "[SYS] Cannot open boot image: " << bootPath << std::endl;
+            return 1;
+        }
+        std::cout << "[SYS] Serial boot: " << bootPath << " (" << host.pending() << " bytes on the wire)" << std::endl;
+    }
+    dut->bootStrap = !bootArg.empty(); // The ROM bootloader waits for the frame only with a host
+
+    // Deferred log frames are expanded with the string table of the running image's ELF
+    // (+elf=<path>; defaults to the boot image's ELF or firmware/firmware.elf)
+    LogDecoder logDecoder;
+    std::string elfArg  = Verilated::commandArgsPlusMatch("elf=");
+    std::string elfPath = !elfArg.empty()   ? elfArg.substr(elfArg.find('=') + 1) :
+                          !bootArg.empty()  ? bootArg.substr(bootArg.find('=') + 1, bootArg.rfind('.') - bootArg.find('=') - 1) + ".elf" :
+                          !imageArg.empty() ? imagePath.substr(0, imagePath.rfind('.')) + ".elf" :
+                                              "firmware/firmware.elf";
+    if (!logDecoder.loadElf(elfPath)) {
+        std::cout << "[SYS] No .logstr in " << elfPath << "; deferred logs shown as raw tokens" << std::endl;
+    }
 
     std::cout << "\033[1;32m[SYS] Initializing RV32I SoC Simulation...\033[0m" << std::endl;
     std::cout << "[SYS] Monitoring UART MMIO (0x40000000)" << std::endl;
     std::cout << "---------------------------------------------" << std::endl;
 
     // Simulation timing: Scaled for 12.5 MHz CPU frequency
-    const long int MAX_SIM_TICKS = 1000000; 
+    // (a serial boot adds 10 bits x 108 CPU cycles x 16 ticks per byte on the wire)
+    // (+max-cycles=<N> sets the budget in CPU cycles; semihost exit usually ends the run first)
+    std::string maxCyclesArg = Verilated::commandArgsPlusMatch("max-cycles=");
+    const long int MAX_SIM_TICKS = !maxCyclesArg.empty() ? 16 * std::stol(maxCyclesArg.substr(maxCyclesArg.find('=') + 1)) :
+                                   1000000 + (long int)host.pending() * 10 * 108 * 16; 
 
     // Edge detection registers
     bool lastWriteValid = false; 
     bool lastTimerIrq   = false;
+    bool lastReturn     = false;
+    bool lastCpuClock   = false;
+
+    // Semihosting: console bytes bypass the UART; EXIT ends the run with the firmware's code
+    TargetMemory targetMemory{dut};
+    auto hostStart = std::chrono::steady_clock::now();
+    uint64_t semihostBytes = 0;
+    int exitCode = -1;
+
+    // Trap-frame traffic: counters accumulated between trap entry and MRET
+    CacheStats trapStats, trapEntryStats;
+    bool inTrapHandler = false;
 
-    for (long int tick = 0; tick < MAX_SIM_TICKS; tick++) {
+    long int tick = 0;
+    for (; tick < MAX_SIM_TICKS && exitCode < 0; tick++) {
         dut->clock ^= 1; // System clock toggle
         
         // Asynchronous reset release
         if (tick > 20) dut->resetActiveLow = 1;
 
+        // Serial host advances once per CPU clock
+        if (tick > 20 && tick % 16 == 0) {
+            host.step();
+            dut->uartReceive = host.line();
+        }
+
         dut->eval();
-        m_trace->dump((vluint64_t)tick);
+        if (tracing) m_trace->dump((vluint64_t)tick);
 
         // Synchronous logic monitoring (Rising Edge)
         if (dut->clock == 1) {
              
              // --- 1. MMIO BUS MONITOR (UART Output) ---
-             // Detects valid write cycles to the UART Transmit Buffer
-             bool currentWriteValid = dut->rootp->soc_top__DOT__ioWriteValid;
+             // Detects accepted write cycles (Valid && Ready) to the UART Transmit Buffer
+             bool currentWriteValid = dut->rootp->soc_top__DOT__ioWriteValid &&
+                                      dut->rootp->soc_top__DOT__ioWriteReady;
              if (currentWriteValid && !lastWriteValid && 
                  dut->rootp->soc_top__DOT__ioWriteAddress == 0x40000000) {
-                 char dataOut = (char)dut->rootp->soc_top__DOT__ioWriteData;
-                 std::cout << dataOut << std::flush; 
+                 uint8_t dataOut = (uint8_t)dut->rootp->soc_top__DOT__ioWriteData;
+                 logDecoder.feed(dataOut, std::cout);
+                 std::cout << std::flush; 
              }
              lastWriteValid = currentWriteValid;
 
@@ -72,13 +201,136 @@ int main(int argc, char **argv) {
                           << "\033[0m" << std::endl; 
              }
              lastTimerIrq = currentTimerIrq;
+
+             if (dut->rootp->soc_top__DOT__externalInterrupt) {
+                std::cout << "\n\033[1;36m[IRQ] External (DMA/UART) at Cycle: "
+                          << std::dec << std::setw(6) << std::setfill(' ') << tick / 16 << "\033[0m" << std::endl;
+             }
+
+             // --- 3. TRAP-FRAME CACHE ATTRIBUTION ---
+             // Save/restore traffic spans timer entry to the MRET that resumes the next task
+             bool currentReturn = dut->rootp->soc_top__DOT__isReturn;
+             if (currentTimerIrq && !inTrapHandler) {
+                 trapEntryStats = CacheStats::sample(dut);
+                 inTrapHandler  = true;
+             } else if (currentReturn && !lastReturn && inTrapHandler) {
+                 trapStats.accumulate(CacheStats::sample(dut), trapEntryStats);
+                 inTrapHandler = false;
+             }
+             lastReturn = currentReturn;
+
+             // --- 4. SEMIHOSTING ---
+             // Sampled once per CPU cycle (cpuClock falling edge), so back-to-back calls are all seen
+             bool currentCpuClock = dut->rootp->soc_top__DOT__cpuClock;
+             if (!currentCpuClock && lastCpuClock && dut->rootp->soc_top__DOT__ioWriteValid &&
+                 dut->rootp->soc_top__DOT__ioWriteReady &&
+                 dut->rootp->soc_top__DOT__ioWriteAddress == 0x40000308) {
+                 uint32_t arg0 = dut->rootp->soc_top__DOT__semihostArg0;
+                 uint32_t arg1 = dut->rootp->soc_top__DOT__semihostArg1;
+                 switch (dut->rootp->soc_top__DOT__ioWriteData) {
+                     case 1: // WRITE(address, length)
+                         for (uint32_t i = 0; i < arg1; i++) std::cout << (char)targetMemory.byte(arg0 + i);
+                         std::cout << std::flush;
+                         semihostBytes += arg1;
+                         break;
+                     case 2: // EXIT(code)
+                         exitCode = (int)(arg0 & 0xFF);
+                         std::cout << "\n[SYS] Semihost exit (code " << std::dec << exitCode
+                                   << ") at Cycle: " << tick / 16 << std::endl;
+                         break;
+                     case 3: // CLOCK: host microseconds since start
+                         dut->semihostResult = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - hostStart).count();
+                         break;
+                     case 4: { // REPORT(result): benchmark counters, also appended to +report=<csv>
+                         BenchReport report = BenchReport::read(targetMemory, arg0);
+                         report.print();
+                         if (!reportPath.empty()) report.append(reportPath, imagePath);
+                         break;
+                     }
+                     default:
+                         std::cout << "\n[SYS] Unknown semihost call " << std::dec
+                                   << dut->rootp->soc_top__DOT__ioWriteData << std::endl;
+                         break;
+                 }
+             }
+
+             // --- 5. COMMIT TRACE ---
+             // Same sampling point: the instruction's last cycle, before its write-back edge
+             if (commitTrace.isOpen() && !currentCpuClock && lastCpuClock && dut->resetActiveLow &&
+                 !dut->rootp->soc_top__DOT__memoryStall) {
+                 uint32_t insn = dut->rootp->soc_top__DOT__instruction;
+                 CommitRecord record;
+                 record.cycle = tick / 16; // Same cycle numbering as the [IRQ] lines
+                 record.pc    = dut->rootp->soc_top__DOT__programCounter;
+                 if (dut->rootp->soc_top__DOT__isTrap) {
+                     record.flags = CommitTrace::FLAG_TRAP;
+                     record.cause = dut->rootp->soc_top__DOT__trapCause;
+                 } else {
+                     if (dut->rootp->soc_top__DOT__registerWriteEnable && ((insn >> 7) & 0x1F)) {
+                         record.flags  |= CommitTrace::FLAG_REG;
+                         record.rd      = (insn >> 7) & 0x1F;
+                         record.rdValue = dut->rootp->soc_top__DOT__writeBackData;
+                     }
+                     if (dut->rootp->soc_top__DOT__resultSource) {
+                         record.flags  |= CommitTrace::FLAG_LOAD;
+                         record.address = dut->rootp->soc_top__DOT__aluResult;
+                     } else if (dut->rootp->soc_top__DOT__memoryWriteEnable) {
+                         record.flags  |= CommitTrace::FLAG_STORE;
+                         record.address = dut->rootp->soc_top__DOT__aluResult;
+                         record.data    = dut->rootp->soc_top__DOT__cpuWriteData;
+                     }
+                 }
+                 commitTrace.append(record);
+             }
+             lastCpuClock = currentCpuClock;
         }
     }
 
     std::cout << "\n---------------------------------------------" << std::endl;
+
+    CacheStats totalStats;
+    totalStats.accumulate(CacheStats::sample(dut), CacheStats());
+    totalStats.report("D-Cache (total)");
+    trapStats.report("D-Cache (trap)");
+    if (logDecoder.frames()) {
+        std::cout << "[PERF] Deferred log: " << std::dec << logDecoder.frames() << " frames, "
+                  << logDecoder.frameBytesReceived() << " UART bytes" << std::endl;
+    }
+    // Model throughput (read by simperf.sh)
+    long int cpuCycles   = tick / 16;
+    double   hostSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+    std::cout << "[PERF] Simulation speed: " << std::dec << cpuCycles << " CPU cycles in " << std::fixed
+              << std::setprecision(3) << hostSeconds << " s (" << std::setprecision(0)
+              << (hostSeconds > 0 ? cpuCycles / hostSeconds : 0.0) << " cycles/s)" << std::endl;
+    if (dut->rootp->soc_top__DOT__hart1Started) {
+        uint32_t hart0Instret = dut->rootp->soc_top__DOT__perfInstret;
+        uint32_t hart1Instret = dut->rootp->soc_top__DOT__hart1Instret;
+        std::cout << "[PERF] Harts: " << std::dec << hart0Instret << " + " << hart1Instret
+                  << " instructions retired | bus contention: " << dut->rootp->soc_top__DOT__busContention
+                  << " cycles (" << std::setprecision(2)
+                  << (cpuCycles ? 100.0 * dut->rootp->soc_top__DOT__busContention / cpuCycles : 0.0) << "%)"
+                  << std::endl;
+    }
+    if (semihostBytes) {
+        std::cout << "[PERF] Semihost console: " << std::dec << semihostBytes << " bytes" << std::endl;
+    }
+    if (commitTrace.isOpen()) {
+        commitTrace.close();
+        std::cout << "[PERF] Commit trace: " << std::dec << commitTrace.records() << " records, "
+                  << commitTrace.bytes() << " bytes (" << std::setprecision(2)
+                  << (commitTrace.records() ? (double)commitTrace.bytes() / commitTrace.records() : 0.0)
+                  << " bytes/record)" << std::endl;
+    }
     std::cout << "\033[1;32m[SYS] Simulation Terminated Successfully.\033[0m" << std::endl;
 
-    m_trace->close();
+    if (tracing) m_trace->close();
     delete dut;
-    return 0;
+
+    // Benchmark runs must end through semihost exit; running out of budget means a hang
+    if (exitCode < 0 && !reportPath.empty()) {
+        std::cout << "[FAIL] No semihost exit within the cycle budget" << std::endl;
+        return 2;
+    }
+    return exitCode < 0 ? 0 : exitCode;
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef TARGET_MEMORY_H
+#define TARGET_MEMORY_H
+
+#include "Vsoc_top.h"
+#include "Vsoc_top___024root.h"
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Backdoor access to target memory for the semihosting host (firmware/semihost.h).
+ * RAM is read through the D-cache's view: a pending write-buffer entry or a valid line wins
+ * over the backing store, so buffers the firmware just wrote are seen without a flush.
+ * Shared by soc_top_tb and the batch runner (sim/soc_batch.cpp).
+ */
+struct TargetMemory {
+    Vsoc_top *dut;
+
+    uint32_t word(uint32_t address) const {
+        auto *root = dut->rootp;
+        if (address < 0x00002000) return root->soc_top__DOT__u_rom__DOT__romArray[(address >> 2) & 0x7FF];
+        if ((address >> 28) != 0x2) return 0;
+
+        uint32_t value = root->soc_top__DOT__gen_dcache__DOT__u_ram__DOT__ramArray[(address >> 2) & 0x3FF];
+        uint32_t index = (address >> 4) & 0xF;
+        if (((root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__lineValid >> index) & 1) &&
+            root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__lineTag[index] == (address >> 8)) {
+            value = root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__lineData[index][(address >> 2) & 0x3];
+        }
+        // Oldest to youngest, so the latest store to a word is applied last
+        uint32_t head = root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__bufferHead;
+        for (uint32_t i = 0; i < root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__bufferCount; i++) {
+            uint32_t slot = (head + i) & 0x3;
+            if ((root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__bufferAddress[slot] >> 2) == (address >> 2)) {
+                value = root->soc_top__DOT__gen_dcache__DOT__u_dcache__DOT__bufferData[slot];
+            }
+        }
+        return value;
+    }
+
+    uint8_t byte(uint32_t address) const { return (word(address & ~3u) >> (8 * (address & 3))) & 0xFF; }
+
+    std::string string(uint32_t address, size_t maxLength = 64) const {
+        std::string text;
+        for (char c; text.size() < maxLength && (c = (char)byte(address + text.size())); ) text += c;
+        return text;
+    }
+
+    // Replaces the boot ROM contents with a raw image (call after the first eval, which runs
+    // $readmemh). Returns an error message, empty on success.
+    std::string loadRom(const std::string &path, size_t &bytesLoaded) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return "Cannot open image";
+        std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        while (image.size() % 4) image.push_back(0);
+        if (!loadRom(image)) return "Image exceeds the 16KB boot ROM";
+        bytesLoaded = image.size();
+        return "";
+    }
+
+    // Same from memory ('image' padded to whole words); false if it does not fit
+    bool loadRom(const std::vector<uint8_t> &image) {
+        if (image.size() > 0x4000 || image.size() % 4) return false;
+        for (size_t i = 0; i < image.size(); i += 4) {
+            dut->rootp->soc_top__DOT__u_rom__DOT__romArray[i / 4] =
+                image[i] | (image[i + 1] << 8) | (image[i + 2] << 16) | ((uint32_t)image[i + 3] << 24);
+        }
+        return true;
+    }
+};
+
+#endif
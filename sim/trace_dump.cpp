@@ -0,0 +1,266 @@
+#include "commit_trace.h"
+#include "rv32_disasm.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Offline viewer for soc_top_tb commit traces (+commit-trace=<file>).
+ * Instruction words and symbols come from the ELF that ran:
+ *   +trace=<file>     Trace to read (default commit_trace.bin)
+ *   +elf=<path>       Image that produced it (default firmware/firmware.elf)
+ *   +from=<N>         First record to show (seeks through the keyframe index)
+ *   +count=<N>        Stop after N matching records
+ *   +pc=<lo>:<hi>     Only records with lo <= pc < hi
+ *   +func=<symbol>    Only records inside a function (or between a label and the next symbol)
+ *   +reg=<name>       Only records that write this register (ABI name or xN)
+ *   +mem=<lo>:<hi>    Only loads/stores with lo <= address < hi
+ *   +traps            Only trap entries
+ *   +profile          Instead of listing, count retired instructions per function
+ * Numbers accept decimal or 0x-prefixed hex.
+ */
+
+/**
+ * @brief Loadable segments and symbol table of a 32-bit little-endian ELF.
+ */
+class ElfImage {
+public:
+    struct Symbol {
+        uint32_t    address, size;
+        std::string name;
+    };
+
+    bool load(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        elf.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (elf.size() < 52 || memcmp(elf.data(), "\x7f" "ELF", 4) != 0 || elf[4] != 1) return false;
+
+        uint32_t headerOffset = read32(28);
+        uint16_t headerSize   = read16(42);
+        uint16_t headerCount  = read16(44);
+        if (headerOffset + (size_t)headerCount * headerSize > elf.size()) return false;
+        for (uint16_t i = 0; i < headerCount; i++) {
+            size_t header = headerOffset + (size_t)i * headerSize;
+            if (read32(header) != 1) continue; // PT_LOAD
+            uint32_t offset = read32(header + 4), fileSize = read32(header + 16);
+            if (offset + (size_t)fileSize > elf.size()) return false;
+            segments.push_back({ read32(header + 12), offset, fileSize });
+        }
+
+        uint32_t sectionOffset = read32(32);
+        uint16_t sectionSize   = read16(46);
+        uint16_t sectionCount  = read16(48);
+        if (sectionOffset + (size_t)sectionCount * sectionSize > elf.size()) return false;
+        for (uint16_t i = 0; i < sectionCount; i++) {
+            size_t header = sectionOffset + (size_t)i * sectionSize;
+            if (read32(header + 4) != 2) continue; // SHT_SYMTAB
+            uint32_t offset  = read32(header + 16), size = read32(header + 20);
+            size_t   strings = sectionOffset + (size_t)read32(header + 24) * sectionSize;
+            uint32_t namesOffset = read32(strings + 16);
+            for (uint32_t entry = offset; entry + 16 <= offset + size && entry + 16 <= elf.size(); entry += 16) {
+                uint8_t type = elf[entry + 12] & 0xF;
+                if (read16(entry + 14) == 0 || (type != 0 && type != 2)) continue; // Defined NOTYPE/FUNC
+                std::string name((const char *)&elf[namesOffset + read32(entry)]);
+                if (name.empty() || name[0] == '$' || name.compare(0, 2, ".L") == 0) continue;
+                symbols.push_back({ read32(entry + 4), read32(entry + 8), name });
+            }
+        }
+        std::sort(symbols.begin(), symbols.end(),
+                  [](const Symbol &a, const Symbol &b) { return a.address < b.address; });
+        return !segments.empty();
+    }
+
+    // The 32 bits at a halfword-aligned 'address' (a compressed instruction may end the image:
+    // its upper half reads 0), 0 outside the image
+    uint32_t word(uint32_t address) const {
+        for (const auto &segment : segments) {
+            if (address >= segment.address && address + 2 <= segment.address + segment.size) {
+                size_t   offset = segment.offset + address - segment.address;
+                uint32_t high   = address + 4 <= segment.address + segment.size ? read16(offset + 2) : 0;
+                return (high << 16) | read16(offset);
+            }
+        }
+        return 0;
+    }
+
+    // Symbol covering 'address' (the closest one below it), or nullptr
+    const Symbol *lookup(uint32_t address) const {
+        auto it = std::upper_bound(symbols.begin(), symbols.end(), address,
+                                   [](uint32_t value, const Symbol &symbol) { return value < symbol.address; });
+        return it == symbols.begin() ? nullptr : &*(it - 1);
+    }
+
+    // Address range of a symbol: its size, or up to the next symbol for sizeless labels
+    bool range(const std::string &name, uint32_t &low, uint32_t &high) const {
+        for (size_t i = 0; i < symbols.size(); i++) {
+            if (symbols[i].name != name) continue;
+            low  = symbols[i].address;
+            high = symbols[i].size ? low + symbols[i].size : low + 4;
+            for (size_t j = i + 1; !symbols[i].size && j < symbols.size(); j++) {
+                if (symbols[j].address > low) { high = symbols[j].address; break; }
+            }
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct Segment {
+        uint32_t address, offset, size;
+    };
+    std::vector<uint8_t> elf;
+    std::vector<Segment> segments;
+    std::vector<Symbol>  symbols;
+
+    uint16_t read16(size_t at) const { return elf[at] | (elf[at + 1] << 8); }
+    uint32_t read32(size_t at) const { return read16(at) | ((uint32_t)read16(at + 2) << 16); }
+};
+
+// Value of "+name=value" (or "+name" for flags, returned as "1"); empty when absent
+static std::string plusArg(int argc, char **argv, const std::string &name) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, name.size() + 1, "+" + name) != 0) continue;
+        if (arg.size() == name.size() + 1) return "1";
+        if (arg[name.size() + 1] == '=') return arg.substr(name.size() + 2);
+    }
+    return "";
+}
+
+// "<lo>:<hi>" into [low, high); false when malformed
+static bool parseRange(const std::string &text, uint32_t &low, uint32_t &high) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) return false;
+    low  = (uint32_t)std::stoul(text.substr(0, colon), nullptr, 0);
+    high = (uint32_t)std::stoul(text.substr(colon + 1), nullptr, 0);
+    return low < high;
+}
+
+static const char *causeName(uint32_t cause) {
+    switch (cause) {
+        case 11:          return "ecall";
+        case 0x80000007u: return "timer";
+        case 0x8000000Bu: return "external";
+        default:          return "?";
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string tracePath = plusArg(argc, argv, "trace");
+    std::string elfPath   = plusArg(argc, argv, "elf");
+    if (tracePath.empty()) tracePath = "commit_trace.bin";
+    if (elfPath.empty())   elfPath   = "firmware/firmware.elf";
+
+    CommitTraceReader trace;
+    if (!trace.open(tracePath)) {
+        std::cout << "[SYS] Cannot read commit trace: " << tracePath << std::endl;
+        return 1;
+    }
+    ElfImage image;
+    if (!image.load(elfPath)) {
+        std::cout << "[SYS] Cannot load ELF: " << elfPath << std::endl;
+        return 1;
+    }
+
+    // Filters
+    std::string fromArg = plusArg(argc, argv, "from"), countArg = plusArg(argc, argv, "count");
+    std::string pcArg   = plusArg(argc, argv, "pc"),   funcArg  = plusArg(argc, argv, "func");
+    std::string regArg  = plusArg(argc, argv, "reg"),  memArg   = plusArg(argc, argv, "mem");
+    bool trapsOnly = !plusArg(argc, argv, "traps").empty();
+    bool profile   = !plusArg(argc, argv, "profile").empty();
+    uint64_t limit = !countArg.empty() ? std::stoull(countArg, nullptr, 0) : UINT64_MAX;
+
+    uint32_t pcLow = 0, pcHigh = 0, memLow = 0, memHigh = 0;
+    if (!pcArg.empty() && !parseRange(pcArg, pcLow, pcHigh)) {
+        std::cout << "[SYS] Bad +pc range: " << pcArg << std::endl;
+        return 1;
+    }
+    if (!funcArg.empty() && !image.range(funcArg, pcLow, pcHigh)) {
+        std::cout << "[SYS] No symbol " << funcArg << " in " << elfPath << std::endl;
+        return 1;
+    }
+    if (!memArg.empty() && !parseRange(memArg, memLow, memHigh)) {
+        std::cout << "[SYS] Bad +mem range: " << memArg << std::endl;
+        return 1;
+    }
+    int reg = regArg.empty() ? -1 : Rv32Disassembler::regIndex(regArg);
+    if (!regArg.empty() && reg < 0) {
+        std::cout << "[SYS] Unknown register: " << regArg << std::endl;
+        return 1;
+    }
+
+    if (!fromArg.empty()) trace.seek(std::stoull(fromArg, nullptr, 0));
+
+    std::map<std::string, uint64_t> functionCounts;
+    uint64_t shown = 0, records = 0, traps = 0;
+    CommitRecord record;
+    char line[192];
+    while (shown < limit && trace.next(record)) {
+        records++;
+        bool isTrap = record.flags & CommitTrace::FLAG_TRAP;
+        bool isMem  = record.flags & (CommitTrace::FLAG_LOAD | CommitTrace::FLAG_STORE);
+        if (isTrap) traps++;
+        if (pcHigh && (record.pc < pcLow || record.pc >= pcHigh)) continue;
+        if (trapsOnly && !isTrap) continue;
+        if (reg >= 0 && !((record.flags & CommitTrace::FLAG_REG) && record.rd == reg)) continue;
+        if (memHigh && (!isMem || record.address < memLow || record.address >= memHigh)) continue;
+        shown++;
+
+        const ElfImage::Symbol *symbol = image.lookup(record.pc);
+        if (profile) {
+            if (!isTrap) functionCounts[symbol ? symbol->name : "?"]++;
+            continue;
+        }
+
+        char where[64] = "";
+        if (symbol) snprintf(where, sizeof where, "<%s+0x%x>", symbol->name.c_str(), record.pc - symbol->address);
+        int length = snprintf(line, sizeof line, "%10llu %10llu  %08x %-24s ", (unsigned long long)record.index,
+                              (unsigned long long)record.cycle, record.pc, where);
+        if (isTrap) {
+            snprintf(line + length, sizeof line - length, "-------- trap    mcause=0x%08x (%s)", record.cause,
+                     causeName(record.cause));
+            std::cout << "\033[1;33m" << line << "\033[0m\n";
+            continue;
+        }
+        uint32_t insn = image.word(record.pc);
+        char encoding[16];
+        if (Rv32cExpander::isCompressed(insn)) snprintf(encoding, sizeof encoding, "    %04x", insn & 0xFFFF);
+        else                                   snprintf(encoding, sizeof encoding, "%08x", insn);
+        length += snprintf(line + length, sizeof line - length, "%s %-28s", encoding,
+                           Rv32Disassembler::disassemble(insn, record.pc).c_str());
+        if (record.flags & CommitTrace::FLAG_REG) {
+            length += snprintf(line + length, sizeof line - length, " %s=0x%08x",
+                               Rv32Disassembler::regName(record.rd), record.rdValue);
+        }
+        if (record.flags & CommitTrace::FLAG_LOAD) {
+            snprintf(line + length, sizeof line - length, " [0x%08x]", record.address);
+        } else if (record.flags & CommitTrace::FLAG_STORE) {
+            snprintf(line + length, sizeof line - length, " [0x%08x]<=0x%08x", record.address, record.data);
+        }
+        std::cout << line << "\n";
+    }
+
+    if (profile) {
+        std::vector<std::pair<uint64_t, std::string>> ranked;
+        uint64_t total = 0;
+        for (const auto &entry : functionCounts) {
+            ranked.push_back({ entry.second, entry.first });
+            total += entry.second;
+        }
+        std::sort(ranked.rbegin(), ranked.rend());
+        for (const auto &entry : ranked) {
+            snprintf(line, sizeof line, "[PERF] %-24s %12llu instr (%5.1f%%)", entry.second.c_str(),
+                     (unsigned long long)entry.first, total ? 100.0 * entry.first / total : 0.0);
+            std::cout << line << "\n";
+        }
+    }
+    std::cout << "[INFO] " << records << " records read, " << shown << " matched, " << traps << " traps"
+              << (trace.indexed() ? "" : " (no index: trace was not closed)") << std::endl;
+    return 0;
+}
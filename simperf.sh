@@ -0,0 +1,135 @@
+#!/bin/bash
+
+# Simulation throughput benchmark for the Verilated soc_top model.
+# Builds each RTL configuration, runs the same firmware for a fixed number of CPU cycles and
+# records build time, binary size and simulated cycles/s in sim_perf.csv. The speed of every
+# configuration is compared with sim/perf_baseline.csv; a drop past the threshold fails.
+#
+# Usage: ./simperf.sh [--update-baseline] [--profile]
+#   --update-baseline   Store this run's speeds as the new baseline
+#   --profile           Also build with --prof-cfuncs and record eval time per module
+#                       (gprof + verilator_profcfunc) in sim_perf_modules.csv
+# Environment: SIMPERF_CYCLES (default 200000), SIMPERF_REPEAT (best of, default 3),
+#              SIMPERF_THRESHOLD (allowed slowdown in percent, default 10)
+
+chmod +x "$0"
+if [ -f "./config.sh" ]; then
+    source ./config.sh
+else
+    echo "Error: config.sh not found."
+    exit 1
+fi
+
+CYCLES=${SIMPERF_CYCLES:-200000}
+REPEAT=${SIMPERF_REPEAT:-3}
+THRESHOLD=${SIMPERF_THRESHOLD:-10}
+BASELINE=sim/perf_baseline.csv
+RESULTS=sim_perf.csv
+MODULES=sim_perf_modules.csv
+BUILD_ROOT=build/simperf
+
+UPDATE_BASELINE=0
+PROFILE=0
+for ARG in "$@"; do
+    case $ARG in
+        --update-baseline) UPDATE_BASELINE=1 ;;
+        --profile)         PROFILE=1 ;;
+        *) echo "Unknown option: $ARG"; exit 1 ;;
+    esac
+done
+
+# RTL configurations: name and soc_top parameter overrides
+CONFIGS=(
+    "default|"
+    "flat_ram|-GuseDataCache=0"
+    "slow_ram|-GramLatencyCycles=32"
+    "in_order_bus|-GbusOutstanding=1"
+    "dma_weight4|-GbusDmaWeight=4"
+    "no_fpu|-GuseFpu=0"
+)
+
+now() { date +%s.%N; }
+
+# ---------------------------------------------------------
+# 1. FIXED FIRMWARE
+# ---------------------------------------------------------
+echo "--- BUILDING FIRMWARE ---"
+make -C firmware clean > /dev/null
+make -C firmware CC="$CC" OBJCOPY="$OBJCOPY" CFLAGS="$CFLAGS" > /dev/null || { echo "Firmware build failed"; exit 1; }
+hexdump -v -e '1/4 "%08x" "\n"' firmware/firmware.bin > firmware/firmware.hex
+
+# ---------------------------------------------------------
+# 2. BUILD & RUN EACH CONFIGURATION
+# ---------------------------------------------------------
+echo "config,build_seconds,binary_bytes,sim_cycles,sim_seconds,cycles_per_sec" > $RESULTS
+[ $PROFILE -eq 1 ] && echo "config,module,percent,eval_seconds" > $MODULES
+
+for CONFIG in "${CONFIGS[@]}"; do
+    NAME=${CONFIG%%|*}
+    PARAMS=${CONFIG#*|}
+    DIR=$BUILD_ROOT/$NAME
+    echo "--- $NAME ${PARAMS:-(defaults)} ---"
+
+    rm -rf $DIR
+    START=$(now)
+    verilator --cc rtl/soc_top.sv --exe sim/soc_top_tb.cpp --trace -Irtl -Isim --top-module soc_top \
+        -Mdir $DIR $PARAMS -LDFLAGS -pthread > /dev/null || { echo "Verilator failed: $NAME"; exit 1; }
+    make -C $DIR -f Vsoc_top.mk -j"$(nproc)" > /dev/null || { echo "Model build failed: $NAME"; exit 1; }
+    BUILD_SECONDS=$(echo "$(now) - $START" | bc)
+    BINARY_BYTES=$(wc -c < $DIR/Vsoc_top | tr -d ' ')
+
+    # Best of REPEAT runs (the fastest run has the least host noise)
+    BEST=""
+    for RUN in $(seq $REPEAT); do
+        LINE=$(./$DIR/Vsoc_top +notrace +max-cycles=$CYCLES | grep "Simulation speed")
+        SIM_CYCLES=$(echo "$LINE" | awk '{ print $4 }')
+        SIM_SECONDS=$(echo "$LINE" | awk '{ print $8 }')
+        if [ -z "$BEST" ] || [ "$(echo "$SIM_SECONDS < $BEST" | bc)" -eq 1 ]; then BEST=$SIM_SECONDS; fi
+    done
+    RATE=$(echo "$SIM_CYCLES / $BEST" | bc)
+    echo "$NAME,$BUILD_SECONDS,$BINARY_BYTES,$SIM_CYCLES,$BEST,$RATE" >> $RESULTS
+    echo "[PERF] $NAME: $RATE cycles/s | build ${BUILD_SECONDS}s | binary $BINARY_BYTES bytes"
+
+    # Per-module eval time from Verilator's function profile
+    if [ $PROFILE -eq 1 ]; then
+        PROFILE_DIR=$DIR-prof
+        rm -rf $PROFILE_DIR
+        verilator --cc rtl/soc_top.sv --exe sim/soc_top_tb.cpp --trace -Irtl -Isim --top-module soc_top \
+            -Mdir $PROFILE_DIR $PARAMS --prof-cfuncs -CFLAGS -pg -LDFLAGS -pg -LDFLAGS -pthread > /dev/null || exit 1
+        make -C $PROFILE_DIR -f Vsoc_top.mk -j"$(nproc)" > /dev/null || exit 1
+        # Run from the repository root ($readmemh path); gprof writes gmon.out to the working directory
+        ./$PROFILE_DIR/Vsoc_top +notrace +max-cycles=$CYCLES > /dev/null && mv gmon.out $PROFILE_DIR/
+        gprof $PROFILE_DIR/Vsoc_top $PROFILE_DIR/gmon.out > $PROFILE_DIR/gprof.out
+        verilator_profcfunc $PROFILE_DIR/gprof.out > $PROFILE_DIR/profcfunc.out
+
+        # "Overall summary by module:" lists "<% time> <module>" until the next blank line
+        awk -v config=$NAME -v seconds=$BEST '
+            /summary by module/ { inSection = 1; next }
+            inSection && NF == 0 { inSection = 0 }
+            inSection && $1 ~ /^[0-9.]+$/ { printf "%s,%s,%s,%.4f\n", config, $NF, $1, $1 * seconds / 100 }
+        ' $PROFILE_DIR/profcfunc.out >> $MODULES
+    fi
+done
+
+# ---------------------------------------------------------
+# 3. BASELINE COMPARISON
+# ---------------------------------------------------------
+if [ $UPDATE_BASELINE -eq 1 ] || [ ! -f $BASELINE ]; then
+    echo "config,cycles_per_sec" > $BASELINE
+    awk -F, 'NR > 1 { print $1 "," $6 }' $RESULTS >> $BASELINE
+    echo "[INFO] Baseline written to $BASELINE"
+    exit 0
+fi
+
+echo "--- BASELINE ($BASELINE, threshold ${THRESHOLD}%) ---"
+awk -F, -v threshold=$THRESHOLD '
+    NR == FNR { if (FNR > 1) baseline[$1] = $2; next }
+    FNR > 1 {
+        if (!($1 in baseline)) { printf "[INFO] %-14s %10d cycles/s (no baseline)\n", $1, $6; next }
+        change = 100 * ($6 - baseline[$1]) / baseline[$1]
+        status = (change < -threshold) ? "FAIL" : "PASS"
+        if (status == "FAIL") failed = 1
+        printf "[%s] %-14s %10d cycles/s | baseline %10d | %+6.1f%%\n", status, $1, $6, baseline[$1], change
+    }
+    END { exit failed }
+' $BASELINE $RESULTS
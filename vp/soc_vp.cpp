@@ -0,0 +1,106 @@
+#include "soc_vp.h"
+#include "log_decoder.h"
+#include "bench_report.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Fast virtual platform of the SoC: runs firmware.elf on SocPlatform (vp/soc_vp.h) with the
+ * console conventions of soc_top_tb (deferred logs, semihosting, benchmark reports, exit code).
+ * Takes the same plusargs as the testbench where they apply:
+ *   +elf=<path>         Image to run (default firmware/firmware.elf)
+ *   +max-cycles=<N>     Budget in CPU cycles (default: the testbench's default run length)
+ *   +report=<csv>       Append benchmark results, as soc_top_tb does
+ *   +ram-latency=<N>    Line transfer cycles of the RAM behind the D-cache (default 8)
+ *   +timer-limit=<N>    Timer period minus 1 in CPU cycles (default 10000)
+ *   +flat-ram           Model useDataCache = 0 (no miss stalls)
+ *   +nofpu              Model useFpu = 0 (FP opcodes trap, MCAUSE 2)
+ *   +noirq              Omit the "[IRQ]" trap lines
+ */
+
+// Value of "+name=value" (or "+name" for flags, returned as "1"); empty when absent
+static std::string plusArg(int argc, char **argv, const std::string &name) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, name.size() + 1, "+" + name) != 0) continue;
+        if (arg.size() == name.size() + 1) return "1";
+        if (arg[name.size() + 1] == '=') return arg.substr(name.size() + 2);
+    }
+    return "";
+}
+
+int main(int argc, char **argv) {
+    std::string elfPath    = plusArg(argc, argv, "elf");
+    std::string cyclesArg  = plusArg(argc, argv, "max-cycles");
+    std::string reportPath = plusArg(argc, argv, "report");
+    std::string latencyArg = plusArg(argc, argv, "ram-latency");
+    std::string timerArg   = plusArg(argc, argv, "timer-limit");
+    if (elfPath.empty()) elfPath = "firmware/firmware.elf";
+
+    // soc_top_tb's default budget is 1,000,000 ticks of 16 per CPU cycle
+    const uint64_t maxCycles = !cyclesArg.empty() ? std::stoull(cyclesArg) : 1000000 / 16;
+
+    SocPlatform platform;
+    platform.useDataCache    = plusArg(argc, argv, "flat-ram").empty();
+    platform.useFpu          = plusArg(argc, argv, "nofpu").empty();
+    platform.traceInterrupts = plusArg(argc, argv, "noirq").empty();
+    if (!latencyArg.empty()) platform.ramLatencyCycles = std::stoul(latencyArg);
+    if (!timerArg.empty())   platform.timerLimit       = std::stoul(timerArg);
+
+    uint32_t bytesLoaded = 0;
+    if (!platform.loadElf(elfPath, bytesLoaded)) {
+        std::cout << "[SYS] Cannot load ELF: " << elfPath << std::endl;
+        return 1;
+    }
+
+    // Same console path as the RTL run: UART bytes through the deferred-log decoder
+    LogDecoder logDecoder;
+    if (!logDecoder.loadElf(elfPath)) {
+        std::cout << "[SYS] No .logstr in " << elfPath << "; deferred logs shown as raw tokens" << std::endl;
+    }
+    platform.consoleByte = [&](uint8_t byte) { logDecoder.feed(byte, std::cout); };
+    platform.benchReport = [&](uint32_t address) {
+        BenchReport report = BenchReport::read(platform, address);
+        report.print();
+        if (!reportPath.empty()) report.append(reportPath, elfPath);
+    };
+
+    std::cout << "\033[1;32m[SYS] Initializing RV32I SoC Virtual Platform...\033[0m" << std::endl;
+    std::cout << "[SYS] ELF: " << elfPath << " (" << bytesLoaded << " bytes loaded)" << std::endl;
+    std::cout << "---------------------------------------------" << std::endl;
+
+    auto hostStart = std::chrono::steady_clock::now();
+    platform.run(maxCycles);
+    double hostSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+    std::cout << std::flush;
+
+    std::cout << "\n---------------------------------------------" << std::endl;
+    uint64_t accesses = platform.dcacheHits + platform.dcacheMisses;
+    std::cout << "[PERF] D-Cache (model)    accesses: " << std::dec << std::setw(8) << accesses
+              << " | hit rate: " << std::fixed << std::setprecision(2) << std::setw(6)
+              << (accesses ? 100.0 * platform.dcacheHits / accesses : 0.0) << "%"
+              << " | writebacks: " << std::setw(6) << platform.dcacheWritebacks
+              << " | stall cycles: " << std::setw(8) << platform.dcacheStalls << std::endl;
+    if (logDecoder.frames()) {
+        std::cout << "[PERF] Deferred log: " << logDecoder.frames() << " frames, "
+                  << logDecoder.frameBytesReceived() << " UART bytes" << std::endl;
+    }
+    if (platform.semihostBytes) {
+        std::cout << "[PERF] Semihost console: " << platform.semihostBytes << " bytes" << std::endl;
+    }
+    std::cout << "[PERF] Virtual platform: " << platform.instret << " instructions, " << platform.cycles
+              << " CPU cycles in " << std::setprecision(3) << hostSeconds << " s ("
+              << std::setprecision(1) << (hostSeconds > 0 ? platform.instret / hostSeconds / 1e6 : 0.0)
+              << " MIPS) | blocks translated: " << platform.blocksTranslated << std::endl;
+    std::cout << "\033[1;32m[SYS] Simulation Terminated Successfully.\033[0m" << std::endl;
+
+    // Same status as soc_top_tb: the firmware's exit code, 2 for a benchmark that never exits
+    if (platform.exitCode < 0 && !reportPath.empty()) {
+        std::cout << "[FAIL] No semihost exit within the cycle budget" << std::endl;
+        return 2;
+    }
+    return platform.exitCode < 0 ? 0 : platform.exitCode;
+}
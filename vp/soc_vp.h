@@ -0,0 +1,924 @@
+#ifndef SOC_VP_H
+#define SOC_VP_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "rv32c_expand.h"
+#include "rv32f_model.h"
+
+/**
+ * @brief Instruction-level model of soc_top for firmware development (driver: vp/soc_vp.cpp).
+ * It has the same memory map, MMIO registers, trap rules and peripherals as the RTL.
+ * Timing is approximate: one cycle per instruction, plus stalls for D-cache misses, sub-word
+ * stores, multi-cycle FPU operations and a full UART FIFO.
+ * Code runs from a cache of decoded basic blocks, so each instruction is decoded once
+ * (RV32C instructions are expanded to their 32-bit form at translation).
+ * Interrupts are taken between blocks.
+ * Only hart 0 is modelled: HART_START is ignored, so SMP firmware runs every task on hart 0.
+ */
+class SocPlatform {
+public:
+    // --- 1. MEMORY MAP (bus_interconnect: address bit 30 selects MMIO, bit 29 RAM, else ROM) ---
+    static const uint32_t ROM_BYTES      = 0x8000;     // inst_mem: 16KB boot ROM + 16KB program RAM
+    static const uint32_t RAM_BYTES      = 0x1000;     // ram_backend / data_mem
+    static const uint32_t PROGRAM_RAM    = 0x00004000; // Writable through LOAD_ADDR/LOAD_DATA
+
+    static const uint32_t UART_TX        = 0x40000000;
+    static const uint32_t UART_STATUS    = 0x40000004;
+    static const uint32_t UART_CTRL      = 0x40000008;
+    static const uint32_t UART_RX        = 0x4000000C;
+    static const uint32_t CSR_MEPC       = 0x40000010;
+    static const uint32_t CSR_MCAUSE     = 0x40000014;
+    static const uint32_t CSR_MTVEC      = 0x40000018;
+    static const uint32_t HART_ID        = 0x4000001C;
+    static const uint32_t PERF_CYCLES    = 0x40000020;
+    static const uint32_t PERF_INSTRET   = 0x40000024;
+    static const uint32_t FCSR           = 0x40000028; // {frm, fflags}
+    static const uint32_t FP_STATUS      = 0x4000002C; // Bit 0: FP state dirty
+    static const uint32_t MSIP0          = 0x40000030;
+    static const uint32_t MSIP1          = 0x40000034;
+    static const uint32_t HART_LOCK      = 0x40000040;
+    static const uint32_t HART_START     = 0x40000044;
+    static const uint32_t BUS_CONTENTION = 0x40000048;
+    static const uint32_t DMA_BASE       = 0x40000100;
+    static const uint32_t LOAD_ADDR      = 0x40000200;
+    static const uint32_t LOAD_DATA      = 0x40000204;
+    static const uint32_t BOOT_STRAP     = 0x40000208;
+    static const uint32_t SEMI_ARG0      = 0x40000300;
+    static const uint32_t SEMI_ARG1      = 0x40000304;
+    static const uint32_t SEMI_CALL      = 0x40000308;
+    static const uint32_t SEMI_RESULT    = 0x4000030C;
+
+    static const uint32_t CAUSE_SOFTWARE = 0x80000003;
+    static const uint32_t CAUSE_TIMER    = 0x80000007;
+    static const uint32_t CAUSE_EXTERNAL = 0x8000000B;
+    static const uint32_t CAUSE_ILLEGAL  = 0x00000002;
+    static const uint32_t CAUSE_ECALL    = 0x0000000B;
+
+    // --- 2. TIMING (soc_top defaults) ---
+    static const uint32_t UART_BYTE_CYCLES = 10 * 108; // 8N1 frame at clocksPerBit = 108
+    static const uint32_t UART_FIFO_DEPTH = 16;
+    static const uint32_t DCACHE_LINES    = 16;       // Direct-mapped, 4 words per line
+
+    uint32_t ramLatencyCycles = 8;     // Per line transfer (soc_top ramLatencyCycles)
+    uint32_t timerLimit       = 10000; // timerCount runs 0..timerLimit (soc_top timerLimit input)
+    bool     useDataCache     = true;  // false: flat RAM, no miss stalls (useDataCache = 0)
+    bool     useFpu           = true;  // false: FP opcodes trap as illegal instructions (useFpu = 0)
+
+    // UART bytes (through the driver's deferred-log decoder) and benchmark reports go to the
+    // driver. Semihost writes and the model's own messages bypass the decoder, as in soc_top_tb,
+    // so a message printed mid-frame is never taken as frame payload.
+    std::function<void(uint8_t)>  consoleByte;
+    std::function<void(const std::string &)> hostText = [](const std::string &text) { std::cout << text << std::flush; };
+    std::function<void(uint32_t)> benchReport; // Address of a bench_result_t
+    bool traceInterrupts = true;              // "[IRQ]" lines in soc_top_tb's format
+
+    SocPlatform() : rom(ROM_BYTES, 0), ram(RAM_BYTES, 0), blocks(ROM_BYTES / 2) {
+        for (uint32_t &tag : lineTag) tag = INVALID_TAG;
+    }
+
+    // Loads the PT_LOAD segments of an ELF32 image at their physical (load) addresses, as
+    // objcopy does for the ROM image; .data is copied to RAM by the firmware, not by the loader
+    bool loadElf(const std::string &path, uint32_t &bytesLoaded) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::vector<uint8_t> elf((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (elf.size() < 52 || memcmp(elf.data(), "\x7f" "ELF", 4) != 0 || elf[4] != 1) return false;
+
+        uint32_t headerOffset = read32(elf, 28);
+        uint16_t headerSize   = read16(elf, 42);
+        uint16_t headerCount  = read16(elf, 44);
+        if (headerOffset + (size_t)headerCount * headerSize > elf.size()) return false;
+
+        bytesLoaded = 0;
+        for (uint16_t i = 0; i < headerCount; i++) {
+            size_t header = headerOffset + (size_t)i * headerSize;
+            if (read32(elf, header) != 1) continue; // PT_LOAD
+            uint32_t offset   = read32(elf, header + 4);
+            uint32_t address  = read32(elf, header + 12);
+            uint32_t fileSize = read32(elf, header + 16);
+            if (offset + (size_t)fileSize > elf.size()) return false;
+            for (uint32_t b = 0; b < fileSize; b++) pokeByte(address + b, elf[offset + b]);
+            bytesLoaded += fileSize;
+        }
+        flushBlocks();
+        return bytesLoaded != 0;
+    }
+
+    // Runs until semihost exit or until 'maxCycles' CPU cycles have elapsed. Blocks run back to
+    // back until the next timed event (timer period, UART frame, DMA step) or until an MMIO access
+    // or MRET may have changed what is pending.
+    void run(uint64_t maxCycles) {
+        if (!nextTimerCycle) nextTimerCycle = (uint64_t)timerLimit + 1;
+        while (exitCode < 0 && cycles < maxCycles) {
+            sync();
+            uint64_t until = std::min(maxCycles, nextEventCycle());
+            syncRequest = false;
+            do {
+                pc = execute(lookupBlock(pc));
+            } while (cycles < until && !syncRequest);
+        }
+    }
+
+    // Raw image at 'address' (ROM/program RAM or RAM), e.g. a generated test program
+    void loadImage(const std::vector<uint8_t> &image, uint32_t address = 0) {
+        for (size_t i = 0; i < image.size(); i++) pokeByte(address + (uint32_t)i, image[i]);
+        flushBlocks();
+    }
+
+    // Architectural register (differential testing)
+    uint32_t reg(uint32_t index) const { return regs[index & 0x1F]; }
+    uint32_t freg(uint32_t index) const { return fregs[index & 0x1F]; }
+    uint32_t fcsrValue() const { return fcsr; }
+
+    // Backdoor view of target memory (semihost buffers, BenchReport)
+    uint32_t word(uint32_t address) const {
+        address &= ~3u;
+        uint32_t value;
+        if (address & 0x40000000) return 0;
+        if (address & 0x20000000) memcpy(&value, &ram[address & (RAM_BYTES - 1)], 4);
+        else                      memcpy(&value, &rom[address & (ROM_BYTES - 1)], 4);
+        return value;
+    }
+
+    uint8_t byte(uint32_t address) const { return (word(address) >> (8 * (address & 3))) & 0xFF; }
+
+    std::string string(uint32_t address, size_t maxLength = 64) const {
+        std::string text;
+        for (char c; text.size() < maxLength && (c = (char)byte(address + text.size())); ) text += c;
+        return text;
+    }
+
+    int      exitCode = -1;
+    uint64_t cycles   = 0;
+    uint64_t instret  = 0;
+    uint64_t semihostBytes = 0;
+
+    // Model statistics
+    uint64_t blocksTranslated = 0, blockFlushes = 0;
+    uint64_t dcacheHits = 0, dcacheMisses = 0, dcacheWritebacks = 0, dcacheStalls = 0;
+
+private:
+    // --- 3. DECODED INSTRUCTIONS ---
+    // rd 0 is remapped to a scratch register (regs[32]) so no operation has to test for x0
+    enum OpKind : uint8_t {
+        OP_ADD, OP_SUB, OP_AND, OP_OR, OP_XOR, OP_SLT, OP_SLTU, OP_SLL, OP_SRL, OP_SRA,
+        OP_ADDI, OP_ANDI, OP_ORI, OP_XORI, OP_SLTI, OP_SLTIU, OP_SLLI, OP_SRLI, OP_SRAI,
+        OP_LI,                                   // LUI/AUIPC: the PC is folded in at translation
+        OP_SH1ADD, OP_SH2ADD, OP_SH3ADD,         // Zba
+        OP_ANDN, OP_ORN, OP_XNOR, OP_MIN, OP_MAX, OP_MINU, OP_MAXU, OP_ROL, OP_ROR, OP_RORI, // Zbb
+        OP_CLZ, OP_CTZ, OP_CPOP, OP_SEXTB, OP_SEXTH, OP_ZEXTH, OP_ORCB, OP_REV8,
+        OP_LB, OP_LH, OP_LW, OP_LBU, OP_LHU,
+        OP_SB, OP_SH, OP_SW,
+        OP_LR, OP_SC, OP_AMO,                    // RV32A (AMO: funct5 in imm)
+        OP_FLW, OP_FSW,
+        OP_FP, OP_FPX,                           // RV32F compute to f[rd] / x[rd] (imm: the instruction)
+        OP_NOP,                                  // FENCE, CSR encodings: NOPs on this core
+        // Block terminators
+        OP_JAL, OP_JALR, OP_BEQ, OP_BNE, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU, OP_ECALL, OP_ILLEGAL, OP_MRET
+    };
+
+    struct Op {
+        uint8_t  kind, rd, rs1, rs2;
+        uint32_t imm;  // Immediate, or the branch/jump target
+        uint32_t pc;
+        uint32_t next; // Sequential PC: pc + 2 (compressed) or pc + 4
+    };
+
+    static const uint32_t MAX_BLOCK_OPS = 32; // Bounds interrupt latency inside straight-line code
+    static const uint32_t INVALID_PC    = 0xFFFFFFFF;
+    static const uint32_t INVALID_TAG   = 0xFFFFFFFF;
+
+    struct Block {
+        uint32_t pc    = INVALID_PC;
+        uint32_t count = 0;
+        Op       ops[MAX_BLOCK_OPS];
+    };
+
+    std::vector<uint8_t> rom, ram;
+    std::vector<Block>   blocks; // Indexed by PC[14:1]: the fetch port aliases every 32KB
+    bool                 blocksStale = false;
+    bool                 syncRequest = false;
+
+    uint32_t regs[33] = {};
+    uint32_t pc = 0;
+
+    // FP state (fp_regfile, FCSR and FP_STATUS in cpu_core)
+    uint32_t fregs[32] = {};
+    uint32_t fcsr = 0;
+    bool     fpDirty = false;
+    uint64_t fpReadyAt[32] = {}; // Cycle from which each f register can be read (fpu.sv hazards)
+    uint64_t fpDrainAt     = 0;  // Cycle the FPU pipeline is empty again
+
+    // Trap state (csr_unit)
+    uint32_t mepc = 0, mcause = 0, mtvec = 0x10;
+    bool     trapActive = false, timerPending = false, externalPending = false;
+    bool     msip[2] = {}, hartLock = false; // SMP control registers
+    bool     reservationValid = false;       // LR.W reservation (RAM word offset)
+    uint32_t reservationOffset = 0;
+    uint64_t nextTimerCycle = 0; // First period starts at run()
+
+    // D-cache tags (write-back, write-allocate): timing only, data lives in 'ram'
+    uint32_t lineTag[DCACHE_LINES];
+    uint32_t lineDirty = 0;
+
+    // UART: TX FIFO level and the cycle the transmitter finishes its current frame
+    uint32_t uartTxLevel = 0, uartTxThreshold = 1;
+    uint64_t uartTxFreeAt = 0;
+    bool     uartTxIrqEnable = false, uartRxIrqEnable = false, uartTxIrqLast = false;
+
+    // DMA channel (dma_controller)
+    enum { DMA_IDLE, DMA_FETCH, DMA_READ, DMA_WRITE, DMA_FINISH };
+    uint32_t dmaState = DMA_IDLE, dmaSource = 0, dmaDestination = 0, dmaNext = 0, dmaFetchAddress = 0;
+    uint32_t dmaBuffer = 0, dmaCount = 0, dmaRemaining = 0, dmaMode = 0, dmaFetchIndex = 0;
+    bool     dmaIrqEnable = false, dmaIrqFlag = false;
+    uint64_t dmaTime = 0; // Cycle of the engine's next step
+
+    uint32_t loadAddress = PROGRAM_RAM;
+    uint32_t semihostArg0 = 0, semihostArg1 = 0, semihostResult = 0;
+    std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+    // Timer request, peripheral progress and interrupt entry, at a block boundary
+    void sync() {
+        if (cycles >= nextTimerCycle) {
+            timerPending = true; // One latched request, however many periods have passed
+            while (nextTimerCycle <= cycles) nextTimerCycle += (uint64_t)timerLimit + 1;
+        }
+        if (dmaState != DMA_IDLE || uartTxLevel) advancePeripherals();
+        if (blocksStale) flushBlocks();
+        if (!trapActive && (timerPending || msip[0] || externalPending)) takeInterrupt();
+    }
+
+    uint64_t nextEventCycle() const {
+        uint64_t next = nextTimerCycle;
+        if (uartTxLevel)          next = std::min(next, uartTxFreeAt);
+        if (dmaState != DMA_IDLE) next = std::min(next, dmaTime);
+        return next;
+    }
+
+    // --- 4. BASIC-BLOCK TRANSLATION ---
+    Block &lookupBlock(uint32_t blockPc) {
+        Block &block = blocks[(blockPc >> 1) & (ROM_BYTES / 2 - 1)];
+        if (block.pc != blockPc) translate(block, blockPc);
+        return block;
+    }
+
+    void flushBlocks() {
+        for (Block &block : blocks) block.pc = INVALID_PC;
+        blocksStale = false;
+        blockFlushes++;
+    }
+
+    void translate(Block &block, uint32_t blockPc) {
+        block.pc    = blockPc;
+        block.count = 0;
+        for (uint32_t at = blockPc; block.count < MAX_BLOCK_OPS; at = block.ops[block.count - 1].next) {
+            Op &op = block.ops[block.count++];
+            uint32_t insn = fetch(at);
+            if (Rv32cExpander::isCompressed(insn)) decode(Rv32cExpander::expand((uint16_t)insn), at, at + 2, op);
+            else                                   decode(insn, at, at + 4, op);
+            if (!useFpu && op.kind >= OP_FLW && op.kind <= OP_FPX) op.kind = OP_ILLEGAL;
+            if (op.kind >= OP_JAL) break;
+        }
+        blocksTranslated++;
+    }
+
+    // The 32 bits at a halfword-aligned PC, like inst_mem's fetch ports (a 32-bit instruction
+    // may straddle two words)
+    uint32_t fetch(uint32_t at) const {
+        uint16_t low, high;
+        memcpy(&low,  &rom[at & (ROM_BYTES - 2)], 2);
+        memcpy(&high, &rom[(at + 2) & (ROM_BYTES - 2)], 2);
+        return ((uint32_t)high << 16) | low;
+    }
+
+    // Decodes like controller.sv: unknown opcodes and SYSTEM encodings other than MRET/ECALL
+    // are NOPs, R-type ops use only funct7[5] unless funct7 names a Zba/Zbb op, loads with
+    // funct3 011/11x return the whole word. FP ops keep rd as is: f0 is a real register.
+    static void decode(uint32_t insn, uint32_t at, uint32_t next, Op &op) {
+        uint32_t opcode = insn & 0x7F, funct3 = (insn >> 12) & 7, funct7 = insn >> 25;
+        uint32_t rd = (insn >> 7) & 0x1F;
+        op.rd   = rd ? rd : 32;
+        op.rs1  = (insn >> 15) & 0x1F;
+        op.rs2  = (insn >> 20) & 0x1F;
+        op.pc   = at;
+        op.next = next;
+        op.imm  = (uint32_t)((int32_t)insn >> 20); // I-type
+        op.kind = OP_NOP;
+
+        switch (opcode) {
+            case 0x33: { // R-type
+                static const uint8_t kinds[8] = { OP_ADD, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_OR, OP_AND };
+                op.kind = kinds[funct3];
+                if ((funct7 & 0x20) && funct3 == 0) op.kind = OP_SUB;
+                if ((funct7 & 0x20) && funct3 == 5) op.kind = OP_SRA;
+                switch ((funct7 << 3) | funct3) { // Zba/Zbb: whole funct7, like controller.sv
+                    case 0x10 << 3 | 2: op.kind = OP_SH1ADD; break;
+                    case 0x10 << 3 | 4: op.kind = OP_SH2ADD; break;
+                    case 0x10 << 3 | 6: op.kind = OP_SH3ADD; break;
+                    case 0x20 << 3 | 7: op.kind = OP_ANDN;   break;
+                    case 0x20 << 3 | 6: op.kind = OP_ORN;    break;
+                    case 0x20 << 3 | 4: op.kind = OP_XNOR;   break;
+                    case 0x05 << 3 | 4: op.kind = OP_MIN;    break;
+                    case 0x05 << 3 | 6: op.kind = OP_MAX;    break;
+                    case 0x05 << 3 | 5: op.kind = OP_MINU;   break;
+                    case 0x05 << 3 | 7: op.kind = OP_MAXU;   break;
+                    case 0x30 << 3 | 1: op.kind = OP_ROL;    break;
+                    case 0x30 << 3 | 5: op.kind = OP_ROR;    break;
+                    case 0x04 << 3 | 4: if (op.rs2 == 0) op.kind = OP_ZEXTH; break;
+                    default: break;
+                }
+                break;
+            }
+            case 0x13: { // I-type
+                static const uint8_t kinds[8] = { OP_ADDI, OP_SLLI, OP_SLTI, OP_SLTIU, OP_XORI, OP_SRLI, OP_ORI, OP_ANDI };
+                op.kind = kinds[funct3];
+                if (funct3 == 5 && (funct7 & 0x20)) op.kind = OP_SRAI;
+                if (funct3 == 1 || funct3 == 5) op.imm &= 0x1F;
+                if (funct3 == 1 && funct7 == 0x30) { // Unary Zbb ops: the operation is in rs2
+                    static const uint8_t unary[8] = { OP_CLZ, OP_CTZ, OP_CPOP, OP_SLLI, OP_SEXTB, OP_SEXTH, OP_SLLI, OP_SLLI };
+                    if (op.rs2 < 8) op.kind = unary[op.rs2];
+                }
+                if (funct3 == 5 && funct7 == 0x30)                  op.kind = OP_RORI;
+                if (funct3 == 5 && funct7 == 0x14 && op.rs2 == 7)   op.kind = OP_ORCB;
+                if (funct3 == 5 && funct7 == 0x34 && op.rs2 == 24)  op.kind = OP_REV8;
+                break;
+            }
+            case 0x03: { // Loads
+                static const uint8_t kinds[8] = { OP_LB, OP_LH, OP_LW, OP_LW, OP_LBU, OP_LHU, OP_LW, OP_LW };
+                op.kind = kinds[funct3];
+                break;
+            }
+            case 0x23: // Stores: funct3[1:0] 00 byte, 10 word, otherwise half
+                op.kind = ((funct3 & 3) == 0) ? OP_SB : ((funct3 & 3) == 2) ? OP_SW : OP_SH;
+                op.imm  = (uint32_t)(((int32_t)insn >> 25) << 5) | ((insn >> 7) & 0x1F);
+                break;
+            case 0x07: // FLW
+                if (Rv32fModel::isLoad(insn)) op.kind = OP_FLW, op.rd = rd;
+                break;
+            case 0x27: // FSW
+                if (Rv32fModel::isStore(insn)) op.kind = OP_FSW;
+                op.imm = (uint32_t)(((int32_t)insn >> 25) << 5) | ((insn >> 7) & 0x1F);
+                break;
+            case 0x53: case 0x43: case 0x47: case 0x4B: case 0x4F: // OP-FP, FMADD/FMSUB/FNMSUB/FNMADD
+                if (!Rv32fModel::isCompute(insn)) break;
+                op.kind = Rv32fModel::writesInteger(insn) ? OP_FPX : OP_FP;
+                if (op.kind == OP_FP) op.rd = rd;
+                op.imm  = insn;
+                break;
+            case 0x63: { // Branches (funct3 010/011 never taken)
+                static const uint8_t kinds[8] = { OP_BEQ, OP_BNE, OP_NOP, OP_NOP, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU };
+                int32_t offset = (((int32_t)insn >> 31) << 12) | ((insn & 0x80) << 4) | ((insn >> 20) & 0x7E0) |
+                                 ((insn >> 7) & 0x1E);
+                op.kind = kinds[funct3];
+                op.imm  = at + offset;
+                if (op.kind == OP_NOP) op.kind = OP_BEQ, op.rs1 = op.rs2 = 0, op.imm = next;
+                break;
+            }
+            case 0x37: op.kind = OP_LI; op.imm = insn & 0xFFFFF000; break;        // LUI
+            case 0x17: op.kind = OP_LI; op.imm = at + (insn & 0xFFFFF000); break; // AUIPC
+            case 0x6F: { // JAL
+                int32_t offset = (((int32_t)insn >> 31) << 20) | (insn & 0xFF000) | ((insn >> 9) & 0x800) |
+                                 ((insn >> 20) & 0x7FE);
+                op.kind = OP_JAL;
+                op.imm  = at + offset;
+                break;
+            }
+            case 0x67: op.kind = OP_JALR; break;
+            case 0x2F: // AMO (word only; address is rs1)
+                if (funct3 != 2) break;
+                op.imm  = insn >> 27;
+                op.kind = (op.imm == 0x02) ? OP_LR : (op.imm == 0x03) ? OP_SC : OP_AMO;
+                break;
+            case 0x73: // SYSTEM
+                if (funct3 == 0 && funct7 == 0x18)   op.kind = OP_MRET;
+                else if (funct3 == 0 && funct7 == 0 && ((insn >> 20) & 31) == 0) op.kind = OP_ECALL; // EBREAK: NOP
+                break;
+            default: break;
+        }
+    }
+
+    // Holds op 'i' of the block until cycle 'ready' ('cycles' is already at the block's end)
+    void fpWait(const Block &block, uint32_t i, uint64_t ready) {
+        uint64_t issue = cycles - block.count + i;
+        if (ready > issue) cycles += ready - issue;
+    }
+
+    // --- 5. EXECUTION ---
+    // Runs one block and returns the next PC. Every op of a block executes (terminators are
+    // last), so the block's cycles are counted on entry; MMIO sees the cycle count at block end.
+    uint32_t execute(const Block &block) {
+        uint32_t *x = regs;
+        cycles  += block.count;
+        instret += block.count;
+        for (uint32_t i = 0; i < block.count; i++) {
+            const Op &op = block.ops[i];
+            switch (op.kind) {
+                case OP_ADD:   x[op.rd] = x[op.rs1] + x[op.rs2]; break;
+                case OP_SUB:   x[op.rd] = x[op.rs1] - x[op.rs2]; break;
+                case OP_AND:   x[op.rd] = x[op.rs1] & x[op.rs2]; break;
+                case OP_OR:    x[op.rd] = x[op.rs1] | x[op.rs2]; break;
+                case OP_XOR:   x[op.rd] = x[op.rs1] ^ x[op.rs2]; break;
+                case OP_SLT:   x[op.rd] = (int32_t)x[op.rs1] < (int32_t)x[op.rs2]; break;
+                case OP_SLTU:  x[op.rd] = x[op.rs1] < x[op.rs2]; break;
+                case OP_SLL:   x[op.rd] = x[op.rs1] << (x[op.rs2] & 0x1F); break;
+                case OP_SRL:   x[op.rd] = x[op.rs1] >> (x[op.rs2] & 0x1F); break;
+                case OP_SRA:   x[op.rd] = (uint32_t)((int32_t)x[op.rs1] >> (x[op.rs2] & 0x1F)); break;
+                case OP_ADDI:  x[op.rd] = x[op.rs1] + op.imm; break;
+                case OP_ANDI:  x[op.rd] = x[op.rs1] & op.imm; break;
+                case OP_ORI:   x[op.rd] = x[op.rs1] | op.imm; break;
+                case OP_XORI:  x[op.rd] = x[op.rs1] ^ op.imm; break;
+                case OP_SLTI:  x[op.rd] = (int32_t)x[op.rs1] < (int32_t)op.imm; break;
+                case OP_SLTIU: x[op.rd] = x[op.rs1] < op.imm; break;
+                case OP_SLLI:  x[op.rd] = x[op.rs1] << op.imm; break;
+                case OP_SRLI:  x[op.rd] = x[op.rs1] >> op.imm; break;
+                case OP_SRAI:  x[op.rd] = (uint32_t)((int32_t)x[op.rs1] >> op.imm); break;
+                case OP_LI:    x[op.rd] = op.imm; break;
+                case OP_SH1ADD: x[op.rd] = (x[op.rs1] << 1) + x[op.rs2]; break;
+                case OP_SH2ADD: x[op.rd] = (x[op.rs1] << 2) + x[op.rs2]; break;
+                case OP_SH3ADD: x[op.rd] = (x[op.rs1] << 3) + x[op.rs2]; break;
+                case OP_ANDN:  x[op.rd] = x[op.rs1] & ~x[op.rs2]; break;
+                case OP_ORN:   x[op.rd] = x[op.rs1] | ~x[op.rs2]; break;
+                case OP_XNOR:  x[op.rd] = ~(x[op.rs1] ^ x[op.rs2]); break;
+                case OP_MIN:   x[op.rd] = (int32_t)x[op.rs1] < (int32_t)x[op.rs2] ? x[op.rs1] : x[op.rs2]; break;
+                case OP_MAX:   x[op.rd] = (int32_t)x[op.rs1] < (int32_t)x[op.rs2] ? x[op.rs2] : x[op.rs1]; break;
+                case OP_MINU:  x[op.rd] = x[op.rs1] < x[op.rs2] ? x[op.rs1] : x[op.rs2]; break;
+                case OP_MAXU:  x[op.rd] = x[op.rs1] < x[op.rs2] ? x[op.rs2] : x[op.rs1]; break;
+                case OP_ROL:   x[op.rd] = rotateLeft(x[op.rs1], x[op.rs2]); break;
+                case OP_ROR:   x[op.rd] = rotateLeft(x[op.rs1], 32 - (x[op.rs2] & 0x1F)); break;
+                case OP_RORI:  x[op.rd] = rotateLeft(x[op.rs1], 32 - op.imm); break;
+                case OP_CLZ:   x[op.rd] = x[op.rs1] ? __builtin_clz(x[op.rs1]) : 32; break;
+                case OP_CTZ:   x[op.rd] = x[op.rs1] ? __builtin_ctz(x[op.rs1]) : 32; break;
+                case OP_CPOP:  x[op.rd] = __builtin_popcount(x[op.rs1]); break;
+                case OP_SEXTB: x[op.rd] = (uint32_t)(int8_t)x[op.rs1]; break;
+                case OP_SEXTH: x[op.rd] = (uint32_t)(int16_t)x[op.rs1]; break;
+                case OP_ZEXTH: x[op.rd] = x[op.rs1] & 0xFFFF; break;
+                case OP_ORCB: {
+                    uint32_t value = x[op.rs1], result = 0;
+                    for (int shift = 0; shift < 32; shift += 8) if ((value >> shift) & 0xFF) result |= 0xFFu << shift;
+                    x[op.rd] = result;
+                    break;
+                }
+                case OP_REV8:  x[op.rd] = __builtin_bswap32(x[op.rs1]); break;
+                case OP_LB:    x[op.rd] = (uint32_t)(int8_t)loadByte(x[op.rs1] + op.imm); break;
+                case OP_LBU:   x[op.rd] = loadByte(x[op.rs1] + op.imm); break;
+                case OP_LH:    x[op.rd] = (uint32_t)(int16_t)loadHalf(x[op.rs1] + op.imm); break;
+                case OP_LHU:   x[op.rd] = loadHalf(x[op.rs1] + op.imm); break;
+                case OP_LW:    x[op.rd] = load(x[op.rs1] + op.imm); break;
+                case OP_SB:    store(x[op.rs1] + op.imm, x[op.rs2], 1); break;
+                case OP_SH:    store(x[op.rs1] + op.imm, x[op.rs2], 2); break;
+                case OP_SW:    store(x[op.rs1] + op.imm, x[op.rs2], 4); break;
+                case OP_LR: {
+                    uint32_t address  = x[op.rs1];
+                    x[op.rd]          = load(address);
+                    reservationValid  = (address & 0x60000000) == 0x20000000;
+                    reservationOffset = address & (RAM_BYTES - 4);
+                    break;
+                }
+                case OP_SC: { // No other master runs inside a block: only a store since the LR breaks it
+                    uint32_t address = x[op.rs1], value = x[op.rs2];
+                    bool     held    = reservationValid && (address & 0x60000000) == 0x20000000 &&
+                                       reservationOffset == (address & (RAM_BYTES - 4));
+                    reservationValid = false;
+                    if (held) store(address, value, 4);
+                    x[op.rd] = !held;
+                    break;
+                }
+                case OP_AMO: {
+                    uint32_t address = x[op.rs1], operand = x[op.rs2], old = load(address);
+                    store(address, amo(op.imm, old, operand), 4);
+                    cycles++; // Read and write phases
+                    x[op.rd] = old;
+                    break;
+                }
+                case OP_FLW:
+                    fpWait(block, i, fpReadyAt[op.rd]);
+                    fregs[op.rd] = load(x[op.rs1] + op.imm);
+                    fpDirty      = true;
+                    break;
+                case OP_FSW:
+                    fpWait(block, i, fpReadyAt[op.rs2]);
+                    store(x[op.rs1] + op.imm, fregs[op.rs2], 4);
+                    break;
+                case OP_FP:
+                case OP_FPX: { // Held for register hazards and the FPU's latency; flags accumulate in FCSR
+                    uint32_t insn = op.imm, rs3 = insn >> 27, flags;
+                    uint64_t ready = 0;
+                    if (Rv32fModel::readsRs1(insn))       ready = std::max(ready, fpReadyAt[op.rs1]);
+                    if (Rv32fModel::readsRs2(insn))       ready = std::max(ready, fpReadyAt[op.rs2]);
+                    if (Rv32fModel::readsRs3(insn))       ready = std::max(ready, fpReadyAt[rs3]);
+                    if (Rv32fModel::writesInDecode(insn)) ready = std::max(ready, fpReadyAt[op.rd]);
+                    if (Rv32fModel::cycles(insn) == Rv32fModel::ITERATIVE_CYCLES) ready = std::max(ready, fpDrainAt);
+                    fpWait(block, i, ready);
+                    uint32_t value = Rv32fModel::execute(insn, fregs[op.rs1], fregs[op.rs2], fregs[rs3], x[op.rs1],
+                                                         fcsr >> 5, flags);
+                    if (Rv32fModel::isPipelined(insn)) {
+                        fpReadyAt[op.rd] = fpDrainAt = cycles - block.count + i + Rv32fModel::PIPELINE_CYCLES;
+                    } else {
+                        cycles += Rv32fModel::cycles(insn) - 1;
+                    }
+                    fcsr   |= flags;
+                    if (op.kind == OP_FP) fregs[op.rd] = value;
+                    else                  x[op.rd] = value;
+                    if (op.kind == OP_FP || flags) fpDirty = true;
+                    break;
+                }
+                case OP_NOP:   break;
+                case OP_JAL:   x[op.rd] = op.next; return op.imm;
+                case OP_JALR: {
+                    uint32_t target = (x[op.rs1] + op.imm) & ~1u;
+                    x[op.rd] = op.next;
+                    return target;
+                }
+                case OP_BEQ:   return x[op.rs1] == x[op.rs2] ? op.imm : op.next;
+                case OP_BNE:   return x[op.rs1] != x[op.rs2] ? op.imm : op.next;
+                case OP_BLT:   return (int32_t)x[op.rs1] <  (int32_t)x[op.rs2] ? op.imm : op.next;
+                case OP_BGE:   return (int32_t)x[op.rs1] >= (int32_t)x[op.rs2] ? op.imm : op.next;
+                case OP_BLTU:  return x[op.rs1] <  x[op.rs2] ? op.imm : op.next;
+                case OP_BGEU:  return x[op.rs1] >= x[op.rs2] ? op.imm : op.next;
+                case OP_ECALL: // Traps retire nothing (perfInstret)
+                    instret--;
+                    enterTrap(CAUSE_ECALL, op.pc);
+                    return mtvec;
+                case OP_ILLEGAL: // RV32F instruction without the FPU (useFpu = 0)
+                    instret--;
+                    enterTrap(CAUSE_ILLEGAL, op.pc);
+                    return mtvec;
+                case OP_MRET:
+                    trapActive  = false;
+                    syncRequest = true; // A request held off by the handler can be taken now
+                    return mepc;
+            }
+        }
+        return block.ops[block.count - 1].next;
+    }
+
+    void enterTrap(uint32_t cause, uint32_t trapPc) {
+        mepc       = trapPc;
+        mcause     = cause;
+        trapActive = true;
+        reservationValid = false; // As in cpu_core: an SC after a trap fails
+    }
+
+    static uint32_t rotateLeft(uint32_t value, uint32_t amount) {
+        amount &= 0x1F;
+        return amount ? (value << amount) | (value >> (32 - amount)) : value;
+    }
+
+    static uint32_t amo(uint32_t funct5, uint32_t old, uint32_t operand) {
+        switch (funct5) {
+            case 0x01: return operand;                                                  // AMOSWAP
+            case 0x04: return old ^ operand;                                            // AMOXOR
+            case 0x08: return old | operand;                                            // AMOOR
+            case 0x0C: return old & operand;                                            // AMOAND
+            case 0x10: return (int32_t)old < (int32_t)operand ? old : operand;          // AMOMIN
+            case 0x14: return (int32_t)old < (int32_t)operand ? operand : old;          // AMOMAX
+            case 0x18: return old < operand ? old : operand;                            // AMOMINU
+            case 0x1C: return old < operand ? operand : old;                            // AMOMAXU
+            default:   return old + operand;                                            // AMOADD
+        }
+    }
+
+    // Timer, then software (MSIP level, cleared by the handler), then external; a latched
+    // request is consumed when the trap is taken
+    void takeInterrupt() {
+        bool timer = timerPending, software = !timer && msip[0];
+        if (traceInterrupts && !software) {
+            std::ostringstream line;
+            if (timer) {
+                line << "\n\033[1;33m[IRQ] Timer Trap at Cycle: " << std::dec << std::setw(6) << cycles
+                     << " | Vector PC: 0x" << std::hex << std::setw(8) << std::setfill('0') << pc << "\033[0m\n";
+            } else {
+                line << "\n\033[1;36m[IRQ] External (DMA/UART) at Cycle: " << std::dec << std::setw(6) << cycles
+                     << "\033[0m\n";
+            }
+            hostText(line.str());
+        }
+        if (timer)          timerPending = false;
+        else if (!software) externalPending = false;
+        enterTrap(timer ? CAUSE_TIMER : software ? CAUSE_SOFTWARE : CAUSE_EXTERNAL, pc);
+        pc = mtvec;
+    }
+
+    // --- 6. DATA ACCESS ---
+    uint32_t load(uint32_t address) {
+        if (address & 0x40000000) return mmioRead(address);
+        if (address & 0x20000000) dcacheAccess(address, false);
+        return word(address);
+    }
+
+    // Lane extraction as in soc_top (loadByte/loadHalf on the word the bus returns)
+    uint32_t loadByte(uint32_t address) { return (load(address) >> (8 * (address & 3))) & 0xFF; }
+    uint32_t loadHalf(uint32_t address) { return (load(address) >> (16 * ((address >> 1) & 1))) & 0xFFFF; }
+
+    void store(uint32_t address, uint32_t value, uint32_t size) {
+        if (address & 0x40000000) {
+            // MMIO takes the byte lanes directly: SB/SH replicate the data across the word
+            uint32_t lanes = (size == 1) ? (value & 0xFF) * 0x01010101u :
+                             (size == 2) ? (value & 0xFFFF) * 0x00010001u : value;
+            mmioWrite(address, lanes);
+            return;
+        }
+        if (!(address & 0x20000000)) return; // The ROM port is read-only
+        dcacheAccess(address, true);
+        if (size != 4) cycles++;             // Read phase of the sub-word read-modify-write
+        // As in cpu_core, the sub-word read reserves its word and the merged write consumes it
+        if (size != 4 || reservationOffset == (address & (RAM_BYTES - 4))) reservationValid = false;
+        uint32_t offset = (size == 4) ? (address & (RAM_BYTES - 4)) :
+                          (size == 2) ? (address & (RAM_BYTES - 2)) : (address & (RAM_BYTES - 1));
+        memcpy(&ram[offset], &value, size);
+    }
+
+    // Write-back, write-allocate timing: a miss waits for the line fill, after writing back a
+    // dirty victim. The write buffer that hides store misses in the RTL is not modelled.
+    void dcacheAccess(uint32_t address, bool write) {
+        if (!useDataCache) return;
+        uint32_t index = (address >> 4) & (DCACHE_LINES - 1);
+        uint32_t tag   = address >> 8;
+        if (lineTag[index] != tag) {
+            uint32_t stall = ramLatencyCycles;
+            if (lineTag[index] != INVALID_TAG && (lineDirty >> index) & 1) {
+                stall += ramLatencyCycles;
+                dcacheWritebacks++;
+            }
+            lineTag[index] = tag;
+            lineDirty &= ~(1u << index);
+            cycles       += stall;
+            dcacheStalls += stall;
+            dcacheMisses++;
+        } else {
+            dcacheHits++;
+        }
+        if (write) lineDirty |= 1u << index;
+    }
+
+    // Loader and ELF backdoor: ROM/program RAM or RAM, by address
+    void pokeByte(uint32_t address, uint8_t value) {
+        if (address & 0x20000000) ram[address & (RAM_BYTES - 1)] = value;
+        else                      rom[address & (ROM_BYTES - 1)] = value;
+    }
+
+    // --- 7. MMIO ---
+    uint32_t mmioRead(uint32_t address) {
+        advancePeripherals();
+        syncRequest = true;
+        switch (address) {
+            case UART_STATUS:
+                return (uartTxLevel << 8) | ((uartTxLevel == 0) << 2) | ((uartTxLevel == UART_FIFO_DEPTH) << 1) |
+                       (uint32_t)(uartTxFreeAt > cycles || uartTxLevel != 0);
+            case UART_CTRL:
+                return ((uint32_t)uartRxIrqEnable << 9) | ((uint32_t)uartTxIrqEnable << 8) | uartTxThreshold;
+            case UART_RX:      return 0; // No host on the serial line: RX stays empty
+            case CSR_MEPC:     return mepc;
+            case CSR_MCAUSE:   return mcause;
+            case CSR_MTVEC:    return mtvec;
+            case HART_ID:      return 0;
+            case MSIP0:        return msip[0];
+            case MSIP1:        return msip[1];
+            case HART_LOCK: {
+                bool taken = !hartLock;
+                hartLock   = true;
+                return taken;
+            }
+            case HART_START:   return 1; // Hart 0 only
+            case PERF_CYCLES:  return (uint32_t)cycles;
+            case PERF_INSTRET: return (uint32_t)instret;
+            case FCSR:         return fcsr;
+            case FP_STATUS:    return fpDirty;
+            case LOAD_ADDR:    return loadAddress;
+            case BOOT_STRAP:   return 0; // No serial host: the ROM application starts at once
+            case SEMI_RESULT:  return semihostResult;
+            default: break;
+        }
+        if ((address >> 8) == (DMA_BASE >> 8)) {
+            bool busy = dmaState != DMA_IDLE;
+            switch (address & 0xFF) {
+                case 0x00: return dmaSource;
+                case 0x04: return dmaDestination;
+                case 0x08: return ((uint32_t)busy << 31) | ((uint32_t)dmaIrqEnable << 18) | (dmaMode << 16) | dmaRemaining;
+                case 0x0C: return dmaNext;
+                case 0x10: return ((uint32_t)dmaIrqFlag << 1) | (uint32_t)busy;
+                case 0x14: return dmaCount;
+                default:   return 0;
+            }
+        }
+        return 0;
+    }
+
+    void mmioWrite(uint32_t address, uint32_t value) {
+        advancePeripherals();
+        syncRequest = true;
+        // The bus holds a UART store (wait states) until the FIFO has room
+        while (address == UART_TX && uartTxLevel == UART_FIFO_DEPTH) {
+            cycles = uartTxFreeAt;
+            advancePeripherals();
+        }
+        mmioRegisterWrite(address, value);
+    }
+
+    // Register side of a write from either bus master (the caller has handled UART back-pressure)
+    void mmioRegisterWrite(uint32_t address, uint32_t value) {
+        switch (address) {
+            case UART_TX:
+                uartPush((uint8_t)value);
+                break;
+            case UART_CTRL:
+                uartTxThreshold = value & 0xFF;
+                uartTxIrqEnable = (value >> 8) & 1;
+                uartRxIrqEnable = (value >> 9) & 1;
+                updateUartIrq();
+                break;
+            case CSR_MEPC:  mepc  = value; break;
+            case CSR_MTVEC: mtvec = value; break;
+            case FCSR:
+                if (useFpu) fcsr = value & 0xFF, fpDirty = true;
+                break;
+            case FP_STATUS:
+                if (useFpu) fpDirty = value & 1;
+                break;
+            case MSIP0:     msip[0]  = value & 1; break;
+            case MSIP1:     msip[1]  = value & 1; break;
+            case HART_LOCK: hartLock = false; break;
+            case LOAD_ADDR: loadAddress = value; break;
+            case LOAD_DATA:
+                if (loadAddress & PROGRAM_RAM) {
+                    memcpy(&rom[loadAddress & (ROM_BYTES - 4)], &value, 4);
+                    blocksStale = true; // Code changed under the block cache
+                }
+                loadAddress += 4;
+                break;
+            case SEMI_ARG0: semihostArg0 = value; break;
+            case SEMI_ARG1: semihostArg1 = value; break;
+            case SEMI_CALL: semihostCall(value); break;
+            default:
+                if ((address >> 8) == (DMA_BASE >> 8)) dmaRegisterWrite(address & 0xFF, value);
+                break;
+        }
+    }
+
+    // Same calls as soc_top_tb (firmware/semihost.h)
+    void semihostCall(uint32_t call) {
+        switch (call) {
+            case 1: { // WRITE(address, length)
+                std::string text;
+                for (uint32_t i = 0; i < semihostArg1; i++) text += (char)byte(semihostArg0 + i);
+                hostText(text);
+                semihostBytes += semihostArg1;
+                break;
+            }
+            case 2: { // EXIT(code)
+                exitCode = (int)(semihostArg0 & 0xFF);
+                std::ostringstream line;
+                line << "\n[SYS] Semihost exit (code " << std::dec << exitCode << ") at Cycle: " << cycles << "\n";
+                hostText(line.str());
+                break;
+            }
+            case 3: // CLOCK: host microseconds since start
+                semihostResult = (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - hostStart).count();
+                break;
+            case 4: // REPORT(result)
+                if (benchReport) benchReport(semihostArg0);
+                break;
+            default: {
+                std::ostringstream line;
+                line << "\n[SYS] Unknown semihost call " << std::dec << call << "\n";
+                hostText(line.str());
+                break;
+            }
+        }
+    }
+
+    // --- 8. PERIPHERALS ---
+    // Brings the UART transmitter and the DMA engine up to the current cycle
+    void advancePeripherals() {
+        while (dmaState != DMA_IDLE && dmaTime < cycles) {
+            advanceUart(dmaTime);
+            dmaStep();
+        }
+        advanceUart(cycles);
+    }
+
+    // The transmitter sends back to back while the FIFO holds bytes
+    void advanceUart(uint64_t now) {
+        while (uartTxLevel && uartTxFreeAt <= now) {
+            uartTxLevel--;
+            uartTxFreeAt += UART_BYTE_CYCLES;
+        }
+        updateUartIrq();
+    }
+
+    // Console text is taken at the FIFO push, where soc_top_tb's bus monitor sees it
+    void uartPush(uint8_t value) {
+        consoleByte(value);
+        if (uartTxLevel == 0 && uartTxFreeAt <= cycles) uartTxFreeAt = cycles + UART_BYTE_CYCLES;
+        else                                            uartTxLevel++;
+        updateUartIrq();
+    }
+
+    // TX threshold interrupt: the rising edge of (enabled && level < threshold) latches a request
+    void updateUartIrq() {
+        bool level = uartTxIrqEnable && uartTxLevel < uartTxThreshold;
+        if (level && !uartTxIrqLast) externalPending = true;
+        uartTxIrqLast = level;
+    }
+
+    void dmaRegisterWrite(uint32_t offset, uint32_t value) {
+        if (offset == 0x10 && (value & 2)) dmaIrqFlag = false;
+        if (dmaState != DMA_IDLE) return; // Channel registers are writable only while idle
+        switch (offset) {
+            case 0x00: dmaSource      = value; break;
+            case 0x04: dmaDestination = value; break;
+            case 0x0C: dmaNext        = value; break;
+            case 0x08:
+                dmaRemaining = value & 0xFFFF;
+                dmaMode      = (value >> 16) & 3;
+                dmaIrqEnable = (value >> 18) & 1;
+                if (value >> 31) {
+                    dmaState = !dmaRemaining ? DMA_FINISH : (dmaMode == 1) ? DMA_WRITE : DMA_READ;
+                    dmaTime  = cycles + 1;
+                }
+                break;
+            default: break;
+        }
+    }
+
+    // One engine state per cycle, as in dma_controller (reads of ROM/RAM, writes through the bus)
+    void dmaStep() {
+        switch (dmaState) {
+            case DMA_FETCH: {
+                uint32_t value = word(dmaFetchAddress + 4 * dmaFetchIndex);
+                switch (dmaFetchIndex++) {
+                    case 0: dmaNext        = value; break;
+                    case 1: dmaSource      = value; break;
+                    case 2: dmaDestination = value; break;
+                    default:
+                        dmaRemaining = value & 0xFFFF;
+                        dmaMode      = (value >> 16) & 3;
+                        dmaIrqEnable = (value >> 18) & 1;
+                        dmaState     = !dmaRemaining ? DMA_FINISH : (dmaMode == 1) ? DMA_WRITE : DMA_READ;
+                        break;
+                }
+                break;
+            }
+            case DMA_READ:
+                dmaBuffer = (dmaMode == 2) ? (word(dmaSource) >> (8 * (dmaSource & 3))) : word(dmaSource);
+                dmaState  = DMA_WRITE;
+                break;
+            case DMA_WRITE: {
+                // To-peripheral writes wait for TX FIFO room (peripheralReady)
+                if (dmaDestination == UART_TX && uartTxLevel == UART_FIFO_DEPTH) {
+                    dmaTime = uartTxFreeAt;
+                    return;
+                }
+                uint32_t value = (dmaMode == 1) ? dmaSource : dmaBuffer;
+                if (dmaDestination & 0x40000000)      mmioRegisterWrite(dmaDestination, value);
+                else if (dmaDestination & 0x20000000) {
+                    memcpy(&ram[dmaDestination & (RAM_BYTES - 4)], &value, 4);
+                    if (reservationOffset == (dmaDestination & (RAM_BYTES - 4))) reservationValid = false;
+                }
+                dmaCount++;
+                if (dmaMode == 2) dmaSource++;
+                else {
+                    if (dmaMode == 0) dmaSource += 4;
+                    dmaDestination += 4;
+                }
+                dmaState = (dmaRemaining == 1) ? DMA_FINISH : (dmaMode != 1) ? DMA_READ : DMA_WRITE;
+                dmaRemaining--;
+                break;
+            }
+            case DMA_FINISH:
+                if (dmaIrqEnable) {
+                    dmaIrqFlag      = true;
+                    externalPending = true;
+                }
+                if (dmaNext) {
+                    dmaFetchAddress = dmaNext;
+                    dmaFetchIndex   = 0;
+                    dmaState        = DMA_FETCH;
+                } else {
+                    dmaState = DMA_IDLE;
+                }
+                break;
+            default: break;
+        }
+        dmaTime++;
+    }
+
+    static uint16_t read16(const std::vector<uint8_t> &b, size_t at) { return b[at] | (b[at + 1] << 8); }
+    static uint32_t read32(const std::vector<uint8_t> &b, size_t at) {
+        return b[at] | (b[at + 1] << 8) | (b[at + 2] << 16) | ((uint32_t)b[at + 3] << 24);
+    }
+};
+
+#endif